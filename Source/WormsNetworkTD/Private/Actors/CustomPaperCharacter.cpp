@@ -1,8 +1,14 @@
 #include "Actors/CustomPaperCharacter.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "Simulation/SpatialHashSubsystem.h"
+#include "Simulation/DamageResolutionSubsystem.h"
+#include "Rendering/WormSpriteBatchSubsystem.h"
+#include "Simulation/LockstepSubsystem.h"
 #include <Net/UnrealNetwork.h>
 
-ACustomPaperCharacter::ACustomPaperCharacter()
+ACustomPaperCharacter::ACustomPaperCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.DoNotCreateDefaultSubobject(APaperCharacter::SpriteComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -27,17 +33,44 @@ ACustomPaperCharacter::ACustomPaperCharacter()
 	GetCharacterMovement()->AirControl = 0.8f;
 	GetCharacterMovement()->MaxWalkSpeed = 600.f;
 	GetCharacterMovement()->BrakingFrictionFactor = 2.f;
+}
+
+void ACustomPaperCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Cible des explosions : suivi incrmental par le spatial hash
+	if (USpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatialHashSubsystem>())
+	{
+		SpatialHash->RegisterActor(this, SpatialCategory::Worm);
+	}
 
-	/* ================= CAMERA ================= */
+	// Sprite rendu par lot avec les autres worms du mme atlas
+	if (UWormSpriteBatchSubsystem* SpriteBatch = GetWorld()->GetSubsystem<UWormSpriteBatchSubsystem>())
+	{
+		SpriteHandle = SpriteBatch->AddEntry(this, SpriteOffset, SpriteScale);
+		SpriteBatch->SetTint(SpriteHandle, SpriteTint);
+		// Idle et course dsynchroniss d'un worm  l'autre
+		SpriteBatch->SetPhaseOffset(SpriteHandle, static_cast<int32>(GetUniqueID() % 16));
+		OnRep_FacingDirection();
+		OnRep_PlayerAnimState();
+	}
+}
+
+void ACustomPaperCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatialHashSubsystem>())
+	{
+		SpatialHash->UnregisterActor(this);
+	}
 
-	SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
-	SpringArm->SetupAttachment(RootComponent);
-	SpringArm->TargetArmLength = 500.f;
-	SpringArm->bDoCollisionTest = false;
+	if (UWormSpriteBatchSubsystem* SpriteBatch = GetWorld()->GetSubsystem<UWormSpriteBatchSubsystem>())
+	{
+		SpriteBatch->RemoveEntry(SpriteHandle);
+		SpriteHandle = INDEX_NONE;
+	}
 
-	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
-	Camera->SetupAttachment(SpringArm);
-	Camera->bUsePawnControlRotation = false;
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACustomPaperCharacter::Tick(float DeltaTime)
@@ -49,6 +82,13 @@ void ACustomPaperCharacter::Tick(float DeltaTime)
 	{
 		UpdateAnimations();
 	}
+
+	// Historique : base d'une validation serveur / rconciliation propritaire,
+	// que rien ne lit encore ; pas de capture sans opt-in
+	if (bRecordSnapshotHistory && GetLocalRole() >= ROLE_AutonomousProxy)
+	{
+		SnapshotHistory.Push(CaptureSnapshot());
+	}
 }
 
 void ACustomPaperCharacter::UpdateAnimations()
@@ -80,29 +120,58 @@ void ACustomPaperCharacter::UpdateAnimations()
 	}
 }
 
+UPaperFlipbook* ACustomPaperCharacter::ResolveFlipbook(const TSoftObjectPtr<UPaperFlipbook>& Flipbook) const
+{
+	if (Flipbook.IsNull())
+		return nullptr;
+
+	if (UPaperFlipbook* Loaded = Flipbook.Get())
+		return Loaded;
+
+	UE_LOG(LogTemp, Warning, TEXT("ResolveFlipbook: %s non precharge, chargement synchrone."),
+		*Flipbook.ToSoftObjectPath().ToString());
+	return Flipbook.LoadSynchronous();
+}
+
 void ACustomPaperCharacter::OnRep_PlayerAnimState()
 {
+	// Pas de rendu (serveur ddi) : rien  charger
+	if (SpriteHandle == INDEX_NONE)
+		return;
+
+	UPaperFlipbook* NewFlipbook = nullptr;
+
 	switch (PlayerAnimState)
 	{
 	case EPlayerState::Idle:
-		if (IdleAnim) GetSprite()->SetFlipbook(IdleAnim);
+		NewFlipbook = ResolveFlipbook(IdleAnim);
 		break;
 
 	case EPlayerState::Running:
-		if (RunAnim) GetSprite()->SetFlipbook(RunAnim);
+		NewFlipbook = ResolveFlipbook(RunAnim);
 		break;
 
 	case EPlayerState::Jumping:
-		if (JumpAnim) GetSprite()->SetFlipbook(JumpAnim);
+		NewFlipbook = ResolveFlipbook(JumpAnim);
 		break;
 
 	case EPlayerState::Falling:
-		if (FallAnim) GetSprite()->SetFlipbook(FallAnim);
+		NewFlipbook = ResolveFlipbook(FallAnim);
 		break;
 
 	default:
 		break;
 	}
+
+	if (!NewFlipbook)
+		return;
+
+	if (UWormSpriteBatchSubsystem* SpriteBatch = GetWorld()->GetSubsystem<UWormSpriteBatchSubsystem>())
+	{
+		// Saut et chute repartent de leur premire frame
+		const bool bRestart = PlayerAnimState == EPlayerState::Jumping || PlayerAnimState == EPlayerState::Falling;
+		SpriteBatch->SetFlipbook(SpriteHandle, NewFlipbook, bRestart);
+	}
 }
 
 void ACustomPaperCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -111,15 +180,149 @@ void ACustomPaperCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 
 	DOREPLIFETIME(ACustomPaperCharacter, PlayerAnimState);
 	DOREPLIFETIME(ACustomPaperCharacter, FacingDirection);
+	DOREPLIFETIME(ACustomPaperCharacter, Health);
+	DOREPLIFETIME(ACustomPaperCharacter, LockstepWormIndex);
+}
+
+/* ================= SNAPSHOTS ================= */
+
+double ACustomPaperCharacter::GetSnapshotTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+FWormSnapshot ACustomPaperCharacter::CaptureSnapshot() const
+{
+	const UCharacterMovementComponent* Movement = GetCharacterMovement();
+
+	FWormSnapshot Snapshot;
+	Snapshot.Time = GetSnapshotTime();
+	Snapshot.Location = FVector3f(GetActorLocation());
+	Snapshot.Velocity = FVector3f(Movement->Velocity);
+	Snapshot.Health = static_cast<int16>(FMath::Clamp(Health, 0, MAX_int16));
+	Snapshot.AnimState = static_cast<uint8>(PlayerAnimState);
+	Snapshot.MovementMode = static_cast<uint8>(Movement->MovementMode);
+	Snapshot.Facing = FacingDirection < 0.f ? -1 : 1;
+	return Snapshot;
+}
+
+void ACustomPaperCharacter::RestoreSnapshot(const FWormSnapshot& Snapshot, bool bFullState)
+{
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+
+	// Tlport sans balayage : le spatial hash suit via TransformUpdated
+	SetActorLocation(FVector(Snapshot.Location), false, nullptr, ETeleportType::TeleportPhysics);
+	Movement->Velocity = FVector(Snapshot.Velocity);
+
+	if (!bFullState)
+		return;
+
+	Health = Snapshot.Health;
+	if (Movement->MovementMode != Snapshot.MovementMode)
+	{
+		Movement->SetMovementMode(static_cast<EMovementMode>(Snapshot.MovementMode));
+	}
+
+	const EPlayerState AnimState = static_cast<EPlayerState>(Snapshot.AnimState);
+	if (AnimState != PlayerAnimState)
+	{
+		PlayerAnimState = AnimState;
+		OnRep_PlayerAnimState();
+	}
+
+	if (FacingDirection != Snapshot.Facing)
+	{
+		FacingDirection = Snapshot.Facing;
+		OnRep_FacingDirection();
+	}
+}
+
+/* ================= DGTS ================= */
+
+int32 ACustomPaperCharacter::ApplyResolvedDamage(int32 Damage)
+{
+	if (!HasAuthority() || !IsAlive())
+		return Health;
+
+	Health = FMath::Max(0, Health - FMath::Max(0, Damage));
+
+	if (!IsAlive())
+	{
+		// Plus une cible : sorti du hash, plus de mouvement
+		GetCharacterMovement()->DisableMovement();
+		if (USpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatialHashSubsystem>())
+		{
+			SpatialHash->UnregisterActor(this);
+		}
+	}
+
+	return Health;
+}
+
+void ACustomPaperCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
+
+	// Suivi de chute ct serveur uniquement, rsolu avec le lot de dgts
+	if (HasAuthority() && GetCharacterMovement()->IsFalling())
+	{
+		if (UDamageResolutionSubsystem* Damage = GetWorld()->GetSubsystem<UDamageResolutionSubsystem>())
+		{
+			Damage->NotifyStartedFalling(this);
+		}
+	}
+}
+
+void ACustomPaperCharacter::Landed(const FHitResult& Hit)
+{
+	Super::Landed(Hit);
+
+	if (HasAuthority())
+	{
+		if (UDamageResolutionSubsystem* Damage = GetWorld()->GetSubsystem<UDamageResolutionSubsystem>())
+		{
+			Damage->NotifyLanded(this);
+		}
+	}
 }
 
 void ACustomPaperCharacter::OnRep_FacingDirection()
 {
-	GetSprite()->SetRelativeScale3D(FVector(FacingDirection, 1.f, 1.f));
+	if (SpriteHandle == INDEX_NONE)
+		return;
+
+	if (UWormSpriteBatchSubsystem* SpriteBatch = GetWorld()->GetSubsystem<UWormSpriteBatchSubsystem>())
+	{
+		SpriteBatch->SetFacing(SpriteHandle, FacingDirection);
+	}
 }
 
 void ACustomPaperCharacter::Server_SetFacingDirection_Implementation(float NewDirection)
 {
 	FacingDirection = FMath::Sign(NewDirection);
 	OnRep_FacingDirection();
+}
+
+/* ================= LOCKSTEP ================= */
+
+void ACustomPaperCharacter::SetLockstepWormIndex(int32 WormIndex)
+{
+	if (!HasAuthority())
+		return;
+
+	LockstepWormIndex = WormIndex;
+	OnRep_LockstepWormIndex(); // Le serveur ne reoit pas d'OnRep
+}
+
+void ACustomPaperCharacter::OnRep_LockstepWormIndex()
+{
+	// Ordre libre avec Client_StartLockstep : la liaison survit au BeginMatch
+	if (LockstepWormIndex == INDEX_NONE)
+		return;
+
+	if (ULockstepSubsystem* Lockstep = GetWorld()->GetSubsystem<ULockstepSubsystem>())
+	{
+		Lockstep->BindWormActor(LockstepWormIndex, this);
+	}
 }
\ No newline at end of file
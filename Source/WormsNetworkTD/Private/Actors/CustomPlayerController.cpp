@@ -2,25 +2,23 @@
 
 #include "Actors/CustomPlayerController.h"
 #include "WormsGameInstance.h"
+#include "Profiling/StartupTrace.h"
+#include "Simulation/LockstepSubsystem.h"
+#include "Actors/WormsCameraManager.h"
+
+ACustomPlayerController::ACustomPlayerController()
+{
+	PlayerCameraManagerClass = AWormsCameraManager::StaticClass();
+}
 
 void ACustomPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (!MappingContextBase)
-		return;
-
-	if (GetLocalPlayer())
-	{
-		if (TObjectPtr<UEnhancedInputLocalPlayerSubsystem> InputSystem =
-			GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
-		{
-			InputSystem->AddMappingContext(MappingContextBase, 0);
-		}
-	}
-
-	MyPlayer = Cast<ACustomPaperCharacter>(GetPawn());
+	FStartupTrace::Mark(StartupTraceMarkers::PlayerControllerBeginPlay);
 
+	// Chemin de boot rapide : le menu passe en premier, avant toute init
+	// d'input ou de rseau (l'OnlineSubsystem est rsolu au premier clic).
 	// On n'affiche le menu que si la partie n'a pas encore commenc.
 	// Sans ce guard, BeginPlay recre le menu sur la nouvelle map
 	// aprs le ServerTravel car le PlayerController survit au travel.
@@ -32,6 +30,20 @@ void ACustomPlayerController::BeginPlay()
 			ShowMainMenu();
 		}
 	}
+
+	MyPlayer = Cast<ACustomPaperCharacter>(GetPawn());
+
+	if (!MappingContextBase)
+		return;
+
+	if (GetLocalPlayer())
+	{
+		if (TObjectPtr<UEnhancedInputLocalPlayerSubsystem> InputSystem =
+			GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
+		{
+			InputSystem->AddMappingContext(MappingContextBase, 0);
+		}
+	}
 }
 
 void ACustomPlayerController::Tick(float DeltaTime)
@@ -87,6 +99,49 @@ void ACustomPlayerController::Client_NotifyGameStarting_Implementation()
 	HideMainMenu();
 }
 
+// ============================================================
+//  RPC Lockstep
+// ============================================================
+
+void ACustomPlayerController::Client_StartLockstep_Implementation(const FLockstepMatchConfig& Config, int32 PlayerIndex)
+{
+	if (ULockstepSubsystem* Lockstep = GetWorld()->GetSubsystem<ULockstepSubsystem>())
+	{
+		Lockstep->BeginMatch(Config, PlayerIndex);
+	}
+}
+
+void ACustomPlayerController::Server_SubmitLockstepInputs_Implementation(const FLockstepInputPacket& Packet)
+{
+	// Mme aprs la fin de partie : l'accus arrte le renvoi des dernires frames
+	if (ULockstepSubsystem* Lockstep = GetWorld()->GetSubsystem<ULockstepSubsystem>())
+	{
+		Lockstep->ServerReceiveInputPacket(this, Packet);
+	}
+}
+
+void ACustomPlayerController::Client_ReceiveLockstepFrames_Implementation(const FLockstepFramePacket& Packet)
+{
+	if (ULockstepSubsystem* Lockstep = GetRunningLockstep())
+	{
+		Lockstep->ReceiveConfirmedFramePacket(Packet);
+	}
+}
+
+void ACustomPlayerController::Server_ReportTurnChecksum_Implementation(int32 Turn, uint32 Checksum)
+{
+	if (ULockstepSubsystem* Lockstep = GetRunningLockstep())
+	{
+		Lockstep->ServerReceiveTurnChecksum(this, Turn, Checksum);
+	}
+}
+
+ULockstepSubsystem* ACustomPlayerController::GetRunningLockstep() const
+{
+	ULockstepSubsystem* Lockstep = GetWorld() ? GetWorld()->GetSubsystem<ULockstepSubsystem>() : nullptr;
+	return Lockstep && Lockstep->IsRunning() ? Lockstep : nullptr;
+}
+
 // ============================================================
 //  Input
 // ============================================================
@@ -94,18 +149,41 @@ void ACustomPlayerController::Client_NotifyGameStarting_Implementation()
 void ACustomPlayerController::Move(const FInputActionValue& Value)
 {
 	float Movement = Value.Get<float>();
+
+	// En lockstep, seul l'input part sur le rseau ; la simulation dplace le worm
+	if (ULockstepSubsystem* Lockstep = GetRunningLockstep())
+	{
+		Lockstep->SetLocalMoveAxis(Movement);
+		return;
+	}
+
 	if (!MyPlayer) return;
 
 	MyPlayer->AddMovementInput(FVector::ForwardVector, Movement);
 
-	if (Movement != 0.f)
+	// Move tombe  chaque frame : RPC seulement quand la direction du pawn change
+	// (tat du pawn, pas du contrleur : juste aprs un changement de pawn aussi)
+	const float Facing = Movement > 0.f ? 1.f : -1.f;
+	if (Movement != 0.f && Facing != MyPlayer->FacingDirection)
 	{
-		MyPlayer->Server_SetFacingDirection(Movement);
+		// Applique tout de suite en local, sans attendre la rplication ; le serveur fait foi
+		if (!MyPlayer->HasAuthority())
+		{
+			MyPlayer->FacingDirection = Facing;
+			MyPlayer->OnRep_FacingDirection();
+		}
+		MyPlayer->Server_SetFacingDirection(Facing);
 	}
 }
 
 void ACustomPlayerController::Jump(const FInputActionValue& Value)
 {
+	if (ULockstepSubsystem* Lockstep = GetRunningLockstep())
+	{
+		Lockstep->AddLocalButtons(LockstepConstants::Button_Jump);
+		return;
+	}
+
 	if (!MyPlayer) return;
 	MyPlayer->Jump();
 }
@@ -0,0 +1,18 @@
+#include "Actors/WormsBotController.h"
+
+AWormsBotController::AWormsBotController()
+{
+	// Visible dans le GameState comme un joueur (scores, fin de partie)
+	bWantsPlayerState = true;
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void AWormsBotController::BeginLockstep(int32 PlayerIndex)
+{
+	Brain.Reset(PlayerIndex);
+}
+
+FLockstepInput AWormsBotController::MakeLockstepInput(const FLockstepState& State)
+{
+	return Brain.Think(State);
+}
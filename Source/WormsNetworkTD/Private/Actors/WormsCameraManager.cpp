@@ -0,0 +1,138 @@
+#include "Actors/WormsCameraManager.h"
+#include "Simulation/LockstepSubsystem.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+AWormsCameraManager::AWormsCameraManager()
+{
+	DefaultFOV = 90.f;
+}
+
+bool AWormsCameraManager::GetVisibleRect(FBox2D& OutRect) const
+{
+	OutRect = VisibleRect;
+	return bHasVisibleRect;
+}
+
+bool AWormsCameraManager::GetLocalVisibleRect(const UWorld* World, FBox2D& OutRect)
+{
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	const AWormsCameraManager* Camera = PC ? Cast<AWormsCameraManager>(PC->PlayerCameraManager) : nullptr;
+	return Camera && Camera->GetVisibleRect(OutRect);
+}
+
+// ============================================================
+//  Suivi
+// ============================================================
+
+bool AWormsCameraManager::FindFocus(const AActor* ViewTarget, FVector2D& OutPosition, FVector2D& OutVelocity,
+	bool& bOutProjectile, float& OutMapWidth) const
+{
+	bOutProjectile = false;
+	OutMapWidth = 0.f;
+
+	const ULockstepSubsystem* Lockstep = GetWorld()->GetSubsystem<ULockstepSubsystem>();
+	if (Lockstep && Lockstep->IsRunning())
+	{
+		const FLockstepState& State = Lockstep->GetSimulation().GetState();
+		OutMapWidth = FTerrainMask::CellToWorld(State.Terrain.GetWidth()).ToFloat();
+
+		// Le tir en vol passe avant le worm qui l'a lancé
+		if (State.Projectiles.Num() > 0)
+		{
+			OutPosition = State.Projectiles[0].Position.ToPlane();
+			OutVelocity = State.Projectiles[0].Velocity.ToPlane();
+			bOutProjectile = true;
+			return true;
+		}
+
+		const int32 WormIndex = State.GetActiveWormIndex();
+		if (State.Worms.IsValidIndex(WormIndex))
+		{
+			OutPosition = State.Worms[WormIndex].Position.ToPlane();
+			OutVelocity = State.Worms[WormIndex].Velocity.ToPlane();
+			return true;
+		}
+	}
+
+	if (!ViewTarget)
+		return false;
+
+	const FVector Location = ViewTarget->GetActorLocation();
+	const FVector Velocity = ViewTarget->GetVelocity();
+	OutPosition = FVector2D(Location.X, Location.Z);
+	OutVelocity = FVector2D(Velocity.X, Velocity.Z);
+	return true;
+}
+
+FVector2D AWormsCameraManager::ComputeHalfExtents(const FMinimalViewInfo& POV) const
+{
+	float AspectRatio = POV.AspectRatio;
+	const ULocalPlayer* LocalPlayer = PCOwner ? PCOwner->GetLocalPlayer() : nullptr;
+	if (LocalPlayer && LocalPlayer->ViewportClient)
+	{
+		FVector2D ViewportSize;
+		LocalPlayer->ViewportClient->GetViewportSize(ViewportSize);
+		if (ViewportSize.Y > 0.0)
+		{
+			AspectRatio = static_cast<float>(ViewportSize.X / ViewportSize.Y);
+		}
+	}
+
+	// La caméra regarde le plan XZ (Y = 0) de face
+	const float HalfWidth = POV.ProjectionMode == ECameraProjectionMode::Orthographic
+		? POV.OrthoWidth * 0.5f
+		: FMath::Abs(static_cast<float>(POV.Location.Y)) * FMath::Tan(FMath::DegreesToRadians(POV.FOV * 0.5f));
+	return FVector2D(HalfWidth, HalfWidth / FMath::Max(AspectRatio, KINDA_SMALL_NUMBER));
+}
+
+void AWormsCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	FVector2D Position;
+	FVector2D Velocity;
+	bool bProjectile = false;
+	float MapWidth = 0.f;
+	if (!FindFocus(OutVT.Target, Position, Velocity, bProjectile, MapWidth))
+	{
+		Super::UpdateViewTarget(OutVT, DeltaTime);
+		bHasFocus = false;
+		bHasVisibleRect = false;
+		return;
+	}
+
+	// Visée en avant de la cible, bornée pour ne pas la perdre de vue
+	const FVector2D Desired = Position + (Velocity * LookAheadSeconds).GetClampedToMaxSize(MaxLookAhead);
+	if (!bHasFocus)
+	{
+		SmoothedFocus = Desired;
+		bHasFocus = true;
+	}
+	else
+	{
+		const float SmoothTime = FMath::Max(bProjectile ? ProjectileSmoothTime : FollowSmoothTime, KINDA_SMALL_NUMBER);
+		SmoothedFocus = FMath::Lerp(SmoothedFocus, Desired, 1.f - FMath::Exp(-DeltaTime / SmoothTime));
+	}
+
+	// Vue de côté : caméra en +Y, regard vers -Y, +X à droite de l'écran
+	FMinimalViewInfo& POV = OutVT.POV;
+	POV.Location = FVector(SmoothedFocus.X, CameraDistance, SmoothedFocus.Y);
+	POV.Rotation = FRotator(0.f, -90.f, 0.f);
+	POV.FOV = DefaultFOV;
+	POV.ProjectionMode = ECameraProjectionMode::Perspective;
+
+	// Cadrage : pas de vide au-delà des bords du terrain
+	const FVector2D HalfExtents = ComputeHalfExtents(POV);
+	if (MapWidth > 2.f * HalfExtents.X)
+	{
+		POV.Location.X = FMath::Clamp(POV.Location.X, HalfExtents.X, MapWidth - HalfExtents.X);
+	}
+
+	ApplyCameraModifiers(DeltaTime, POV);
+
+	const FVector2D Center(POV.Location.X, POV.Location.Z);
+	const FVector2D Extent = HalfExtents + FVector2D(CullMargin, CullMargin);
+	VisibleRect = FBox2D(Center - Extent, Center + Extent);
+	bHasVisibleRect = true;
+}
@@ -0,0 +1,81 @@
+#include "Actors/WormsMatchInfo.h"
+#include "Simulation/WaterSubsystem.h"
+#include "Simulation/DamageResolutionSubsystem.h"
+#include "Engine/World.h"
+#include <Net/UnrealNetwork.h>
+
+AWormsMatchInfo::AWormsMatchInfo()
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	// Ne change qu'aux fins de tour
+	SetNetUpdateFrequency(2.f);
+}
+
+void AWormsMatchInfo::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AWormsMatchInfo, WaterLevelRow);
+	DOREPLIFETIME(AWormsMatchInfo, DamageEvents);
+}
+
+void AWormsMatchInfo::SetWaterLevelRow(int32 Row)
+{
+	const uint16 NewRow = static_cast<uint16>(FMath::Clamp(Row, 0, MAX_uint16));
+	if (NewRow == WaterLevelRow)
+		return;
+
+	WaterLevelRow = NewRow;
+	ForceNetUpdate();
+
+	// Le serveur ne reçoit pas d'OnRep
+	OnRep_WaterLevelRow();
+}
+
+void AWormsMatchInfo::OnRep_WaterLevelRow()
+{
+	if (UWaterSubsystem* Water = GetWorld()->GetSubsystem<UWaterSubsystem>())
+	{
+		Water->HandleWaterLevelRow(WaterLevelRow);
+	}
+}
+
+void AWormsMatchInfo::AppendDamageEvents(const TArray<FWormsDamageEvent>& Events)
+{
+	if (Events.Num() == 0)
+		return;
+
+	DamageEvents.Append(Events);
+
+	// Les clients qui ratent un envoi rattrapent les événements encore dans la fenêtre
+	const int32 Overflow = DamageEvents.Num() - DamageConstants::MaxReplicatedEvents;
+	if (Overflow > 0)
+	{
+		DamageEvents.RemoveAt(0, Overflow, EAllowShrinking::No);
+	}
+
+	// Pas d'attente de NetUpdateFrequency : les chiffres doivent suivre l'impact
+	ForceNetUpdate();
+
+	// Le serveur ne reçoit pas d'OnRep
+	OnRep_DamageEvents();
+}
+
+void AWormsMatchInfo::OnRep_DamageEvents()
+{
+	UDamageResolutionSubsystem* Damage = GetWorld()->GetSubsystem<UDamageResolutionSubsystem>();
+	if (!Damage)
+		return;
+
+	// Réplication initiale (avant BeginPlay) : le numéro de départ est celui de la fenêtre reçue,
+	// un joueur qui rejoint ne rejoue pas jusqu'à MaxReplicatedEvents vieux impacts
+	if (!HasActorBegunPlay())
+	{
+		Damage->SkipReplicatedEvents(DamageEvents);
+		return;
+	}
+
+	Damage->HandleReplicatedEvents(DamageEvents);
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "Assets/AssetPreloadSubsystem.h"
+#include "Assets/WormsMatchAssets.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Texture2D.h"
+
+namespace
+{
+	// Catégories d'icônes (poids fort de la clé IconHandles)
+	constexpr uint8 IconCategory_Profile = 0;
+	constexpr uint8 IconCategory_Team = 1;
+	constexpr uint8 IconCategory_RoomMode = 2;
+}
+
+// ============================================================
+//  Initialisation / Nettoyage
+// ============================================================
+
+void UAssetPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UAssetPreloadSubsystem: AssetManager indisponible, prechargement desactive."));
+		return;
+	}
+
+	// Le catalogue ne contient que des soft refs : le charger ne tire aucune texture.
+	const FPrimaryAssetId CatalogId(WormsAssetConstants::MatchAssetsType, MatchAssetsName);
+	CatalogHandle = AssetManager->LoadPrimaryAsset(CatalogId, TArray<FName>(),
+		FStreamableDelegate::CreateUObject(this, &UAssetPreloadSubsystem::OnCatalogLoaded));
+
+	if (!CatalogHandle.IsValid())
+	{
+		// Déjà résident (ou introuvable) : on tente la résolution directe
+		OnCatalogLoaded();
+	}
+}
+
+void UAssetPreloadSubsystem::Deinitialize()
+{
+	ReleaseAll();
+
+	if (CatalogHandle.IsValid())
+	{
+		CatalogHandle->ReleaseHandle();
+		CatalogHandle.Reset();
+	}
+	MatchAssets = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UAssetPreloadSubsystem::OnCatalogLoaded()
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+		return;
+
+	const FPrimaryAssetId CatalogId(WormsAssetConstants::MatchAssetsType, MatchAssetsName);
+	MatchAssets = AssetManager->GetPrimaryAssetObject<UWormsMatchAssets>(CatalogId);
+	if (!MatchAssets)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UAssetPreloadSubsystem: catalogue %s introuvable."), *CatalogId.ToString());
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UAssetPreloadSubsystem: catalogue %s pret."), *CatalogId.ToString());
+
+	// Rejoue les demandes arrivées avant que le catalogue soit prêt
+	if (bMatchBundleRequested)
+	{
+		bMatchBundleRequested = false;
+		PreloadMatchBundle();
+	}
+	if (PendingPlayers.Num() > 0)
+	{
+		const TArray<FPlayerLobbyInfo> Players = MoveTemp(PendingPlayers);
+		PendingPlayers.Reset();
+		PreloadForLobby(Players);
+	}
+}
+
+// ============================================================
+//  Préchargement
+// ============================================================
+
+void UAssetPreloadSubsystem::PreloadMatchBundle()
+{
+	if (!MatchAssets)
+	{
+		bMatchBundleRequested = true;
+		return;
+	}
+
+	if (MatchBundleHandle.IsValid())
+		return;
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+		return;
+
+	MatchBundleHandle = AssetManager->LoadPrimaryAsset(MatchAssets->GetPrimaryAssetId(),
+		{ WormsAssetConstants::Bundle_Match },
+		FStreamableDelegate::CreateUObject(this, &UAssetPreloadSubsystem::HandleAssetsLoaded));
+
+	UE_LOG(LogTemp, Log, TEXT("PreloadMatchBundle: %d flipbook(s) en streaming."), MatchAssets->CharacterFlipbooks.Num());
+}
+
+void UAssetPreloadSubsystem::PreloadForLobby(const TArray<FPlayerLobbyInfo>& Players)
+{
+	if (!MatchAssets)
+	{
+		// Le catalogue arrive : on mémorise le dernier roster uniquement
+		PendingPlayers = Players;
+		return;
+	}
+
+	// Clés nécessaires pour ce roster
+	TSet<int32> WantedKeys;
+	for (const FPlayerLobbyInfo& Player : Players)
+	{
+		if (MatchAssets->ProfileIcons.IsValidIndex(Player.ProfileIcon))
+		{
+			const int32 Key = MakeIconKey(IconCategory_Profile, Player.ProfileIcon);
+			WantedKeys.Add(Key);
+			RequestIcon(Key, MatchAssets->ProfileIcons[Player.ProfileIcon]);
+		}
+		if (MatchAssets->TeamIcons.IsValidIndex(Player.TeamIcon))
+		{
+			const int32 Key = MakeIconKey(IconCategory_Team, Player.TeamIcon);
+			WantedKeys.Add(Key);
+			RequestIcon(Key, MatchAssets->TeamIcons[Player.TeamIcon]);
+		}
+	}
+
+	// Les icônes de mode de room restent chargées tant que le menu existe
+	for (int32 i = 0; i < MatchAssets->RoomModeIcons.Num(); i++)
+	{
+		const int32 Key = MakeIconKey(IconCategory_RoomMode, i);
+		WantedKeys.Add(Key);
+		RequestIcon(Key, MatchAssets->RoomModeIcons[i]);
+	}
+
+	// Relâche ce que plus personne n'utilise
+	for (auto It = IconHandles.CreateIterator(); It; ++It)
+	{
+		if (!WantedKeys.Contains(It.Key()))
+		{
+			if (It.Value().IsValid())
+			{
+				It.Value()->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	// Le lobby est le bon moment pour streamer les flipbooks de la partie
+	PreloadMatchBundle();
+}
+
+void UAssetPreloadSubsystem::RequestIcon(int32 Key, const TSoftObjectPtr<UTexture2D>& Icon)
+{
+	if (IconHandles.Contains(Key) || Icon.IsNull())
+		return;
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+		return;
+
+	TSharedPtr<FStreamableHandle> Handle = AssetManager->GetStreamableManager().RequestAsyncLoad(
+		Icon.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &UAssetPreloadSubsystem::HandleAssetsLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	IconHandles.Add(Key, Handle);
+}
+
+void UAssetPreloadSubsystem::ReleaseAll()
+{
+	for (TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : IconHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	IconHandles.Empty();
+
+	if (MatchBundleHandle.IsValid())
+	{
+		MatchBundleHandle->ReleaseHandle();
+		MatchBundleHandle.Reset();
+	}
+
+	PendingPlayers.Reset();
+	bMatchBundleRequested = false;
+}
+
+void UAssetPreloadSubsystem::HandleAssetsLoaded()
+{
+	OnPreloadedAssetsChanged.Broadcast();
+}
+
+// ============================================================
+//  Accesseurs
+// ============================================================
+
+UTexture2D* UAssetPreloadSubsystem::ResolveIcon(const TArray<TSoftObjectPtr<UTexture2D>>* Icons, int32 Index)
+{
+	if (!Icons || !Icons->IsValidIndex(Index))
+		return nullptr;
+
+	// Get() ne déclenche jamais de chargement synchrone
+	return (*Icons)[Index].Get();
+}
+
+UTexture2D* UAssetPreloadSubsystem::GetProfileIcon(int32 Index) const
+{
+	return ResolveIcon(MatchAssets ? &MatchAssets->ProfileIcons : nullptr, Index);
+}
+
+UTexture2D* UAssetPreloadSubsystem::GetTeamIcon(int32 Index) const
+{
+	return ResolveIcon(MatchAssets ? &MatchAssets->TeamIcons : nullptr, Index);
+}
+
+UTexture2D* UAssetPreloadSubsystem::GetRoomModeIcon(int32 Index) const
+{
+	return ResolveIcon(MatchAssets ? &MatchAssets->RoomModeIcons : nullptr, Index);
+}
@@ -1,6 +1,7 @@
 #include "Beacon/LobbyBeaconClient.h"
 #include "Beacon/LobbyBeaconHostObject.h"
 #include "GameFramework/PlayerController.h"
+#include "Engine/NetConnection.h"
 
 ALobbyBeaconClient::ALobbyBeaconClient(const FObjectInitializer& Initializer)
 	: Super(Initializer)
@@ -17,15 +18,33 @@ void ALobbyBeaconClient::OnConnected()
 	Super::OnConnected();
 	UE_LOG(LogTemp, Warning, TEXT("ALobbyBeaconClient: connecte au beacon host."));
 
-	// Ds que la connexion est tablie, on demande une place
+	OnBeaconConnected.ExecuteIfBound();
+
+	// Rservation demande avant l'ouverture (ou connexion classique) : elle part maintenant
+	if (bAutoReserve)
+	{
+		RequestReservation();
+	}
+}
+
+void ALobbyBeaconClient::RequestReservation()
+{
+	if (!IsConnected())
+	{
+		bAutoReserve = true;
+		return;
+	}
+
+	// PlayerId dj connu (hte, ou place reprise aprs une migration) : propos
+	// au host, qui reste seul  attribuer les index
 	const ULocalPlayer* LocalPlayer = GetWorld()->GetFirstLocalPlayerFromController();
 	if (LocalPlayer)
 	{
-		Server_RequestReservation(LocalPlayer->GetPreferredUniqueNetId());
+		Server_RequestReservation(LocalPlayer->GetPreferredUniqueNetId(), PendingPlayerInfo.PlayerId);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("ALobbyBeaconClient::OnConnected: aucun LocalPlayer trouve."));
+		UE_LOG(LogTemp, Error, TEXT("ALobbyBeaconClient::RequestReservation: aucun LocalPlayer trouve."));
 		// Signale l'chec au subsystem
 		if (OnRequestValidate.IsBound())
 		{
@@ -37,6 +56,16 @@ void ALobbyBeaconClient::OnConnected()
 void ALobbyBeaconClient::OnFailure()
 {
 	Super::OnFailure();
+
+	// Dj dans le lobby : c'est l'hte qui est parti, pas une rservation qui choue
+	if (bAdmitted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ALobbyBeaconClient: connexion au host perdue (revision %d)."), RosterRevision);
+		bAdmitted = false;
+		OnHostLost.ExecuteIfBound();
+		return;
+	}
+
 	UE_LOG(LogTemp, Error, TEXT("ALobbyBeaconClient: echec de connexion au beacon host."));
 
 	if (OnRequestValidate.IsBound())
@@ -50,11 +79,26 @@ bool ALobbyBeaconClient::ConnectToServer(FURL& Url)
 	return InitClient(Url);
 }
 
+bool ALobbyBeaconClient::InitBase()
+{
+	if (!Super::InitBase())
+		return false;
+
+#if DO_ENABLE_NET_TEST
+	// NetDriver cr, connexion pas encore ouverte : la poigne de main subit aussi les conditions
+	if (PacketSimulation.IsSet() && NetDriver)
+	{
+		NetDriver->SetPacketSimulationSettings(PacketSimulation.GetValue());
+	}
+#endif
+	return true;
+}
+
 // ============================================================
 //  Rservation
 // ============================================================
 
-void ALobbyBeaconClient::Server_RequestReservation_Implementation(const FUniqueNetIdRepl& PlayerNetId)
+void ALobbyBeaconClient::Server_RequestReservation_Implementation(const FUniqueNetIdRepl& PlayerNetId, int32 PlayerId)
 {
 	ALobbyBeaconHostObject* Host = Cast<ALobbyBeaconHostObject>(GetBeaconOwner());
 	if (!Host)
@@ -64,24 +108,35 @@ void ALobbyBeaconClient::Server_RequestReservation_Implementation(const FUniqueN
 		return;
 	}
 
-	if (Host->ReservedSlots >= Host->MaxSlots)
+	// Demande rejoue sur une connexion qui a dj sa place : pas de second slot
+	if (AssignedPlayerId != 0)
+	{
+		Client_ReservationAccepted(AssignedPlayerId);
+		return;
+	}
+
+	// Place et index compact attribus par le host (refus : room pleine ou en fermeture)
+	AssignedPlayerId = Host->GrantReservation(PlayerNetId, PlayerId);
+	if (AssignedPlayerId == 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Server_RequestReservation: lobby plein (%d/%d)."),
-			Host->ReservedSlots, Host->MaxSlots);
 		Client_ReservationDenied();
 		return;
 	}
+	ReservedNetId = PlayerNetId;
 
-	Host->ReservedSlots++;
-	UE_LOG(LogTemp, Warning, TEXT("Server_RequestReservation: reservation accordee (%d/%d)."),
-		Host->ReservedSlots, Host->MaxSlots);
+	Client_ReservationAccepted(AssignedPlayerId);
 
-	Client_ReservationAccepted();
+	// Les connexions sans place ne reoivent pas le roster : envoi  l'admission
+	Client_ReceiveRoomSettings(Host->RoomSettings);
+	Client_ReceiveLobbyUpdate(Host->ConnectedPlayers, Host->RosterRevision, Host->HostPlayerId);
+	Host->SendChatHistory(this);
 }
 
-void ALobbyBeaconClient::Client_ReservationAccepted_Implementation()
+void ALobbyBeaconClient::Client_ReservationAccepted_Implementation(int32 PlayerId)
 {
-	UE_LOG(LogTemp, Warning, TEXT("ALobbyBeaconClient: reservation acceptee."));
+	UE_LOG(LogTemp, Warning, TEXT("ALobbyBeaconClient: reservation acceptee (joueur %d)."), PlayerId);
+	bAdmitted = true;
+	PendingPlayerInfo.PlayerId = PlayerId;
 
 	// 1. Notifie le subsystem (qui informera l'UI via OnBeaconClientCreated)
 	if (OnRequestValidate.IsBound())
@@ -97,12 +152,6 @@ void ALobbyBeaconClient::Client_ReservationAccepted_Implementation()
 	//    PendingPlayerInfo est pr-rempli par ConnectHostAsClient() pour l'hte.
 	//    Pour un client normal, il contient les valeurs par dfaut   remplacer
 	//    par les vraies donnes de profil (GameInstance / SaveGame).
-	if (PendingPlayerInfo.PlayerId == 0)
-	{
-		// Gnre un ID pseudo-unique si non fourni
-		PendingPlayerInfo.PlayerId = static_cast<int32>(FPlatformTime::Cycles() & 0x7FFFFFFF);
-	}
-
 	Server_SendLobbyInfo(PendingPlayerInfo);
 }
 
@@ -129,11 +178,137 @@ void ALobbyBeaconClient::Server_SendLobbyInfo_Implementation(const FPlayerLobbyI
 		return;
 	}
 
-	Host->RegisterOrUpdatePlayer(PlayerInfo);
+	// Ni l'index, ni l'identit, ni l'adresse ne viennent du client : index et
+	// identit de la rservation, adresse vue par l'hte (cible d'une migration)
+	FPlayerLobbyInfo HostSideInfo = PlayerInfo;
+	HostSideInfo.PlayerId = AssignedPlayerId;
+	HostSideInfo.UniqueNetId = ReservedNetId;
+	const UNetConnection* Connection = GetNetConnection();
+	HostSideInfo.NetAddress = Connection ? Connection->LowLevelGetRemoteAddress(false) : FString();
+
+	Host->RegisterOrUpdatePlayer(HostSideInfo);
 }
 
-void ALobbyBeaconClient::Client_ReceiveLobbyUpdate_Implementation(const TArray<FPlayerLobbyInfo>& Players)
+void ALobbyBeaconClient::Client_ReceiveLobbyUpdate_Implementation(const TArray<FPlayerLobbyInfo>& Players, int32 Revision, int32 InHostPlayerId)
 {
-	UE_LOG(LogTemp, Log, TEXT("Client_ReceiveLobbyUpdate: %d joueur(s) dans le lobby."), Players.Num());
+	if (Revision < RosterRevision)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Client_ReceiveLobbyUpdate: revision %d perimee (locale %d), ignoree."), Revision, RosterRevision);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Client_ReceiveLobbyUpdate: %d joueur(s) dans le lobby (revision %d)."), Players.Num(), Revision);
+	LobbyPlayers = Players;
+	RosterRevision = Revision;
+	HostPlayerId = InHostPlayerId;
+
+	// Un joueur parti n'est plus prt (l'hte a oubli son tat sans le diffuser)
+	for (auto It = ReadyPlayerIds.CreateIterator(); It; ++It)
+	{
+		if (!Players.ContainsByPredicate([Id = *It](const FPlayerLobbyInfo& Player) { return Player.PlayerId == Id; }))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
 	OnLobbyUpdated.Broadcast(Players);
+}
+
+void ALobbyBeaconClient::Client_ReceiveRoomSettings_Implementation(const FRoomSettings& Settings)
+{
+	RoomSettings = Settings;
+}
+
+// ============================================================
+//  Canal chat / prt
+// ============================================================
+
+void ALobbyBeaconClient::Server_SendChat_Implementation(const FString& Text)
+{
+	if (ALobbyBeaconHostObject* Host = Cast<ALobbyBeaconHostObject>(GetBeaconOwner()))
+	{
+		Host->PostChat(this, Text);
+	}
+}
+
+void ALobbyBeaconClient::Server_SetReady_Implementation(bool bReady)
+{
+	if (ALobbyBeaconHostObject* Host = Cast<ALobbyBeaconHostObject>(GetBeaconOwner()))
+	{
+		Host->PostReady(this, bReady);
+	}
+}
+
+void ALobbyBeaconClient::Client_ReceiveLobbyEvents_Implementation(const TArray<FLobbyChannelEvent>& Events)
+{
+	ApplyLobbyEvents(Events);
+}
+
+void ALobbyBeaconClient::Client_ReceiveChatHistory_Implementation(const TArray<uint8>& Chunk, int32 RawSize, bool bCompressed)
+{
+	TArray<FLobbyChannelEvent> Events;
+	if (!FLobbyChatChannel::ReadHistoryChunk(Chunk, RawSize, bCompressed, Events))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Client_ReceiveChatHistory: bloc illisible (%d octets)."), Chunk.Num());
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Client_ReceiveChatHistory: %d evenement(s) recu(s)."), Events.Num());
+	ChatLog.Reset();
+	ReadyPlayerIds.Reset();
+	ApplyLobbyEvents(Events);
+}
+
+void ALobbyBeaconClient::ApplyLobbyEvents(const TArray<FLobbyChannelEvent>& Events)
+{
+	for (const FLobbyChannelEvent& Event : Events)
+	{
+		if (Event.Kind == ELobbyEventKind::Ready)
+		{
+			if (Event.bReady)
+			{
+				ReadyPlayerIds.Add(Event.PlayerId);
+			}
+			else
+			{
+				ReadyPlayerIds.Remove(Event.PlayerId);
+			}
+		}
+		else
+		{
+			ChatLog.Add(Event);
+		}
+	}
+
+	// Journal born : les plus anciens messages sortent en premier
+	if (ChatLog.Num() > MaxChatLog)
+	{
+		ChatLog.RemoveAt(0, ChatLog.Num() - MaxChatLog);
+	}
+
+	OnLobbyEvents.Broadcast(Events);
+}
+
+// ============================================================
+//  Fermeture de la room
+// ============================================================
+
+void ALobbyBeaconClient::Client_RoomClosing_Implementation()
+{
+	UE_LOG(LogTemp, Warning, TEXT("ALobbyBeaconClient: room fermee par l'hote."));
+
+	// La dconnexion qui suit est voulue : pas de migration d'hte
+	bAdmitted = false;
+
+	// Acquittement avant le delegate, qui dtruit gnralement ce client
+	Server_AckRoomClosing();
+	OnRoomClosed.ExecuteIfBound();
+}
+
+void ALobbyBeaconClient::Server_AckRoomClosing_Implementation()
+{
+	if (ALobbyBeaconHostObject* Host = Cast<ALobbyBeaconHostObject>(GetBeaconOwner()))
+	{
+		Host->AcknowledgeClose(this);
+	}
 }
\ No newline at end of file
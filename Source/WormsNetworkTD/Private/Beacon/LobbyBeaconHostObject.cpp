@@ -1,5 +1,6 @@
 #include "Beacon/LobbyBeaconHostObject.h"
 #include "Beacon/LobbyBeaconClient.h"
+#include "TimerManager.h"
 
 ALobbyBeaconHostObject::ALobbyBeaconHostObject(const FObjectInitializer& Initializer)
 	: Super(Initializer)
@@ -28,8 +29,8 @@ void ALobbyBeaconHostObject::OnClientConnected(AOnlineBeaconClient* NewClientAct
 	UE_LOG(LogTemp, Warning, TEXT("OnClientConnected: client ajoute (%d connecte(s))."),
 		ConnectedClients.Num());
 
-	// Envoie immdiatement l'tat actuel du lobby au nouveau client
-	LobbyClient->Client_ReceiveLobbyUpdate(ConnectedPlayers);
+	// Pas de roster ici : une connexion peut rester sans place (tenue au chaud
+	// par le pool du client) ; il part  l'admission (Server_RequestReservation).
 }
 
 // ============================================================
@@ -47,6 +48,17 @@ void ALobbyBeaconHostObject::NotifyClientDisconnected(AOnlineBeaconClient* Leavi
 
 		UE_LOG(LogTemp, Warning, TEXT("NotifyClientDisconnected: client retire (%d restant(s))."),
 			ConnectedClients.Num());
+
+		// Parti avant d'acquitter la fermeture : inutile de l'attendre
+		if (bClosing)
+		{
+			AcknowledgeClose(LobbyClient);
+		}
+		else if (LobbyClient->HasReservation())
+		{
+			// Sa place et son index redeviennent disponibles
+			UnregisterPlayer(LobbyClient->GetAssignedPlayerId());
+		}
 	}
 }
 
@@ -60,30 +72,138 @@ AOnlineBeaconClient* ALobbyBeaconHostObject::SpawnBeaconActor(UNetConnection* Cl
 	return Super::SpawnBeaconActor(ClientConnection);
 }
 
+// ============================================================
+//  Rservation et index des joueurs
+// ============================================================
+
+int32 ALobbyBeaconHostObject::GrantReservation(const FUniqueNetIdRepl& PlayerNetId, int32 PreferredPlayerId)
+{
+	// Room en cours de fermeture : plus aucune place
+	if (bClosing)
+		return 0;
+
+	// Joueur de l'ancien roster aprs une migration : sa place est dj compte.
+	// Une autre identit qui la rclame passe par l'attribution normale
+	const FUniqueNetIdRepl* MigratedNetId = PreferredPlayerId != 0 ? MigratedPlayerIds.Find(PreferredPlayerId) : nullptr;
+	if (MigratedNetId && PlayerNetId.IsValid() && *MigratedNetId == PlayerNetId)
+	{
+		MigratedPlayerIds.Remove(PreferredPlayerId);
+		if (MigratedPlayerIds.Num() == 0)
+		{
+			GetWorldTimerManager().ClearTimer(MigrationGraceTimer);
+		}
+		NetIdToPlayerId.Add(PlayerNetId, PreferredPlayerId);
+		UE_LOG(LogTemp, Warning, TEXT("GrantReservation: place reprise pour le joueur %d."), PreferredPlayerId);
+		return PreferredPlayerId;
+	}
+
+	if (ReservedSlots >= MaxSlots)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GrantReservation: lobby plein (%d/%d)."), ReservedSlots, MaxSlots);
+		return 0;
+	}
+
+	const int32 PlayerId = AllocatePlayerId(PlayerNetId, PreferredPlayerId);
+	if (PlayerId == 0)
+		return 0;
+
+	AssignedPlayerIds.Add(PlayerId);
+	if (PlayerNetId.IsValid())
+	{
+		NetIdToPlayerId.Add(PlayerNetId, PlayerId);
+	}
+	ReservedSlots++;
+
+	UE_LOG(LogTemp, Warning, TEXT("GrantReservation: joueur %d admis (%d/%d)."), PlayerId, ReservedSlots, MaxSlots);
+	return PlayerId;
+}
+
+int32 ALobbyBeaconHostObject::AllocatePlayerId(const FUniqueNetIdRepl& PlayerNetId, int32 PreferredPlayerId) const
+{
+	const auto IsFree = [this](int32 PlayerId)
+	{
+		return !AssignedPlayerIds.Contains(PlayerId) && !MigratedPlayerIds.Contains(PlayerId);
+	};
+
+	// Mme identit qu'un joueur parti : mme index. Une identit partage par
+	// plusieurs connexions (bench, PIE sur un seul compte) retombe sur un index neuf.
+	if (const int32* Previous = PlayerNetId.IsValid() ? NetIdToPlayerId.Find(PlayerNetId) : nullptr)
+	{
+		if (IsFree(*Previous))
+			return *Previous;
+	}
+
+	if (PreferredPlayerId != 0 && PreferredPlayerId == HostPlayerId && IsFree(PreferredPlayerId))
+		return PreferredPlayerId;
+
+	// L'index de l'hte lui reste rserv tant qu'il ne l'a pas pris
+	for (int32 PlayerId = 1; PlayerId <= LobbyConstants::MaxPlayerIndex; PlayerId++)
+	{
+		if (PlayerId != HostPlayerId && IsFree(PlayerId))
+			return PlayerId;
+	}
+
+	UE_LOG(LogTemp, Error, TEXT("AllocatePlayerId: plus aucun index libre."));
+	return 0;
+}
+
+const FPlayerLobbyInfo* ALobbyBeaconHostObject::FindPlayer(int32 PlayerId) const
+{
+	const int32* Slot = PlayerToSlot.Find(PlayerId);
+	return Slot ? &ConnectedPlayers[*Slot] : nullptr;
+}
+
+bool ALobbyBeaconHostObject::RemoveFromRoster(int32 PlayerId)
+{
+	int32 Slot = INDEX_NONE;
+	if (!PlayerToSlot.RemoveAndCopyValue(PlayerId, Slot))
+		return false;
+
+	// Le dernier joueur prend la place libre : seule son entre change
+	ConnectedPlayers.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	if (ConnectedPlayers.IsValidIndex(Slot))
+	{
+		PlayerToSlot.Add(ConnectedPlayers[Slot].PlayerId, Slot);
+	}
+	return true;
+}
+
+void ALobbyBeaconHostObject::RebuildPlayerIndex()
+{
+	PlayerToSlot.Reset();
+	for (int32 Slot = 0; Slot < ConnectedPlayers.Num(); Slot++)
+	{
+		PlayerToSlot.Add(ConnectedPlayers[Slot].PlayerId, Slot);
+	}
+}
+
 // ============================================================
 //  Gestion des joueurs
 // ============================================================
 
 void ALobbyBeaconHostObject::RegisterOrUpdatePlayer(const FPlayerLobbyInfo& PlayerInfo)
 {
+	// Seul un index accord par GrantReservation entre dans le roster
+	if (!AssignedPlayerIds.Contains(PlayerInfo.PlayerId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RegisterOrUpdatePlayer: joueur %d sans reservation, ignore."), PlayerInfo.PlayerId);
+		return;
+	}
+
 	// L'hte impose son propre nombre d'units  tous les joueurs
 	FPlayerLobbyInfo CorrectedInfo = PlayerInfo;
 	CorrectedInfo.UnitNB = RoomUnitCount;
 
-	const int32 ExistingIndex = ConnectedPlayers.IndexOfByPredicate(
-		[&](const FPlayerLobbyInfo& P) { return P.PlayerId == CorrectedInfo.PlayerId; }
-	);
-
-	if (ExistingIndex != INDEX_NONE)
+	if (const int32* ExistingSlot = PlayerToSlot.Find(CorrectedInfo.PlayerId))
 	{
 		// Mise  jour d'un joueur existant
-		ConnectedPlayers[ExistingIndex] = CorrectedInfo;
+		ConnectedPlayers[*ExistingSlot] = CorrectedInfo;
 		UE_LOG(LogTemp, Log, TEXT("RegisterOrUpdatePlayer: mise a jour de '%s'."), *CorrectedInfo.PlayerName);
 	}
 	else
 	{
 		// Nouveau joueur
-		ConnectedPlayers.Add(CorrectedInfo);
+		PlayerToSlot.Add(CorrectedInfo.PlayerId, ConnectedPlayers.Add(CorrectedInfo));
 		UE_LOG(LogTemp, Warning, TEXT("RegisterOrUpdatePlayer: '%s' ajoute (%d joueur(s))."),
 			*CorrectedInfo.PlayerName, ConnectedPlayers.Num());
 	}
@@ -93,36 +213,251 @@ void ALobbyBeaconHostObject::RegisterOrUpdatePlayer(const FPlayerLobbyInfo& Play
 
 void ALobbyBeaconHostObject::UnregisterPlayer(int32 PlayerId)
 {
-	const int32 RemovedCount = ConnectedPlayers.RemoveAll(
-		[PlayerId](const FPlayerLobbyInfo& P) { return P.PlayerId == PlayerId; }
-	);
+	// Place libre mme si les infos du joueur n'taient pas encore arrives
+	if (AssignedPlayerIds.Remove(PlayerId) == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnregisterPlayer: joueur %d introuvable."), PlayerId);
+		return;
+	}
+
+	ReservedSlots = FMath::Max(0, ReservedSlots - 1);
+	const bool bWasListed = RemoveFromRoster(PlayerId);
+	ChatChannel.RemovePlayer(PlayerId);
+
+	UE_LOG(LogTemp, Warning, TEXT("UnregisterPlayer: joueur %d retire (%d restant(s))."),
+		PlayerId, ConnectedPlayers.Num());
+
+	if (bWasListed)
+	{
+		BroadcastLobbyUpdate();
+	}
+}
+
+// ============================================================
+//  Migration d'hte
+// ============================================================
+
+void ALobbyBeaconHostObject::AdoptMigratedRoster(const TArray<FPlayerLobbyInfo>& Players, int32 PriorRevision)
+{
+	ConnectedPlayers = Players;
+	ReservedSlots = Players.Num();
+	RosterRevision = PriorRevision;
+	RebuildPlayerIndex();
+
+	// Toutes les places sont en attente, y compris celle du nouvel hte
+	// (son client local passe par la mme reconnexion que les autres).
+	// Les index sont conservs : ceux de l'ancien hte restent valables.
+	MigratedPlayerIds.Reset();
+	AssignedPlayerIds.Reset();
+	for (const FPlayerLobbyInfo& Player : Players)
+	{
+		MigratedPlayerIds.Add(Player.PlayerId, Player.UniqueNetId);
+		AssignedPlayerIds.Add(Player.PlayerId);
+		if (Player.UniqueNetId.IsValid())
+		{
+			NetIdToPlayerId.Add(Player.UniqueNetId, Player.PlayerId);
+		}
+	}
+
+	GetWorldTimerManager().SetTimer(MigrationGraceTimer, this,
+		&ALobbyBeaconHostObject::ExpireMigratedSlots, LobbyConstants::MigrationGraceSeconds, false);
+
+	UE_LOG(LogTemp, Warning, TEXT("AdoptMigratedRoster: %d joueur(s) repris (revision %d)."),
+		Players.Num(), PriorRevision);
+}
+
+void ALobbyBeaconHostObject::ExpireMigratedSlots()
+{
+	if (MigratedPlayerIds.Num() == 0)
+		return;
+
+	UE_LOG(LogTemp, Warning, TEXT("ExpireMigratedSlots: %d joueur(s) non reconnecte(s), places liberees."),
+		MigratedPlayerIds.Num());
+
+	// Une seule diffusion pour tous les absents
+	int32 RemovedCount = 0;
+	for (const TPair<int32, FUniqueNetIdRepl>& Migrated : MigratedPlayerIds)
+	{
+		AssignedPlayerIds.Remove(Migrated.Key);
+		ChatChannel.RemovePlayer(Migrated.Key);
+		RemovedCount += RemoveFromRoster(Migrated.Key) ? 1 : 0;
+	}
+	ReservedSlots = FMath::Max(0, ReservedSlots - MigratedPlayerIds.Num());
+	MigratedPlayerIds.Reset();
 
 	if (RemovedCount > 0)
 	{
-		ReservedSlots = FMath::Max(0, ReservedSlots - 1);
-		UE_LOG(LogTemp, Warning, TEXT("UnregisterPlayer: joueur %d retire (%d restant(s))."),
-			PlayerId, ConnectedPlayers.Num());
 		BroadcastLobbyUpdate();
 	}
-	else
+}
+
+// ============================================================
+//  Fermeture de la room
+// ============================================================
+
+void ALobbyBeaconHostObject::BeginClose(FSimpleDelegate OnClosed)
+{
+	if (bClosing)
+		return;
+
+	bClosing = true;
+	OnCloseFinished = OnClosed;
+	CloseStartSeconds = FPlatformTime::Seconds();
+
+	// Une seule notification par client ; plus de diffusion du roster d'ici la fin
+	PendingCloseAcks.Reset();
+	for (ALobbyBeaconClient* Client : ConnectedClients)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnregisterPlayer: joueur %d introuvable."), PlayerId);
+		if (IsValid(Client) && Client->HasReservation())
+		{
+			PendingCloseAcks.Add(Client);
+			Client->Client_RoomClosing();
+		}
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("BeginClose: %d client(s) prevenu(s)."), PendingCloseAcks.Num());
+
+	if (PendingCloseAcks.Num() == 0)
+	{
+		FinishClose();
+		return;
+	}
+
+	GetWorldTimerManager().SetTimer(CloseTimer, this,
+		&ALobbyBeaconHostObject::FinishClose, LobbyConstants::CloseAckTimeoutSeconds, false);
+}
+
+void ALobbyBeaconHostObject::AcknowledgeClose(ALobbyBeaconClient* Client)
+{
+	if (!bClosing || PendingCloseAcks.Remove(Client) == 0)
+		return;
+
+	if (PendingCloseAcks.Num() == 0)
+	{
+		FinishClose();
+	}
+}
+
+void ALobbyBeaconHostObject::FinishClose()
+{
+	GetWorldTimerManager().ClearTimer(CloseTimer);
+
+	UE_LOG(LogTemp, Warning, TEXT("FinishClose: %d place(s) liberee(s) en %.1f ms (%d sans acquittement)."),
+		ReservedSlots, (FPlatformTime::Seconds() - CloseStartSeconds) * 1000.0, PendingCloseAcks.Num());
+
+	// Libration en un lot, sans diffusion : les clients ont dj quitt le lobby
+	ConnectedPlayers.Reset();
+	PlayerToSlot.Reset();
+	AssignedPlayerIds.Reset();
+	ReservedSlots = 0;
+	MigratedPlayerIds.Reset();
+	GetWorldTimerManager().ClearTimer(MigrationGraceTimer);
+	PendingCloseAcks.Reset();
+	ChatChannel.Reset();
+	GetWorldTimerManager().ClearTimer(ChatFlushTimer);
+
+	// Copie : l'appelant dtruit gnralement le beacon host dans ce callback
+	const FSimpleDelegate Finished = OnCloseFinished;
+	OnCloseFinished.Unbind();
+	Finished.ExecuteIfBound();
+}
+
+// ============================================================
+//  Canal chat / prt
+// ============================================================
+
+void ALobbyBeaconHostObject::PostChat(ALobbyBeaconClient* Client, const FString& Text)
+{
+	if (bClosing || !IsValid(Client) || !Client->HasReservation())
+		return;
+
+	if (ChatChannel.PostChat(Client->GetAssignedPlayerId(), Text, FPlatformTime::Seconds()))
+	{
+		ScheduleChatFlush();
+	}
+}
+
+void ALobbyBeaconHostObject::PostReady(ALobbyBeaconClient* Client, bool bReady)
+{
+	if (bClosing || !IsValid(Client) || !Client->HasReservation())
+		return;
+
+	if (ChatChannel.PostReady(Client->GetAssignedPlayerId(), bReady, FPlatformTime::Seconds()))
+	{
+		ScheduleChatFlush();
 	}
 }
 
+void ALobbyBeaconHostObject::ScheduleChatFlush()
+{
+	if (GetWorldTimerManager().IsTimerActive(ChatFlushTimer))
+		return;
+
+	GetWorldTimerManager().SetTimer(ChatFlushTimer, this,
+		&ALobbyBeaconHostObject::FlushChat, FLobbyChatChannel::FlushIntervalSeconds, false);
+}
+
+void ALobbyBeaconHostObject::FlushChat()
+{
+	FlushChatExcept(nullptr);
+}
+
+void ALobbyBeaconHostObject::FlushChatExcept(const ALobbyBeaconClient* Excluded)
+{
+	if (bClosing || !ChatChannel.HasPending())
+		return;
+
+	// Tout ce qui s'est accumul pendant l'intervalle part en un seul RPC par client
+	const TArray<FLobbyChannelEvent> Events = ChatChannel.TakePending();
+
+	TArray<ALobbyBeaconClient*> ClientsCopy = ConnectedClients;
+	for (ALobbyBeaconClient* Client : ClientsCopy)
+	{
+		if (IsValid(Client) && Client != Excluded && Client->HasReservation())
+		{
+			Client->Client_ReceiveLobbyEvents(Events);
+		}
+	}
+}
+
+void ALobbyBeaconHostObject::SendChatHistory(ALobbyBeaconClient* Client)
+{
+	if (!IsValid(Client))
+		return;
+
+	// Les entres en attente sont dj dans l'historique : elles partent avant
+	// chez les autres, l'arrivant (dj admis) ne les reoit que par l'historique
+	GetWorldTimerManager().ClearTimer(ChatFlushTimer);
+	FlushChatExcept(Client);
+
+	TArray<uint8> Chunk;
+	int32 RawSize = 0;
+	bool bCompressed = false;
+	ChatChannel.BuildHistoryChunk(Chunk, RawSize, bCompressed);
+
+	UE_LOG(LogTemp, Log, TEXT("SendChatHistory: historique envoye (%d octets, %d non compresses)."), Chunk.Num(), RawSize);
+	Client->Client_ReceiveChatHistory(Chunk, RawSize, bCompressed);
+}
+
 // ============================================================
 //  Diffusion
 // ============================================================
 
 void ALobbyBeaconHostObject::BroadcastLobbyUpdate()
 {
+	// Room en fermeture : les clients ne regardent plus le roster
+	if (bClosing)
+		return;
+
+	RosterRevision++;
+
 	// On itre sur une copie pour tre robuste si un client se dconnecte pendant la boucle
 	TArray<ALobbyBeaconClient*> ClientsCopy = ConnectedClients;
 	for (ALobbyBeaconClient* Client : ClientsCopy)
 	{
-		if (IsValid(Client))
+		if (IsValid(Client) && Client->HasReservation())
 		{
-			Client->Client_ReceiveLobbyUpdate(ConnectedPlayers);
+			Client->Client_ReceiveLobbyUpdate(ConnectedPlayers, RosterRevision, HostPlayerId);
 		}
 	}
 }
\ No newline at end of file
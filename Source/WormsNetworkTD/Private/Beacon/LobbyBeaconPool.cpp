@@ -0,0 +1,137 @@
+#include "Beacon/LobbyBeaconPool.h"
+#include "Beacon/LobbyBeaconClient.h"
+#include "Engine/World.h"
+
+FString ULobbyBeaconPool::MakeKey(const FString& Address, int32 Port)
+{
+	return FString::Printf(TEXT("%s:%d"), *Address, Port);
+}
+
+// ============================================================
+//  Acquisition / sortie du pool
+// ============================================================
+
+ALobbyBeaconClient* ULobbyBeaconPool::Acquire(UWorld* World, const FString& Address, int32 Port)
+{
+	const FString Key = MakeKey(Address, Port);
+	const double Now = FPlatformTime::Seconds();
+
+	if (FPooledBeacon* Pooled = Connections.Find(Key))
+	{
+		const EBeaconConnectionState State = IsValid(Pooled->Client) ? Pooled->Client->GetConnectionState() : EBeaconConnectionState::Invalid;
+		if (State == EBeaconConnectionState::Open || State == EBeaconConnectionState::Pending)
+		{
+			Pooled->LastUsedSeconds = Now;
+			return Pooled->Client;
+		}
+
+		// Connexion tombée : on la remplace
+		if (IsValid(Pooled->Client))
+		{
+			Pooled->Client->DestroyBeacon();
+		}
+		Connections.Remove(Key);
+	}
+
+	if (!World)
+		return nullptr;
+
+	if (Connections.Num() >= MaxConnections)
+	{
+		EvictLeastRecentlyUsed();
+	}
+
+	ALobbyBeaconClient* Client = World->SpawnActor<ALobbyBeaconClient>();
+	if (!Client)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LobbyBeaconPool: impossible de spawner ALobbyBeaconClient."));
+		return nullptr;
+	}
+
+	Client->SetActorHiddenInGame(true);
+	Client->SetActorEnableCollision(false);
+	Client->SetReplicates(true);
+	Client->bAutoReserve = false;
+
+	FURL Destination(nullptr, *Address, TRAVEL_Absolute);
+	Destination.Port = Port;
+	if (!Client->ConnectToServer(Destination))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LobbyBeaconPool: connexion a %s impossible."), *Key);
+		Client->DestroyBeacon();
+		return nullptr;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("LobbyBeaconPool: nouvelle connexion vers %s (%d dans le pool)."), *Key, Connections.Num() + 1);
+	FPooledBeacon& Pooled = Connections.Add(Key);
+	Pooled.Client = Client;
+	Pooled.LastUsedSeconds = Now;
+	return Client;
+}
+
+void ULobbyBeaconPool::Detach(ALobbyBeaconClient* Client)
+{
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Client == Client)
+		{
+			It.RemoveCurrent();
+			return;
+		}
+	}
+}
+
+// ============================================================
+//  Entretien
+// ============================================================
+
+void ULobbyBeaconPool::Tick(double Now)
+{
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		ALobbyBeaconClient* Client = It.Value().Client;
+		const EBeaconConnectionState State = IsValid(Client) ? Client->GetConnectionState() : EBeaconConnectionState::Invalid;
+		const bool bAlive = State == EBeaconConnectionState::Open || State == EBeaconConnectionState::Pending;
+
+		if (!bAlive || Now - It.Value().LastUsedSeconds > IdleSeconds)
+		{
+			if (IsValid(Client))
+			{
+				Client->DestroyBeacon();
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void ULobbyBeaconPool::EvictLeastRecentlyUsed()
+{
+	FString OldestKey;
+	double OldestSeconds = TNumericLimits<double>::Max();
+	for (const TPair<FString, FPooledBeacon>& Pair : Connections)
+	{
+		if (Pair.Value.LastUsedSeconds < OldestSeconds)
+		{
+			OldestSeconds = Pair.Value.LastUsedSeconds;
+			OldestKey = Pair.Key;
+		}
+	}
+
+	FPooledBeacon Evicted;
+	if (Connections.RemoveAndCopyValue(OldestKey, Evicted) && IsValid(Evicted.Client))
+	{
+		Evicted.Client->DestroyBeacon();
+	}
+}
+
+void ULobbyBeaconPool::Reset()
+{
+	for (const TPair<FString, FPooledBeacon>& Pair : Connections)
+	{
+		if (IsValid(Pair.Value.Client))
+		{
+			Pair.Value.Client->DestroyBeacon();
+		}
+	}
+	Connections.Reset();
+}
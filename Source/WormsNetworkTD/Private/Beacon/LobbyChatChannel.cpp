@@ -0,0 +1,238 @@
+#include "Beacon/LobbyChatChannel.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint8 HistoryFormatVersion = 1;
+
+	// Garde-fou à la décompression : un bloc d'historique plein fait quelques Ko
+	constexpr int32 MaxHistoryRawBytes = 64 * 1024;
+
+	void SerializeEvent(FArchive& Ar, FLobbyChannelEvent& Event)
+	{
+		// PlayerId : index compact, un octet suffit
+		uint8 Kind = static_cast<uint8>(Event.Kind);
+		uint8 PlayerIndex = static_cast<uint8>(Event.PlayerId);
+		Ar << Kind << PlayerIndex;
+		Event.Kind = static_cast<ELobbyEventKind>(Kind);
+		Event.PlayerId = PlayerIndex;
+
+		if (Event.Kind == ELobbyEventKind::Ready)
+		{
+			Ar << Event.bReady;
+		}
+		else
+		{
+			Ar << Event.Text;
+		}
+	}
+}
+
+bool FLobbyTokenBucket::TryConsume(double Now, float Capacity, float RefillPerSecond, float Cost)
+{
+	Tokens = FMath::Min(Capacity, Tokens + static_cast<float>(Now - LastRefillSeconds) * RefillPerSecond);
+	LastRefillSeconds = Now;
+
+	if (Tokens < Cost)
+		return false;
+
+	Tokens -= Cost;
+	return true;
+}
+
+// ============================================================
+//  Entrées
+// ============================================================
+
+FLobbyTokenBucket& FLobbyChatChannel::GetBucket(int32 PlayerId, double Now)
+{
+	if (FLobbyTokenBucket* Bucket = Buckets.Find(PlayerId))
+		return *Bucket;
+
+	// Nouveau joueur : seau plein
+	FLobbyTokenBucket& Bucket = Buckets.Add(PlayerId);
+	Bucket.Tokens = BucketCapacity;
+	Bucket.LastRefillSeconds = Now;
+	return Bucket;
+}
+
+bool FLobbyChatChannel::PostChat(int32 PlayerId, const FString& Text, double Now)
+{
+	FString Trimmed = Text.TrimStartAndEnd().Left(MaxMessageChars);
+	if (Trimmed.IsEmpty())
+		return false;
+
+	if (!GetBucket(PlayerId, Now).TryConsume(Now, BucketCapacity, BucketRefillPerSecond, 1.f))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("LobbyChat: joueur %d limite en debit, message ignore."), PlayerId);
+		return false;
+	}
+
+	FLobbyChannelEvent& Event = Pending.AddDefaulted_GetRef();
+	Event.Kind = ELobbyEventKind::Chat;
+	Event.PlayerId = PlayerId;
+	Event.Text = MoveTemp(Trimmed);
+
+	AddToHistory(Event);
+	return true;
+}
+
+bool FLobbyChatChannel::PostReady(int32 PlayerId, bool bReady, double Now)
+{
+	if (IsReady(PlayerId) == bReady)
+		return false;
+
+	if (!GetBucket(PlayerId, Now).TryConsume(Now, BucketCapacity, BucketRefillPerSecond, 1.f))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("LobbyChat: joueur %d limite en debit, bascule pret ignoree."), PlayerId);
+		return false;
+	}
+
+	if (bReady)
+	{
+		ReadyPlayers.Add(PlayerId);
+	}
+	else
+	{
+		ReadyPlayers.Remove(PlayerId);
+	}
+
+	// Bascule déjà en attente pour ce joueur : seul le dernier état part
+	FLobbyChannelEvent* Queued = Pending.FindByPredicate([PlayerId](const FLobbyChannelEvent& Event)
+	{
+		return Event.Kind == ELobbyEventKind::Ready && Event.PlayerId == PlayerId;
+	});
+	if (!Queued)
+	{
+		Queued = &Pending.AddDefaulted_GetRef();
+		Queued->Kind = ELobbyEventKind::Ready;
+		Queued->PlayerId = PlayerId;
+	}
+	Queued->bReady = bReady;
+	return true;
+}
+
+void FLobbyChatChannel::RemovePlayer(int32 PlayerId)
+{
+	ReadyPlayers.Remove(PlayerId);
+	Buckets.Remove(PlayerId);
+	Pending.RemoveAll([PlayerId](const FLobbyChannelEvent& Event)
+	{
+		return Event.Kind == ELobbyEventKind::Ready && Event.PlayerId == PlayerId;
+	});
+}
+
+TArray<FLobbyChannelEvent> FLobbyChatChannel::TakePending()
+{
+	TArray<FLobbyChannelEvent> Events = MoveTemp(Pending);
+	Pending.Reset();
+	return Events;
+}
+
+void FLobbyChatChannel::Reset()
+{
+	History.Reset();
+	HistoryHead = 0;
+	Pending.Reset();
+	Buckets.Reset();
+	ReadyPlayers.Reset();
+}
+
+// ============================================================
+//  Historique
+// ============================================================
+
+void FLobbyChatChannel::AddToHistory(const FLobbyChannelEvent& Event)
+{
+	if (History.Num() < HistoryCapacity)
+	{
+		History.Add(Event);
+		HistoryHead = History.Num() % HistoryCapacity;
+		return;
+	}
+
+	History[HistoryHead] = Event;
+	HistoryHead = (HistoryHead + 1) % HistoryCapacity;
+}
+
+void FLobbyChatChannel::BuildHistoryChunk(TArray<uint8>& OutChunk, int32& OutRawSize, bool& bOutCompressed) const
+{
+	TArray<uint8> Raw;
+	FMemoryWriter Writer(Raw);
+
+	uint8 Version = HistoryFormatVersion;
+	uint16 Count = static_cast<uint16>(ReadyPlayers.Num() + History.Num());
+	Writer << Version << Count;
+
+	for (const int32 PlayerId : ReadyPlayers)
+	{
+		FLobbyChannelEvent Event;
+		Event.Kind = ELobbyEventKind::Ready;
+		Event.PlayerId = PlayerId;
+		Event.bReady = true;
+		SerializeEvent(Writer, Event);
+	}
+
+	// Du plus ancien au plus récent : l'anneau commence à HistoryHead une fois plein
+	const int32 Start = History.Num() < HistoryCapacity ? 0 : HistoryHead;
+	for (int32 i = 0; i < History.Num(); i++)
+	{
+		FLobbyChannelEvent Event = History[(Start + i) % History.Num()];
+		SerializeEvent(Writer, Event);
+	}
+
+	OutRawSize = Raw.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Raw.Num());
+	OutChunk.SetNumUninitialized(CompressedSize);
+	bOutCompressed = FCompression::CompressMemory(NAME_Zlib, OutChunk.GetData(), CompressedSize, Raw.GetData(), Raw.Num())
+		&& CompressedSize < Raw.Num();
+	if (!bOutCompressed)
+	{
+		OutChunk = MoveTemp(Raw);
+		return;
+	}
+	OutChunk.SetNum(CompressedSize, EAllowShrinking::No);
+}
+
+bool FLobbyChatChannel::ReadHistoryChunk(const TArray<uint8>& Chunk, int32 RawSize, bool bCompressed, TArray<FLobbyChannelEvent>& OutEvents)
+{
+	OutEvents.Reset();
+	if (RawSize <= 0 || RawSize > MaxHistoryRawBytes)
+		return false;
+
+	TArray<uint8> Raw;
+	if (!bCompressed)
+	{
+		if (Chunk.Num() != RawSize)
+			return false;
+		Raw = Chunk;
+	}
+	else
+	{
+		Raw.SetNumUninitialized(RawSize);
+		if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), RawSize, Chunk.GetData(), Chunk.Num()))
+			return false;
+	}
+
+	FMemoryReader Reader(Raw);
+	uint8 Version = 0;
+	uint16 Count = 0;
+	Reader << Version << Count;
+	if (Reader.IsError() || Version != HistoryFormatVersion)
+		return false;
+
+	OutEvents.Reserve(Count);
+	for (int32 i = 0; i < Count && !Reader.IsError(); i++)
+	{
+		SerializeEvent(Reader, OutEvents.AddDefaulted_GetRef());
+	}
+
+	if (Reader.IsError())
+	{
+		OutEvents.Reset();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,573 @@
+#include "Network/LanRoomDiscovery.h"
+#include "NboSerializer.h"
+
+namespace
+{
+	constexpr uint8 QueryMagic[2] = { 'W', 'Q' };
+	constexpr uint8 ReplyMagic[2] = { 'W', 'R' };
+	constexpr uint8 UpdateMagic[2] = { 'W', 'U' };
+	constexpr uint8 PacketVersion = 1;
+
+	// IPv4, port, joueurs, max, longueur du blob (puis le blob)
+	constexpr int32 RoomFieldsSize = 4 + 2 + 1 + 1 + 1;
+
+	// Magic + version (+ type de push)
+	constexpr int32 ReplyHeaderSize = 3 + RoomFieldsSize;
+	constexpr int32 UpdateHeaderSize = 4 + RoomFieldsSize;
+
+	constexpr uint8 Flag_RequireFreeSlot = 1 << 0;
+	constexpr uint8 Flag_Subscribe = 1 << 1;
+	constexpr uint8 Flag_Snapshot = 1 << 2;
+
+	// ----- Abonnement (cadences publiques dans FLanRoomDiscovery) -----
+	constexpr double LeaseSeconds = 10.0;
+
+	// Plus de deux battements manqués : hôte considéré disparu
+	constexpr double RoomTimeoutSeconds = 40.0;
+
+	// Regroupe les changements rapprochés (arrivées en rafale) en un push
+	constexpr double PushIntervalSeconds = 0.25;
+
+	// Réponses au snapshot : ping approximé comme pour une recherche
+	constexpr double SnapshotWindowSeconds = 1.0;
+
+	uint64 MakeNonce()
+	{
+		return (static_cast<uint64>(FMath::Rand()) << 32) ^ FPlatformTime::Cycles64();
+	}
+
+	bool ParseIPv4(const FString& Address, uint32& OutIp)
+	{
+		TArray<FString> Parts;
+		if (Address.ParseIntoArray(Parts, TEXT(".")) != 4)
+			return false;
+
+		OutIp = 0;
+		for (const FString& Part : Parts)
+		{
+			const int32 Byte = FCString::Atoi(*Part);
+			if (Byte < 0 || Byte > 255)
+				return false;
+			OutIp = (OutIp << 8) | static_cast<uint32>(Byte);
+		}
+		return true;
+	}
+
+	void WriteRoomFields(const FLanRoomAdvert& Advert, const TArray<uint8>* Blob, TArray<uint8>& Out)
+	{
+		uint32 Ip = 0;
+		ParseIPv4(Advert.HostAddress, Ip);
+		const uint16 Port = static_cast<uint16>(Advert.BeaconPort);
+
+		Out.Add(static_cast<uint8>(Ip >> 24));
+		Out.Add(static_cast<uint8>(Ip >> 16));
+		Out.Add(static_cast<uint8>(Ip >> 8));
+		Out.Add(static_cast<uint8>(Ip));
+		Out.Add(static_cast<uint8>(Port >> 8));
+		Out.Add(static_cast<uint8>(Port));
+		Out.Add(static_cast<uint8>(FMath::Clamp(Advert.CurrentPlayers, 0, 255)));
+		Out.Add(static_cast<uint8>(FMath::Clamp(Advert.MaxPlayers, 0, 255)));
+		Out.Add(static_cast<uint8>(Blob ? Blob->Num() : 0));
+		if (Blob)
+		{
+			Out.Append(*Blob);
+		}
+	}
+
+	/** Data pointe sur les champs room. Sans blob, Settings n'est pas touché. */
+	bool ReadRoomFields(const uint8* Data, int32 Size, FLanRoomAdvert& OutAdvert, bool& bOutHasSettings)
+	{
+		if (Size < RoomFieldsSize)
+			return false;
+
+		const int32 BlobSize = Data[8];
+		if (Size < RoomFieldsSize + BlobSize)
+			return false;
+
+		bOutHasSettings = BlobSize > 0;
+		if (bOutHasSettings && !OutAdvert.Settings.Decode(TConstArrayView<uint8>(Data + RoomFieldsSize, BlobSize)))
+			return false;
+
+		OutAdvert.HostAddress = FString::Printf(TEXT("%d.%d.%d.%d"), Data[0], Data[1], Data[2], Data[3]);
+		OutAdvert.BeaconPort = (Data[4] << 8) | Data[5];
+		OutAdvert.CurrentPlayers = Data[6];
+		OutAdvert.MaxPlayers = Data[7];
+		return true;
+	}
+
+	bool SameSettings(const FRoomSettings& A, const FRoomSettings& B)
+	{
+		return A.GameMode == B.GameMode && A.UnitLife == B.UnitLife && A.UnitCount == B.UnitCount
+			&& A.TurnsBeforeWater == B.TurnsBeforeWater && A.RoomName == B.RoomName;
+	}
+
+	FString MakeRoomKey(const FLanRoomAdvert& Advert)
+	{
+		return FString::Printf(TEXT("%s:%d"), *Advert.HostAddress, Advert.BeaconPort);
+	}
+
+	void WriteQueryPacket(FLANSession& Session, const FRoomQueryFilter& Filter, uint8 ExtraFlags, FNboSerializeToBuffer& Packet)
+	{
+		uint8 Payload[FLanRoomDiscovery::QueryPayloadSize];
+		FLanRoomDiscovery::WriteQueryPayload(Filter, Payload);
+		Payload[4] |= ExtraFlags;
+
+		Session.CreateClientQueryPacket(Packet, Session.LanNonce);
+		Packet.WriteBinary(Payload, FLanRoomDiscovery::QueryPayloadSize);
+	}
+}
+
+FLanRoomDiscovery::~FLanRoomDiscovery()
+{
+	StopHosting();
+	CancelSearch();
+	StopWatching();
+}
+
+// ============================================================
+//  Format des paquets
+// ============================================================
+
+void FLanRoomDiscovery::WriteQueryPayload(const FRoomQueryFilter& Filter, uint8 (&OutPayload)[QueryPayloadSize])
+{
+	OutPayload[0] = QueryMagic[0];
+	OutPayload[1] = QueryMagic[1];
+	OutPayload[2] = PacketVersion;
+	OutPayload[3] = Filter.ModeMask;
+	OutPayload[4] = Filter.bRequireFreeSlot ? Flag_RequireFreeSlot : 0;
+}
+
+bool FLanRoomDiscovery::ReadQueryPayload(const uint8* Data, int32 Size, FRoomQueryFilter& OutFilter)
+{
+	if (Size < QueryPayloadSize || Data[0] != QueryMagic[0] || Data[1] != QueryMagic[1] || Data[2] < 1)
+		return false;
+
+	OutFilter.ModeMask = Data[3];
+	OutFilter.bRequireFreeSlot = (Data[4] & Flag_RequireFreeSlot) != 0;
+	OutFilter.MaxPingMs = 0;
+	return true;
+}
+
+bool FLanRoomDiscovery::BuildReplyPayload(const FRoomQueryFilter& Filter, const FLanRoomAdvert& Advert, TArray<uint8>& OutPayload)
+{
+	if (!Filter.MatchesRoom(Advert.Settings, Advert.CurrentPlayers, Advert.MaxPlayers))
+		return false;
+
+	const TArray<uint8> Blob = Advert.Settings.Encode();
+
+	OutPayload.Reset(ReplyHeaderSize + Blob.Num());
+	OutPayload.Add(ReplyMagic[0]);
+	OutPayload.Add(ReplyMagic[1]);
+	OutPayload.Add(PacketVersion);
+	WriteRoomFields(Advert, &Blob, OutPayload);
+	return true;
+}
+
+bool FLanRoomDiscovery::ReadReplyPayload(const uint8* Data, int32 Size, FLanRoomAdvert& OutAdvert)
+{
+	if (Size < ReplyHeaderSize || Data[0] != ReplyMagic[0] || Data[1] != ReplyMagic[1] || Data[2] < 1)
+		return false;
+
+	bool bHasSettings = false;
+	return ReadRoomFields(Data + 3, Size - 3, OutAdvert, bHasSettings) && bHasSettings;
+}
+
+void FLanRoomDiscovery::WriteUpdatePayload(ERoomListChange Change, const FLanRoomAdvert& Advert, TArray<uint8>& OutPayload)
+{
+	const TArray<uint8> Blob = Change == ERoomListChange::Added ? Advert.Settings.Encode() : TArray<uint8>();
+
+	OutPayload.Reset(UpdateHeaderSize + Blob.Num());
+	OutPayload.Add(UpdateMagic[0]);
+	OutPayload.Add(UpdateMagic[1]);
+	OutPayload.Add(PacketVersion);
+	OutPayload.Add(static_cast<uint8>(Change));
+	WriteRoomFields(Advert, Change == ERoomListChange::Added ? &Blob : nullptr, OutPayload);
+}
+
+bool FLanRoomDiscovery::ReadUpdatePayload(const uint8* Data, int32 Size, ERoomListChange& OutChange, FLanRoomAdvert& OutAdvert)
+{
+	if (Size < UpdateHeaderSize || Data[0] != UpdateMagic[0] || Data[1] != UpdateMagic[1] || Data[2] < 1
+		|| Data[3] > static_cast<uint8>(ERoomListChange::Removed))
+		return false;
+
+	OutChange = static_cast<ERoomListChange>(Data[3]);
+
+	bool bHasSettings = false;
+	if (!ReadRoomFields(Data + 4, Size - 4, OutAdvert, bHasSettings))
+		return false;
+
+	// Un ajout sans settings serait une ligne vide
+	return OutChange != ERoomListChange::Added || bHasSettings;
+}
+
+// ============================================================
+//  Hôte
+// ============================================================
+
+bool FLanRoomDiscovery::StartHosting(FGetAdvert InGetAdvert)
+{
+	StopHosting();
+
+	GetAdvert = MoveTemp(InGetAdvert);
+	HostSession.LanAnnouncePort = LobbyConstants::LanDiscoveryPort;
+
+	FOnValidQueryPacketDelegate QueryDelegate = FOnValidQueryPacketDelegate::CreateRaw(this, &FLanRoomDiscovery::HandleQuery);
+	bHosting = HostSession.Host(QueryDelegate, LobbyConstants::LanDiscoveryPort);
+	if (!bHosting)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LanRoomDiscovery: impossible d'ecouter sur le port %d."), LobbyConstants::LanDiscoveryPort);
+	}
+	return bHosting;
+}
+
+void FLanRoomDiscovery::StopHosting()
+{
+	if (bHosting)
+	{
+		// Les abonnés retirent la ligne tout de suite plutôt qu'à l'expiration
+		if (bPushedAny && FPlatformTime::Seconds() < WatchedUntilSeconds)
+		{
+			BroadcastUpdate(ERoomListChange::Removed, LastPushed);
+		}
+
+		HostSession.StopLANSession();
+		bHosting = false;
+	}
+
+	GetAdvert.Reset();
+	WatchedUntilSeconds = 0.0;
+	WatchModeMask = 0;
+	bPushedAny = false;
+}
+
+void FLanRoomDiscovery::HandleQuery(uint8* PacketData, int32 PacketLength, uint64 ClientNonce)
+{
+	// Filtre en fin de paquet : indépendant de ce que FLANSession retire de l'en-tête
+	FRoomQueryFilter Filter;
+	const uint8* Payload = PacketData + PacketLength - QueryPayloadSize;
+	if (PacketLength < QueryPayloadSize || !ReadQueryPayload(Payload, QueryPayloadSize, Filter))
+		return;
+
+	if (Payload[4] & Flag_Subscribe)
+	{
+		// Bail (re)pris : l'union des modes suivis borne ce que l'on pousse
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= WatchedUntilSeconds)
+		{
+			WatchModeMask = 0;
+		}
+		WatchModeMask |= Filter.ModeMask;
+		WatchedUntilSeconds = Now + LeaseSeconds;
+
+		// Nouvel abonné : annonce complète au prochain push
+		if (Payload[4] & Flag_Snapshot)
+		{
+			bPushedAny = false;
+		}
+		return;
+	}
+
+	FLanRoomAdvert Advert;
+	TArray<uint8> Reply;
+	if (!GetAdvert || !GetAdvert(Advert) || !BuildReplyPayload(Filter, Advert, Reply))
+		return;
+
+	FNboSerializeToBuffer Packet(LAN_BEACON_MAX_PACKET_SIZE);
+	HostSession.CreateHostResponsePacket(Packet, ClientNonce);
+	Packet.WriteBinary(Reply.GetData(), Reply.Num());
+	if (!Packet.HasOverflow())
+	{
+		HostSession.BroadcastPacket(Packet, Packet.GetByteCount());
+	}
+}
+
+void FLanRoomDiscovery::PushRoomState(double Now)
+{
+	FLanRoomAdvert Advert;
+	if (!GetAdvert || !GetAdvert(Advert))
+		return;
+
+	if ((WatchModeMask & (1u << static_cast<uint8>(Advert.Settings.GameMode))) == 0)
+		return;
+
+	const bool bFull = !bPushedAny || Now >= NextHeartbeatSeconds || !SameSettings(Advert.Settings, LastPushed.Settings);
+	const bool bCounts = Advert.CurrentPlayers != LastPushed.CurrentPlayers || Advert.MaxPlayers != LastPushed.MaxPlayers;
+	if (!bFull && !bCounts)
+		return;
+
+	BroadcastUpdate(bFull ? ERoomListChange::Added : ERoomListChange::Updated, Advert);
+
+	LastPushed = MoveTemp(Advert);
+	bPushedAny = true;
+	if (bFull)
+	{
+		NextHeartbeatSeconds = Now + HeartbeatSeconds;
+	}
+}
+
+void FLanRoomDiscovery::BroadcastUpdate(ERoomListChange Change, const FLanRoomAdvert& Advert)
+{
+	TArray<uint8> Payload;
+	WriteUpdatePayload(Change, Advert, Payload);
+
+	// Nonce commun : un seul broadcast pour tous les abonnés
+	FNboSerializeToBuffer Packet(LAN_BEACON_MAX_PACKET_SIZE);
+	HostSession.CreateHostResponsePacket(Packet, LobbyConstants::LanRoomFeedNonce);
+	Packet.WriteBinary(Payload.GetData(), Payload.Num());
+	if (!Packet.HasOverflow())
+	{
+		HostSession.BroadcastPacket(Packet, Packet.GetByteCount());
+	}
+}
+
+// ============================================================
+//  Client : recherche ponctuelle
+// ============================================================
+
+bool FLanRoomDiscovery::StartSearch(const FRoomQueryFilter& Filter, int32 MaxResults, FOnLanRoomsFound InOnFound)
+{
+	CancelSearch();
+
+	SearchFilter = Filter;
+	SearchMaxResults = FMath::Max(1, MaxResults);
+	SearchResults.Reset();
+	OnFound = MoveTemp(InOnFound);
+
+	SearchSession.LanAnnouncePort = LobbyConstants::LanDiscoveryPort;
+	SearchSession.LanNonce = MakeNonce();
+
+	FNboSerializeToBuffer Packet(LAN_BEACON_MAX_PACKET_SIZE);
+	WriteQueryPacket(SearchSession, Filter, 0, Packet);
+
+	FOnValidResponsePacketDelegate ResponseDelegate = FOnValidResponsePacketDelegate::CreateRaw(this, &FLanRoomDiscovery::HandleReply);
+	FOnSearchingTimeoutDelegate TimeoutDelegate = FOnSearchingTimeoutDelegate::CreateRaw(this, &FLanRoomDiscovery::HandleSearchTimeout);
+
+	SearchStartSeconds = FPlatformTime::Seconds();
+	bSearchDone = false;
+	bSearching = SearchSession.Search(Packet, ResponseDelegate, TimeoutDelegate);
+	if (!bSearching)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LanRoomDiscovery: echec de la requete broadcast."));
+	}
+	return bSearching;
+}
+
+void FLanRoomDiscovery::CancelSearch()
+{
+	if (bSearching)
+	{
+		SearchSession.StopLANSession();
+		bSearching = false;
+	}
+	bSearchDone = false;
+	OnFound.Unbind();
+}
+
+void FLanRoomDiscovery::HandleReply(uint8* PacketData, int32 PacketLength)
+{
+	if (!bSearching || bSearchDone)
+		return;
+
+	FLanRoomAdvert Advert;
+	if (!ReadReplyPayload(PacketData, PacketLength, Advert))
+		return;
+
+	// Le ping n'est connu qu'ici ; mode et place libre ont déjà été filtrés par l'hôte
+	Advert.PingMs = static_cast<int32>((FPlatformTime::Seconds() - SearchStartSeconds) * 1000.0);
+	if (!SearchFilter.MatchesPing(Advert.PingMs))
+		return;
+
+	SearchResults.Add(MoveTemp(Advert));
+	bSearchDone = SearchResults.Num() >= SearchMaxResults;
+}
+
+void FLanRoomDiscovery::HandleSearchTimeout()
+{
+	bSearchDone = true;
+}
+
+void FLanRoomDiscovery::FinishSearch()
+{
+	if (!bSearching)
+		return;
+
+	SearchSession.StopLANSession();
+	bSearching = false;
+	bSearchDone = false;
+
+	// Copie : le callback peut relancer une recherche
+	const TArray<FLanRoomAdvert> Rooms = MoveTemp(SearchResults);
+	FOnLanRoomsFound Callback = MoveTemp(OnFound);
+	OnFound.Unbind();
+	Callback.ExecuteIfBound(Rooms);
+}
+
+// ============================================================
+//  Client : liste en direct
+// ============================================================
+
+bool FLanRoomDiscovery::StartWatching(const FRoomQueryFilter& Filter, FOnLanRoomChanged InOnChanged)
+{
+	StopWatching();
+
+	WatchFilter = Filter;
+	OnChanged = MoveTemp(InOnChanged);
+
+	WatchSession.LanAnnouncePort = LobbyConstants::LanDiscoveryPort;
+	WatchSession.LanNonce = LobbyConstants::LanRoomFeedNonce;
+
+	FNboSerializeToBuffer Packet(LAN_BEACON_MAX_PACKET_SIZE);
+	WriteQueryPacket(WatchSession, Filter, Flag_Subscribe | Flag_Snapshot, Packet);
+
+	// Pas de timeout : la session reste à l'écoute jusqu'à StopWatching
+	FOnValidResponsePacketDelegate UpdateDelegate = FOnValidResponsePacketDelegate::CreateRaw(this, &FLanRoomDiscovery::HandleUpdate);
+
+	WatchStartSeconds = FPlatformTime::Seconds();
+	NextRenewSeconds = WatchStartSeconds + RenewSeconds;
+	bWatching = WatchSession.Search(Packet, UpdateDelegate, FOnSearchingTimeoutDelegate());
+	if (!bWatching)
+	{
+		UE_LOG(LogTemp, Error, TEXT("LanRoomDiscovery: echec de l'abonnement a la liste de rooms."));
+	}
+	return bWatching;
+}
+
+void FLanRoomDiscovery::StopWatching()
+{
+	if (bWatching)
+	{
+		WatchSession.StopLANSession();
+		bWatching = false;
+	}
+	WatchedRooms.Reset();
+	PendingChanges.Reset();
+	OnChanged.Unbind();
+}
+
+void FLanRoomDiscovery::RenewWatch()
+{
+	FNboSerializeToBuffer Packet(LAN_BEACON_MAX_PACKET_SIZE);
+	WriteQueryPacket(WatchSession, WatchFilter, Flag_Subscribe, Packet);
+	WatchSession.BroadcastPacket(Packet, Packet.GetByteCount());
+}
+
+void FLanRoomDiscovery::HandleUpdate(uint8* PacketData, int32 PacketLength)
+{
+	ERoomListChange Change;
+	FLanRoomAdvert Advert;
+	if (!bWatching || !ReadUpdatePayload(PacketData, PacketLength, Change, Advert))
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	const FString Key = MakeRoomKey(Advert);
+	FWatchedRoom* Known = WatchedRooms.Find(Key);
+
+	if (Change == ERoomListChange::Removed)
+	{
+		if (Known)
+		{
+			PendingChanges.Emplace(ERoomListChange::Removed, Known->Advert);
+			WatchedRooms.Remove(Key);
+		}
+		return;
+	}
+
+	if (Change == ERoomListChange::Updated)
+	{
+		// Settings inconnus : le prochain battement complet ajoutera la room
+		if (!Known)
+			return;
+		Advert.Settings = Known->Advert.Settings;
+	}
+
+	// Room apparue après le snapshot : le délai mesure son arrivée, pas le réseau
+	Advert.PingMs = Known ? Known->Advert.PingMs
+		: (Now - WatchStartSeconds < SnapshotWindowSeconds ? static_cast<int32>((Now - WatchStartSeconds) * 1000.0) : INDEX_NONE);
+
+	// Une room qui sort du filtre (pleine, par exemple) disparaît de la liste
+	if (!WatchFilter.MatchesRoom(Advert.Settings, Advert.CurrentPlayers, Advert.MaxPlayers) || !WatchFilter.MatchesPing(Advert.PingMs))
+	{
+		if (Known)
+		{
+			PendingChanges.Emplace(ERoomListChange::Removed, Known->Advert);
+			WatchedRooms.Remove(Key);
+		}
+		return;
+	}
+
+	if (!Known)
+	{
+		WatchedRooms.Add(Key, { Advert, Now });
+		PendingChanges.Emplace(ERoomListChange::Added, MoveTemp(Advert));
+		return;
+	}
+
+	Known->LastHeardSeconds = Now;
+	if (Known->Advert.CurrentPlayers != Advert.CurrentPlayers || Known->Advert.MaxPlayers != Advert.MaxPlayers
+		|| !SameSettings(Known->Advert.Settings, Advert.Settings))
+	{
+		Known->Advert = Advert;
+		PendingChanges.Emplace(ERoomListChange::Updated, MoveTemp(Advert));
+	}
+}
+
+void FLanRoomDiscovery::ExpireWatchedRooms(double Now)
+{
+	for (auto It = WatchedRooms.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().LastHeardSeconds > RoomTimeoutSeconds)
+		{
+			PendingChanges.Emplace(ERoomListChange::Removed, It.Value().Advert);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+// ============================================================
+//  Tick
+// ============================================================
+
+void FLanRoomDiscovery::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	if (bHosting)
+	{
+		HostSession.Tick(DeltaTime);
+
+		if (Now < WatchedUntilSeconds && Now >= NextPushSeconds)
+		{
+			PushRoomState(Now);
+			NextPushSeconds = Now + PushIntervalSeconds;
+		}
+	}
+
+	if (bSearching)
+	{
+		SearchSession.Tick(DeltaTime);
+		if (bSearchDone)
+		{
+			FinishSearch();
+		}
+	}
+
+	if (bWatching)
+	{
+		WatchSession.Tick(DeltaTime);
+		ExpireWatchedRooms(Now);
+
+		if (Now >= NextRenewSeconds)
+		{
+			RenewWatch();
+			NextRenewSeconds = Now + RenewSeconds;
+		}
+
+		// Hors de FLANSession::Tick : un callback peut arrêter ou relancer l'abonnement
+		for (int32 i = 0; i < PendingChanges.Num(); i++)
+		{
+			const TPair<ERoomListChange, FLanRoomAdvert> Pending = PendingChanges[i];
+			OnChanged.ExecuteIfBound(Pending.Key, Pending.Value);
+		}
+		PendingChanges.Reset();
+	}
+}
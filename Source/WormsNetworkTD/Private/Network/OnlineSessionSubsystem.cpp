@@ -3,10 +3,34 @@
 #include "OnlineSubsystemUtils.h"
 #include "Beacon/LobbyBeaconHostObject.h"
 #include "Beacon/LobbyBeaconClient.h"
+#include "Beacon/LobbyBeaconPool.h"
 #include "Beacon/LobbyTypes.h"
 #include "OnlineBeaconHost.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
+#include "Profile/PlayerProfileSubsystem.h"
+#include "Profiling/StartupTrace.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+
+namespace
+{
+	/** Ligne de l'UI pour une room LAN : pas de FOnlineSessionSearchResult, join par adresse. */
+	FCustomSessionInfo MakeLanSessionInfo(const FLanRoomAdvert& Room)
+	{
+		FCustomSessionInfo Info;
+		Info.Settings = Room.Settings;
+		Info.SessionName = Room.Settings.RoomName;
+		Info.GameMode = Room.Settings.GameMode;
+		Info.CurrentPlayers = Room.CurrentPlayers;
+		Info.MaxPlayers = Room.MaxPlayers;
+		Info.Ping = Room.PingMs;
+		Info.SessionSearchResultIndex = INDEX_NONE;
+		Info.HostAddress = Room.HostAddress;
+		Info.BeaconPort = Room.BeaconPort;
+		return Info;
+	}
+}
 
 // ============================================================
 //  Initialisation / Nettoyage
@@ -15,12 +39,47 @@
 void UOnlineSessionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+
+	// Dmarrage rapide : l'interface de session n'est plus rsolue ici mais
+	// au premier appel de l'API (EnsureSessionInterface), pour que le menu
+	// s'affiche sans attendre l'OnlineSubsystem.
+	FStartupTrace::Mark(StartupTraceMarkers::SessionSubsystemInit);
+
+	BeaconPool = NewObject<ULobbyBeaconPool>(this);
+
+	// Sockets LAN et pool beacon hors de tout monde : ticks par le core ticker
+	NetworkTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UOnlineSessionSubsystem::TickNetwork));
+}
+
+bool UOnlineSessionSubsystem::EnsureSessionInterface()
+{
+	if (Session.IsValid())
+		return true;
+
 	Session = Online::GetSessionInterface(GetWorld());
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("EnsureSessionInterface: Session interface introuvable."));
+		return false;
+	}
+
+	FStartupTrace::Mark(StartupTraceMarkers::SessionInterfaceResolved);
+	return true;
 }
 
 void UOnlineSessionSubsystem::Deinitialize()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(NetworkTickHandle);
+	LanDiscovery.StopHosting();
+	LanDiscovery.CancelSearch();
+	LanDiscovery.StopWatching();
+
 	CleanupBeaconClient();
+	if (BeaconPool)
+	{
+		BeaconPool->Reset();
+	}
 	Super::Deinitialize();
 }
 
@@ -29,6 +88,9 @@ void UOnlineSessionSubsystem::CleanupBeaconClient()
 	if (LobbyBeaconClient)
 	{
 		LobbyBeaconClient->OnLobbyUpdated.RemoveDynamic(this, &UOnlineSessionSubsystem::HandleLobbyUpdated_Internal);
+		LobbyBeaconClient->OnLobbyEvents.RemoveDynamic(this, &UOnlineSessionSubsystem::HandleLobbyEvents_Internal);
+		LobbyBeaconClient->OnHostLost.Unbind();
+		LobbyBeaconClient->OnRoomClosed.Unbind();
 		LobbyBeaconClient->DestroyBeacon();
 		LobbyBeaconClient = nullptr;
 	}
@@ -39,16 +101,18 @@ void UOnlineSessionSubsystem::CleanupBeaconClient()
 //  Cration de session
 // ============================================================
 
-void UOnlineSessionSubsystem::CreateSession(const FString& SessionName, int32 NumPublicConnections,
-	bool bIsLanMatch, const FString& GameMode, int32 UnitLife, int32 UnitCount, int32 TurnsBeforeWater)
+void UOnlineSessionSubsystem::CreateSession(const FRoomSettings& RoomSettings, bool bIsLanMatch)
 {
-	if (!Session.IsValid())
+	if (!EnsureSessionInterface())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CreateSession: Session interface invalide."));
 		return;
 	}
 
+	const int32 NumPublicConnections = RoomSettings.GetMaxPlayers();
 	MaxPlayers = NumPublicConnections;
+	HostedRoomSettings = RoomSettings;
+	bLobbyIsLan = bIsLanMatch;
 
 	LastSessionSettings = MakeShareable(new FOnlineSessionSettings());
 	LastSessionSettings->NumPublicConnections = NumPublicConnections;
@@ -59,11 +123,11 @@ void UOnlineSessionSubsystem::CreateSession(const FString& SessionName, int32 Nu
 	LastSessionSettings->bIsLANMatch = bIsLanMatch;
 	LastSessionSettings->bShouldAdvertise = true;
 
-	LastSessionSettings->Set(LobbyConstants::Key_SessionName, SessionName, EOnlineDataAdvertisementType::ViaOnlineService);
-	LastSessionSettings->Set(LobbyConstants::Key_GameMode, GameMode, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
-	LastSessionSettings->Set(LobbyConstants::Key_UnitLife, UnitLife, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
-	LastSessionSettings->Set(LobbyConstants::Key_UnitCount, UnitCount, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
-	LastSessionSettings->Set(LobbyConstants::Key_TurnsBeforeWater, TurnsBeforeWater, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	// Un seul setting annonc (y compris dans le ping LAN) : le blob versionn
+	LastSessionSettings->Set(LobbyConstants::Key_RoomSettings, RoomSettings.Encode(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	// Copie du mode seul, filtrable par le service (Equals sur un entier)
+	LastSessionSettings->Set(LobbyConstants::Key_RoomMode, static_cast<int32>(RoomSettings.GameMode), EOnlineDataAdvertisementType::ViaOnlineService);
 
 	CreateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(
 		FOnCreateSessionCompleteDelegate::CreateUObject(this, &UOnlineSessionSubsystem::OnCreateSessionCompleted)
@@ -96,6 +160,96 @@ void UOnlineSessionSubsystem::OnCreateSessionCompleted(FName SessionName, bool S
 
 	// Session prte -> on dmarre le beacon host
 	CreateHostBeacon();
+
+	if (LastSessionSettings.IsValid() && LastSessionSettings->bIsLANMatch)
+	{
+		StartLanAdvertising();
+	}
+}
+
+// ============================================================
+//  Dcouverte LAN filtre (FLanRoomDiscovery)
+// ============================================================
+
+bool UOnlineSessionSubsystem::TickNetwork(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	LanDiscovery.Tick(DeltaTime);
+	if (BeaconPool)
+	{
+		BeaconPool->Tick(Now);
+	}
+	if (Migration.bActive)
+	{
+		TickMigration(Now);
+	}
+	return true;
+}
+
+void UOnlineSessionSubsystem::StartLanAdvertising()
+{
+	// Adresse rsolue une fois : elle ne change pas pendant la vie de la room
+	FString HostAddress = TEXT("127.0.0.1");
+	if (ISocketSubsystem* Sockets = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+	{
+		bool bCanBindAll = false;
+		const TSharedRef<FInternetAddr> LocalAddr = Sockets->GetLocalHostAddr(*GLog, bCanBindAll);
+		uint32 Ip = 0;
+		LocalAddr->GetIp(Ip);
+		if (Ip != 0)
+		{
+			HostAddress = FString::Printf(TEXT("%u.%u.%u.%u"), (Ip >> 24) & 0xFF, (Ip >> 16) & 0xFF, (Ip >> 8) & 0xFF, Ip & 0xFF);
+		}
+	}
+
+	LanDiscovery.StartHosting([this, HostAddress](FLanRoomAdvert& OutAdvert)
+	{
+		const ALobbyBeaconHostObject* HostObject = LobbyHostObject.Get();
+		if (!HostObject)
+			return false;
+
+		OutAdvert.Settings = HostedRoomSettings;
+		OutAdvert.CurrentPlayers = HostObject->ReservedSlots;
+		OutAdvert.MaxPlayers = HostObject->MaxSlots;
+		OutAdvert.HostAddress = HostAddress;
+		OutAdvert.BeaconPort = LobbyConstants::BeaconPort;
+		return true;
+	});
+
+	UE_LOG(LogTemp, Warning, TEXT("StartLanAdvertising: room annoncee depuis %s."), *HostAddress);
+}
+
+void UOnlineSessionSubsystem::OnLanRoomsFound(const TArray<FLanRoomAdvert>& Rooms)
+{
+	// Pas de FOnlineSessionSearchResult : le join passe par HostAddress
+	SearchResults.Reset();
+
+	TArray<FCustomSessionInfo> SessionInfos;
+	SessionInfos.Reserve(Rooms.Num());
+	for (const FLanRoomAdvert& Room : Rooms)
+	{
+		SessionInfos.Add(MakeLanSessionInfo(Room));
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("FindSessions (LAN) termine: %d room(s) correspondante(s)"), SessionInfos.Num());
+
+	OnFindSessionsCompleteEvent.Broadcast(SessionInfos, true);
+}
+
+bool UOnlineSessionSubsystem::StartRoomListSubscription(const FRoomQueryFilter& Filter)
+{
+	return LanDiscovery.StartWatching(Filter,
+		FOnLanRoomChanged::CreateUObject(this, &UOnlineSessionSubsystem::OnLanRoomChanged));
+}
+
+void UOnlineSessionSubsystem::StopRoomListSubscription()
+{
+	LanDiscovery.StopWatching();
+}
+
+void UOnlineSessionSubsystem::OnLanRoomChanged(ERoomListChange Change, const FLanRoomAdvert& Room)
+{
+	OnRoomListPatched.Broadcast(MakeLanSessionInfo(Room), Change);
 }
 
 // ============================================================
@@ -104,7 +258,25 @@ void UOnlineSessionSubsystem::OnCreateSessionCompleted(FName SessionName, bool S
 
 void UOnlineSessionSubsystem::FindSessions(int32 MaxSearchResults, bool bIsLANQuery)
 {
-	if (!Session.IsValid())
+	FindSessionsFiltered(MaxSearchResults, bIsLANQuery, FRoomQueryFilter());
+}
+
+void UOnlineSessionSubsystem::FindSessionsFiltered(int32 MaxSearchResults, bool bIsLANQuery, const FRoomQueryFilter& Filter)
+{
+	LastQueryFilter = Filter;
+
+	// LAN : le filtre voyage dans la requte, les htes hors filtre se taisent
+	if (bIsLANQuery)
+	{
+		if (!LanDiscovery.StartSearch(Filter, MaxSearchResults,
+			FOnLanRoomsFound::CreateUObject(this, &UOnlineSessionSubsystem::OnLanRoomsFound)))
+		{
+			OnFindSessionsCompleteEvent.Broadcast(TArray<FCustomSessionInfo>(), false);
+		}
+		return;
+	}
+
+	if (!EnsureSessionInterface())
 	{
 		UE_LOG(LogTemp, Error, TEXT("FindSessions: Session interface invalide."));
 		return;
@@ -112,9 +284,20 @@ void UOnlineSessionSubsystem::FindSessions(int32 MaxSearchResults, bool bIsLANQu
 
 	LastSessionSearch = MakeShareable(new FOnlineSessionSearch());
 	LastSessionSearch->MaxSearchResults = MaxSearchResults;
-	LastSessionSearch->bIsLanQuery = bIsLANQuery;
+	LastSessionSearch->bIsLanQuery = false;
 	LastSessionSearch->QuerySettings.Set(SEARCH_LOBBIES, true, EOnlineComparisonOp::Equals);
 
+	// Un seul mode coch : filtr par le service ; plusieurs : revrifi  la rception
+	const EWormsGameMode SingleMode = Filter.GetSingleMode();
+	if (SingleMode != EWormsGameMode::Count)
+	{
+		LastSessionSearch->QuerySettings.Set(LobbyConstants::Key_RoomMode, static_cast<int32>(SingleMode), EOnlineComparisonOp::Equals);
+	}
+	if (Filter.bRequireFreeSlot)
+	{
+		LastSessionSearch->QuerySettings.Set(SEARCH_MINSLOTSAVAILABLE, 1, EOnlineComparisonOp::GreaterThanEquals);
+	}
+
 	FindHandle = Session->AddOnFindSessionsCompleteDelegate_Handle(
 		FOnFindSessionsCompleteDelegate::CreateUObject(this, &UOnlineSessionSubsystem::OnFindSessionsCompleted)
 	);
@@ -133,17 +316,33 @@ void UOnlineSessionSubsystem::OnFindSessionsCompleted(bool Successful)
 	SearchResults = LastSessionSearch->SearchResults;
 
 	TArray<FCustomSessionInfo> SessionInfos;
+	SessionInfos.Reserve(SearchResults.Num());
+	TArray<uint8> Blob;
 	for (int32 i = 0; i < SearchResults.Num(); i++)
 	{
 		const FOnlineSessionSearchResult& Result = SearchResults[i];
 		FCustomSessionInfo Info;
-		Result.Session.SessionSettings.Get(LobbyConstants::Key_SessionName, Info.SessionName);
-		Result.Session.SessionSettings.Get(LobbyConstants::Key_GameMode, Info.GameMode);
+
+		// Une seule lecture par rsultat ; une room sans blob lisible n'est pas propose
+		Blob.Reset();
+		if (!Result.Session.SessionSettings.Get(LobbyConstants::Key_RoomSettings, Blob) || !Info.Settings.Decode(Blob))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FindSessions: resultat %d sans settings de room valides, ignore."), i);
+			continue;
+		}
+
+		Info.SessionName = Info.Settings.RoomName;
+		Info.GameMode = Info.Settings.GameMode;
 		Info.CurrentPlayers = Result.Session.SessionSettings.NumPublicConnections
 			- Result.Session.NumOpenPublicConnections;
 		Info.MaxPlayers = Result.Session.SessionSettings.NumPublicConnections;
 		Info.Ping = Result.PingInMs;
 		Info.SessionSearchResultIndex = i;
+
+		// Filet de scurit : tous les services n'appliquent pas chaque QuerySetting
+		if (!LastQueryFilter.MatchesRoom(Info.Settings, Info.CurrentPlayers, Info.MaxPlayers) || !LastQueryFilter.MatchesPing(Info.Ping))
+			continue;
+
 		SessionInfos.Add(Info);
 	}
 
@@ -159,7 +358,7 @@ void UOnlineSessionSubsystem::OnFindSessionsCompleted(bool Successful)
 
 void UOnlineSessionSubsystem::JoinGameSession(const FOnlineSessionSearchResult& SessionResult)
 {
-	if (!Session.IsValid())
+	if (!EnsureSessionInterface())
 	{
 		UE_LOG(LogTemp, Error, TEXT("JoinGameSession: Session interface invalide."));
 		return;
@@ -212,67 +411,393 @@ void UOnlineSessionSubsystem::OnJoinSessionCompleted(FName SessionName, EOnJoinS
 void UOnlineSessionSubsystem::CustomJoinSession(const FCustomSessionInfo& SessionInfo)
 {
 	UE_LOG(LogTemp, Warning, TEXT("CustomJoinSession: demarrage pour l'index %d"), SessionInfo.SessionSearchResultIndex);
+	JoinFirstAvailable({ SessionInfo });
+}
 
-	if (!Session.IsValid() || !SearchResults.IsValidIndex(SessionInfo.SessionSearchResultIndex))
+void UOnlineSessionSubsystem::JoinFirstAvailable(const TArray<FCustomSessionInfo>& Candidates)
+{
+	if (bBeaconConnecting)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CustomJoinSession: session invalide ou index hors limites."));
-		OnSessionJoinCompleted.Broadcast(false);
+		UE_LOG(LogTemp, Warning, TEXT("JoinFirstAvailable: connexion beacon deja en cours, ignore."));
 		return;
 	}
 
-	if (bBeaconConnecting)
+	// Une room en double rutiliserait la connexion en cours de rservation
+	JoinCandidates.Reset(Candidates.Num());
+	for (const FCustomSessionInfo& Candidate : Candidates)
+	{
+		const bool bDuplicate = !Candidate.HostAddress.IsEmpty() && JoinCandidates.ContainsByPredicate([&Candidate](const FCustomSessionInfo& Other)
+		{
+			return Other.HostAddress == Candidate.HostAddress && Other.BeaconPort == Candidate.BeaconPort;
+		});
+		if (!bDuplicate)
+		{
+			JoinCandidates.Add(Candidate);
+		}
+	}
+
+	// Nettoie un ventuel beacon client rsiduel (lobby prcdent) ; un join abandonne la migration
+	CleanupBeaconClient();
+	Migration = FLobbyMigration();
+
+	NextJoinCandidate = 0;
+	JoinAttempts = 0;
+	JoinStartSeconds = FPlatformTime::Seconds();
+	bBeaconConnecting = true;
+	TryNextJoinCandidate();
+}
+
+bool UOnlineSessionSubsystem::ResolveBeaconAddress(const FCustomSessionInfo& SessionInfo, FString& OutAddress, int32& OutPort) const
+{
+	// Room LAN : seule l'adresse annonce est connue
+	if (!SessionInfo.HostAddress.IsEmpty())
+	{
+		OutAddress = SessionInfo.HostAddress;
+		OutPort = SessionInfo.BeaconPort > 0 ? SessionInfo.BeaconPort : LobbyConstants::BeaconPort;
+		return true;
+	}
+
+	// Service en ligne : hte rsolu par le service, port du beacon  la place du port de jeu
+	FString ConnectString;
+	if (!Session.IsValid() || !SearchResults.IsValidIndex(SessionInfo.SessionSearchResultIndex)
+		|| !Session->GetResolvedConnectString(SearchResults[SessionInfo.SessionSearchResultIndex], NAME_GamePort, ConnectString))
+		return false;
+
+	FString Host;
+	FString GamePort;
+	if (!ConnectString.Split(TEXT(":"), &Host, &GamePort, ESearchCase::CaseSensitive, ESearchDir::FromEnd) || !GamePort.IsNumeric())
+	{
+		Host = ConnectString;
+	}
+	if (Host.IsEmpty())
+		return false;
+
+	OutAddress = Host;
+	OutPort = LobbyConstants::BeaconPort;
+	return true;
+}
+
+void UOnlineSessionSubsystem::TryNextJoinCandidate()
+{
+	EnsureSessionInterface();
+
+	while (JoinCandidates.IsValidIndex(NextJoinCandidate))
+	{
+		FString Address;
+		int32 Port = 0;
+		if (!ResolveBeaconAddress(JoinCandidates[NextJoinCandidate++], Address, Port))
+		{
+			UE_LOG(LogTemp, Error, TEXT("JoinFirstAvailable: session invalide ou index hors limites."));
+			continue;
+		}
+
+		ALobbyBeaconClient* Client = BeaconPool->Acquire(GetWorld(), Address, Port);
+		if (!Client)
+			continue;
+
+		// Prchauffe la room suivante : en cas de refus, sa connexion est dj ouverte
+		FString NextAddress;
+		int32 NextPort = 0;
+		if (JoinCandidates.IsValidIndex(NextJoinCandidate) && ResolveBeaconAddress(JoinCandidates[NextJoinCandidate], NextAddress, NextPort))
+		{
+			BeaconPool->Acquire(GetWorld(), NextAddress, NextPort);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("JoinFirstAvailable: reservation sur %s:%d (%s)."), *Address, Port,
+			Client->IsConnected() ? TEXT("connexion reutilisee") : TEXT("connexion en cours"));
+
+		// Nom et icnes du profil local : envoys au host ds l'acceptation
+		if (const UPlayerProfileSubsystem* Profile = GetGameInstance()->GetSubsystem<UPlayerProfileSubsystem>())
+		{
+			Client->PendingPlayerInfo = Profile->MakeLobbyInfo();
+		}
+
+		JoinAttempts++;
+		PendingJoinClient = Client;
+		PendingJoinAddress = Address;
+		PendingJoinPort = Port;
+		Client->OnRequestValidate.BindUObject(this, &UOnlineSessionSubsystem::HandleJoinReservation, TWeakObjectPtr<ALobbyBeaconClient>(Client));
+		Client->RequestReservation();
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("JoinFirstAvailable: aucune room n'a accepte (%d tentative(s))."), JoinAttempts);
+	PendingJoinClient.Reset();
+	bBeaconConnecting = false;
+	OnSessionJoinCompleted.Broadcast(false);
+}
+
+void UOnlineSessionSubsystem::HandleJoinReservation(bool bValidated, TWeakObjectPtr<ALobbyBeaconClient> WeakClient)
+{
+	// Rponse tardive d'une connexion du pool qui n'est plus celle qu'on attend
+	ALobbyBeaconClient* Client = WeakClient.Get();
+	if (!Client || Client != PendingJoinClient.Get())
+		return;
+
+	PendingJoinClient.Reset();
+
+	if (!bValidated)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("CustomJoinSession: connexion beacon deja en cours, ignore."));
+		// Refus (room pleine) : la connexion reste dans le pool, room suivante
+		UE_LOG(LogTemp, Warning, TEXT("JoinFirstAvailable: reservation refusee, room suivante."));
+		TryNextJoinCandidate();
+		return;
+	}
+
+	bBeaconConnecting = false;
+	bLobbyIsLan = JoinCandidates.IsValidIndex(NextJoinCandidate - 1) && !JoinCandidates[NextJoinCandidate - 1].HostAddress.IsEmpty();
+
+	UE_LOG(LogTemp, Warning, TEXT("JoinFirstAvailable: beacon valide en %.1f ms (%d tentative(s))."),
+		(FPlatformTime::Seconds() - JoinStartSeconds) * 1000.0, JoinAttempts);
+
+	AdoptLobbyClient(Client);
+}
+
+void UOnlineSessionSubsystem::AdoptLobbyClient(ALobbyBeaconClient* Client)
+{
+	// Admis : la connexion sort du pool et devient celle du lobby
+	BeaconPool->Detach(Client);
+	LobbyBeaconClient = Client;
+	LobbyHostAddress = PendingJoinAddress;
+	LobbyHostPort = PendingJoinPort;
+	LobbyBeaconClient->OnLobbyUpdated.AddDynamic(this, &UOnlineSessionSubsystem::HandleLobbyUpdated_Internal);
+	LobbyBeaconClient->OnLobbyEvents.AddDynamic(this, &UOnlineSessionSubsystem::HandleLobbyEvents_Internal);
+	LobbyBeaconClient->OnHostLost.BindUObject(this, &UOnlineSessionSubsystem::HandleHostLost);
+	LobbyBeaconClient->OnRoomClosed.BindUObject(this, &UOnlineSessionSubsystem::HandleRoomClosed);
+
+	// Notifie l'UI que le beacon est prt
+	OnBeaconClientCreated.Broadcast(LobbyBeaconClient);
+}
+
+void UOnlineSessionSubsystem::HandleRoomClosed()
+{
+	UE_LOG(LogTemp, Warning, TEXT("HandleRoomClosed: room fermee par l'hote, retour au menu."));
+
+	// L'acquittement est dj parti : la connexion peut tre ferme tout de suite
+	CleanupBeaconClient();
+	Migration = FLobbyMigration();
+	OnLobbyClosed.Broadcast();
+}
+
+// ============================================================
+//  Migration d'hte (l'hte a quitt le lobby)
+// ============================================================
+
+void UOnlineSessionSubsystem::HandleHostLost()
+{
+	ALobbyBeaconClient* LostClient = LobbyBeaconClient;
+	if (!LostClient)
 		return;
+
+	// Copie du lobby avant destruction du client : c'est ce roster qui reste affich
+	Migration = FLobbyMigration();
+	Migration.Candidates = LostClient->LobbyPlayers;
+	Migration.Settings = LostClient->RoomSettings;
+	Migration.LocalPlayer = LostClient->PendingPlayerInfo;
+	Migration.Revision = LostClient->RosterRevision;
+	Migration.StartSeconds = FPlatformTime::Seconds();
+	Migration.bActive = true;
+
+	const int32 LostHostId = LostClient->HostPlayerId;
+	Migration.Candidates.RemoveAll([LostHostId](const FPlayerLobbyInfo& P) { return P.PlayerId == LostHostId; });
+
+	// Infos pas encore revenues dans le roster : le joueur local reste candidat
+	if (!Migration.Candidates.ContainsByPredicate([this](const FPlayerLobbyInfo& P) { return P.PlayerId == Migration.LocalPlayer.PlayerId; }))
+	{
+		Migration.Candidates.Add(Migration.LocalPlayer);
 	}
 
-	// Nettoie un ventuel beacon client rsiduel
+	// Seul notre lien a pu tomber : l'ancien hte est retent avant d'lire,
+	// sinon ce client se proclamerait hte d'un second lobby
+	Migration.LostHostAddress = LobbyHostAddress;
+	Migration.LostHostPort = LobbyHostPort;
+	Migration.bConfirmingHostLoss = !LobbyHostAddress.IsEmpty();
+	Migration.ConfirmDeadline = Migration.StartSeconds + LobbyConstants::HostLossConfirmSeconds;
+	Migration.NextAttemptSeconds = Migration.StartSeconds;
+
+	UE_LOG(LogTemp, Warning, TEXT("HandleHostLost: hote %d perdu, migration sur %d joueur(s) (revision %d)."),
+		LostHostId, Migration.Candidates.Num(), Migration.Revision);
+
 	CleanupBeaconClient();
+	if (Migration.bConfirmingHostLoss)
+	{
+		TickMigration(Migration.StartSeconds);
+		return;
+	}
+	ElectMigratedHost();
+}
 
-	// Cre le beacon client
-	LobbyBeaconClient = GetWorld()->SpawnActor<ALobbyBeaconClient>();
-	if (!LobbyBeaconClient)
+void UOnlineSessionSubsystem::ElectMigratedHost()
+{
+	// Plus petit PlayerId : mme rsultat chez tous les clients, sans change
+	const FPlayerLobbyInfo* Elected = nullptr;
+	for (const FPlayerLobbyInfo& Candidate : Migration.Candidates)
+	{
+		if (!Elected || Candidate.PlayerId < Elected->PlayerId)
+		{
+			Elected = &Candidate;
+		}
+	}
+
+	// Le joueur local est toujours candidat : l'lection finit au pire sur lui
+	check(Elected);
+	Migration.ElectedPlayerId = Elected->PlayerId;
+
+	if (Elected->PlayerId == Migration.LocalPlayer.PlayerId)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CustomJoinSession: impossible de spawner le BeaconClient."));
+		BecomeMigratedHost();
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	Migration.ElectedDeadline = Now + LobbyConstants::MigrationConnectTimeoutSeconds;
+	Migration.NextAttemptSeconds = Now;
+
+	UE_LOG(LogTemp, Warning, TEXT("ElectMigratedHost: '%s' (%d) elu, reconnexion vers %s."),
+		*Elected->PlayerName, Elected->PlayerId, *Elected->NetAddress);
+
+	TickMigration(Now);
+}
+
+void UOnlineSessionSubsystem::BecomeMigratedHost()
+{
+	UE_LOG(LogTemp, Warning, TEXT("BecomeMigratedHost: joueur local elu, reprise du lobby."));
+
+	HostedRoomSettings = Migration.Settings;
+	MaxPlayers = Migration.Settings.GetMaxPlayers();
+	PendingHostPlayerInfo = Migration.LocalPlayer;
+
+	// Beacon d'abord (synchrone) : le roster est repris avant que la moindre
+	// demande de reconnexion puisse arriver
+	CreateHostBeacon();
+
+	ALobbyBeaconHostObject* HostObject = LobbyHostObject.Get();
+	if (!BeaconHost || !HostObject)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BecomeMigratedHost: beacon host indisponible, lobby perdu."));
+		Migration = FLobbyMigration();
 		OnSessionJoinCompleted.Broadcast(false);
 		return;
 	}
 
-	LobbyBeaconClient->SetActorHiddenInGame(true);
-	LobbyBeaconClient->SetActorEnableCollision(false);
-	LobbyBeaconClient->SetReplicates(true);
+	HostObject->AdoptMigratedRoster(Migration.Candidates, Migration.Revision);
 
-	// Bind les vnements AVANT la connexion pour ne rien manquer
-	LobbyBeaconClient->OnLobbyUpdated.AddDynamic(this, &UOnlineSessionSubsystem::HandleLobbyUpdated_Internal);
+	UE_LOG(LogTemp, Warning, TEXT("BecomeMigratedHost: beacon actif en %.1f ms."),
+		(FPlatformTime::Seconds() - Migration.StartSeconds) * 1000.0);
+	Migration.bActive = false;
 
-	const FOnlineSessionSearchResult& TempResult = SearchResults[SessionInfo.SessionSearchResultIndex];
+	// Annonce de la room au nom du nouvel hte (CreateHostBeacon y est sans effet)
+	CreateSession(HostedRoomSettings, bLobbyIsLan);
+}
 
-	LobbyBeaconClient->OnRequestValidate.BindLambda(
-		[this, TempResult](bool bValidated)
+void UOnlineSessionSubsystem::TickMigration(double Now)
+{
+	if (Migration.bConfirmingHostLoss)
+	{
+		// Ancien hte muet jusqu' l'chance : il est bien parti, on lit
+		if (Now > Migration.ConfirmDeadline)
 		{
-			bBeaconConnecting = false;
-			if (bValidated)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("CustomJoinSession: beacon valide."));
-				// Notifie l'UI que le beacon est prt
-				OnBeaconClientCreated.Broadcast(LobbyBeaconClient);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("CustomJoinSession: validation beacon echouee."));
-				CleanupBeaconClient();
-				OnSessionJoinCompleted.Broadcast(false);
-			}
+			AbandonPendingJoin();
+			Migration.bConfirmingHostLoss = false;
+
+			UE_LOG(LogTemp, Warning, TEXT("TickMigration: hote %s injoignable, election."), *Migration.LostHostAddress);
+			ElectMigratedHost();
+			return;
 		}
-	);
 
-	// Connexion au beacon host
-	FURL Destination(nullptr, TEXT("127.0.0.1"), TRAVEL_Absolute);
-	Destination.Port = LobbyConstants::BeaconPort;
-	UE_LOG(LogTemp, Warning, TEXT("CustomJoinSession: connexion a %s:%d"), *Destination.Host, Destination.Port);
+		if (!PendingJoinClient.IsValid() && Now >= Migration.NextAttemptSeconds)
+		{
+			Migration.NextAttemptSeconds = Now + LobbyConstants::MigrationRetrySeconds;
+			RequestMigrationReservation(Migration.LostHostAddress, Migration.LostHostPort);
+		}
+		return;
+	}
 
-	bBeaconConnecting = true;
-	LobbyBeaconClient->ConnectToServer(Destination);
+	if (Migration.ElectedPlayerId == Migration.LocalPlayer.PlayerId)
+		return;
+
+	// lu injoignable : cart, lection suivante
+	if (Now > Migration.ElectedDeadline)
+	{
+		AbandonPendingJoin();
+
+		UE_LOG(LogTemp, Warning, TEXT("TickMigration: elu %d injoignable, election suivante."), Migration.ElectedPlayerId);
+		const int32 Unreachable = Migration.ElectedPlayerId;
+		Migration.Candidates.RemoveAll([Unreachable](const FPlayerLobbyInfo& P) { return P.PlayerId == Unreachable; });
+		ElectMigratedHost();
+		return;
+	}
+
+	if (PendingJoinClient.IsValid() || Now < Migration.NextAttemptSeconds)
+		return;
+
+	const FPlayerLobbyInfo* Elected = Migration.Candidates.FindByPredicate(
+		[this](const FPlayerLobbyInfo& P) { return P.PlayerId == Migration.ElectedPlayerId; });
+	if (!Elected || Elected->NetAddress.IsEmpty())
+	{
+		Migration.ElectedDeadline = Now;
+		return;
+	}
+
+	Migration.NextAttemptSeconds = Now + LobbyConstants::MigrationRetrySeconds;
+	RequestMigrationReservation(Elected->NetAddress, LobbyConstants::BeaconPort);
+}
+
+void UOnlineSessionSubsystem::RequestMigrationReservation(const FString& Address, int32 Port)
+{
+	ALobbyBeaconClient* Client = BeaconPool->Acquire(GetWorld(), Address, Port);
+	if (!Client)
+		return;
+
+	// Mme PlayerId qu'avant : le nouvel hte y reconnat la place reprise
+	Client->PendingPlayerInfo = Migration.LocalPlayer;
+	PendingJoinClient = Client;
+	PendingJoinAddress = Address;
+	PendingJoinPort = Port;
+	Client->OnRequestValidate.BindUObject(this, &UOnlineSessionSubsystem::HandleMigrationReservation, TWeakObjectPtr<ALobbyBeaconClient>(Client));
+	Client->RequestReservation();
+}
+
+void UOnlineSessionSubsystem::AbandonPendingJoin()
+{
+	if (ALobbyBeaconClient* Abandoned = PendingJoinClient.Get())
+	{
+		Abandoned->OnRequestValidate.Unbind();
+		BeaconPool->Detach(Abandoned);
+		Abandoned->DestroyBeacon();
+	}
+	PendingJoinClient.Reset();
+}
+
+void UOnlineSessionSubsystem::HandleMigrationReservation(bool bValidated, TWeakObjectPtr<ALobbyBeaconClient> WeakClient)
+{
+	ALobbyBeaconClient* Client = WeakClient.Get();
+	if (!Client || Client != PendingJoinClient.Get())
+		return;
+
+	PendingJoinClient.Reset();
+
+	if (!bValidated)
+	{
+		// Ancien hte joignable mais sans place pour nous : il n'est pas parti,
+		// ce client quitte le lobby plutt que d'en ouvrir un second
+		if (Migration.bConfirmingHostLoss && Client->IsConnected())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HandleMigrationReservation: hote toujours present, place refusee, lobby quitte."));
+			Migration = FLobbyMigration();
+			OnLobbyClosed.Broadcast();
+		}
+
+		// Beacon pas encore ouvert : nouvel essai au prochain intervalle
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("HandleMigrationReservation: %s en %.1f ms."),
+		Migration.bConfirmingHostLoss ? TEXT("lien vers l'hote retabli") : TEXT("lobby retrouve"),
+		(FPlatformTime::Seconds() - Migration.StartSeconds) * 1000.0);
+
+	Migration = FLobbyMigration();
+	AdoptLobbyClient(Client);
 }
 
 // ============================================================
@@ -317,14 +842,19 @@ void UOnlineSessionSubsystem::CreateHostBeacon()
 	HostObject->ReservedSlots = 0;
 	HostObject->MaxSlots = MaxPlayers;
 
-	int32 UnitCount = 1;
-	if (LastSessionSettings.IsValid())
+	HostObject->RoomUnitCount = HostedRoomSettings.UnitCount;
+	HostObject->RoomSettings = HostedRoomSettings;
+
+	// Index rserv  l'hte (le premier, ou le sien aprs une migration) :
+	// les clients savent ainsi qui exclure de l'lection
+	if (PendingHostPlayerInfo.PlayerId == 0)
 	{
-		LastSessionSettings->Get(LobbyConstants::Key_UnitCount, UnitCount);
+		PendingHostPlayerInfo.PlayerId = 1;
 	}
-	HostObject->RoomUnitCount = UnitCount;
+	HostObject->HostPlayerId = PendingHostPlayerInfo.PlayerId;
 
 	BeaconHost->RegisterHost(HostObject);
+	LobbyHostObject = HostObject;
 
 	UE_LOG(LogTemp, Warning, TEXT("CreateHostBeacon: host actif sur le port %d."), BeaconHost->ListenPort);
 
@@ -361,6 +891,7 @@ void UOnlineSessionSubsystem::ConnectHostAsClient(const FPlayerLobbyInfo& HostIn
 
 	// Bind les vnements AVANT la connexion
 	LobbyBeaconClient->OnLobbyUpdated.AddDynamic(this, &UOnlineSessionSubsystem::HandleLobbyUpdated_Internal);
+	LobbyBeaconClient->OnLobbyEvents.AddDynamic(this, &UOnlineSessionSubsystem::HandleLobbyEvents_Internal);
 
 	// Capture HostInfo par valeur pour l'utiliser dans le lambda
 	LobbyBeaconClient->OnRequestValidate.BindLambda(
@@ -394,20 +925,46 @@ void UOnlineSessionSubsystem::ConnectHostAsClient(const FPlayerLobbyInfo& HostIn
 }
 
 // ============================================================
-//  Destroy session
+//  Fermeture de room / Destroy session
 // ============================================================
 
+void UOnlineSessionSubsystem::CloseRoom()
+{
+	// La room disparat des listes LAN tout de suite (push Removed aux abonns)
+	LanDiscovery.StopHosting();
+
+	ALobbyBeaconHostObject* HostObject = LobbyHostObject.Get();
+	if (!HostObject)
+	{
+		DestroySession();
+		return;
+	}
+
+	if (HostObject->IsClosing())
+		return;
+
+	HostObject->BeginClose(FSimpleDelegate::CreateUObject(this, &UOnlineSessionSubsystem::DestroySession));
+}
+
 void UOnlineSessionSubsystem::DestroySession()
 {
-	if (!Session.IsValid())
+	if (!EnsureSessionInterface())
 		return;
 
+	// Plus de rponse aux recherches LAN
+	LanDiscovery.StopHosting();
+
+	// Dpart volontaire : le client local part avant le host, sans dclencher de migration
+	CleanupBeaconClient();
+	Migration = FLobbyMigration();
+
 	// On nettoie aussi le beacon host
 	if (BeaconHost)
 	{
 		BeaconHost->Destroy();
 		BeaconHost = nullptr;
 	}
+	LobbyHostObject.Reset();
 
 	DestroyHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(
 		FOnDestroySessionCompleteDelegate::CreateUObject(this, &UOnlineSessionSubsystem::OnDestroySessionCompleted)
@@ -435,7 +992,7 @@ template<typename ValueType>
 void UOnlineSessionSubsystem::UpdateCustomSetting(const FName& KeyName, const ValueType& Value,
 	EOnlineDataAdvertisementType::Type InType)
 {
-	if (!Session.IsValid() || !LastSessionSettings.IsValid())
+	if (!EnsureSessionInterface() || !LastSessionSettings.IsValid())
 		return;
 
 	TSharedPtr<FOnlineSessionSettings> UpdatedSettings = MakeShareable(new FOnlineSessionSettings(*LastSessionSettings));
@@ -467,4 +1024,36 @@ void UOnlineSessionSubsystem::OnUpdateSessionCompleted(FName SessionName, bool S
 void UOnlineSessionSubsystem::HandleLobbyUpdated_Internal(const TArray<FPlayerLobbyInfo>& Players)
 {
 	OnLobbysUpdated.Broadcast(Players);
+}
+
+void UOnlineSessionSubsystem::HandleLobbyEvents_Internal(const TArray<FLobbyChannelEvent>& Events)
+{
+	OnLobbyChannelEvents.Broadcast(Events);
+}
+
+// ============================================================
+//  Chat / prt du lobby
+// ============================================================
+
+void UOnlineSessionSubsystem::SendLobbyChat(const FString& Text)
+{
+	// Pas de canal pendant une migration : le message serait perdu avec l'ancien hte
+	if (!LobbyBeaconClient || !LobbyBeaconClient->IsAdmitted())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SendLobbyChat: pas de lobby, message ignore."));
+		return;
+	}
+
+	LobbyBeaconClient->Server_SendChat(Text.Left(FLobbyChatChannel::MaxMessageChars));
+}
+
+void UOnlineSessionSubsystem::SetLobbyReady(bool bReady)
+{
+	if (!LobbyBeaconClient || !LobbyBeaconClient->IsAdmitted())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SetLobbyReady: pas de lobby, ignore."));
+		return;
+	}
+
+	LobbyBeaconClient->Server_SetReady(bReady);
 }
\ No newline at end of file
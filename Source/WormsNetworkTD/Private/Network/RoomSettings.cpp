@@ -0,0 +1,74 @@
+#include "Network/RoomSettings.h"
+
+namespace
+{
+	// Version, GameMode, UnitLife (2), UnitCount, TurnsBeforeWater, longueur du nom
+	constexpr int32 RoomSettingsHeaderSizeV1 = 7;
+}
+
+TArray<uint8> FRoomSettings::Encode() const
+{
+	const FTCHARToUTF8 Name(*RoomName.Left(MaxRoomNameChars));
+	const int32 NameBytes = FMath::Min(Name.Length(), 255);
+
+	TArray<uint8> Blob;
+	Blob.Reserve(RoomSettingsHeaderSizeV1 + NameBytes);
+
+	const uint16 Life = static_cast<uint16>(FMath::Clamp(UnitLife, 0, MAX_uint16));
+	Blob.Add(CurrentVersion);
+	Blob.Add(static_cast<uint8>(GameMode));
+	Blob.Add(static_cast<uint8>(Life & 0xFF));
+	Blob.Add(static_cast<uint8>(Life >> 8));
+	Blob.Add(static_cast<uint8>(FMath::Clamp(UnitCount, 0, 255)));
+	Blob.Add(static_cast<uint8>(FMath::Clamp(TurnsBeforeWater, 0, 255)));
+	Blob.Add(static_cast<uint8>(NameBytes));
+	Blob.Append(reinterpret_cast<const uint8*>(Name.Get()), NameBytes);
+	return Blob;
+}
+
+bool FRoomSettings::Decode(TConstArrayView<uint8> Blob)
+{
+	if (Blob.Num() < RoomSettingsHeaderSizeV1 || Blob[0] < 1)
+		return false;
+
+	if (Blob[1] >= static_cast<uint8>(EWormsGameMode::Count))
+		return false;
+
+	const int32 NameBytes = Blob[6];
+	if (Blob.Num() < RoomSettingsHeaderSizeV1 + NameBytes)
+		return false;
+
+	GameMode = static_cast<EWormsGameMode>(Blob[1]);
+	UnitLife = Blob[2] | (Blob[3] << 8);
+	UnitCount = Blob[4];
+	TurnsBeforeWater = Blob[5];
+	RoomName = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Blob.GetData() + RoomSettingsHeaderSizeV1), NameBytes));
+
+	// Versions suivantes : champs au-delà de RoomSettingsHeaderSizeV1 + NameBytes, ignorés ici
+	return true;
+}
+
+// ============================================================
+//  Filtre
+// ============================================================
+
+void FRoomQueryFilter::SetModeAllowed(EWormsGameMode GameMode, bool bAllowed)
+{
+	const uint8 Bit = static_cast<uint8>(1u << static_cast<uint8>(GameMode));
+	ModeMask = bAllowed ? (ModeMask | Bit) : (ModeMask & ~Bit);
+}
+
+EWormsGameMode FRoomQueryFilter::GetSingleMode() const
+{
+	const uint8 Known = static_cast<uint8>((1u << static_cast<uint8>(EWormsGameMode::Count)) - 1);
+	const uint8 Modes = ModeMask & Known;
+	return Modes != 0 && FMath::IsPowerOfTwo(Modes) ? static_cast<EWormsGameMode>(FMath::CountTrailingZeros(Modes)) : EWormsGameMode::Count;
+}
+
+bool FRoomQueryFilter::MatchesRoom(const FRoomSettings& Room, int32 CurrentPlayers, int32 MaxPlayers) const
+{
+	if (!AllowsMode(Room.GameMode))
+		return false;
+
+	return !bRequireFreeSlot || CurrentPlayers < MaxPlayers;
+}
@@ -0,0 +1,298 @@
+#include "Profile/PlayerProfileSubsystem.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Magic (4), Version, longueur du nom
+	constexpr int32 ProfileHeaderSizeV1 = 6;
+
+	void AppendU32(TArray<uint8>& Blob, uint32 Value)
+	{
+		for (int32 Shift = 0; Shift < 32; Shift += 8)
+		{
+			Blob.Add(static_cast<uint8>((Value >> Shift) & 0xFF));
+		}
+	}
+
+	uint32 ReadU32(TConstArrayView<uint8> Blob, int32 Offset)
+	{
+		return Blob[Offset] | (Blob[Offset + 1] << 8) | (Blob[Offset + 2] << 16) | (static_cast<uint32>(Blob[Offset + 3]) << 24);
+	}
+
+	/** Fichier temporaire puis remplacement : un arrêt en pleine écriture laisse l'ancien profil intact. */
+	bool WriteProfileFile(const FString& Path, const TArray<uint8>& Blob)
+	{
+		const FString TempPath = Path + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Blob, *TempPath))
+			return false;
+
+		return IFileManager::Get().Move(*Path, *TempPath, true, true);
+	}
+
+	FString MakeDefaultPlayerName()
+	{
+		const FString UserName = FPlatformProcess::UserName();
+		return UserName.IsEmpty() ? TEXT("Player") : UserName.Left(FPlayerProfile::MaxPlayerNameChars);
+	}
+}
+
+// ============================================================
+//  Format
+// ============================================================
+
+TArray<uint8> FPlayerProfile::Encode() const
+{
+	const FTCHARToUTF8 Name(*PlayerName.Left(MaxPlayerNameChars));
+	const int32 NameBytes = FMath::Min(Name.Length(), 255);
+	const TArray<uint8> Room = LastRoomSettings.Encode();
+
+	TArray<uint8> Blob;
+	Blob.Reserve(ProfileHeaderSizeV1 + NameBytes + 3 + Room.Num());
+
+	AppendU32(Blob, Magic);
+	Blob.Add(CurrentVersion);
+	Blob.Add(static_cast<uint8>(NameBytes));
+	Blob.Append(reinterpret_cast<const uint8*>(Name.Get()), NameBytes);
+	Blob.Add(static_cast<uint8>(FMath::Clamp(ProfileIcon, 0, 255)));
+	Blob.Add(static_cast<uint8>(FMath::Clamp(TeamIcon, 0, 255)));
+	Blob.Add(static_cast<uint8>(FMath::Min(Room.Num(), 255)));
+	Blob.Append(Room.GetData(), FMath::Min(Room.Num(), 255));
+	return Blob;
+}
+
+bool FPlayerProfile::Decode(TConstArrayView<uint8> Blob)
+{
+	if (Blob.Num() < ProfileHeaderSizeV1 || ReadU32(Blob, 0) != Magic || Blob[4] < 1)
+		return false;
+
+	const int32 NameBytes = Blob[5];
+	int32 Offset = ProfileHeaderSizeV1 + NameBytes;
+	if (Blob.Num() < Offset + 3)
+		return false;
+
+	const int32 RoomBytes = Blob[Offset + 2];
+	if (Blob.Num() < Offset + 3 + RoomBytes)
+		return false;
+
+	PlayerName = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Blob.GetData() + ProfileHeaderSizeV1), NameBytes));
+	ProfileIcon = Blob[Offset];
+	TeamIcon = Blob[Offset + 1];
+	Offset += 3;
+
+	// Settings illisibles : le profil reste valable, la room repart des défauts
+	if (!LastRoomSettings.Decode(Blob.Slice(Offset, RoomBytes)))
+	{
+		LastRoomSettings = FRoomSettings();
+	}
+
+	// Versions suivantes : champs au-delà du blob room, ignorés ici
+	return true;
+}
+
+// ============================================================
+//  Cycle de vie
+// ============================================================
+
+void UPlayerProfileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Profile.PlayerName = MakeDefaultPlayerName();
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UPlayerProfileSubsystem::Tick));
+
+	// Lecture et décodage hors du game thread ; seul le résultat y revient
+	const FString Path = GetProfilePath();
+	TWeakObjectPtr<UPlayerProfileSubsystem> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Path]()
+	{
+		TArray<uint8> Data;
+		FPlayerProfile Loaded;
+		const bool bFound = FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent) && Loaded.Decode(Data);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Loaded = MoveTemp(Loaded), bFound]()
+		{
+			if (UPlayerProfileSubsystem* This = WeakThis.Get())
+			{
+				This->HandleProfileLoaded(Loaded, bFound);
+			}
+		});
+	});
+}
+
+void UPlayerProfileSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	// Fin de session : l'écriture en vol se termine, la dernière modification part tout de suite
+	if (SaveTask.IsValid())
+	{
+		// Échec : le profil n'est pas sur disque, on retente ici
+		bDirty |= !SaveTask.Get();
+		SaveTask.Reset();
+	}
+	if (bLoaded && bDirty)
+	{
+		bDirty = false;
+		if (!WriteProfileFile(GetProfilePath(), Profile.Encode()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("PlayerProfile: sauvegarde de fin de session echouee."));
+		}
+	}
+
+	Super::Deinitialize();
+}
+
+FString UPlayerProfileSubsystem::GetProfilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), ProfileFileName);
+}
+
+void UPlayerProfileSubsystem::HandleProfileLoaded(const FPlayerProfile& Loaded, bool bFound)
+{
+	if (bFound)
+	{
+		// Ce que l'utilisateur a déjà changé pendant le chargement est conservé
+		const FPlayerProfile Local = Profile;
+		Profile = Loaded;
+		if (FieldsChangedBeforeLoad & Field_Name)
+		{
+			Profile.PlayerName = Local.PlayerName;
+		}
+		if (FieldsChangedBeforeLoad & Field_Icons)
+		{
+			Profile.ProfileIcon = Local.ProfileIcon;
+			Profile.TeamIcon = Local.TeamIcon;
+		}
+		if (FieldsChangedBeforeLoad & Field_Room)
+		{
+			Profile.LastRoomSettings = Local.LastRoomSettings;
+		}
+		if (Profile.PlayerName.IsEmpty())
+		{
+			Profile.PlayerName = MakeDefaultPlayerName();
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("PlayerProfile: %s (joueur '%s')."),
+		bFound ? TEXT("profil charge") : TEXT("aucun profil, valeurs par defaut"), *Profile.PlayerName);
+
+	bLoaded = true;
+	FieldsChangedBeforeLoad = 0;
+	OnProfileLoaded.Broadcast();
+}
+
+// ============================================================
+//  Lecture / modification
+// ============================================================
+
+FPlayerLobbyInfo UPlayerProfileSubsystem::MakeLobbyInfo() const
+{
+	FPlayerLobbyInfo Info;
+	Info.PlayerName = Profile.PlayerName;
+	Info.ProfileIcon = Profile.ProfileIcon;
+	Info.TeamIcon = Profile.TeamIcon;
+	return Info;
+}
+
+void UPlayerProfileSubsystem::SetPlayerName(const FString& PlayerName)
+{
+	const FString Trimmed = PlayerName.TrimStartAndEnd().Left(FPlayerProfile::MaxPlayerNameChars);
+	if (Trimmed.IsEmpty() || Trimmed == Profile.PlayerName)
+		return;
+
+	Profile.PlayerName = Trimmed;
+	MarkDirty(Field_Name);
+}
+
+void UPlayerProfileSubsystem::SetIcons(int32 ProfileIcon, int32 TeamIcon)
+{
+	if (ProfileIcon == Profile.ProfileIcon && TeamIcon == Profile.TeamIcon)
+		return;
+
+	Profile.ProfileIcon = ProfileIcon;
+	Profile.TeamIcon = TeamIcon;
+	MarkDirty(Field_Icons);
+}
+
+void UPlayerProfileSubsystem::SetLastRoomSettings(const FRoomSettings& RoomSettings)
+{
+	// Comparaison sur l'encodage : c'est lui qui est écrit
+	if (RoomSettings.Encode() == Profile.LastRoomSettings.Encode())
+		return;
+
+	Profile.LastRoomSettings = RoomSettings;
+	MarkDirty(Field_Room);
+}
+
+// ============================================================
+//  Sauvegarde différée
+// ============================================================
+
+void UPlayerProfileSubsystem::MarkDirty(uint8 Field)
+{
+	if (!bLoaded)
+	{
+		FieldsChangedBeforeLoad |= Field;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bDirty)
+	{
+		bDirty = true;
+		FirstDirtySeconds = Now;
+	}
+
+	// Chaque modification repousse l'écriture, sans dépasser MaxSaveDelaySeconds
+	SaveDueSeconds = FMath::Min(Now + SaveDebounceSeconds, FirstDirtySeconds + MaxSaveDelaySeconds);
+}
+
+bool UPlayerProfileSubsystem::Tick(float DeltaTime)
+{
+	if (SaveTask.IsValid())
+	{
+		if (!SaveTask.IsReady())
+			return true;
+
+		if (!SaveTask.Get())
+		{
+			UE_LOG(LogTemp, Error, TEXT("PlayerProfile: ecriture de %s echouee, nouvel essai differe."), *GetProfilePath());
+
+			// Les données écrites ne sont pas sur disque : à réécrire, sans
+			// avancer une échéance déjà posée par une modification plus récente
+			const double Now = FPlatformTime::Seconds();
+			if (!bDirty)
+			{
+				bDirty = true;
+				FirstDirtySeconds = Now;
+				SaveDueSeconds = Now + SaveDebounceSeconds;
+			}
+		}
+		SaveTask.Reset();
+	}
+
+	// Pas d'écriture avant le chargement : elle écraserait le fichier encore non lu
+	if (bLoaded && bDirty && FPlatformTime::Seconds() >= SaveDueSeconds)
+	{
+		StartSave();
+	}
+	return true;
+}
+
+void UPlayerProfileSubsystem::StartSave()
+{
+	// Encodage sur le game thread (quelques dizaines d'octets), disque sur le pool
+	bDirty = false;
+	TArray<uint8> Blob = Profile.Encode();
+	const FString Path = GetProfilePath();
+
+	SaveTask = Async(EAsyncExecution::ThreadPool, [Blob = MoveTemp(Blob), Path]()
+	{
+		return WriteProfileFile(Path, Blob);
+	});
+}
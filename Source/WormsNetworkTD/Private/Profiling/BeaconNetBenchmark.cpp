@@ -0,0 +1,378 @@
+#include "Profiling/BeaconNetBenchmark.h"
+#include "Beacon/LobbyBeaconClient.h"
+#include "Beacon/LobbyBeaconHostObject.h"
+#include "Beacon/LobbyTypes.h"
+#include "Profiling/ProfilingReport.h"
+#include "OnlineBeaconHost.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+TWeakObjectPtr<UBeaconNetBenchmark> UBeaconNetBenchmark::ActiveRun;
+
+namespace
+{
+	// Au-delà, la condition est marquée "timeout" dans le rapport
+	constexpr double ConditionTimeoutSeconds = 30.0;
+
+	// Laisse le temps aux sockets beacon d'être libérées entre deux conditions
+	constexpr double TeardownDelaySeconds = 0.5;
+}
+
+// ============================================================
+//  Matrice par défaut
+// ============================================================
+
+TArray<FBeaconNetCondition> UBeaconNetBenchmark::GetDefaultMatrix()
+{
+	return {
+		{ TEXT("clean"),           0,   0,   0 },
+		{ TEXT("loss_2"),          2,   0,   0 },
+		{ TEXT("loss_10"),        10,   0,   0 },
+		{ TEXT("lag_100"),         0, 100, 100 },
+		{ TEXT("lag_100_jit_60"),  0,  70, 130 },
+		{ TEXT("wifi_bad"),        8,  40, 200 },
+		{ TEXT("wifi_awful"),     20,  80, 300 },
+	};
+}
+
+// ============================================================
+//  Lancement
+// ============================================================
+
+bool UBeaconNetBenchmark::Run(UWorld* InWorld, int32 InNumClients, bool bInExitWhenDone)
+{
+	if (ActiveRun.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BeaconNetBench: un benchmark est deja en cours."));
+		return false;
+	}
+
+	if (!InWorld)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BeaconNetBench: aucun monde disponible."));
+		return false;
+	}
+
+#if !DO_ENABLE_NET_TEST
+	UE_LOG(LogTemp, Warning, TEXT("BeaconNetBench: simulation de paquets indisponible dans ce build, seules les mesures 'clean' sont representatives."));
+#endif
+
+	UBeaconNetBenchmark* Bench = NewObject<UBeaconNetBenchmark>(GetTransientPackage());
+	Bench->AddToRoot();
+	Bench->World = InWorld;
+	Bench->NumClients = FMath::Clamp(InNumClients, 1, 16);
+	Bench->bExitWhenDone = bInExitWhenDone;
+	Bench->Matrix = GetDefaultMatrix();
+	Bench->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(Bench, &UBeaconNetBenchmark::Tick));
+
+	ActiveRun = Bench;
+	UE_LOG(LogTemp, Warning, TEXT("BeaconNetBench: demarrage (%d client(s), %d condition(s))."),
+		Bench->NumClients, Bench->Matrix.Num());
+	return true;
+}
+
+// ============================================================
+//  Machine à états
+// ============================================================
+
+bool UBeaconNetBenchmark::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	switch (Step)
+	{
+	case EStep::StartCondition:
+		if (!Matrix.IsValidIndex(ConditionIndex))
+		{
+			Step = EStep::Done;
+			break;
+		}
+		StartCondition();
+		break;
+
+	case EStep::Running:
+	{
+		// Convergence : tous les clients ont reçu le roster complet
+		if (ConvergenceTime < 0.0)
+		{
+			bool bAllConverged = Clients.Num() > 0;
+			for (const ALobbyBeaconClient* Client : Clients)
+			{
+				if (!IsValid(Client) || Client->LobbyPlayers.Num() < NumClients)
+				{
+					bAllConverged = false;
+					break;
+				}
+			}
+			if (bAllConverged)
+			{
+				ConvergenceTime = Now - ConditionStartTime;
+			}
+		}
+
+		if (ConvergenceTime >= 0.0)
+		{
+			// Roster complet : on mesure la fermeture propre de la room
+			CloseStartTime = Now;
+			Step = EStep::Closing;
+
+			TWeakObjectPtr<UBeaconNetBenchmark> WeakThis(this);
+			HostObject->BeginClose(FSimpleDelegate::CreateLambda([WeakThis]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->HostCloseTime = FPlatformTime::Seconds() - WeakThis->CloseStartTime;
+				}
+			}));
+		}
+		else if (Now - ConditionStartTime > ConditionTimeoutSeconds)
+		{
+			FinishCondition(true);
+		}
+		break;
+	}
+
+	case EStep::Closing:
+		if (HostCloseTime >= 0.0 && CloseNotifyTimes.Num() >= Clients.Num())
+		{
+			FinishCondition(false);
+		}
+		else if (Now - ConditionStartTime > ConditionTimeoutSeconds)
+		{
+			FinishCondition(true);
+		}
+		break;
+
+	case EStep::Teardown:
+		if (Now - TeardownStartTime > TeardownDelaySeconds)
+		{
+			ConditionIndex++;
+			Step = EStep::StartCondition;
+		}
+		break;
+
+	case EStep::Done:
+	{
+		WriteReport();
+		ActiveRun.Reset();
+		RemoveFromRoot();
+		return false; // désenregistre le ticker
+	}
+	}
+
+	return true;
+}
+
+void UBeaconNetBenchmark::StartCondition()
+{
+	UWorld* W = World.Get();
+	if (!W)
+	{
+		Step = EStep::Done;
+		return;
+	}
+
+	const FBeaconNetCondition& Condition = Matrix[ConditionIndex];
+	UE_LOG(LogTemp, Warning, TEXT("BeaconNetBench: condition '%s' (perte %d%%, latence %d-%d ms)."),
+		*Condition.Name, Condition.LossPercent, Condition.LagMinMs, Condition.LagMaxMs);
+
+	ReservationTimes.Reset();
+	ConvergenceTime = -1.0;
+	CloseNotifyTimes.Reset();
+	HostCloseTime = -1.0;
+
+	// ----- Host -----
+	BeaconHost = W->SpawnActor<AOnlineBeaconHost>();
+	if (!BeaconHost || !BeaconHost->InitHost())
+	{
+		UE_LOG(LogTemp, Error, TEXT("BeaconNetBench: InitHost() echoue (port %d occupe ?)."), LobbyConstants::BeaconPort);
+		FinishCondition(true);
+		return;
+	}
+	BeaconHost->PauseBeaconRequests(false);
+
+	HostObject = W->SpawnActor<ALobbyBeaconHostObject>();
+	if (!HostObject)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BeaconNetBench: spawn du HostObject echoue."));
+		FinishCondition(true);
+		return;
+	}
+	HostObject->MaxSlots = NumClients;
+	HostObject->RoomUnitCount = 1;
+	BeaconHost->RegisterHost(HostObject);
+
+	// ----- Clients -----
+	ConditionStartTime = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < NumClients; i++)
+	{
+		ALobbyBeaconClient* Client = W->SpawnActor<ALobbyBeaconClient>();
+		if (!Client)
+			continue;
+
+		// Tous les clients partagent le net id du joueur local : le host leur
+		// attribue quand même des index distincts
+		Client->PendingPlayerInfo.PlayerName = FString::Printf(TEXT("Bench %d"), i + 1);
+
+		TWeakObjectPtr<UBeaconNetBenchmark> WeakThis(this);
+		Client->OnRequestValidate.BindLambda([WeakThis](bool bValidated)
+		{
+			if (WeakThis.IsValid() && bValidated)
+			{
+				WeakThis->ReservationTimes.Add(FPlatformTime::Seconds() - WeakThis->ConditionStartTime);
+			}
+		});
+		Client->OnRoomClosed.BindLambda([WeakThis]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->CloseNotifyTimes.Add(FPlatformTime::Seconds() - WeakThis->CloseStartTime);
+			}
+		});
+
+#if DO_ENABLE_NET_TEST
+		// Appliqué côté client dans les deux sens : modélise le lien Wi-Fi du joueur.
+		// Posé avant la connexion pour que la poignée de main soit dégradée elle aussi
+		FPacketSimulationSettings Settings;
+		Settings.PktLoss = Condition.LossPercent;
+		Settings.PktIncomingLoss = Condition.LossPercent;
+		Settings.PktLagMin = Condition.LagMinMs;
+		Settings.PktLagMax = Condition.LagMaxMs;
+		Settings.PktIncomingLagMin = Condition.LagMinMs;
+		Settings.PktIncomingLagMax = Condition.LagMaxMs;
+		Client->PacketSimulation = Settings;
+#endif
+
+		FURL Destination(nullptr, TEXT("127.0.0.1"), TRAVEL_Absolute);
+		Destination.Port = LobbyConstants::BeaconPort;
+		Client->ConnectToServer(Destination);
+
+		Clients.Add(Client);
+	}
+
+	Step = EStep::Running;
+}
+
+void UBeaconNetBenchmark::FinishCondition(bool bTimedOut)
+{
+	FBeaconNetResult& Result = Results.AddDefaulted_GetRef();
+	Result.ConditionName = Matrix[ConditionIndex].Name;
+	Result.NumClients = NumClients;
+	Result.NumReserved = ReservationTimes.Num();
+	Result.bTimedOut = bTimedOut;
+	Result.RosterConvergenceMs = ConvergenceTime >= 0.0 ? ConvergenceTime * 1000.0 : -1.0;
+
+	if (ReservationTimes.Num() > 0)
+	{
+		TArray<double> Sorted = ReservationTimes;
+		Sorted.Sort();
+		Result.ReservationMedianMs = Sorted[Sorted.Num() / 2] * 1000.0;
+		Result.ReservationMaxMs = Sorted.Last() * 1000.0;
+	}
+
+	if (CloseNotifyTimes.Num() > 0)
+	{
+		Result.CloseNotifyMaxMs = FMath::Max(CloseNotifyTimes) * 1000.0;
+	}
+	Result.HostCloseMs = HostCloseTime >= 0.0 ? HostCloseTime * 1000.0 : -1.0;
+
+	for (const ALobbyBeaconClient* Client : Clients)
+	{
+		if (!IsValid(Client))
+			continue;
+
+		if (Client->LobbyPlayers.Num() >= NumClients)
+		{
+			Result.NumConverged++;
+		}
+
+		if (const UNetDriver* Driver = Client->GetNetDriver())
+		{
+			Result.ClientBytesOut += Driver->OutTotalBytes;
+			Result.ClientBytesIn += Driver->InTotalBytes;
+		}
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("BeaconNetBench: '%s' -> %d/%d reserve(s), roster %.1f ms%s."),
+		*Result.ConditionName, Result.NumReserved, NumClients, Result.RosterConvergenceMs,
+		bTimedOut ? TEXT(" (timeout)") : TEXT(""));
+
+	Teardown();
+}
+
+void UBeaconNetBenchmark::Teardown()
+{
+	for (ALobbyBeaconClient* Client : Clients)
+	{
+		if (IsValid(Client))
+		{
+			Client->OnRequestValidate.Unbind();
+			Client->OnRoomClosed.Unbind();
+			Client->DestroyBeacon();
+		}
+	}
+	Clients.Reset();
+
+	if (IsValid(HostObject))
+	{
+		HostObject->Destroy();
+	}
+	HostObject = nullptr;
+
+	if (IsValid(BeaconHost))
+	{
+		BeaconHost->DestroyBeacon();
+	}
+	BeaconHost = nullptr;
+
+	TeardownStartTime = FPlatformTime::Seconds();
+	Step = EStep::Teardown;
+}
+
+// ============================================================
+//  Rapport
+// ============================================================
+
+void UBeaconNetBenchmark::WriteReport() const
+{
+	FProfilingReport Report(TEXT("BeaconNetBench"), 2, FString::Printf(TEXT("clients=%d | net_test=%d | timeout_s=%.0f | close_ack_timeout_s=%.2f"),
+		NumClients, DO_ENABLE_NET_TEST ? 1 : 0, ConditionTimeoutSeconds, LobbyConstants::CloseAckTimeoutSeconds));
+	Report.AddLine(FString::Printf(TEXT("# %-16s %5s %9s %8s %9s %10s %10s %10s %10s %10s %12s %12s"),
+		TEXT("condition"), TEXT("loss"), TEXT("lag_ms"), TEXT("reserved"), TEXT("converged"),
+		TEXT("resv_p50"), TEXT("resv_max"), TEXT("roster_ms"), TEXT("close_cli"), TEXT("close_host"),
+		TEXT("cli_out_B"), TEXT("cli_in_B")));
+
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		const FBeaconNetResult& R = Results[i];
+		const FBeaconNetCondition& C = Matrix[i];
+		Report.AddLine(FString::Printf(TEXT("  %-16s %5d %4d-%-4d %4d/%-3d %5d/%-3d %10.1f %10.1f %10.1f %10.1f %10.1f %12llu %12llu%s"),
+			*R.ConditionName, C.LossPercent, C.LagMinMs, C.LagMaxMs,
+			R.NumReserved, R.NumClients, R.NumConverged, R.NumClients,
+			R.ReservationMedianMs, R.ReservationMaxMs, R.RosterConvergenceMs,
+			R.CloseNotifyMaxMs, R.HostCloseMs,
+			R.ClientBytesOut, R.ClientBytesIn,
+			R.bTimedOut ? TEXT(" TIMEOUT") : TEXT("")));
+	}
+
+	Report.WriteAndMaybeExit(bExitWhenDone);
+}
+
+// ============================================================
+//  Commande console
+// ============================================================
+
+static FAutoConsoleCommandWithWorldAndArgs GBeaconNetBenchCommand(
+	TEXT("Worms.BeaconNetBench"),
+	TEXT("Benchmark beacon loopback sous pertes/latence. Usage: Worms.BeaconNetBench [NumClients] [exit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Clients = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 3;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		UBeaconNetBenchmark::Run(World, Clients > 0 ? Clients : 3, bExit);
+	})
+);
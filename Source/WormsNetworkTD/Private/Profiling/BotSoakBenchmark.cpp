@@ -0,0 +1,120 @@
+#include "Simulation/LockstepSimulation.h"
+#include "Simulation/WormBotBrain.h"
+#include "Profiling/ProfilingReport.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================
+//  Soak bots (hors ligne, sans monde)
+//
+//  Partie 100 % bots sur la simulation lockstep, graine fixe :
+//  mêmes décisions à chaque exécution sur une même machine. Mesure
+//  le coût serveur par tick (simulation + réflexion des bots) et
+//  vérifie que les bots jouent vraiment (tirs, morts, fin de partie).
+//  Pour le chemin réseau complet : Worms.BotMatch sur un serveur dédié.
+//
+//  Rapport : Saved/Profiling/BotSoak.txt
+//  Console : Worms.BotSoak [NumBots] [MaxTurns] [exit]
+// ============================================================
+namespace
+{
+	constexpr uint32 MaxSoakFrames = 60 * 60 * LockstepConstants::TickRate;
+
+	void RunBotSoak(int32 NumBots, int32 MaxTurns, bool bExitWhenDone)
+	{
+		FLockstepMatchConfig Config;
+		Config.NumPlayers = NumBots;
+		Config.Seed = 1234;
+
+		FLockstepSimulation Sim;
+		Sim.Init(Config);
+
+		TArray<FWormBotBrain> Brains;
+		Brains.SetNum(NumBots);
+		for (int32 i = 0; i < NumBots; i++)
+		{
+			Brains[i].Reset(i);
+		}
+
+		// Même décalage d'input que le réseau : la frame F applique les inputs pensés en F - InputDelay
+		TArray<TArray<FLockstepInput>> InputQueue;
+		InputQueue.SetNum(LockstepConstants::InputDelayFrames + 1);
+		for (TArray<FLockstepInput>& Slot : InputQueue)
+		{
+			Slot.SetNum(NumBots);
+		}
+
+		TArray<double> ThinkSamples;
+		double SimSeconds = 0.0;
+		uint32 Frames = 0;
+		int32 Turns = 0;
+		int32 Shots = 0;
+
+		while (Turns < MaxTurns && Frames < MaxSoakFrames && Sim.CountAlivePlayers() > 1)
+		{
+			TArray<FLockstepInput>& Thought = InputQueue[(Frames + LockstepConstants::InputDelayFrames) % InputQueue.Num()];
+
+			const double ThinkStart = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumBots; i++)
+			{
+				Thought[i] = Brains[i].Think(Sim.GetState());
+			}
+			ThinkSamples.Add(FPlatformTime::Seconds() - ThinkStart);
+
+			TArray<FLockstepInput>& Inputs = InputQueue[Frames % InputQueue.Num()];
+			const bool bShotBefore = Sim.GetState().bShotFiredThisTurn;
+
+			const double SimStart = FPlatformTime::Seconds();
+			const bool bTurnEnded = Sim.Step(Inputs);
+			SimSeconds += FPlatformTime::Seconds() - SimStart;
+
+			Shots += (!bShotBefore && Sim.GetState().bShotFiredThisTurn) ? 1 : 0;
+			Turns += bTurnEnded ? 1 : 0;
+			for (FLockstepInput& Input : Inputs)
+			{
+				Input = FLockstepInput();
+			}
+			Frames++;
+		}
+
+		int32 Dead = 0;
+		for (const FLockstepWorm& Worm : Sim.GetState().Worms)
+		{
+			Dead += Worm.bAlive ? 0 : 1;
+		}
+
+		double ThinkTotal = 0.0;
+		for (const double Sample : ThinkSamples)
+		{
+			ThinkTotal += Sample;
+		}
+		ThinkSamples.Sort();
+		const double ThinkP50Us = ThinkSamples.Num() > 0 ? ThinkSamples[ThinkSamples.Num() / 2] * 1e6 : 0.0;
+		const double ThinkMaxMs = ThinkSamples.Num() > 0 ? ThinkSamples.Last() * 1000.0 : 0.0;
+
+		FProfilingReport Report(TEXT("BotSoak"), 1, FString::Printf(TEXT("bots=%d | seed=%d | max_turns=%d | tick_rate=%d"),
+			NumBots, Config.Seed, MaxTurns, LockstepConstants::TickRate));
+		Report.AddInt(TEXT("frames"), Frames);
+		Report.AddInt(TEXT("turns"), Turns);
+		Report.AddInt(TEXT("shots"), Shots);
+		Report.AddInt(TEXT("worms_dead"), Dead);
+		Report.AddInt(TEXT("players_alive"), Sim.CountAlivePlayers());
+		Report.AddFloat(TEXT("sim_us_per_tick"), Frames > 0 ? SimSeconds * 1e6 / Frames : 0.0, 3);
+		Report.AddFloat(TEXT("think_us_per_tick_avg"), Frames > 0 ? ThinkTotal * 1e6 / Frames : 0.0, 3);
+		Report.AddFloat(TEXT("think_us_per_tick_p50"), ThinkP50Us, 3);
+		Report.AddFloat(TEXT("think_ms_worst_tick"), ThinkMaxMs, 3);
+		Report.AddInt(TEXT("checksum"), Sim.ComputeChecksum());
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommand GBotSoakCommand(
+	TEXT("Worms.BotSoak"),
+	TEXT("Partie lockstep 100% bots hors ligne, cout serveur par tick. Usage: Worms.BotSoak [NumBots] [MaxTurns] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Bots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 4;
+		const int32 Turns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 40;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		RunBotSoak(FMath::Clamp(Bots, 2, LockstepConstants::MaxPlayers), Turns > 0 ? Turns : 40, bExit);
+	})
+);
@@ -0,0 +1,303 @@
+#include "Network/LanRoomDiscovery.h"
+#include "Profiling/ProfilingReport.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+
+// ============================================================
+//  Découverte LAN filtrée
+//
+//  N rooms annoncées (graine fixe), une requête sans filtre puis
+//  une requête "1V1 seulement". Sections unfiltered / filter_1v1 :
+//  chemin d'un paquet rejoué sans le réseau, chaque hôte décode la
+//  requête et évalue le filtre (BuildReplyPayload), le client décode
+//  chaque réponse. Octets sur le fil = en-tête FLANSession + payload
+//  + UDP/IP ; pas de latence dans ces sections.
+//
+//  Aller-retour réel (socket_*) : les Responders premières rooms sont
+//  hébergées par de vrais FLanRoomDiscovery dans ce process, sur le
+//  port de découverte, et un client lance StartSearch. Temps mesuré
+//  du broadcast au callback, arrêté dès que toutes les rooms qui
+//  correspondent ont répondu (sinon au timeout de FLANSession).
+//  Plafonné à MaxLiveResponders : au-delà, ce sont les tampons de
+//  réception de l'OS qui saturent, pas le protocole.
+//
+//  Liste en direct : sur une fenêtre simulée, trafic d'un navigateur
+//  qui relance une recherche complète toutes les PollSeconds contre
+//  un abonné (snapshot, renouvellements, battements, un push par
+//  changement du nombre de joueurs).
+//
+//  Rapport : Saved/Profiling/LanDiscoveryBench.txt
+//  Console : Worms.LanDiscoveryBench [NumRooms] [Responders] [exit]
+// ============================================================
+namespace
+{
+	// Magic + version + nonce de FLANSession, puis en-têtes UDP/IPv4
+	constexpr int32 LanHeaderBytes = 16;
+	constexpr int32 UdpIpHeaderBytes = 28;
+
+	// Liste en direct
+	constexpr int32 LiveWindowSeconds = 60;
+	constexpr int32 PollSeconds = 2;
+	constexpr float ChangeChancePerSecond = 0.02f;
+
+	// Aller-retour réel
+	constexpr int32 MaxLiveResponders = 64;
+	constexpr double LiveSafetySeconds = 10.0;
+
+	struct FQueryStats
+	{
+		int32 Replies = 0;
+		int64 QueryBytes = 0;
+		int64 ReplyBytes = 0;
+		double ResponderSeconds = 0.0;
+		double ClientSeconds = 0.0;
+		int32 Parsed = 0;
+	};
+
+	FQueryStats RunQuery(const FRoomQueryFilter& Filter, const TArray<FLanRoomAdvert>& Rooms)
+	{
+		FQueryStats Stats;
+
+		uint8 Query[FLanRoomDiscovery::QueryPayloadSize];
+		FLanRoomDiscovery::WriteQueryPayload(Filter, Query);
+		Stats.QueryBytes = LanHeaderBytes + FLanRoomDiscovery::QueryPayloadSize + UdpIpHeaderBytes;
+
+		// Côté hôtes : un broadcast reçu par toutes les rooms
+		TArray<TArray<uint8>> Replies;
+		Replies.Reserve(Rooms.Num());
+		TArray<uint8> Payload;
+
+		const double ResponderStart = FPlatformTime::Seconds();
+		for (const FLanRoomAdvert& Room : Rooms)
+		{
+			FRoomQueryFilter Received;
+			if (FLanRoomDiscovery::ReadQueryPayload(Query, FLanRoomDiscovery::QueryPayloadSize, Received)
+				&& FLanRoomDiscovery::BuildReplyPayload(Received, Room, Payload))
+			{
+				Replies.Add(Payload);
+			}
+		}
+		Stats.ResponderSeconds = FPlatformTime::Seconds() - ResponderStart;
+
+		// Côté client : une réponse par room correspondante
+		const double ClientStart = FPlatformTime::Seconds();
+		for (const TArray<uint8>& Reply : Replies)
+		{
+			FLanRoomAdvert Advert;
+			Stats.Parsed += FLanRoomDiscovery::ReadReplyPayload(Reply.GetData(), Reply.Num(), Advert) ? 1 : 0;
+			Stats.ReplyBytes += LanHeaderBytes + Reply.Num() + UdpIpHeaderBytes;
+		}
+		Stats.ClientSeconds = FPlatformTime::Seconds() - ClientStart;
+
+		Stats.Replies = Replies.Num();
+		return Stats;
+	}
+
+	void AppendStats(FProfilingReport& Report, const TCHAR* Label, const FQueryStats& Stats, int32 NumRooms)
+	{
+		Report.AddSection(Label);
+		Report.AddInt(TEXT("replies"), Stats.Replies);
+		Report.AddInt(TEXT("replies_parsed"), Stats.Parsed);
+		Report.AddInt(TEXT("query_bytes"), Stats.QueryBytes);
+		Report.AddInt(TEXT("reply_bytes_total"), Stats.ReplyBytes);
+		Report.AddFloat(TEXT("responder_ns_per_room"), NumRooms > 0 ? Stats.ResponderSeconds * 1e9 / NumRooms : 0.0, 3);
+		Report.AddFloat(TEXT("client_us_total"), Stats.ClientSeconds * 1e6, 3);
+	}
+
+	int64 WireBytes(int32 PayloadBytes)
+	{
+		return LanHeaderBytes + PayloadBytes + UdpIpHeaderBytes;
+	}
+
+	/** Octets reçus par un navigateur pendant LiveWindowSeconds : polling complet vs abonnement. */
+	void AppendLiveListStats(FProfilingReport& Report, TArray<FLanRoomAdvert> Rooms, FRandomStream& Random)
+	{
+		const FRoomQueryFilter Filter;
+		const int64 QueryBytes = WireBytes(FLanRoomDiscovery::QueryPayloadSize);
+
+		int64 PollBytes = 0;
+		int64 LiveBytes = 0;
+		int32 Changes = 0;
+		TArray<uint8> Payload;
+
+		// Snapshot de l'abonné : requête + une annonce complète par room
+		LiveBytes += QueryBytes;
+		for (const FLanRoomAdvert& Room : Rooms)
+		{
+			FLanRoomDiscovery::WriteUpdatePayload(ERoomListChange::Added, Room, Payload);
+			LiveBytes += WireBytes(Payload.Num());
+		}
+
+		for (int32 Second = 0; Second < LiveWindowSeconds; Second++)
+		{
+			if (Second % PollSeconds == 0)
+			{
+				PollBytes += QueryBytes;
+				for (const FLanRoomAdvert& Room : Rooms)
+				{
+					if (FLanRoomDiscovery::BuildReplyPayload(Filter, Room, Payload))
+						PollBytes += WireBytes(Payload.Num());
+				}
+			}
+
+			if (Second > 0 && Second % FMath::RoundToInt(FLanRoomDiscovery::RenewSeconds) == 0)
+			{
+				LiveBytes += QueryBytes;
+			}
+
+			const bool bHeartbeat = Second > 0 && Second % FMath::RoundToInt(FLanRoomDiscovery::HeartbeatSeconds) == 0;
+			for (FLanRoomAdvert& Room : Rooms)
+			{
+				if (Random.FRand() < ChangeChancePerSecond)
+				{
+					Room.CurrentPlayers = Room.CurrentPlayers % Room.MaxPlayers + 1;
+					FLanRoomDiscovery::WriteUpdatePayload(ERoomListChange::Updated, Room, Payload);
+					LiveBytes += WireBytes(Payload.Num());
+					Changes++;
+				}
+
+				if (bHeartbeat)
+				{
+					FLanRoomDiscovery::WriteUpdatePayload(ERoomListChange::Added, Room, Payload);
+					LiveBytes += WireBytes(Payload.Num());
+				}
+			}
+		}
+
+		Report.AddSection(FString::Printf(TEXT("live_list_%ds"), LiveWindowSeconds));
+		Report.AddInt(TEXT("player_changes"), Changes);
+		Report.AddInt(TEXT("poll_bytes"), PollBytes);
+		Report.AddInt(TEXT("subscription_bytes"), LiveBytes);
+		Report.AddFloat(TEXT("subscription_ratio"), PollBytes > 0 ? static_cast<double>(LiveBytes) / PollBytes : 0.0, 3);
+	}
+
+	struct FSocketStats
+	{
+		int32 Responders = 0;
+		int32 Expected = 0;
+		int32 Received = 0;
+		double SearchMs = 0.0;
+		bool bStarted = false;
+	};
+
+	FSocketStats RunSocketSearch(const FRoomQueryFilter& Filter, const TArray<FLanRoomAdvert>& Rooms, int32 NumResponders)
+	{
+		FSocketStats Stats;
+
+		TArray<TUniquePtr<FLanRoomDiscovery>> Hosts;
+		for (int32 i = 0; i < NumResponders; i++)
+		{
+			const FLanRoomAdvert Advert = Rooms[i];
+			TUniquePtr<FLanRoomDiscovery>& Host = Hosts.Add_GetRef(MakeUnique<FLanRoomDiscovery>());
+			if (!Host->StartHosting([Advert](FLanRoomAdvert& OutAdvert) { OutAdvert = Advert; return true; }))
+				return Stats;
+
+			Stats.Expected += Filter.MatchesRoom(Advert.Settings, Advert.CurrentPlayers, Advert.MaxPlayers) ? 1 : 0;
+			Stats.Responders++;
+		}
+
+		// Aucune room attendue : la recherche n'attendrait que son timeout
+		if (Stats.Expected == 0)
+			return Stats;
+
+		bool bFound = false;
+		double FoundSeconds = 0.0;
+		FLanRoomDiscovery Client;
+
+		const double Start = FPlatformTime::Seconds();
+		Stats.bStarted = Client.StartSearch(Filter, Stats.Expected, FOnLanRoomsFound::CreateLambda(
+			[&Stats, &bFound, &FoundSeconds](const TArray<FLanRoomAdvert>& Found)
+			{
+				FoundSeconds = FPlatformTime::Seconds();
+				Stats.Received = Found.Num();
+				bFound = true;
+			}));
+
+		double Last = Start;
+		while (Stats.bStarted && !bFound && FPlatformTime::Seconds() - Start < LiveSafetySeconds)
+		{
+			const double Now = FPlatformTime::Seconds();
+			const float DeltaTime = static_cast<float>(Now - Last);
+			Last = Now;
+
+			for (const TUniquePtr<FLanRoomDiscovery>& Host : Hosts)
+			{
+				Host->Tick(DeltaTime);
+			}
+			Client.Tick(DeltaTime);
+			FPlatformProcess::SleepNoStats(0.0f);
+		}
+
+		Stats.SearchMs = bFound ? (FoundSeconds - Start) * 1000.0 : LiveSafetySeconds * 1000.0;
+		return Stats;
+	}
+
+	void AppendSocketStats(FProfilingReport& Report, const TCHAR* Label, const FSocketStats& Stats)
+	{
+		Report.AddSection(FString::Printf(TEXT("socket_%s"), Label));
+		Report.AddInt(TEXT("responders"), Stats.Responders);
+		Report.AddInt(TEXT("expected_replies"), Stats.Expected);
+		Report.AddInt(TEXT("replies"), Stats.Received);
+		Report.AddFloat(TEXT("search_round_trip_ms"), Stats.SearchMs, 3);
+		Report.AddYesNo(TEXT("search_started"), Stats.bStarted);
+		Report.AddYesNo(TEXT("all_replies"), Stats.Expected > 0 && Stats.Received == Stats.Expected);
+	}
+
+	void RunLanDiscoveryBench(int32 NumRooms, int32 NumResponders, bool bExitWhenDone)
+	{
+		const int32 Seed = 4242;
+		FRandomStream Random(Seed);
+
+		TArray<FLanRoomAdvert> Rooms;
+		Rooms.Reserve(NumRooms);
+		int32 NumOneVsOne = 0;
+		for (int32 i = 0; i < NumRooms; i++)
+		{
+			FLanRoomAdvert& Room = Rooms.AddDefaulted_GetRef();
+			Room.Settings.RoomName = FString::Printf(TEXT("Room %03d"), i);
+			Room.Settings.GameMode = static_cast<EWormsGameMode>(Random.RandRange(0, static_cast<int32>(EWormsGameMode::Count) - 1));
+			Room.Settings.UnitLife = 100;
+			Room.Settings.UnitCount = Random.RandRange(1, 4);
+			Room.Settings.TurnsBeforeWater = 10;
+			Room.MaxPlayers = Room.Settings.GetMaxPlayers();
+			Room.CurrentPlayers = Random.RandRange(1, Room.MaxPlayers);
+			Room.HostAddress = FString::Printf(TEXT("192.168.%d.%d"), i / 250, 1 + i % 250);
+			Room.BeaconPort = LobbyConstants::BeaconPort;
+			NumOneVsOne += Room.Settings.GameMode == EWormsGameMode::OneVsOne ? 1 : 0;
+		}
+
+		FRoomQueryFilter OneVsOneOnly;
+		OneVsOneOnly.ModeMask = 0;
+		OneVsOneOnly.SetModeAllowed(EWormsGameMode::OneVsOne, true);
+
+		const FQueryStats All = RunQuery(FRoomQueryFilter(), Rooms);
+		const FQueryStats Filtered = RunQuery(OneVsOneOnly, Rooms);
+
+		// Vrais sockets, un jeu d'hôtes par requête (aucune réponse en retard de la précédente)
+		const int32 Responders = FMath::Clamp(NumResponders, 1, FMath::Min(NumRooms, MaxLiveResponders));
+		const FSocketStats SocketAll = RunSocketSearch(FRoomQueryFilter(), Rooms, Responders);
+		const FSocketStats SocketFiltered = RunSocketSearch(OneVsOneOnly, Rooms, Responders);
+
+		FProfilingReport Report(TEXT("LanDiscoveryBench"), 3, FString::Printf(TEXT("rooms=%d | seed=%d | rooms_1v1=%d | poll_s=%d | responders=%d"),
+			NumRooms, Seed, NumOneVsOne, PollSeconds, Responders));
+		AppendStats(Report, TEXT("unfiltered"), All, NumRooms);
+		AppendStats(Report, TEXT("filter_1v1"), Filtered, NumRooms);
+		Report.AddFloat(TEXT("reply_bytes_ratio"), All.ReplyBytes > 0 ? static_cast<double>(Filtered.ReplyBytes) / All.ReplyBytes : 0.0, 3);
+		AppendSocketStats(Report, TEXT("unfiltered"), SocketAll);
+		AppendSocketStats(Report, TEXT("filter_1v1"), SocketFiltered);
+		AppendLiveListStats(Report, Rooms, Random);
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommand GLanDiscoveryBenchCommand(
+	TEXT("Worms.LanDiscoveryBench"),
+	TEXT("Requete LAN filtree et liste en direct sur N rooms simulees, puis aller-retour broadcast reel sur quelques hotes locaux. Usage: Worms.LanDiscoveryBench [NumRooms] [Responders] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Rooms = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500;
+		const int32 Responders = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		RunLanDiscoveryBench(Rooms > 0 ? Rooms : 500, Responders > 0 ? Responders : MaxLiveResponders, bExit);
+	})
+);
@@ -0,0 +1,390 @@
+#include "Profiling/LockstepBenchmark.h"
+#include "Actors/CustomPaperCharacter.h"
+#include "Engine/ReplicatedState.h"
+#include "Profiling/ProfilingReport.h"
+#include "UObject/CoreNet.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	// Garde-fou : une partie scriptée ne doit jamais dépasser ce nombre de ticks
+	constexpr uint32 MaxBenchFrames = 60 * 60 * LockstepConstants::TickRate;
+
+	// Modèle réseau : latence aller simple fixe (~33 ms), sans perte
+	constexpr uint32 BenchLatencyTicks = 2;
+
+	// Renvoi sans nouveauté, comme InputResendSeconds du subsystem (100 ms)
+	constexpr uint32 BenchResendTicks = LockstepConstants::TickRate / 10;
+
+	template<typename TPacket>
+	int32 GetPacketBits(const TPacket& Packet)
+	{
+		FNetBitWriter Writer(nullptr, 4096);
+		TPacket Copy = Packet;
+		bool bSuccess = false;
+		Copy.NetSerialize(Writer, nullptr, bSuccess);
+		return static_cast<int32>(Writer.GetNumBits());
+	}
+
+	int32 GetRepMovementBits(const FLockstepWorm& Worm)
+	{
+		FRepMovement Movement;
+		Movement.Location = Worm.Position.ToVector();
+		Movement.LinearVelocity = Worm.Velocity.ToVector();
+		Movement.bSimulatedPhysicSleep = false;
+
+		FNetBitWriter Writer(nullptr, 1024);
+		bool bSuccess = false;
+		Movement.NetSerialize(Writer, nullptr, bSuccess);
+		return static_cast<int32>(Writer.GetNumBits());
+	}
+
+	struct FRunOutput
+	{
+		TArray<uint32> TurnChecksums;
+		uint32 NumFrames = 0;
+		double Seconds = 0.0;
+		uint64 LockstepBitsUp = 0;
+		uint64 LockstepBitsDown = 0;
+		uint32 NetStallTicks = 0;
+		double RepMovementBits = 0.0;
+	};
+
+	struct FBenchPacket
+	{
+		uint32 ArrivalTick = 0;
+		uint32 FirstFrame = 0;
+		uint32 NumFrames = 0;
+		uint32 AckFrame = 0;
+	};
+
+	// Un client distant et son état côté serveur (mêmes règles que ULockstepSubsystem)
+	struct FBenchClient
+	{
+		uint32 Frame = 0;
+		uint32 NextSample = LockstepConstants::InputDelayFrames;
+		uint32 FirstUnconfirmed = LockstepConstants::InputDelayFrames;
+		uint32 HeldUntil = LockstepConstants::InputDelayFrames;
+		bool bDirty = false;
+		uint32 LastSendTick = 0;
+		TArray<FBenchPacket> Uplink;
+
+		uint32 ReceivedUntil = LockstepConstants::InputDelayFrames;
+		uint32 AckFrame = LockstepConstants::InputDelayFrames;
+		uint32 SentUntil = LockstepConstants::InputDelayFrames;
+		uint32 LastServerSendTick = 0;
+		TArray<FBenchPacket> Downlink;
+	};
+
+	/**
+	 * Rejoue les inputs de la partie sur le protocole réel : hôte = joueur 0,
+	 * un FLockstepInputPacket et un FLockstepFramePacket par Tick et par client
+	 * au plus, mesurés par NetSerialize. Un client bloqué (frame pas encore
+	 * arrivée) n'envoie qu'un accusé ou un renvoi périodique.
+	 */
+	void MeasureLockstepTraffic(const TArray<FLockstepInput>& FrameInputs, int32 NumPlayers, FRunOutput& Out)
+	{
+		const uint32 Delay = LockstepConstants::InputDelayFrames;
+		const uint32 NumFrames = FrameInputs.Num() / NumPlayers;
+
+		auto GetInput = [&](uint32 Frame, int32 Player)
+		{
+			const int32 Index = static_cast<int32>(Frame) * NumPlayers + Player;
+			return FrameInputs.IsValidIndex(Index) ? FrameInputs[Index] : FLockstepInput();
+		};
+
+		TArray<FBenchClient> Clients;
+		Clients.SetNum(NumPlayers - 1);
+		uint32 HostFrame = 0;
+		uint32 HostNextSample = Delay;
+		uint32 NextConfirm = Delay;
+
+		auto TryConfirm = [&]()
+		{
+			while (NextConfirm < HostNextSample)
+			{
+				for (const FBenchClient& Client : Clients)
+				{
+					if (Client.ReceivedUntil <= NextConfirm)
+						return;
+				}
+				NextConfirm++;
+			}
+		};
+
+		for (uint32 Tick = 0; Tick < MaxBenchFrames * 4; Tick++)
+		{
+			bool bDone = HostFrame >= NumFrames;
+			for (const FBenchClient& Client : Clients)
+			{
+				bDone &= Client.Frame >= NumFrames;
+			}
+			if (bDone)
+				break;
+
+			// RPC arrivés avant le Tick
+			for (FBenchClient& Client : Clients)
+			{
+				while (Client.Uplink.Num() > 0 && Client.Uplink[0].ArrivalTick <= Tick)
+				{
+					const FBenchPacket Packet = Client.Uplink[0];
+					Client.Uplink.RemoveAt(0);
+					Client.ReceivedUntil = FMath::Max(Client.ReceivedUntil, Packet.FirstFrame + Packet.NumFrames);
+					Client.AckFrame = FMath::Clamp(Packet.AckFrame, Client.AckFrame, NextConfirm);
+				}
+				while (Client.Downlink.Num() > 0 && Client.Downlink[0].ArrivalTick <= Tick)
+				{
+					const FBenchPacket Packet = Client.Downlink[0];
+					Client.Downlink.RemoveAt(0);
+					Client.HeldUntil = FMath::Max(Client.HeldUntil, Packet.FirstFrame + Packet.NumFrames);
+					Client.FirstUnconfirmed = FMath::Max(Client.FirstUnconfirmed, Packet.FirstFrame + Packet.NumFrames);
+					Client.bDirty = true;
+				}
+			}
+			TryConfirm();
+
+			// Hôte : son input atteint le serveur sans réseau
+			if (HostFrame < NumFrames && (HostFrame < Delay || HostFrame < NextConfirm))
+			{
+				HostNextSample = HostFrame + Delay + 1;
+				HostFrame++;
+				TryConfirm();
+			}
+
+			// Clients : un pas si la frame est là, puis SendLocalInputs
+			bool bStalled = false;
+			for (int32 c = 0; c < Clients.Num(); c++)
+			{
+				FBenchClient& Client = Clients[c];
+				if (Client.Frame < NumFrames)
+				{
+					if (Client.Frame < Delay || Client.Frame < Client.HeldUntil)
+					{
+						Client.NextSample = Client.Frame + Delay + 1;
+						Client.Frame++;
+						Client.bDirty = true;
+					}
+					else
+					{
+						bStalled = true;
+					}
+				}
+
+				if (!Client.bDirty && Tick - Client.LastSendTick < BenchResendTicks)
+					continue;
+
+				FLockstepInputPacket Packet;
+				Packet.FirstFrame = Client.FirstUnconfirmed;
+				Packet.AckFrame = FMath::Max3(Client.HeldUntil, Client.Frame, Delay);
+				const uint32 Last = FMath::Min(Client.NextSample, Client.FirstUnconfirmed + LockstepConstants::MaxPacketInputs);
+				for (uint32 Frame = Client.FirstUnconfirmed; Frame < Last; Frame++)
+				{
+					Packet.Inputs.Add(GetInput(Frame, c + 1));
+				}
+
+				Out.LockstepBitsUp += Align(GetPacketBits(Packet), 8);
+				Client.Uplink.Add({ Tick + BenchLatencyTicks, Packet.FirstFrame, static_cast<uint32>(Packet.Inputs.Num()), Packet.AckFrame });
+				Client.bDirty = false;
+				Client.LastSendTick = Tick;
+			}
+			Out.NetStallTicks += bStalled ? 1 : 0;
+
+			// Serveur : ServerSendConfirmedFrames
+			for (FBenchClient& Client : Clients)
+			{
+				if (Client.AckFrame >= NextConfirm)
+					continue;
+				if (Client.SentUntil == NextConfirm && Tick - Client.LastServerSendTick < BenchResendTicks)
+					continue;
+
+				FLockstepFramePacket Packet;
+				Packet.FirstFrame = Client.AckFrame;
+				Packet.NumPlayers = static_cast<uint8>(NumPlayers);
+				const uint32 Last = FMath::Min(NextConfirm, Client.AckFrame + LockstepConstants::MaxPacketFrames);
+				for (uint32 Frame = Client.AckFrame; Frame < Last; Frame++)
+				{
+					for (int32 p = 0; p < NumPlayers; p++)
+					{
+						Packet.Inputs.Add(GetInput(Frame, p));
+					}
+				}
+
+				Out.LockstepBitsDown += Align(GetPacketBits(Packet), 8);
+				Client.Downlink.Add({ Tick + BenchLatencyTicks, Packet.FirstFrame, Last - Packet.FirstFrame, 0 });
+				Client.SentUntil = NextConfirm;
+				Client.LastServerSendTick = Tick;
+			}
+		}
+	}
+
+	FRunOutput RunOnce(const FLockstepMatchConfig& Config, int32 NumTurns, bool bMeasureBandwidth)
+	{
+		FRunOutput Out;
+		FLockstepSimulation Sim;
+		Sim.Init(Config);
+
+		const int32 NumPlayers = Sim.GetConfig().NumPlayers;
+		const int32 RemoteClients = FMath::Max(1, NumPlayers - 1);
+		const float UpdatesPerTick = FMath::Min(GetDefault<ACustomPaperCharacter>()->GetNetUpdateFrequency(), static_cast<float>(LockstepConstants::TickRate))
+			/ LockstepConstants::TickRate;
+
+		TArray<FLockstepInput> Inputs;
+		TArray<FLockstepInput> FrameInputs;
+		TArray<FFixedVec2> PreviousPositions;
+
+		const double Start = FPlatformTime::Seconds();
+		while (Out.TurnChecksums.Num() < NumTurns && Out.NumFrames < MaxBenchFrames && Sim.CountAlivePlayers() > 1)
+		{
+			FLockstepBenchmark::MakeScriptedInputs(Sim.GetState(), NumPlayers, Inputs);
+
+			if (bMeasureBandwidth)
+			{
+				PreviousPositions.Reset();
+				for (const FLockstepWorm& Worm : Sim.GetState().Worms)
+				{
+					PreviousPositions.Add(Worm.Position);
+				}
+			}
+
+			if (Sim.Step(Inputs))
+			{
+				Out.TurnChecksums.Add(Sim.ComputeChecksum());
+			}
+			Out.NumFrames++;
+
+			if (!bMeasureBandwidth)
+				continue;
+
+			// ----- Lockstep : rejoué sur le modèle réseau en fin de partie -----
+			FrameInputs.Append(Inputs);
+
+			// ----- Référence : FRepMovement de chaque worm qui a bougé -----
+			const TArray<FLockstepWorm>& Worms = Sim.GetState().Worms;
+			for (int32 i = 0; i < Worms.Num(); i++)
+			{
+				if (Worms[i].Position == PreviousPositions[i])
+					continue;
+
+				const int32 Bits = Align(GetRepMovementBits(Worms[i]), 8);
+				Out.RepMovementBits += Bits * UpdatesPerTick * RemoteClients;
+			}
+		}
+		Out.Seconds = FPlatformTime::Seconds() - Start;
+
+		if (bMeasureBandwidth && NumPlayers > 1)
+		{
+			MeasureLockstepTraffic(FrameInputs, NumPlayers, Out);
+		}
+		return Out;
+	}
+}
+
+// ============================================================
+//  Inputs scriptés
+// ============================================================
+
+void FLockstepBenchmark::MakeScriptedInputs(const FLockstepState& State, int32 NumPlayers, TArray<FLockstepInput>& OutInputs)
+{
+	OutInputs.Reset();
+	OutInputs.SetNum(NumPlayers);
+	if (!OutInputs.IsValidIndex(State.ActivePlayer))
+		return;
+
+	// Marche une seconde, saute, remarche, puis tire ; direction et visée varient par tour
+	FLockstepInput& Input = OutInputs[State.ActivePlayer];
+	const int32 Tick = State.TurnTick;
+	const uint32 Hash = static_cast<uint32>(State.Turn) * 2654435761u;
+	const int8 Direction = (State.Turn & 1) ? -1 : 1;
+
+	if (Tick < 60 || (Tick > 60 && Tick < 120))
+	{
+		Input.MoveAxis = Direction;
+	}
+	if (Tick == 60)
+	{
+		Input.MoveAxis = Direction;
+		Input.Buttons |= LockstepConstants::Button_Jump;
+	}
+	if (Tick == 150)
+	{
+		// Visée entre 20° et 160°, puissance 140..255
+		Input.Buttons |= LockstepConstants::Button_Fire;
+		Input.AimAngle = static_cast<uint16>(3641 + (Hash >> 8) % 25486);
+		Input.Power = static_cast<uint8>(140 + (Hash >> 20) % 116);
+	}
+}
+
+// ============================================================
+//  Run
+// ============================================================
+
+FLockstepBenchResult FLockstepBenchmark::Run(const FLockstepMatchConfig& Config, int32 NumTurns)
+{
+	FLockstepBenchResult Result;
+
+	// Premier run : mesure de bande passante ; second : timing pur + déterminisme
+	const FRunOutput First = RunOnce(Config, NumTurns, true);
+	const FRunOutput Second = RunOnce(Config, NumTurns, false);
+
+	Result.NumTurns = First.TurnChecksums.Num();
+	Result.NumFrames = Second.NumFrames;
+	Result.bDeterministic = First.TurnChecksums == Second.TurnChecksums && First.NumFrames == Second.NumFrames;
+	Result.SimMicrosecondsPerTick = Second.NumFrames > 0 ? Second.Seconds * 1e6 / Second.NumFrames : 0.0;
+
+	const double Turns = FMath::Max(1, Result.NumTurns);
+	Result.LockstepBytesUpPerTurn = First.LockstepBitsUp / 8.0 / Turns;
+	Result.LockstepBytesDownPerTurn = First.LockstepBitsDown / 8.0 / Turns;
+	Result.RepMovementBytesPerTurn = First.RepMovementBits / 8.0 / Turns;
+	Result.NetStallTicks = First.NetStallTicks;
+	Result.NetUpdateFrequency = GetDefault<ACustomPaperCharacter>()->GetNetUpdateFrequency();
+
+	FLockstepWorm Sample;
+	Sample.Position = FFixedVec2(FFixed::FromInt(2048), FFixed::FromInt(900));
+	Sample.Velocity = FFixedVec2(FFixed::FromInt(600), FFixed::FromInt(-300));
+	Result.RepMovementBitsPerUpdate = GetRepMovementBits(Sample);
+
+	return Result;
+}
+
+void FLockstepBenchmark::WriteReport(const FLockstepMatchConfig& Config, const FLockstepBenchResult& R, bool bExitWhenDone)
+{
+	const double LockstepTotal = R.LockstepBytesUpPerTurn + R.LockstepBytesDownPerTurn;
+
+	FProfilingReport Report(TEXT("LockstepBench"), 2, FString::Printf(TEXT("players=%d | units=%d | seed=%d | tick_hz=%d | input_delay=%u | latency_ticks=%u"),
+		Config.NumPlayers, Config.UnitsPerPlayer, Config.Seed, LockstepConstants::TickRate, LockstepConstants::InputDelayFrames, BenchLatencyTicks), 28);
+	Report.AddInt(TEXT("turns"), R.NumTurns);
+	Report.AddInt(TEXT("frames"), R.NumFrames);
+	Report.AddYesNo(TEXT("deterministic"), R.bDeterministic);
+	Report.AddFloat(TEXT("sim_us_per_tick"), R.SimMicrosecondsPerTick, 2);
+	Report.AddFloat(TEXT("lockstep_up_B_per_turn"), R.LockstepBytesUpPerTurn, 1);
+	Report.AddFloat(TEXT("lockstep_down_B_per_turn"), R.LockstepBytesDownPerTurn, 1);
+	Report.AddFloat(TEXT("lockstep_total_B_per_turn"), LockstepTotal, 1);
+	Report.AddInt(TEXT("net_stall_ticks"), R.NetStallTicks);
+	Report.AddInt(TEXT("repmovement_bits_per_update"), R.RepMovementBitsPerUpdate);
+	Report.AddFloat(TEXT("net_update_frequency"), R.NetUpdateFrequency, 1);
+	Report.AddFloat(TEXT("repmovement_B_per_turn"), R.RepMovementBytesPerTurn, 1);
+	Report.AddFloat(TEXT("ratio_repmovement_lockstep"), LockstepTotal > 0.0 ? R.RepMovementBytesPerTurn / LockstepTotal : 0.0, 2);
+	Report.WriteAndMaybeExit(bExitWhenDone);
+}
+
+// ============================================================
+//  Commande console
+// ============================================================
+
+static FAutoConsoleCommand GLockstepBenchCommand(
+	TEXT("Worms.LockstepBench"),
+	TEXT("Determinisme, cout CPU et octets/tour du lockstep vs SetReplicateMovement. Usage: Worms.LockstepBench [NumTurns] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Turns = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+
+		FLockstepMatchConfig Config;
+		Config.NumPlayers = 4;
+		Config.UnitsPerPlayer = 2;
+		Config.Seed = 1234;
+
+		const FLockstepBenchResult Result = FLockstepBenchmark::Run(Config, Turns > 0 ? Turns : 20);
+		FLockstepBenchmark::WriteReport(Config, Result, bExit);
+	})
+);
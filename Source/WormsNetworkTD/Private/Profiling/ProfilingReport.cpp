@@ -0,0 +1,90 @@
+#include "Profiling/ProfilingReport.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Printf n'accepte que des formats littéraux : une précision par cas
+	FString FormatFixed(double Value, int32 Decimals)
+	{
+		switch (Decimals)
+		{
+		case 0: return FString::Printf(TEXT("%.0f"), Value);
+		case 1: return FString::Printf(TEXT("%.1f"), Value);
+		case 2: return FString::Printf(TEXT("%.2f"), Value);
+		case 3: return FString::Printf(TEXT("%.3f"), Value);
+		default: return FString::Printf(TEXT("%.4f"), Value);
+		}
+	}
+}
+
+FProfilingReport::FProfilingReport(const TCHAR* InName, int32 Version, const FString& Fields, int32 InKeyWidth)
+	: Name(InName)
+	, KeyWidth(InKeyWidth)
+{
+	Text = FString::Printf(TEXT("# %s v%d | %s\n"), InName, Version, *Fields);
+}
+
+void FProfilingReport::AddSection(const FString& Label)
+{
+	Text += FString::Printf(TEXT("[%s]\n"), *Label);
+}
+
+void FProfilingReport::AddInt(const TCHAR* Key, int64 Value)
+{
+	AddText(Key, FString::Printf(TEXT("%lld"), Value));
+}
+
+void FProfilingReport::AddFloat(const TCHAR* Key, double Value, int32 Decimals)
+{
+	AddText(Key, FormatFixed(Value, Decimals));
+}
+
+void FProfilingReport::AddText(const TCHAR* Key, const FString& Value)
+{
+	// Clé alignée à gauche, valeur à droite sur 12 colonnes
+	Text += TEXT("  ") + FString(Key).RightPad(KeyWidth) + TEXT(" ") + Value.LeftPad(12) + TEXT("\n");
+}
+
+void FProfilingReport::AddYesNo(const TCHAR* Key, bool bValue)
+{
+	AddText(Key, bValue ? TEXT("yes") : TEXT("NO"));
+}
+
+void FProfilingReport::AddLine(const FString& Line)
+{
+	Text += Line;
+	Text += TEXT("\n");
+}
+
+FString FProfilingReport::Write() const
+{
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), Name + TEXT(".txt"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	FFileHelper::SaveStringToFile(Text, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+	UE_LOG(LogTemp, Warning, TEXT("%s: rapport ecrit dans %s\n%s"), *Name, *Path, *Text);
+	return Path;
+}
+
+void FProfilingReport::WriteAndMaybeExit(bool bExitWhenDone) const
+{
+	Write();
+
+	if (bExitWhenDone)
+	{
+		RequestEngineExit(*FString::Printf(TEXT("%s termine"), *Name));
+	}
+}
+
+bool FProfilingReport::HasExitArg(const TArray<FString>& Args)
+{
+	return Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("exit"), ESearchCase::IgnoreCase); });
+}
+
+double FProfilingReport::MedianMs(TArray<double>& Samples)
+{
+	Samples.Sort();
+	return Samples.Num() > 0 ? Samples[Samples.Num() / 2] * 1000.0 : 0.0;
+}
@@ -0,0 +1,150 @@
+#include "Simulation/WormSnapshot.h"
+#include "Actors/CustomPaperCharacter.h"
+#include "Profiling/ProfilingReport.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+// ============================================================
+//  Microbenchmark des snapshots de worm
+//
+//  Coût unitaire, en ns, des opérations faites à chaque tick
+//  (capture + ajout à l'historique) et lors d'une validation
+//  (échantillonnage interpolé, retour arrière puis restauration).
+//  La partie historique tourne hors monde ; capture et restauration
+//  utilisent les worms présents dans le monde courant, s'il y en a.
+//
+//  Rapport : Saved/Profiling/SnapshotBench.txt
+//  Console : Worms.SnapshotBench [Iterations] [exit]
+// ============================================================
+namespace
+{
+	constexpr int32 NumHistories = 64;
+
+	double NsPerOp(double Seconds, int64 Ops)
+	{
+		return Ops > 0 ? Seconds * 1e9 / Ops : 0.0;
+	}
+
+	void RunSnapshotBench(UWorld* World, int32 Iterations, bool bExitWhenDone)
+	{
+		FRandomStream Random(1234);
+		FProfilingReport Report(TEXT("SnapshotBench"), 1, FString::Printf(TEXT("iterations=%d | histories=%d | capacity=%d | snapshot_bytes=%d"),
+			Iterations, NumHistories, FWormSnapshotHistory::Capacity, static_cast<int32>(sizeof(FWormSnapshot))));
+
+		// ----- Historique (hors monde) -----
+		TArray<FWormSnapshotHistory> Histories;
+		Histories.SetNum(NumHistories);
+
+		FWormSnapshot Snapshot;
+		Snapshot.Health = 100;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 It = 0; It < Iterations; It++)
+		{
+			Snapshot.Time = It / 60.0;
+			Snapshot.Location.X = static_cast<float>(It);
+			Histories[It % NumHistories].Push(Snapshot);
+		}
+		const double PushNs = NsPerOp(FPlatformTime::Seconds() - Start, Iterations);
+
+		// Remplissage complet pour échantillonner sur tout l'anneau
+		for (FWormSnapshotHistory& History : Histories)
+		{
+			History.Reset();
+			for (int32 i = 0; i < FWormSnapshotHistory::Capacity; i++)
+			{
+				Snapshot.Time = i / 60.0;
+				History.Push(Snapshot);
+			}
+		}
+
+		const double Span = (FWormSnapshotHistory::Capacity - 1) / 60.0;
+		TArray<double> Times;
+		Times.SetNum(1024);
+		for (double& Time : Times)
+		{
+			Time = Random.FRandRange(0.f, static_cast<float>(Span));
+		}
+
+		int32 Found = 0;
+		FWormSnapshot Sampled;
+		Start = FPlatformTime::Seconds();
+		for (int32 It = 0; It < Iterations; It++)
+		{
+			Found += Histories[It % NumHistories].Sample(Times[It % Times.Num()], Sampled) ? 1 : 0;
+		}
+		const double SampleNs = NsPerOp(FPlatformTime::Seconds() - Start, Iterations);
+
+		Report.AddFloat(TEXT("push_ns"), PushNs, 2);
+		Report.AddFloat(TEXT("sample_ns"), SampleNs, 2);
+		Report.AddInt(TEXT("sample_found"), Found);
+
+		// ----- Capture / restauration (worms du monde) -----
+		TArray<ACustomPaperCharacter*> Worms;
+		if (World)
+		{
+			for (TActorIterator<ACustomPaperCharacter> It(World); It; ++It)
+			{
+				Worms.Add(*It);
+			}
+		}
+
+		if (Worms.Num() > 0)
+		{
+			const int32 WormIterations = FMath::Max(1, Iterations / 10);
+
+			Start = FPlatformTime::Seconds();
+			for (int32 It = 0; It < WormIterations; It++)
+			{
+				Snapshot = Worms[It % Worms.Num()]->CaptureSnapshot();
+			}
+			const double CaptureNs = NsPerOp(FPlatformTime::Seconds() - Start, WormIterations);
+
+			// Restauration sur place : l'état du monde ne change pas
+			TArray<FWormSnapshot> Current;
+			for (const ACustomPaperCharacter* Worm : Worms)
+			{
+				Current.Add(Worm->CaptureSnapshot());
+			}
+
+			Start = FPlatformTime::Seconds();
+			for (int32 It = 0; It < WormIterations; It++)
+			{
+				const int32 Index = It % Worms.Num();
+				Worms[Index]->RestoreSnapshot(Current[Index], false);
+			}
+			const double RestoreNs = NsPerOp(FPlatformTime::Seconds() - Start, WormIterations);
+
+			Start = FPlatformTime::Seconds();
+			for (int32 It = 0; It < WormIterations; It++)
+			{
+				const int32 Index = It % Worms.Num();
+				Worms[Index]->RestoreSnapshot(Current[Index], true);
+			}
+			const double RestoreFullNs = NsPerOp(FPlatformTime::Seconds() - Start, WormIterations);
+
+			Report.AddInt(TEXT("world_worms"), Worms.Num());
+			Report.AddFloat(TEXT("capture_ns"), CaptureNs, 2);
+			Report.AddFloat(TEXT("restore_move_ns"), RestoreNs, 2);
+			Report.AddFloat(TEXT("restore_full_ns"), RestoreFullNs, 2);
+		}
+		else
+		{
+			Report.AddInt(TEXT("world_worms"), 0);
+		}
+
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSnapshotBenchCommand(
+	TEXT("Worms.SnapshotBench"),
+	TEXT("Cout en ns des snapshots de worm (historique, capture, restauration). Usage: Worms.SnapshotBench [Iterations] [exit]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		RunSnapshotBench(World, Iterations > 0 ? Iterations : 1000000, bExit);
+	})
+);
@@ -0,0 +1,114 @@
+#include "Simulation/SpatialHash2D.h"
+#include "Profiling/ProfilingReport.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+// ============================================================
+//  Benchmark spatial hash (hors ligne, sans monde)
+//
+//  Scénario cible : une bombe à fragmentation = 100 explosions
+//  simultanées contre 64 worms, objectif < 1 ms par lot.
+//  Compare au parcours brut (ce que ferait une boucle sur tous les
+//  worms par explosion) et vérifie que les deux trouvent les mêmes hits.
+//
+//  Rapport : Saved/Profiling/SpatialHashBench.txt
+//  Console : Worms.SpatialHashBench [NumBlasts] [NumWorms] [exit]
+// ============================================================
+namespace
+{
+	constexpr int32 SpatialHashIterations = 200;
+	constexpr float BenchMapWidth = 4096.f;
+	constexpr float BenchMapHeight = 2048.f;
+	constexpr double TargetMs = 1.0;
+
+	void RunSpatialHashBench(int32 NumBlasts, int32 NumWorms, bool bExitWhenDone)
+	{
+		FRandomStream Random(1234);
+		FSpatialHash2D Hash(128.f, 1024);
+
+		TArray<FVector2D> Worms;
+		for (int32 i = 0; i < NumWorms; i++)
+		{
+			Worms.Add(FVector2D(Random.FRandRange(0.f, BenchMapWidth), Random.FRandRange(0.f, BenchMapHeight * 0.5f)));
+			Hash.Add(Worms.Last(), SpatialCategory::Worm, i);
+		}
+
+		// Fragments regroupés autour de quelques impacts, comme une vraie grappe
+		TArray<FSpatialBlast> Blasts;
+		for (int32 i = 0; i < NumBlasts; i++)
+		{
+			const FVector2D Impact = Worms[(i / 10) % FMath::Max(1, NumWorms)];
+			FSpatialBlast& Blast = Blasts.AddDefaulted_GetRef();
+			Blast.Center = Impact + FVector2D(Random.FRandRange(-200.f, 200.f), Random.FRandRange(-100.f, 100.f));
+			Blast.Radius = Random.FRandRange(48.f, 160.f);
+			Blast.CategoryMask = SpatialCategory::Worm;
+		}
+
+		// ----- Requêtes groupées -----
+		FSpatialBatchResult Result;
+		TArray<double> HashSamples;
+		for (int32 It = 0; It < SpatialHashIterations; It++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Hash.QueryRadiusBatch(Blasts, Result);
+			HashSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		// ----- Référence : parcours brut -----
+		int32 BruteHits = 0;
+		TArray<double> BruteSamples;
+		for (int32 It = 0; It < SpatialHashIterations; It++)
+		{
+			BruteHits = 0;
+			const double Start = FPlatformTime::Seconds();
+			for (const FSpatialBlast& Blast : Blasts)
+			{
+				const double RadiusSq = static_cast<double>(Blast.Radius) * Blast.Radius;
+				for (const FVector2D& Worm : Worms)
+				{
+					BruteHits += FVector2D::DistSquared(Worm, Blast.Center) <= RadiusSq ? 1 : 0;
+				}
+			}
+			BruteSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		// ----- Mises à jour incrémentales (tous les worms bougent un peu) -----
+		TArray<double> UpdateSamples;
+		for (int32 It = 0; It < SpatialHashIterations; It++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumWorms; i++)
+			{
+				Worms[i] += FVector2D(Random.FRandRange(-10.f, 10.f), Random.FRandRange(-10.f, 10.f));
+				Hash.Update(i, Worms[i]);
+			}
+			UpdateSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		const double HashMs = FProfilingReport::MedianMs(HashSamples);
+		const double BruteMs = FProfilingReport::MedianMs(BruteSamples);
+		const double UpdateMs = FProfilingReport::MedianMs(UpdateSamples);
+
+		FProfilingReport Report(TEXT("SpatialHashBench"), 1, FString::Printf(TEXT("blasts=%d | worms=%d | iterations=%d | target_ms=%.1f"),
+			NumBlasts, NumWorms, SpatialHashIterations, TargetMs));
+		Report.AddFloat(TEXT("batch_query_p50_ms"), HashMs, 4);
+		Report.AddFloat(TEXT("brute_force_p50_ms"), BruteMs, 4);
+		Report.AddFloat(TEXT("update_all_p50_ms"), UpdateMs, 4);
+		Report.AddInt(TEXT("hits"), Result.Hits.Num());
+		Report.AddYesNo(TEXT("hits_match_brute"), Result.Hits.Num() == BruteHits);
+		Report.AddYesNo(TEXT("under_target"), HashMs < TargetMs);
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommand GSpatialHashBenchCommand(
+	TEXT("Worms.SpatialHashBench"),
+	TEXT("Requetes d'explosions groupees sur le spatial hash vs parcours brut. Usage: Worms.SpatialHashBench [NumBlasts] [NumWorms] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Blasts = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		const int32 Worms = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 64;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		RunSpatialHashBench(Blasts > 0 ? Blasts : 100, Worms > 0 ? Worms : 64, bExit);
+	})
+);
@@ -0,0 +1,122 @@
+#include "Profiling/StartupTrace.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/App.h"
+#include "CoreGlobals.h"
+
+TArray<FStartupTrace::FMarker> FStartupTrace::Markers;
+FCriticalSection FStartupTrace::MarkersLock;
+bool FStartupTrace::bFinished = false;
+
+// ============================================================
+//  Marqueurs
+// ============================================================
+
+void FStartupTrace::Mark(const TCHAR* Name)
+{
+	const double Now = FPlatformTime::Seconds() - GStartTime;
+
+	FScopeLock Lock(&MarkersLock);
+	if (bFinished)
+		return;
+
+	for (const FMarker& Existing : Markers)
+	{
+		if (Existing.Name == Name)
+			return;
+	}
+
+	FMarker& Marker = Markers.AddDefaulted_GetRef();
+	Marker.Name = Name;
+	Marker.SecondsSinceStart = Now;
+	Marker.ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	UE_LOG(LogTemp, Log, TEXT("StartupTrace: %s a %.2f ms"), Name, Now * 1000.0);
+}
+
+void FStartupTrace::Finish()
+{
+	{
+		FScopeLock Lock(&MarkersLock);
+		if (bFinished)
+			return;
+	}
+
+	Mark(TEXT("MenuInteractive"));
+
+	{
+		FScopeLock Lock(&MarkersLock);
+		bFinished = true;
+	}
+
+	const bool bExit = FParse::Param(FCommandLine::Get(), TEXT("ExitAfterStartupTrace"));
+	if (bExit || FParse::Param(FCommandLine::Get(), TEXT("StartupTrace")))
+	{
+		const FString Path = Export();
+		UE_LOG(LogTemp, Warning, TEXT("StartupTrace: trace exportee dans %s"), *Path);
+	}
+
+	if (bExit)
+	{
+		RequestEngineExit(TEXT("ExitAfterStartupTrace"));
+	}
+}
+
+// ============================================================
+//  Export JSON
+// ============================================================
+
+FString FStartupTrace::Export()
+{
+	TArray<FMarker> Snapshot;
+	{
+		FScopeLock Lock(&MarkersLock);
+		Snapshot = Markers;
+	}
+
+	Snapshot.Sort([](const FMarker& A, const FMarker& B) { return A.SecondsSinceStart < B.SecondsSinceStart; });
+
+	// Format volontairement plat et stable pour être diffé / parsé par les scripts de bench
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"version\": 1,\n\t\"headless\": %s,\n"),
+		FApp::CanEverRender() ? TEXT("false") : TEXT("true"));
+	Json += TEXT("\t\"markers\": [\n");
+
+	double Previous = 0.0;
+	for (int32 i = 0; i < Snapshot.Num(); i++)
+	{
+		const FMarker& Marker = Snapshot[i];
+		Json += FString::Printf(TEXT("\t\t{ \"name\": \"%s\", \"ms\": %.3f, \"delta_ms\": %.3f, \"thread\": %u }%s\n"),
+			*Marker.Name,
+			Marker.SecondsSinceStart * 1000.0,
+			(Marker.SecondsSinceStart - Previous) * 1000.0,
+			Marker.ThreadId,
+			i + 1 < Snapshot.Num() ? TEXT(",") : TEXT(""));
+		Previous = Marker.SecondsSinceStart;
+	}
+	Json += TEXT("\t]\n}\n");
+
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), TEXT("StartupTrace.json"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	FFileHelper::SaveStringToFile(Json, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	return Path;
+}
+
+// ============================================================
+//  Commande console
+// ============================================================
+
+static FAutoConsoleCommand GStartupTraceDumpCommand(
+	TEXT("Worms.StartupTrace.Dump"),
+	TEXT("Exporte la trace de demarrage dans Saved/Profiling/StartupTrace.json"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		UE_LOG(LogTemp, Warning, TEXT("StartupTrace: trace exportee dans %s"), *FStartupTrace::Export());
+	})
+);
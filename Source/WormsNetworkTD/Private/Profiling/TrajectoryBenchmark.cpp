@@ -0,0 +1,134 @@
+#include "Simulation/TrajectorySolver.h"
+#include "Simulation/LockstepSimulation.h"
+#include "Profiling/ProfilingReport.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================
+//  Benchmark trajectoires (hors ligne, sans monde)
+//
+//  Terrain réel : celui généré par FLockstepSimulation (graine fixe).
+//   - aperçu : un tir complet avec points, objectif < 0.2 ms par frame,
+//   - bots : recherche sur 100 x 100 = 10k candidats, SIMD vs scalaire,
+//     objectif < 16 ms (une frame : le bot vise sans étaler la recherche),
+//   - vérifie que SIMD et scalaire donnent exactement les mêmes impacts.
+//
+//  Rapport : Saved/Profiling/TrajectoryBench.txt
+//  Console : Worms.TrajectoryBench [AngleSteps] [PowerSteps] [exit]
+// ============================================================
+namespace
+{
+	constexpr int32 BatchIterations = 20;
+	constexpr int32 PreviewIterations = 500;
+	constexpr double PreviewTargetMs = 0.2;
+	constexpr double SearchTargetMs = 16.0;
+
+	void RunTrajectoryBench(int32 AngleSteps, int32 PowerSteps, bool bExitWhenDone)
+	{
+		FLockstepMatchConfig Config;
+		Config.Seed = 1234;
+		FLockstepSimulation Sim;
+		Sim.Init(Config);
+
+		const FLockstepState& State = Sim.GetState();
+		const FTerrainMask& Terrain = State.Terrain;
+
+		// Tireur = premier worm, cible = dernier
+		FTrajectoryParams Params;
+		Params.Origin = FVector2D(State.Worms[0].Position.X.ToFloat(), State.Worms[0].Position.Z.ToFloat());
+		Params.Wind = 120.f;
+		const FVector2D Target(State.Worms.Last().Position.X.ToFloat(), State.Worms.Last().Position.Z.ToFloat());
+
+		// ----- Aperçu -----
+		TArray<FVector2D> Points;
+		TArray<double> PreviewSamples;
+		for (int32 It = 0; It < PreviewIterations; It++)
+		{
+			const FTrajectoryCandidate Aim{ 30.f + (It % 60), 0.8f };
+			const double Start = FPlatformTime::Seconds();
+			FTrajectorySolver::BuildPreview(Terrain, Params, Aim, Points);
+			PreviewSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		// ----- Candidats -----
+		TArray<FTrajectoryCandidate> Candidates;
+		for (int32 a = 0; a < AngleSteps; a++)
+		{
+			for (int32 p = 0; p < PowerSteps; p++)
+			{
+				Candidates.Add({ (a + 0.5f) * 180.f / AngleSteps, static_cast<float>(p + 1) / PowerSteps });
+			}
+		}
+
+		TArray<FTrajectoryImpact> SimdImpacts;
+		SimdImpacts.SetNumUninitialized(Candidates.Num());
+		TArray<double> SimdSamples;
+		for (int32 It = 0; It < BatchIterations; It++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			FTrajectorySolver::SimulateBatch(Terrain, Params, Candidates, SimdImpacts);
+			SimdSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		TArray<FTrajectoryImpact> ScalarImpacts;
+		ScalarImpacts.SetNumUninitialized(Candidates.Num());
+		TArray<double> ScalarSamples;
+		for (int32 It = 0; It < BatchIterations; It++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Candidates.Num(); i++)
+			{
+				ScalarImpacts[i] = FTrajectorySolver::SimulateOne(Terrain, Params, Candidates[i]);
+			}
+			ScalarSamples.Add(FPlatformTime::Seconds() - Start);
+		}
+
+		int32 Mismatches = 0;
+		int32 Hits = 0;
+		for (int32 i = 0; i < Candidates.Num(); i++)
+		{
+			const FTrajectoryImpact& A = SimdImpacts[i];
+			const FTrajectoryImpact& B = ScalarImpacts[i];
+			Mismatches += (A.Position != B.Position || A.Ticks != B.Ticks || A.bHitTerrain != B.bHitTerrain) ? 1 : 0;
+			Hits += A.bHitTerrain ? 1 : 0;
+		}
+
+		// ----- Recherche complète (ce que fait un bot) -----
+		FTrajectoryCandidate Best;
+		float MissDistance = 0.f;
+		const double SearchStart = FPlatformTime::Seconds();
+		const bool bFound = FTrajectorySolver::FindBestShot(Terrain, Params, Target, AngleSteps, PowerSteps, 64.f, Best, MissDistance);
+		const double SearchMs = (FPlatformTime::Seconds() - SearchStart) * 1000.0;
+
+		const double PreviewMs = FProfilingReport::MedianMs(PreviewSamples);
+		const double SimdMs = FProfilingReport::MedianMs(SimdSamples);
+		const double ScalarMs = FProfilingReport::MedianMs(ScalarSamples);
+
+		FProfilingReport Report(TEXT("TrajectoryBench"), 2, FString::Printf(TEXT("candidates=%d | lanes=%d | max_substeps=%d | preview_target_ms=%.1f | search_target_ms=%.1f"),
+			Candidates.Num(), TrajectoryConstants::LaneCount, TrajectoryConstants::MaxSubsteps, PreviewTargetMs, SearchTargetMs));
+		Report.AddFloat(TEXT("preview_p50_ms"), PreviewMs, 4);
+		Report.AddInt(TEXT("preview_points"), Points.Num());
+		Report.AddFloat(TEXT("batch_simd_p50_ms"), SimdMs, 4);
+		Report.AddFloat(TEXT("batch_scalar_p50_ms"), ScalarMs, 4);
+		Report.AddFloat(TEXT("simd_speedup"), SimdMs > 0.0 ? ScalarMs / SimdMs : 0.0, 2);
+		Report.AddFloat(TEXT("best_shot_search_ms"), SearchMs, 4);
+		Report.AddInt(TEXT("terrain_hits"), Hits);
+		Report.AddYesNo(TEXT("simd_matches_scalar"), Mismatches == 0);
+		Report.AddText(TEXT("best_shot"), bFound ? FString::Printf(TEXT("%.1fdeg/%.2f"), Best.AngleDegrees, Best.Power01) : FString(TEXT("none")));
+		Report.AddFloat(TEXT("best_miss_cm"), bFound ? MissDistance : -1.f, 1);
+		Report.AddYesNo(TEXT("preview_under_target"), PreviewMs < PreviewTargetMs);
+		Report.AddYesNo(TEXT("search_under_target"), SearchMs < SearchTargetMs);
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommand GTrajectoryBenchCommand(
+	TEXT("Worms.TrajectoryBench"),
+	TEXT("Apercu de visee et recherche de tir SIMD vs scalaire. Usage: Worms.TrajectoryBench [AngleSteps] [PowerSteps] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Angles = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		const int32 Powers = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100;
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		RunTrajectoryBench(Angles > 0 ? Angles : 100, Powers > 0 ? Powers : 100, bExit);
+	})
+);
@@ -0,0 +1,28 @@
+#include "Rendering/WormSpriteBatchComponent.h"
+
+UWormSpriteBatchComponent::UWormSpriteBatchComponent()
+{
+	// Purement visuel : ni collision, ni tick, ni ombre portée
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	CastShadow = false;
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UWormSpriteBatchComponent::SetInstanceSprite(int32 InstanceIndex, UPaperSprite* Sprite)
+{
+	if (PerInstanceSpriteData.IsValidIndex(InstanceIndex))
+	{
+		PerInstanceSpriteData[InstanceIndex].SourceSprite = Sprite;
+		bInstancesDirty = true;
+	}
+}
+
+void UWormSpriteBatchComponent::FlushInstances()
+{
+	if (bInstancesDirty)
+	{
+		bInstancesDirty = false;
+		MarkRenderStateDirty();
+	}
+}
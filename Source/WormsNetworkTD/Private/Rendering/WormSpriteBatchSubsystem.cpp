@@ -0,0 +1,334 @@
+#include "Rendering/WormSpriteBatchSubsystem.h"
+#include "Rendering/WormSpriteBatchComponent.h"
+#include "Simulation/DamageResolutionSubsystem.h"
+#include "Actors/WormsCameraManager.h"
+#include "PaperFlipbook.h"
+#include "PaperSprite.h"
+#include "Engine/World.h"
+
+namespace
+{
+	constexpr float FlashDuration = 0.15f;
+	const FLinearColor FlashColor(1.f, 0.25f, 0.25f);
+
+	UTexture* GetAtlas(const UPaperFlipbook* Flipbook)
+	{
+		const UPaperSprite* Sprite = Flipbook ? Flipbook->GetSpriteAtFrame(0) : nullptr;
+		return Sprite ? Sprite->GetBakedTexture() : nullptr;
+	}
+}
+
+bool UWormSpriteBatchSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Rien à dessiner sur un serveur dédié
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWormSpriteBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UDamageResolutionSubsystem* Damage = InWorld.GetSubsystem<UDamageResolutionSubsystem>())
+	{
+		Damage->OnDamageEvents.AddDynamic(this, &UWormSpriteBatchSubsystem::HandleDamageEvents);
+	}
+}
+
+void UWormSpriteBatchSubsystem::Deinitialize()
+{
+	Entries.Reset();
+	FreeList.Reset();
+	OwnerToEntry.Reset();
+	Timelines.Reset();
+	Batches.Reset();
+	BatchOwner = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UWormSpriteBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWormSpriteBatchSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================
+//  Entrées
+// ============================================================
+
+int32 UWormSpriteBatchSubsystem::AddEntry(AActor* Owner, const FVector& Offset, float Scale)
+{
+	if (!Owner)
+		return INDEX_NONE;
+
+	const int32 Handle = FreeList.Num() > 0 ? FreeList.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+
+	FWormSpriteEntry& Entry = Entries[Handle];
+	Entry = FWormSpriteEntry();
+	Entry.Owner = Owner;
+	Entry.OwnerKey = Owner;
+	Entry.Offset = Offset;
+	Entry.Scale = Scale;
+	Entry.bUsed = true;
+
+	OwnerToEntry.Add(Owner, Handle);
+	return Handle;
+}
+
+void UWormSpriteBatchSubsystem::RemoveEntry(int32 Handle)
+{
+	if (!Entries.IsValidIndex(Handle) || !Entries[Handle].bUsed)
+		return;
+
+	FWormSpriteEntry& Entry = Entries[Handle];
+	DetachInstance(Entry);
+	ReleaseTimeline(Entry.Flipbook);
+	OwnerToEntry.Remove(Entry.OwnerKey);
+
+	Entry = FWormSpriteEntry();
+	FreeList.Add(Handle);
+}
+
+void UWormSpriteBatchSubsystem::SetFlipbook(int32 Handle, UPaperFlipbook* Flipbook, bool bRestart)
+{
+	if (!Entries.IsValidIndex(Handle) || !Entries[Handle].bUsed)
+		return;
+
+	FWormSpriteEntry& Entry = Entries[Handle];
+	if (Entry.Flipbook == Flipbook && !bRestart)
+		return;
+
+	if (Entry.Flipbook != Flipbook)
+	{
+		ReleaseTimeline(Entry.Flipbook);
+		Entry.Flipbook = nullptr;
+		Entry.ShownKeyFrame = INDEX_NONE;
+
+		if (!Flipbook || Flipbook->GetNumKeyFrames() == 0)
+		{
+			DetachInstance(Entry);
+			return;
+		}
+
+		AcquireTimeline(Flipbook);
+		Entry.Flipbook = Flipbook;
+		Entry.RestartKeyFrames = 0;
+	}
+
+	if (bRestart && Entry.Flipbook)
+	{
+		// Keyframe 0 maintenant : on compense la tête partagée et la phase, sans toucher à la phase
+		const FFlipbookTimeline& Timeline = Timelines.FindChecked(Flipbook);
+		const int32 Current = (Timeline.KeyFrame + Entry.PhaseKeyFrames) % Timeline.NumKeyFrames;
+		Entry.RestartKeyFrames = (Timeline.NumKeyFrames - Current) % Timeline.NumKeyFrames;
+		Entry.ShownKeyFrame = INDEX_NONE;
+	}
+
+	// Même atlas : simple changement de sprite au prochain tick
+	UWormSpriteBatchComponent* Batch = GetOrCreateBatch(GetAtlas(Flipbook));
+	if (Entry.Batch == Batch)
+		return;
+
+	DetachInstance(Entry);
+	Entry.Batch = Batch;
+	Entry.Instance = Batch->AddInstance(FTransform::Identity, Flipbook->GetSpriteAtFrame(0), true, Entry.Tint);
+	Entry.ShownTransform = FTransform::Identity;
+	Entry.ShownColor = Entry.Tint;
+}
+
+void UWormSpriteBatchSubsystem::SetPhaseOffset(int32 Handle, int32 PhaseKeyFrames)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].PhaseKeyFrames = FMath::Max(0, PhaseKeyFrames);
+	}
+}
+
+void UWormSpriteBatchSubsystem::SetFacing(int32 Handle, float Facing)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].Facing = Facing < 0.f ? -1.f : 1.f;
+	}
+}
+
+void UWormSpriteBatchSubsystem::SetTint(int32 Handle, const FLinearColor& Tint)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].Tint = Tint;
+	}
+}
+
+UWormSpriteBatchComponent* UWormSpriteBatchSubsystem::GetOrCreateBatch(UTexture* Atlas)
+{
+	if (TObjectPtr<UWormSpriteBatchComponent>* Found = Batches.Find(Atlas))
+		return *Found;
+
+	if (!BatchOwner)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		BatchOwner = GetWorld()->SpawnActor<AActor>(Params);
+
+		USceneComponent* Root = NewObject<USceneComponent>(BatchOwner, TEXT("Root"));
+		BatchOwner->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UWormSpriteBatchComponent* Batch = NewObject<UWormSpriteBatchComponent>(BatchOwner);
+	Batch->SetupAttachment(BatchOwner->GetRootComponent());
+	Batch->RegisterComponent();
+
+	Batches.Add(Atlas, Batch);
+	return Batch;
+}
+
+void UWormSpriteBatchSubsystem::DetachInstance(FWormSpriteEntry& Entry)
+{
+	UWormSpriteBatchComponent* Batch = Entry.Batch;
+	if (!Batch || Entry.Instance == INDEX_NONE)
+	{
+		Entry.Batch = nullptr;
+		Entry.Instance = INDEX_NONE;
+		return;
+	}
+
+	// RemoveInstance décale les suivantes : rare (changement d'atlas, mort, départ)
+	const int32 Removed = Entry.Instance;
+	Batch->RemoveInstance(Removed);
+	for (FWormSpriteEntry& Other : Entries)
+	{
+		if (Other.Batch == Batch && Other.Instance > Removed)
+		{
+			Other.Instance--;
+		}
+	}
+
+	Entry.Batch = nullptr;
+	Entry.Instance = INDEX_NONE;
+}
+
+// ============================================================
+//  Timelines partagées
+// ============================================================
+
+FFlipbookTimeline* UWormSpriteBatchSubsystem::AcquireTimeline(UPaperFlipbook* Flipbook)
+{
+	FFlipbookTimeline& Timeline = Timelines.FindOrAdd(Flipbook);
+	if (Timeline.RefCount++ == 0)
+	{
+		Timeline.Flipbook = Flipbook;
+		Timeline.NumKeyFrames = Flipbook->GetNumKeyFrames();
+		Timeline.KeyFrame = Flipbook->GetKeyFrameIndexAtTime(FMath::Fmod(static_cast<float>(GetWorld()->GetTimeSeconds()),
+			FMath::Max(Flipbook->GetTotalDuration(), KINDA_SMALL_NUMBER)));
+	}
+	return &Timeline;
+}
+
+void UWormSpriteBatchSubsystem::ReleaseTimeline(UPaperFlipbook* Flipbook)
+{
+	FFlipbookTimeline* Timeline = Flipbook ? Timelines.Find(Flipbook) : nullptr;
+	if (Timeline && --Timeline->RefCount <= 0)
+	{
+		Timelines.Remove(Flipbook);
+	}
+}
+
+// ============================================================
+//  Mise à jour par frame
+// ============================================================
+
+void UWormSpriteBatchSubsystem::Tick(float DeltaTime)
+{
+	// Une avance par flipbook utilisé, quel que soit le nombre d'entrées qui le jouent
+	const float Now = static_cast<float>(GetWorld()->GetTimeSeconds());
+	for (TPair<TObjectPtr<UPaperFlipbook>, FFlipbookTimeline>& Pair : Timelines)
+	{
+		const float Duration = Pair.Value.Flipbook->GetTotalDuration();
+		Pair.Value.KeyFrame = Duration > 0.f ? Pair.Value.Flipbook->GetKeyFrameIndexAtTime(FMath::Fmod(Now, Duration)) : 0;
+	}
+
+	// Rectangle publié par la caméra de match ; sans lui, rien n'est ignoré
+	FBox2D VisibleRect(ForceInit);
+	const bool bCull = AWormsCameraManager::GetLocalVisibleRect(GetWorld(), VisibleRect);
+	NumSkippedLastFrame = 0;
+
+	for (int32 Handle = 0; Handle < Entries.Num(); Handle++)
+	{
+		FWormSpriteEntry& Entry = Entries[Handle];
+		if (!Entry.bUsed || !Entry.Batch)
+			continue;
+
+		const AActor* Owner = Entry.Owner.Get();
+		if (!Owner)
+		{
+			RemoveEntry(Handle);
+			continue;
+		}
+
+		if (Entry.FlashTimeLeft > 0.f)
+		{
+			Entry.FlashTimeLeft -= DeltaTime;
+		}
+
+		const FVector Location = Owner->GetActorLocation() + Entry.Offset;
+		if (bCull && !VisibleRect.IsInside(FVector2D(Location.X, Location.Z)))
+		{
+			// Sortie d'écran : une écriture d'échelle nulle, plus rien ensuite tant qu'elle reste dehors
+			if (!Entry.ShownTransform.GetScale3D().IsZero())
+			{
+				Entry.ShownTransform = FTransform(FQuat::Identity, Location, FVector::ZeroVector);
+				Entry.Batch->UpdateInstanceTransform(Entry.Instance, Entry.ShownTransform, true, false);
+				Entry.Batch->MarkInstancesDirty();
+			}
+			NumSkippedLastFrame++;
+			continue;
+		}
+
+		// Frame : index de la timeline partagée + phase de l'entrée + recalage éventuel
+		const FFlipbookTimeline& Timeline = Timelines.FindChecked(Entry.Flipbook);
+		const int32 KeyFrame = (Timeline.KeyFrame + Entry.PhaseKeyFrames + Entry.RestartKeyFrames) % FMath::Max(1, Timeline.NumKeyFrames);
+		if (KeyFrame != Entry.ShownKeyFrame)
+		{
+			Entry.ShownKeyFrame = KeyFrame;
+			Entry.Batch->SetInstanceSprite(Entry.Instance, Entry.Flipbook->GetKeyFrameChecked(KeyFrame).Sprite);
+		}
+
+		// Caché (worm mort en lockstep) : instance gardée, échelle nulle
+		const float Scale = Owner->IsHidden() ? 0.f : Entry.Scale;
+		const FTransform Transform(Owner->GetActorQuat(), Location, FVector(Entry.Facing * Scale, 1.f, Scale));
+		if (!Transform.Equals(Entry.ShownTransform, 0.01))
+		{
+			Entry.ShownTransform = Transform;
+			Entry.Batch->UpdateInstanceTransform(Entry.Instance, Transform, true, false);
+			Entry.Batch->MarkInstancesDirty();
+		}
+
+		const FLinearColor Color = Entry.FlashTimeLeft > 0.f
+			? FLinearColor::LerpUsingHSV(Entry.Tint, FlashColor, FMath::Clamp(Entry.FlashTimeLeft / FlashDuration, 0.f, 1.f))
+			: Entry.Tint;
+		if (!Color.Equals(Entry.ShownColor))
+		{
+			Entry.ShownColor = Color;
+			Entry.Batch->UpdateInstanceColor(Entry.Instance, Color, false);
+			Entry.Batch->MarkInstancesDirty();
+		}
+	}
+
+	// Écritures ci-dessus sans MarkRenderStateDirty : un envoi au rendu par lot modifié, aucun pour un lot immobile
+	for (const TPair<TObjectPtr<UTexture>, TObjectPtr<UWormSpriteBatchComponent>>& Pair : Batches)
+	{
+		Pair.Value->FlushInstances();
+	}
+}
+
+void UWormSpriteBatchSubsystem::HandleDamageEvents(const TArray<FWormsDamageEvent>& Events)
+{
+	for (const FWormsDamageEvent& Event : Events)
+	{
+		if (const int32* Handle = OwnerToEntry.Find(Event.Target.Get()))
+		{
+			Entries[*Handle].FlashTimeLeft = FlashDuration;
+		}
+	}
+}
@@ -0,0 +1,224 @@
+#include "Simulation/DamageResolutionSubsystem.h"
+#include "Simulation/SpatialHashSubsystem.h"
+#include "Actors/CustomPaperCharacter.h"
+#include "Actors/WormsMatchInfo.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+void UDamageResolutionSubsystem::Deinitialize()
+{
+	PendingExplosions.Reset();
+	PendingFalls.Reset();
+	FallStartZ.Reset();
+	TargetToRow.Reset();
+	Targets.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UDamageResolutionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageResolutionSubsystem, STATGROUP_Tickables);
+}
+
+void UDamageResolutionSubsystem::Tick(float DeltaTime)
+{
+	// Un lot par frame serveur, après le mouvement des acteurs
+	if (PendingExplosions.Num() > 0 || PendingFalls.Num() > 0)
+	{
+		ResolvePending();
+	}
+}
+
+// ============================================================
+//  File (serveur)
+// ============================================================
+
+void UDamageResolutionSubsystem::QueueExplosion(const FWormsExplosion& Explosion)
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+		return;
+
+	PendingExplosions.Add(Explosion);
+}
+
+void UDamageResolutionSubsystem::NotifyStartedFalling(ACustomPaperCharacter* Worm)
+{
+	if (Worm && Worm->HasAuthority())
+	{
+		FallStartZ.Add(Worm, Worm->GetActorLocation().Z);
+	}
+}
+
+void UDamageResolutionSubsystem::NotifyLanded(ACustomPaperCharacter* Worm)
+{
+	float StartZ = 0.f;
+	if (!Worm || !FallStartZ.RemoveAndCopyValue(Worm, StartZ))
+		return;
+
+	const float FallHeight = StartZ - Worm->GetActorLocation().Z;
+	if (FallHeight > DamageConstants::SafeFallHeight)
+	{
+		PendingFalls.Emplace(Worm, FallHeight);
+	}
+}
+
+// ============================================================
+//  Résolution
+// ============================================================
+
+int32 UDamageResolutionSubsystem::FindOrAddTarget(ACustomPaperCharacter* Worm)
+{
+	if (const int32* Row = TargetToRow.Find(Worm))
+		return *Row;
+
+	const int32 Row = Targets.Add(Worm);
+	TargetDamage.Add(0);
+	TargetImpulse.Add(FVector2D::ZeroVector);
+	TargetFlags.Add(0);
+	TargetToRow.Add(Worm, Row);
+	return Row;
+}
+
+void UDamageResolutionSubsystem::ResolvePending()
+{
+	Targets.Reset();
+	TargetDamage.Reset();
+	TargetImpulse.Reset();
+	TargetFlags.Reset();
+	TargetToRow.Reset();
+
+	// ----- 1. Collecte : toutes les explosions en un appel -----
+	if (PendingExplosions.Num() > 0)
+	{
+		if (const USpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<USpatialHashSubsystem>())
+		{
+			Blasts.Reset(PendingExplosions.Num());
+			for (const FWormsExplosion& Explosion : PendingExplosions)
+			{
+				Blasts.Add({ USpatialHashSubsystem::ToPlane(Explosion.Center), Explosion.Radius, SpatialCategory::Worm });
+			}
+			SpatialHash->QueryExplosions(Blasts, BlastHits);
+
+			// ----- 2. Calcul : cumul par cible -----
+			for (const FSpatialHit& Hit : BlastHits.Hits)
+			{
+				ACustomPaperCharacter* Worm = Cast<ACustomPaperCharacter>(SpatialHash->GetActor(Hit.Handle));
+				if (!Worm || !Worm->IsAlive())
+					continue;
+
+				const FWormsExplosion& Explosion = PendingExplosions[Hit.BlastIndex];
+				const FVector2D Offset = USpatialHashSubsystem::ToPlane(Worm->GetActorLocation()) - Blasts[Hit.BlastIndex].Center;
+				const float Distance = FMath::Sqrt(Hit.DistanceSquared);
+				const float Falloff = Explosion.Radius > 0.f ? FMath::Clamp(1.f - Distance / Explosion.Radius, 0.f, 1.f) : 1.f;
+				const FVector2D Direction = Distance > KINDA_SMALL_NUMBER ? Offset / Distance : FVector2D(0.f, 1.f);
+
+				const int32 Row = FindOrAddTarget(Worm);
+				TargetDamage[Row] += FMath::FloorToInt(Explosion.Damage * Falloff);
+				TargetImpulse[Row] += Direction * (Explosion.Knockback * Falloff);
+			}
+		}
+		PendingExplosions.Reset();
+	}
+
+	for (const TPair<TWeakObjectPtr<ACustomPaperCharacter>, float>& Fall : PendingFalls)
+	{
+		ACustomPaperCharacter* Worm = Fall.Key.Get();
+		if (!Worm || !Worm->IsAlive())
+			continue;
+
+		const int32 Row = FindOrAddTarget(Worm);
+		TargetDamage[Row] += FMath::FloorToInt((Fall.Value - DamageConstants::SafeFallHeight) * DamageConstants::FallDamagePerUnit);
+		TargetFlags[Row] |= DamageConstants::Flag_Fall;
+	}
+	PendingFalls.Reset();
+
+	if (Targets.Num() == 0)
+		return;
+
+	// ----- 3. Application et événements -----
+	TArray<FWormsDamageEvent> Events;
+	Events.Reserve(Targets.Num());
+
+	for (int32 Row = 0; Row < Targets.Num(); Row++)
+	{
+		ACustomPaperCharacter* Worm = Targets[Row];
+		const int32 Remaining = Worm->ApplyResolvedDamage(TargetDamage[Row]);
+
+		if (Remaining <= 0)
+		{
+			TargetFlags[Row] |= DamageConstants::Flag_Killed;
+			FallStartZ.Remove(Worm);
+		}
+		else if (!TargetImpulse[Row].IsNearlyZero())
+		{
+			// Éjection : la chute qui suit repart de la position actuelle
+			Worm->LaunchCharacter(FVector(TargetImpulse[Row].X, 0.f, TargetImpulse[Row].Y), true, true);
+			FallStartZ.Add(Worm, Worm->GetActorLocation().Z);
+		}
+
+		// Effleuré en bord de rayon, chute juste au-dessus du seuil : rien à afficher
+		if (TargetDamage[Row] <= 0)
+			continue;
+
+		FWormsDamageEvent& Event = Events.AddDefaulted_GetRef();
+		Event.Serial = NextSerial++;
+		Event.Target = Worm;
+		Event.Damage = TargetDamage[Row];
+		Event.RemainingHealth = Remaining;
+		Event.Location = Worm->GetActorLocation();
+		Event.Flags = TargetFlags[Row];
+	}
+
+	if (AWormsMatchInfo* Info = FindMatchInfo())
+	{
+		Info->AppendDamageEvents(Events);
+	}
+	else
+	{
+		// Pas d'acteur répliqué (test hors réseau) : au moins les visuels locaux
+		HandleReplicatedEvents(Events);
+	}
+}
+
+AWormsMatchInfo* UDamageResolutionSubsystem::FindMatchInfo()
+{
+	if (!MatchInfo.IsValid())
+	{
+		// Un seul acteur par monde, créé par UWaterSubsystem
+		TActorIterator<AWormsMatchInfo> It(GetWorld());
+		MatchInfo = It ? *It : nullptr;
+	}
+	return MatchInfo.Get();
+}
+
+// ============================================================
+//  Événements répliqués
+// ============================================================
+
+void UDamageResolutionSubsystem::HandleReplicatedEvents(const TArray<FWormsDamageEvent>& Events)
+{
+	// La liste répliquée garde les derniers événements : ne relayer que les nouveaux
+	TArray<FWormsDamageEvent> NewEvents;
+	for (const FWormsDamageEvent& Event : Events)
+	{
+		if (Event.Serial > LastSeenSerial)
+		{
+			NewEvents.Add(Event);
+		}
+	}
+
+	if (NewEvents.Num() == 0)
+		return;
+
+	LastSeenSerial = NewEvents.Last().Serial;
+	OnDamageEvents.Broadcast(NewEvents);
+}
+
+void UDamageResolutionSubsystem::SkipReplicatedEvents(const TArray<FWormsDamageEvent>& Events)
+{
+	for (const FWormsDamageEvent& Event : Events)
+	{
+		LastSeenSerial = FMath::Max(LastSeenSerial, Event.Serial);
+	}
+}
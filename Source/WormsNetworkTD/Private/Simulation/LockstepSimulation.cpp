@@ -0,0 +1,668 @@
+#include "Simulation/LockstepSimulation.h"
+#include "Misc/Crc.h"
+#include "Serialization/Archive.h"
+
+const FFixed FLockstepSimulation::FixedDt = FFixed::FromRatio(1, LockstepConstants::TickRate);
+
+namespace
+{
+	// ----- Tuning (mêmes valeurs qu'ACustomPaperCharacter) -----
+	const FFixed Gravity = FFixed::FromInt(-980 * 5 / 2);     // GravityScale 2.5
+	const FFixed JumpZVelocity = FFixed::FromInt(800);
+	const FFixed MaxWalkSpeed = FFixed::FromInt(600);
+	const FFixed AirControlRate = FFixed::FromInt(4);          // ~AirControl 0.8 à 60 Hz
+
+	// ----- Armes -----
+	const FFixed ProjectileMaxSpeed = FFixed::FromInt(1500);
+	const FFixed ExplosionRadius = FFixed::FromInt(64);
+	constexpr int32 ExplosionDamage = 50;
+	const FFixed ExplosionKnockback = FFixed::FromInt(900);
+	const FFixed MaxWind = FFixed::FromInt(300);
+
+	// ----- Chute -----
+	const FFixed SafeFallHeight = FFixed::FromInt(320);
+	constexpr int32 FallDamagePerCell = 1;
+
+	// Phase de retraite après la résolution d'un tir
+	constexpr int32 RetreatTicks = 3 * LockstepConstants::TickRate;
+
+	const FFixed CellSizeFixed = FFixed::FromInt(FTerrainMask::CellSize);
+
+	uint32 MixCrc(uint32 Crc, int32 Value)
+	{
+		return FCrc::MemCrc32(&Value, sizeof(Value), Crc);
+	}
+
+	uint32 MixCrc(uint32 Crc, const FFixedVec2& V)
+	{
+		Crc = MixCrc(Crc, V.X.Raw);
+		return MixCrc(Crc, V.Z.Raw);
+	}
+
+	FArchive& operator<<(FArchive& Ar, FFixed& F)
+	{
+		Ar << F.Raw;
+		return Ar;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FFixedVec2& V)
+	{
+		Ar << V.X;
+		Ar << V.Z;
+		return Ar;
+	}
+}
+
+// ============================================================
+//  Sérialisation de FLockstepInput (réseau)
+// ============================================================
+
+bool FLockstepInput::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Déplacement : 0 = immobile, 1 = droite, 2 = gauche
+	uint8 Move = MoveAxis > 0 ? 1 : (MoveAxis < 0 ? 2 : 0);
+	Ar.SerializeBits(&Move, 2);
+
+	uint8 Bits = Buttons & (LockstepConstants::Button_Jump | LockstepConstants::Button_Fire);
+	Ar.SerializeBits(&Bits, 2);
+
+	if (Ar.IsLoading())
+	{
+		MoveAxis = Move == 1 ? 1 : (Move == 2 ? -1 : 0);
+		Buttons = Bits;
+	}
+
+	// La visée n'a de sens que pour le tick où le tir part
+	if (Buttons & LockstepConstants::Button_Fire)
+	{
+		Ar << AimAngle;
+		Ar << Power;
+	}
+	else if (Ar.IsLoading())
+	{
+		AimAngle = 0;
+		Power = 0;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FLockstepInputPacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << FirstFrame;
+	Ar << AckFrame;
+
+	// 0..MaxPacketInputs sur 5 bits
+	uint32 Count = FMath::Min(Inputs.Num(), LockstepConstants::MaxPacketInputs);
+	Ar.SerializeInt(Count, LockstepConstants::MaxPacketInputs + 1);
+	if (Ar.IsLoading())
+	{
+		Inputs.SetNum(Count);
+	}
+
+	bOutSuccess = true;
+	for (uint32 i = 0; i < Count && bOutSuccess; i++)
+	{
+		Inputs[i].NetSerialize(Ar, Map, bOutSuccess);
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
+
+bool FLockstepFramePacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << FirstFrame;
+
+	// 1..MaxPlayers sur 4 bits, 0..MaxPacketFrames sur 5 bits
+	uint32 Players = FMath::Clamp<uint32>(NumPlayers, 1, LockstepConstants::MaxPlayers);
+	Ar.SerializeInt(Players, LockstepConstants::MaxPlayers + 1);
+
+	uint32 Count = FMath::Min(GetNumFrames(), LockstepConstants::MaxPacketFrames);
+	Ar.SerializeInt(Count, LockstepConstants::MaxPacketFrames + 1);
+
+	if (Ar.IsLoading())
+	{
+		if (Players == 0)
+		{
+			bOutSuccess = false;
+			return true;
+		}
+		NumPlayers = static_cast<uint8>(Players);
+		Inputs.SetNum(Count * Players);
+	}
+
+	bOutSuccess = true;
+	for (uint32 i = 0; i < Count * Players && bOutSuccess; i++)
+	{
+		Inputs[i].NetSerialize(Ar, Map, bOutSuccess);
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
+
+// ============================================================
+//  Snapshot
+// ============================================================
+
+void FLockstepState::Serialize(FArchive& Ar)
+{
+	Ar << Frame;
+	Ar << Turn;
+	Ar << TurnTick;
+	Ar << ActivePlayer;
+	Ar << RetreatTicksLeft;
+	Ar << bShotFiredThisTurn;
+	Ar << Wind;
+	Ar << RandomState;
+	Ar << ActiveWormPerPlayer;
+
+	int32 NumWorms = Worms.Num();
+	Ar << NumWorms;
+	if (Ar.IsLoading())
+	{
+		Worms.SetNum(NumWorms);
+	}
+	for (FLockstepWorm& Worm : Worms)
+	{
+		Ar << Worm.Position << Worm.Velocity << Worm.FallStartZ;
+		Ar << Worm.Health << Worm.OwnerPlayer << Worm.bGrounded << Worm.bAlive;
+	}
+
+	int32 NumProjectiles = Projectiles.Num();
+	Ar << NumProjectiles;
+	if (Ar.IsLoading())
+	{
+		Projectiles.SetNum(NumProjectiles);
+	}
+	for (FLockstepProjectile& Projectile : Projectiles)
+	{
+		Ar << Projectile.Position << Projectile.Velocity << Projectile.OwnerPlayer;
+	}
+
+	int32 WaterRow = Water.GetRow();
+	Ar << WaterRow;
+
+	Terrain.Serialize(Ar);
+
+	// Masque d'eau et index de hauteur sont dérivés : reconstruits au chargement
+	if (Ar.IsLoading())
+	{
+		Water.Init(Terrain, WaterRow);
+		WormHeights.Reset(Worms.Num());
+		for (int32 i = 0; i < Worms.Num(); i++)
+		{
+			if (Worms[i].bAlive)
+			{
+				WormHeights.SetHeight(i, Worms[i].Position.Z);
+			}
+			else
+			{
+				WormHeights.Remove(i);
+			}
+		}
+	}
+}
+
+// ============================================================
+//  Initialisation
+// ============================================================
+
+void FLockstepSimulation::Init(const FLockstepMatchConfig& InConfig)
+{
+	Config = InConfig;
+	Config.NumPlayers = FMath::Clamp(Config.NumPlayers, 1, LockstepConstants::MaxPlayers);
+	Config.UnitsPerPlayer = FMath::Max(1, Config.UnitsPerPlayer);
+
+	State = FLockstepState();
+	State.RandomState = static_cast<uint32>(Config.Seed) * 2654435761u + 1u;
+	State.Terrain.Init(Config.MapWidthCells, Config.MapHeightCells);
+	LastDamageOps.Reset();
+
+	GenerateTerrain();
+	SpawnWorms();
+	State.Water.Init(State.Terrain, 0);
+
+	State.ActiveWormPerPlayer.SetNum(Config.NumPlayers);
+	for (int32 Player = 0; Player < Config.NumPlayers; Player++)
+	{
+		State.ActiveWormPerPlayer[Player] = Player * Config.UnitsPerPlayer;
+	}
+}
+
+uint32 FLockstepSimulation::NextRandom()
+{
+	// xorshift32 : entier pur, identique partout
+	uint32 X = State.RandomState;
+	X ^= X << 13;
+	X ^= X >> 17;
+	X ^= X << 5;
+	State.RandomState = X;
+	return X;
+}
+
+void FLockstepSimulation::GenerateTerrain()
+{
+	const int32 Width = State.Terrain.GetWidth();
+	const int32 Height = State.Terrain.GetHeight();
+
+	// Somme de quelques sinusoïdes à phase aléatoire, tout en virgule fixe
+	const int32 BaseHeight = Height * 2 / 5;
+	const int32 Amplitude = Height / 6;
+	const uint16 Phase1 = static_cast<uint16>(NextRandom());
+	const uint16 Phase2 = static_cast<uint16>(NextRandom());
+
+	TArray<int32> Heights;
+	Heights.SetNum(Width);
+	for (int32 X = 0; X < Width; X++)
+	{
+		const uint16 A1 = static_cast<uint16>(Phase1 + X * 65536 / FMath::Max(1, Width) * 2);
+		const uint16 A2 = static_cast<uint16>(Phase2 + X * 65536 / FMath::Max(1, Width) * 5);
+		const FFixed Wave = FFixed::SinBinary(A1) * FFixed::FromRatio(2, 3) + FFixed::SinBinary(A2) * FFixed::FromRatio(1, 3);
+		Heights[X] = BaseHeight + (Wave * FFixed::FromInt(Amplitude)).FloorToInt();
+	}
+
+	State.Terrain.FillColumnsFromHeights(Heights);
+}
+
+void FLockstepSimulation::SpawnWorms()
+{
+	const int32 Total = Config.NumPlayers * Config.UnitsPerPlayer;
+	const int32 Width = State.Terrain.GetWidth();
+	State.Worms.SetNum(Total);
+	State.WormHeights.Reset(Total);
+
+	for (int32 i = 0; i < Total; i++)
+	{
+		// Répartition régulière, joueurs entrelacés
+		const int32 Slot = (i % Config.NumPlayers) * Config.UnitsPerPlayer + i / Config.NumPlayers;
+		const int32 CellX = (Slot * 2 + 1) * Width / (Total * 2);
+		const int32 Ground = State.Terrain.FindGroundBelow(CellX, State.Terrain.GetHeight() - 1);
+
+		FLockstepWorm& Worm = State.Worms[i];
+		Worm.OwnerPlayer = static_cast<uint8>(i / Config.UnitsPerPlayer);
+		Worm.Health = Config.UnitLife;
+		Worm.Position = FFixedVec2(
+			FTerrainMask::CellToWorld(CellX) + CellSizeFixed * FFixed::FromRatio(1, 2),
+			FTerrainMask::CellToWorld(Ground + 1));
+		Worm.FallStartZ = Worm.Position.Z;
+		Worm.bGrounded = true;
+		State.WormHeights.SetHeight(i, Worm.Position.Z);
+	}
+}
+
+// ============================================================
+//  Pas de simulation
+// ============================================================
+
+bool FLockstepSimulation::Step(TConstArrayView<FLockstepInput> Inputs)
+{
+	LastDamageOps.Reset();
+
+	const int32 ActiveWorm = State.GetActiveWormIndex();
+	const FLockstepInput* ActiveInput = Inputs.IsValidIndex(State.ActivePlayer) ? &Inputs[State.ActivePlayer] : nullptr;
+
+	// Une fois le tir parti, le worm actif ne peut plus tirer mais peut fuir
+	if (ActiveInput && ActiveInput->HasButton(LockstepConstants::Button_Fire)
+		&& !State.bShotFiredThisTurn && State.Worms.IsValidIndex(ActiveWorm) && State.Worms[ActiveWorm].bAlive)
+	{
+		const FLockstepWorm& Shooter = State.Worms[ActiveWorm];
+		const FFixed Speed = ProjectileMaxSpeed * FFixed::FromRatio(ActiveInput->Power, 255);
+
+		FLockstepProjectile& Projectile = State.Projectiles.AddDefaulted_GetRef();
+		Projectile.OwnerPlayer = Shooter.OwnerPlayer;
+		Projectile.Position = Shooter.Position + FFixedVec2(FFixed(), CellSizeFixed * 2);
+		Projectile.Velocity = FFixedVec2(
+			FFixed::CosBinary(ActiveInput->AimAngle) * Speed,
+			FFixed::SinBinary(ActiveInput->AimAngle) * Speed);
+
+		State.bShotFiredThisTurn = true;
+	}
+
+	// Ordre strict : index croissant, aucune itération sur conteneur non ordonné
+	for (int32 i = 0; i < State.Worms.Num(); i++)
+	{
+		StepWorm(i, i == ActiveWorm ? ActiveInput : nullptr);
+	}
+
+	StepProjectiles();
+
+	State.Frame++;
+	State.TurnTick++;
+
+	// Fin de tour : temps écoulé, ou fin de la retraite après un tir résolu
+	if (State.bShotFiredThisTurn && State.Projectiles.Num() == 0 && State.RetreatTicksLeft < 0)
+	{
+		State.RetreatTicksLeft = RetreatTicks;
+	}
+	if (State.RetreatTicksLeft >= 0)
+	{
+		State.RetreatTicksLeft--;
+	}
+
+	const bool bActiveDied = State.Worms.IsValidIndex(ActiveWorm) && !State.Worms[ActiveWorm].bAlive;
+	if (State.TurnTick >= Config.TicksPerTurn || State.RetreatTicksLeft == 0 || (bActiveDied && State.Projectiles.Num() == 0))
+	{
+		EndTurn();
+		return true;
+	}
+	return false;
+}
+
+void FLockstepSimulation::StepWorm(int32 WormIndex, const FLockstepInput* Input)
+{
+	FLockstepWorm& Worm = State.Worms[WormIndex];
+	if (!Worm.bAlive)
+		return;
+
+	const FTerrainMask& Terrain = State.Terrain;
+	const FFixed Dt = FixedDt;
+	const int32 MoveAxis = Input ? FMath::Clamp<int32>(Input->MoveAxis, -1, 1) : 0;
+	const FFixed TargetSpeed = MaxWalkSpeed * MoveAxis;
+
+	// ----- Contrôle -----
+	if (Worm.bGrounded)
+	{
+		Worm.Velocity.X = TargetSpeed;
+		if (Input && Input->HasButton(LockstepConstants::Button_Jump))
+		{
+			Worm.Velocity.Z = JumpZVelocity;
+			Worm.bGrounded = false;
+			Worm.FallStartZ = Worm.Position.Z;
+		}
+	}
+	else
+	{
+		Worm.Velocity.X += (TargetSpeed - Worm.Velocity.X) * (AirControlRate * Dt);
+		Worm.Velocity.Z += Gravity * Dt;
+	}
+
+	// ----- Horizontal (avec marche d'une cellule) -----
+	if (Worm.Velocity.X != FFixed())
+	{
+		const FFixed NewX = Worm.Position.X + Worm.Velocity.X * Dt;
+		const int32 CellX = FTerrainMask::WorldToCell(NewX);
+		const int32 FeetY = FTerrainMask::WorldToCell(Worm.Position.Z);
+
+		if (!Terrain.IsSolid(CellX, FeetY) && !Terrain.IsSolid(CellX, FeetY + 1))
+		{
+			Worm.Position.X = NewX;
+		}
+		else if (Worm.bGrounded && !Terrain.IsSolid(CellX, FeetY + 1) && !Terrain.IsSolid(CellX, FeetY + 2))
+		{
+			Worm.Position.X = NewX;
+			Worm.Position.Z = FTerrainMask::CellToWorld(FeetY + 1);
+		}
+		else
+		{
+			Worm.Velocity.X = FFixed();
+		}
+	}
+
+	// ----- Vertical -----
+	const int32 CellX = FTerrainMask::WorldToCell(Worm.Position.X);
+	if (Worm.bGrounded)
+	{
+		// Le sol a peut-être été creusé sous ses pieds
+		const int32 FeetY = FTerrainMask::WorldToCell(Worm.Position.Z);
+		if (!Terrain.IsSolid(CellX, FeetY - 1))
+		{
+			Worm.bGrounded = false;
+			Worm.FallStartZ = Worm.Position.Z;
+		}
+	}
+	else
+	{
+		const FFixed NewZ = Worm.Position.Z + Worm.Velocity.Z * Dt;
+		const int32 NewCellY = FTerrainMask::WorldToCell(NewZ);
+
+		if (Worm.Velocity.Z <= FFixed() && Terrain.IsSolid(CellX, NewCellY))
+		{
+			// Atterrissage : calé sur le haut de la cellule
+			Worm.Position.Z = FTerrainMask::CellToWorld(NewCellY + 1);
+			Worm.Velocity = FFixedVec2();
+			Worm.bGrounded = true;
+
+			const FFixed FallHeight = Worm.FallStartZ - Worm.Position.Z;
+			if (FallHeight > SafeFallHeight)
+			{
+				const int32 Cells = (FallHeight - SafeFallHeight).FloorToInt() / FTerrainMask::CellSize;
+				ApplyDamage(WormIndex, Cells * FallDamagePerCell, FFixedVec2(), ELockstepDamageCause::Fall);
+			}
+		}
+		else if (Worm.Velocity.Z > FFixed() && Terrain.IsSolid(CellX, NewCellY + 2))
+		{
+			// Plafond
+			Worm.Velocity.Z = FFixed();
+		}
+		else
+		{
+			Worm.Position.Z = NewZ;
+		}
+	}
+
+	// Index de hauteur : no-op si le worm n'a pas bougé verticalement
+	State.WormHeights.SetHeight(WormIndex, Worm.Position.Z);
+
+	// Sortie par le bas de la map, ou chute dans l'eau
+	if (Worm.Position.Z < FFixed() || Worm.Position.Z < State.Water.GetWorldZ())
+	{
+		ApplyDamage(WormIndex, Worm.Health, FFixedVec2(), ELockstepDamageCause::Water);
+	}
+}
+
+void FLockstepSimulation::StepProjectiles()
+{
+	const FFixed Dt = FixedDt;
+	const FTerrainMask& Terrain = State.Terrain;
+	const FFixed MapWidth = FTerrainMask::CellToWorld(Terrain.GetWidth());
+
+	for (int32 i = 0; i < State.Projectiles.Num(); )
+	{
+		FLockstepProjectile& Projectile = State.Projectiles[i];
+		Projectile.Velocity.X += State.Wind * Dt;
+		Projectile.Velocity.Z += Gravity * Dt;
+
+		const FFixedVec2 Delta = Projectile.Velocity * Dt;
+		const int32 Substeps = FMath::Clamp(
+			(FFixed::Max(FFixed::Abs(Delta.X), FFixed::Abs(Delta.Z)).FloorToInt() / FTerrainMask::CellSize) + 1,
+			1, LockstepConstants::MaxProjectileSubsteps);
+		const FFixedVec2 Step = FFixedVec2(
+			FFixed::FromRaw(Delta.X.Raw / Substeps),
+			FFixed::FromRaw(Delta.Z.Raw / Substeps));
+
+		bool bExploded = false;
+		bool bLost = false;
+		for (int32 s = 0; s < Substeps; s++)
+		{
+			Projectile.Position += Step;
+			if (Projectile.Position.Z < FFixed() || Projectile.Position.X < FFixed() || Projectile.Position.X > MapWidth)
+			{
+				bLost = true;
+				break;
+			}
+			if (Terrain.IsSolidAtWorld(Projectile.Position))
+			{
+				bExploded = true;
+				break;
+			}
+		}
+
+		if (bExploded)
+		{
+			const FFixedVec2 Center = Projectile.Position;
+			const uint8 Owner = Projectile.OwnerPlayer;
+			State.Projectiles.RemoveAt(i, EAllowShrinking::No);
+			Explode(Center, Owner);
+			continue;
+		}
+		if (bLost)
+		{
+			State.Projectiles.RemoveAt(i, EAllowShrinking::No);
+			continue;
+		}
+		i++;
+	}
+}
+
+void FLockstepSimulation::Explode(const FFixedVec2& Center, uint8 OwnerPlayer)
+{
+	int32 MinRow = 0;
+	int32 MaxRow = 0;
+	if (State.Terrain.CarveCircle(
+		FTerrainMask::WorldToCell(Center.X),
+		FTerrainMask::WorldToCell(Center.Z),
+		ExplosionRadius.FloorToInt() / FTerrainMask::CellSize,
+		MinRow, MaxRow))
+	{
+		State.Water.OnTerrainChanged(State.Terrain, MinRow, MaxRow);
+	}
+
+	const int64 RadiusSq = static_cast<int64>(ExplosionRadius.Raw) * ExplosionRadius.Raw;
+	for (int32 i = 0; i < State.Worms.Num(); i++)
+	{
+		const FLockstepWorm& Worm = State.Worms[i];
+		if (!Worm.bAlive)
+			continue;
+
+		// Centre du corps du worm (une cellule au-dessus des pieds)
+		const FFixedVec2 Offset = (Worm.Position + FFixedVec2(FFixed(), CellSizeFixed)) - Center;
+		if (Offset.SizeSquaredRaw() >= RadiusSq)
+			continue;
+
+		const FFixed Distance = Offset.Size();
+		const FFixed Falloff = (ExplosionRadius - Distance) / ExplosionRadius;
+		const int32 Damage = (FFixed::FromInt(ExplosionDamage) * Falloff).FloorToInt();
+
+		FFixedVec2 Direction(FFixed(), FFixed::FromInt(1));
+		if (Distance > FFixed())
+		{
+			Direction = FFixedVec2(Offset.X / Distance, Offset.Z / Distance);
+		}
+		ApplyDamage(i, Damage, Direction * (ExplosionKnockback * Falloff), ELockstepDamageCause::Explosion);
+	}
+}
+
+void FLockstepSimulation::ApplyDamage(int32 WormIndex, int32 Damage, const FFixedVec2& Impulse, ELockstepDamageCause Cause)
+{
+	FLockstepWorm& Worm = State.Worms[WormIndex];
+	if (!Worm.bAlive)
+		return;
+
+	Worm.Health = FMath::Max(0, Worm.Health - FMath::Max(0, Damage));
+	if (Impulse.X != FFixed() || Impulse.Z != FFixed())
+	{
+		Worm.Velocity += Impulse;
+		Worm.bGrounded = false;
+		Worm.FallStartZ = Worm.Position.Z;
+	}
+	if (Worm.Health <= 0)
+	{
+		Worm.bAlive = false;
+		State.WormHeights.Remove(WormIndex);
+	}
+
+	FLockstepDamageOp& Op = LastDamageOps.AddDefaulted_GetRef();
+	Op.Frame = State.Frame;
+	Op.WormIndex = static_cast<uint8>(WormIndex);
+	Op.Damage = Damage;
+	Op.Impulse = Impulse;
+	Op.Cause = Cause;
+	Op.bKill = !Worm.bAlive;
+}
+
+void FLockstepSimulation::EndTurn()
+{
+	State.Turn++;
+	State.TurnTick = 0;
+	State.RetreatTicksLeft = -1;
+	State.bShotFiredThisTurn = false;
+
+	// Vent du tour suivant : [-MaxWind, MaxWind]
+	const int32 WindRaw = static_cast<int32>(NextRandom() % (2 * MaxWind.Raw + 1)) - MaxWind.Raw;
+	State.Wind = FFixed::FromRaw(WindRaw);
+
+	RaiseWater();
+
+	// Joueur suivant ayant encore un worm vivant
+	for (int32 Offset = 1; Offset <= Config.NumPlayers; Offset++)
+	{
+		const int32 Candidate = (State.ActivePlayer + Offset) % Config.NumPlayers;
+		const int32 First = Candidate * Config.UnitsPerPlayer;
+		const int32 Current = State.ActiveWormPerPlayer[Candidate] - First;
+
+		for (int32 k = 1; k <= Config.UnitsPerPlayer; k++)
+		{
+			const int32 WormIndex = First + (Current + k) % Config.UnitsPerPlayer;
+			if (State.Worms[WormIndex].bAlive)
+			{
+				State.ActivePlayer = Candidate;
+				State.ActiveWormPerPlayer[Candidate] = WormIndex;
+				return;
+			}
+		}
+	}
+}
+
+void FLockstepSimulation::RaiseWater()
+{
+	if (State.Turn < Config.TurnsBeforeWater)
+		return;
+
+	if (State.Water.RaiseTo(State.Water.GetRow() + Config.WaterRiseCells, State.Terrain) == 0)
+		return;
+
+	// Seuls les worms sous la nouvelle ligne sont visités
+	TArray<int32> Drowned;
+	State.WormHeights.CollectBelow(State.Water.GetWorldZ(), Drowned);
+	for (const int32 WormIndex : Drowned)
+	{
+		ApplyDamage(WormIndex, State.Worms[WormIndex].Health, FFixedVec2(), ELockstepDamageCause::Water);
+	}
+}
+
+int32 FLockstepSimulation::CountAlivePlayers() const
+{
+	uint32 Mask = 0;
+	for (const FLockstepWorm& Worm : State.Worms)
+	{
+		if (Worm.bAlive)
+		{
+			Mask |= 1u << Worm.OwnerPlayer;
+		}
+	}
+	return FMath::CountBits(Mask);
+}
+
+// ============================================================
+//  Checksum
+// ============================================================
+
+uint32 FLockstepSimulation::ComputeChecksum() const
+{
+	uint32 Crc = 0;
+	Crc = MixCrc(Crc, static_cast<int32>(State.Frame));
+	Crc = MixCrc(Crc, State.Turn);
+	Crc = MixCrc(Crc, State.ActivePlayer);
+	Crc = MixCrc(Crc, State.Wind.Raw);
+	Crc = MixCrc(Crc, static_cast<int32>(State.RandomState));
+	Crc = MixCrc(Crc, State.Water.GetRow());
+
+	for (const FLockstepWorm& Worm : State.Worms)
+	{
+		Crc = MixCrc(Crc, Worm.Position);
+		Crc = MixCrc(Crc, Worm.Velocity);
+		Crc = MixCrc(Crc, Worm.Health);
+		Crc = MixCrc(Crc, (Worm.bAlive ? 1 : 0) | (Worm.bGrounded ? 2 : 0));
+	}
+
+	for (const FLockstepProjectile& Projectile : State.Projectiles)
+	{
+		Crc = MixCrc(Crc, Projectile.Position);
+		Crc = MixCrc(Crc, Projectile.Velocity);
+	}
+
+	return State.Terrain.ComputeHash(Crc);
+}
@@ -0,0 +1,1054 @@
+#include "Simulation/LockstepSubsystem.h"
+#include "Simulation/TrajectorySolver.h"
+#include "Actors/CustomPlayerController.h"
+#include "Actors/CustomPaperCharacter.h"
+#include "Actors/WormsBotController.h"
+#include "WormsGameInstance.h"
+#include "Network/OnlineSessionSubsystem.h"
+#include "Beacon/LobbyTypes.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+
+namespace
+{
+	// Au-delà, on ne rattrape pas : évite la spirale après un stall réseau
+	constexpr int32 MaxCatchUpSteps = 8;
+
+	// Simulation bloquée (rien de nouveau à envoyer) : renvoi des inputs non confirmés,
+	// et côté serveur des frames confirmées non accusées
+	constexpr double InputResendSeconds = 0.1;
+
+	// Fin de partie : délai max pour livrer les dernières frames aux clients
+	constexpr double MatchEndFlushSeconds = 5.0;
+}
+
+// ============================================================
+//  Cycle de vie
+// ============================================================
+
+void ULockstepSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Map atteinte par le ServerTravel du lobby : la partie part à l'arrivée des joueurs
+	if (InWorld.GetNetMode() != NM_Client && UWormsGameInstance::IsMatchWorld(&InWorld))
+	{
+		bAutoStartPending = true;
+		AutoStartDeadline = FPlatformTime::Seconds() + AutoStartTimeoutSeconds;
+	}
+}
+
+void ULockstepSubsystem::Deinitialize()
+{
+	// Match interrompu (retour menu, travel) : on garde quand même le replay
+	if (bRunning)
+	{
+		EndMatch();
+	}
+
+	ConfirmedFrames.Reset();
+	ServerPendingFrames.Reset();
+	ServerConfirmedHistory.Reset();
+	ServerPeers.Reset();
+	ServerPlayers.Reset();
+	ServerBots.Reset();
+	ServerSpawnedWorms.Reset();
+	BoundActors.Reset();
+
+	// Le journal appartient à l'instance de jeu et survit au travel
+	StatsWriter = nullptr;
+	if (ReplaySaveTask.IsValid())
+	{
+		ReplaySaveTask.Wait();
+		ReplaySaveTask.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId ULockstepSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULockstepSubsystem, STATGROUP_Tickables);
+}
+
+// ============================================================
+//  Démarrage
+// ============================================================
+
+void ULockstepSubsystem::StartLockstepMatch(FLockstepMatchConfig Config)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lockstep: StartLockstepMatch doit etre appele sur le serveur."));
+		return;
+	}
+
+	// Index = ordre des PlayerControllers, identique pour tout le monde une fois diffusé
+	ServerPlayers.Reset();
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (ACustomPlayerController* PC = Cast<ACustomPlayerController>(It->Get()))
+		{
+			if (ServerPlayers.Num() >= LockstepConstants::MaxPlayers)
+				break;
+			ServerPlayers.Add(PC);
+		}
+	}
+
+	// Bots après les humains ; une partie forcée (Worms.BotMatch) a au moins deux camps
+	const int32 NumBots = ForcedBotCount != INDEX_NONE
+		? FMath::Max(ForcedBotCount, 2 - ServerPlayers.Num())
+		: ServerGetBotFillCount(ServerPlayers.Num());
+	ServerSpawnBots(FMath::Min(NumBots, LockstepConstants::MaxPlayers - ServerPlayers.Num()));
+
+	if (ServerPlayers.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lockstep: aucun joueur, partie non lancee."));
+		return;
+	}
+
+	Config.NumPlayers = ServerPlayers.Num();
+	bAutoStartPending = false;
+	ServerBindWormActors(Config);
+
+	ServerPendingFrames.Reset();
+	ServerConfirmedHistory.Reset();
+	ServerTurnChecksums.Reset();
+	ServerPendingReports.Reset();
+	ServerNextConfirmFrame = LockstepConstants::InputDelayFrames;
+
+	// Les premières frames ne sont jamais envoyées (cf. CanStepFrame)
+	FServerPeer FirstPeer;
+	FirstPeer.AckFrame = ServerNextConfirmFrame;
+	FirstPeer.SentUntilFrame = ServerNextConfirmFrame;
+	ServerPeers.Init(FirstPeer, ServerPlayers.Num());
+
+	for (int32 i = 0; i < ServerPlayers.Num(); i++)
+	{
+		if (ACustomPlayerController* PC = Cast<ACustomPlayerController>(ServerPlayers[i].Get()))
+		{
+			PC->Client_StartLockstep(Config, i);
+		}
+		else if (AWormsBotController* Bot = Cast<AWormsBotController>(ServerPlayers[i].Get()))
+		{
+			Bot->BeginLockstep(i);
+		}
+	}
+
+	// Serveur dédié : aucun PC local, la simulation de référence tourne ici
+	if (World->GetNetMode() == NM_DedicatedServer)
+	{
+		BeginMatch(Config, INDEX_NONE);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Lockstep: partie lancee (%d joueurs dont %d bots, seed %d)."),
+		Config.NumPlayers, ServerBots.Num(), Config.Seed);
+}
+
+void ULockstepSubsystem::ServerTryAutoStart()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+		return;
+
+	const UWormsGameInstance* GI = Cast<UWormsGameInstance>(World->GetGameInstance());
+	const int32 Expected = GI ? GI->ExpectedMatchPlayers : 0;
+
+	int32 NumReady = 0;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const ACustomPlayerController* PC = Cast<ACustomPlayerController>(It->Get());
+		if (PC && Cast<ACustomPaperCharacter>(PC->GetPawn()))
+		{
+			NumReady++;
+		}
+	}
+
+	// Un joueur dont le travel échoue ne bloque pas les autres au-delà du délai
+	const bool bTimedOut = FPlatformTime::Seconds() >= AutoStartDeadline;
+	if (NumReady == 0 || (NumReady < Expected && !bTimedOut))
+		return;
+
+	if (NumReady < Expected)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lockstep: %d/%d joueur(s) arrive(s), partie lancee sans les autres."), NumReady, Expected);
+	}
+
+	StartLockstepMatch(MakeMatchConfigFromSession());
+}
+
+void ULockstepSubsystem::ServerBindWormActors(const FLockstepMatchConfig& Config)
+{
+	UWorld* World = GetWorld();
+
+	// Worms créés pour une partie précédente
+	for (const TWeakObjectPtr<AActor>& Actor : ServerSpawnedWorms)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->Destroy();
+		}
+	}
+	ServerSpawnedWorms.Reset();
+
+	// Les worms sans pawn reprennent la classe (Blueprint) de ceux des joueurs
+	TSubclassOf<ACustomPaperCharacter> WormClass = ACustomPaperCharacter::StaticClass();
+	FTransform SpawnTransform = FTransform::Identity;
+	for (const TWeakObjectPtr<AController>& Controller : ServerPlayers)
+	{
+		if (const ACustomPaperCharacter* Pawn = Controller.IsValid() ? Cast<ACustomPaperCharacter>(Controller->GetPawn()) : nullptr)
+		{
+			WormClass = Pawn->GetClass();
+			SpawnTransform = Pawn->GetActorTransform();
+			break;
+		}
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// Même ordre que FLockstepSimulation::SpawnWorms : worm = joueur * UnitsPerPlayer + unité
+	const int32 UnitsPerPlayer = FMath::Max(1, Config.UnitsPerPlayer);
+	for (int32 Player = 0; Player < ServerPlayers.Num(); Player++)
+	{
+		AController* Controller = ServerPlayers[Player].Get();
+		ACustomPaperCharacter* Pawn = Controller ? Cast<ACustomPaperCharacter>(Controller->GetPawn()) : nullptr;
+
+		for (int32 Unit = 0; Unit < UnitsPerPlayer; Unit++)
+		{
+			ACustomPaperCharacter* Worm = Unit == 0 ? Pawn : nullptr;
+			if (!Worm)
+			{
+				Worm = World->SpawnActor<ACustomPaperCharacter>(WormClass, SpawnTransform, Params);
+				if (!Worm)
+					continue;
+				ServerSpawnedWorms.Add(Worm);
+			}
+
+			// Répliqué : chaque machine lie l'acteur à son index (OnRep_LockstepWormIndex)
+			Worm->SetLockstepWormIndex(Player * UnitsPerPlayer + Unit);
+		}
+	}
+}
+
+void ULockstepSubsystem::StartBotMatch(int32 NumBots)
+{
+	ForcedBotCount = FMath::Max(0, NumBots);
+	StartLockstepMatch(MakeMatchConfigFromSession());
+	ForcedBotCount = INDEX_NONE;
+}
+
+int32 ULockstepSubsystem::ServerGetBotFillCount(int32 NumHumans) const
+{
+	if (!bFillFFAWithBots)
+		return 0;
+
+	const UGameInstance* GI = GetWorld()->GetGameInstance();
+	const UOnlineSessionSubsystem* Sessions = GI ? GI->GetSubsystem<UOnlineSessionSubsystem>() : nullptr;
+	if (!Sessions || !Sessions->LastSessionSettings.IsValid())
+		return 0;
+
+	const FRoomSettings& Room = Sessions->GetHostedRoomSettings();
+	if (Room.GameMode != EWormsGameMode::FFA)
+		return 0;
+
+	return FMath::Max(0, Room.GetMaxPlayers() - NumHumans);
+}
+
+void ULockstepSubsystem::ServerSpawnBots(int32 NumBots)
+{
+	// Les bots d'une partie précédente ne reprennent pas de slot
+	for (const TWeakObjectPtr<AWormsBotController>& Bot : ServerBots)
+	{
+		if (Bot.IsValid())
+		{
+			Bot->Destroy();
+		}
+	}
+	ServerBots.Reset();
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	for (int32 i = 0; i < NumBots; i++)
+	{
+		if (AWormsBotController* Bot = GetWorld()->SpawnActor<AWormsBotController>(Params))
+		{
+			ServerBots.Add(Bot);
+			ServerPlayers.Add(Bot);
+		}
+	}
+}
+
+FLockstepMatchConfig ULockstepSubsystem::MakeMatchConfigFromSession() const
+{
+	FLockstepMatchConfig Config;
+	Config.Seed = FMath::Rand();
+
+	const UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	const UOnlineSessionSubsystem* Sessions = GI ? GI->GetSubsystem<UOnlineSessionSubsystem>() : nullptr;
+	if (Sessions && Sessions->LastSessionSettings.IsValid())
+	{
+		const FRoomSettings& Room = Sessions->GetHostedRoomSettings();
+		Config.UnitLife = Room.UnitLife;
+		Config.UnitsPerPlayer = Room.UnitCount;
+		Config.TurnsBeforeWater = Room.TurnsBeforeWater;
+	}
+	return Config;
+}
+
+void ULockstepSubsystem::BeginMatch(const FLockstepMatchConfig& Config, int32 InLocalPlayerIndex)
+{
+	Simulation.Init(Config);
+	LocalPlayerIndex = InLocalPlayerIndex;
+	Accumulator = 0.0;
+	NextSampleFrame = LockstepConstants::InputDelayFrames;
+	ConfirmedFrames.Reset();
+	PendingInput = FLockstepInput();
+	UnconfirmedInputs.Reset();
+	FirstUnconfirmedFrame = NextSampleFrame;
+	bInputsDirty = false;
+	LastInputSendSeconds = 0.0;
+	PendingMoveAxis = 0.f;
+	bRunning = true;
+
+	// Acteurs liés avant le début (serveur, ou réplication arrivée avant le RPC) : position de départ
+	SyncBoundActors();
+
+	const UWorld* World = GetWorld();
+	const bool bIsClient = World && World->GetNetMode() == NM_Client;
+	if (bIsClient ? bRecordClientReplays : bRecordReplays)
+	{
+		ReplayWriter.Begin(Simulation.GetConfig(), Simulation.GetState());
+	}
+
+	StatsBeginMatch();
+}
+
+void ULockstepSubsystem::EndMatch()
+{
+	bRunning = false;
+	StatsEndMatch();
+
+	// Serveur : les clients s'arrêtent à la même frame, le reste de l'historique est inutile
+	const UWorld* World = GetWorld();
+	if (World && World->GetNetMode() != NM_Client)
+	{
+		ServerNextConfirmFrame = FMath::Min(ServerNextConfirmFrame, Simulation.GetState().Frame);
+		for (auto It = ServerConfirmedHistory.CreateIterator(); It; ++It)
+		{
+			if (It.Key() >= ServerNextConfirmFrame)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		ServerFlushDeadline = FPlatformTime::Seconds() + MatchEndFlushSeconds;
+	}
+
+	// Fichier complété ici (mémoire seule), disque sur le pool de threads
+	TArray<uint8> ReplayData;
+	if (ReplayWriter.Finalize(ReplayData))
+	{
+		LastReplayPath = FMatchReplayWriter::MakeDefaultPath();
+		ReplaySaveTask = FMatchReplayWriter::SaveAsync(LastReplayPath, MoveTemp(ReplayData));
+	}
+}
+
+// ============================================================
+//  Input local
+// ============================================================
+
+void ULockstepSubsystem::SetLocalMoveAxis(float Axis)
+{
+	PendingMoveAxis = Axis;
+	LastMoveInputFrame = GFrameCounter;
+}
+
+void ULockstepSubsystem::AddLocalButtons(uint8 Buttons)
+{
+	PendingInput.Buttons |= Buttons;
+}
+
+void ULockstepSubsystem::QueueFire(float AimDegrees, float Power01)
+{
+	PendingInput.Buttons |= LockstepConstants::Button_Fire;
+	PendingInput.AimAngle = static_cast<uint16>(FMath::RoundToInt(FMath::Fmod(AimDegrees, 360.f) / 360.f * 65536.f) & 0xFFFF);
+	PendingInput.Power = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Power01 * 255.f), 0, 255));
+}
+
+TArray<FVector> ULockstepSubsystem::PreviewLocalShot(float AimDegrees, float Power01) const
+{
+	TArray<FVector> Points;
+
+	const FLockstepState& State = Simulation.GetState();
+	const int32 ActiveWorm = State.GetActiveWormIndex();
+	if (!bRunning || State.ActivePlayer != LocalPlayerIndex || State.bShotFiredThisTurn || !State.Worms.IsValidIndex(ActiveWorm))
+		return Points;
+
+	FTrajectoryParams Params;
+	Params.Origin = FVector2D(State.Worms[ActiveWorm].Position.X.ToFloat(), State.Worms[ActiveWorm].Position.Z.ToFloat());
+	Params.Wind = State.Wind.ToFloat();
+
+	TArray<FVector2D> Path;
+	FTrajectorySolver::BuildPreview(State.Terrain, Params, { AimDegrees, Power01 }, Path);
+
+	Points.Reserve(Path.Num());
+	for (const FVector2D& Point : Path)
+	{
+		Points.Add(FVector(Point.X, 0.f, Point.Y));
+	}
+	return Points;
+}
+
+void ULockstepSubsystem::SampleLocalInput()
+{
+	if (LocalPlayerIndex == INDEX_NONE)
+		return;
+
+	// Move est déclenché à chaque frame tant que la touche est tenue :
+	// sans appel récent, on considère l'axe relâché.
+	if (GFrameCounter - LastMoveInputFrame > 1)
+	{
+		PendingMoveAxis = 0.f;
+	}
+
+	FLockstepInput Input = PendingInput;
+	Input.MoveAxis = PendingMoveAxis > 0.1f ? 1 : (PendingMoveAxis < -0.1f ? -1 : 0);
+	PendingInput = FLockstepInput();
+
+	// Envoyé par SendLocalInputs en fin de Tick, avec les frames non confirmées
+	check(FirstUnconfirmedFrame + UnconfirmedInputs.Num() == NextSampleFrame);
+	UnconfirmedInputs.Add(Input);
+	bInputsDirty = true;
+}
+
+void ULockstepSubsystem::SendLocalInputs()
+{
+	if (LocalPlayerIndex == INDEX_NONE)
+		return;
+
+	// Nouvelle frame échantillonnée, accusé reçu ou frames à accuser ; sinon seulement un renvoi de temps en temps
+	const double Now = FPlatformTime::Seconds();
+	if (!bInputsDirty && Now - LastInputSendSeconds < InputResendSeconds)
+		return;
+
+	ACustomPlayerController* PC = GetLocalController();
+	if (!PC)
+		return;
+
+	bInputsDirty = false;
+	LastInputSendSeconds = Now;
+
+	// Les plus anciennes d'abord : ce sont elles qui bloquent la confirmation
+	FLockstepInputPacket Packet;
+	Packet.FirstFrame = FirstUnconfirmedFrame;
+	Packet.AckFrame = GetFirstMissingFrame();
+	Packet.Inputs.Append(UnconfirmedInputs.GetData(), FMath::Min(UnconfirmedInputs.Num(), LockstepConstants::MaxPacketInputs));
+	PC->Server_SubmitLockstepInputs(Packet);
+}
+
+uint32 ULockstepSubsystem::GetFirstMissingFrame() const
+{
+	// Les frames déjà simulées ont été retirées de ConfirmedFrames
+	uint32 Frame = FMath::Max(Simulation.GetState().Frame, LockstepConstants::InputDelayFrames);
+	while (ConfirmedFrames.Contains(Frame))
+	{
+		Frame++;
+	}
+	return Frame;
+}
+
+void ULockstepSubsystem::ServerSampleBotInputs()
+{
+	// Même entrée que Server_SubmitLockstepInputs, sans aller-retour réseau
+	for (const TWeakObjectPtr<AWormsBotController>& Bot : ServerBots)
+	{
+		if (AWormsBotController* BotController = Bot.Get())
+		{
+			ServerReceiveInput(BotController, NextSampleFrame, BotController->MakeLockstepInput(Simulation.GetState()));
+		}
+	}
+}
+
+// ============================================================
+//  Boucle à pas fixe
+// ============================================================
+
+void ULockstepSubsystem::Tick(float DeltaTime)
+{
+	if (!bRunning)
+	{
+		if (bAutoStartPending)
+		{
+			ServerTryAutoStart();
+		}
+		else if (ServerConfirmedHistory.Num() > 0)
+		{
+			// Fin de partie : les clients doivent encore recevoir les dernières frames
+			if (FPlatformTime::Seconds() < ServerFlushDeadline)
+			{
+				ServerSendConfirmedFrames();
+			}
+			else
+			{
+				ServerConfirmedHistory.Reset();
+			}
+		}
+		return;
+	}
+
+	const double Dt = 1.0 / LockstepConstants::TickRate;
+	Accumulator = FMath::Min(Accumulator + DeltaTime, Dt * MaxCatchUpSteps);
+
+	bool bStepped = false;
+	while (bRunning && Accumulator >= Dt)
+	{
+		const uint32 Frame = Simulation.GetState().Frame;
+		if (!CanStepFrame(Frame))
+		{
+			// Inputs pas encore reçus : on attend sans consommer le temps
+			break;
+		}
+
+		// L'input échantillonné maintenant sera appliqué InputDelay frames plus tard
+		if (NextSampleFrame <= Frame + LockstepConstants::InputDelayFrames)
+		{
+			SampleLocalInput();
+			ServerSampleBotInputs();
+			NextSampleFrame++;
+		}
+
+		StepOneFrame();
+		Accumulator -= Dt;
+		bStepped = true;
+	}
+
+	// Au plus un paquet par Tick ; bloqué, un renvoi périodique répare une perte
+	SendLocalInputs();
+	ServerSendConfirmedFrames();
+
+	if (bStepped)
+	{
+		SyncBoundActors();
+	}
+}
+
+bool ULockstepSubsystem::CanStepFrame(uint32 Frame) const
+{
+	return Frame < LockstepConstants::InputDelayFrames || ConfirmedFrames.Contains(Frame);
+}
+
+void ULockstepSubsystem::StepOneFrame()
+{
+	const uint32 Frame = Simulation.GetState().Frame;
+
+	TArray<FLockstepInput> Inputs;
+	if (!ConfirmedFrames.RemoveAndCopyValue(Frame, Inputs))
+	{
+		Inputs.SetNum(Simulation.GetConfig().NumPlayers);
+	}
+
+	OnFrameStepped.Broadcast(Frame, Inputs);
+
+	const int32 Turn = Simulation.GetState().Turn;
+	const int32 ActivePlayer = Simulation.GetState().ActivePlayer;
+	const bool bShotBefore = Simulation.GetState().bShotFiredThisTurn;
+	const bool bTurnEnded = Simulation.Step(Inputs);
+	ReplayWriter.RecordFrame(Frame, Inputs, Simulation.GetLastDamageOps());
+	if (!bTurnEnded)
+	{
+		if (bStatsRecording)
+		{
+			StatsRecordFrame(Frame, Turn, Inputs, ActivePlayer, bShotBefore, false, 0);
+		}
+		return;
+	}
+
+	const uint32 Checksum = Simulation.ComputeChecksum();
+	ReplayWriter.RecordTurnEnd(Turn, Checksum, Simulation.GetState());
+	if (bStatsRecording)
+	{
+		StatsRecordFrame(Frame, Turn, Inputs, ActivePlayer, bShotBefore, true, Checksum);
+	}
+	OnTurnEnded.Broadcast(Turn, Checksum);
+
+	UWorld* World = GetWorld();
+	if (World && World->GetNetMode() != NM_Client)
+	{
+		ServerCheckChecksum(Turn, INDEX_NONE, Checksum);
+	}
+	else if (ACustomPlayerController* PC = GetLocalController())
+	{
+		PC->Server_ReportTurnChecksum(Turn, Checksum);
+	}
+
+	if (Simulation.CountAlivePlayers() <= 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lockstep: fin de partie au tour %d."), Turn);
+		EndMatch();
+	}
+}
+
+void ULockstepSubsystem::ReceiveConfirmedFramePacket(const FLockstepFramePacket& Packet)
+{
+	if (!bRunning || Packet.NumPlayers != Simulation.GetConfig().NumPlayers)
+		return;
+
+	const int32 NumFrames = FMath::Min(Packet.GetNumFrames(), LockstepConstants::MaxPacketFrames);
+	for (int32 i = 0; i < NumFrames; i++)
+	{
+		ReceiveConfirmedFrame(Packet.FirstFrame + i, MakeArrayView(Packet.Inputs).Slice(i * Packet.NumPlayers, Packet.NumPlayers));
+	}
+
+	// Le serveur n'envoie que ce qui n'est pas accusé : même un paquet sans
+	// frame nouvelle signale un accusé perdu, à renvoyer
+	bInputsDirty = true;
+}
+
+void ULockstepSubsystem::ReceiveConfirmedFrame(uint32 Frame, TConstArrayView<FLockstepInput> Inputs)
+{
+	// Redondance : la même frame arrive dans plusieurs paquets, seule la première compte
+	if (!bRunning || Frame < Simulation.GetState().Frame || ConfirmedFrames.Contains(Frame))
+		return;
+
+	ConfirmedFrames.Add(Frame, TArray<FLockstepInput>(Inputs));
+
+	// Frame confirmée = accusé de réception de notre input : plus besoin de le renvoyer
+	if (Frame >= FirstUnconfirmedFrame)
+	{
+		const int32 Acked = FMath::Min(static_cast<int32>(Frame + 1 - FirstUnconfirmedFrame), UnconfirmedInputs.Num());
+		UnconfirmedInputs.RemoveAt(0, Acked, EAllowShrinking::No);
+		FirstUnconfirmedFrame = Frame + 1;
+		bInputsDirty |= Acked > 0;
+	}
+}
+
+// ============================================================
+//  Serveur : agrégation des inputs
+// ============================================================
+
+void ULockstepSubsystem::ServerReceiveInput(AController* From, uint32 Frame, const FLockstepInput& Input)
+{
+	const int32 PlayerIndex = ServerGetPlayerIndex(From);
+	if (PlayerIndex == INDEX_NONE || Frame < ServerNextConfirmFrame)
+		return;
+
+	// Borne la fenêtre : un client ne peut pas s'avancer indéfiniment
+	if (Frame > ServerNextConfirmFrame + LockstepConstants::TickRate * 10)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Lockstep: input du joueur %d trop en avance (frame %u)."), PlayerIndex, Frame);
+		return;
+	}
+
+	FPendingFrame& Pending = ServerPendingFrames.FindOrAdd(Frame);
+	if (Pending.Inputs.Num() == 0)
+	{
+		Pending.Inputs.SetNum(ServerPlayers.Num());
+	}
+
+	// Redondance : la même frame arrive dans plusieurs paquets, seule la première compte
+	if (Pending.ReceivedMask & (1u << PlayerIndex))
+		return;
+
+	Pending.Inputs[PlayerIndex] = Input;
+	Pending.ReceivedMask |= 1u << PlayerIndex;
+
+	ServerTryConfirmFrames();
+}
+
+void ULockstepSubsystem::ServerReceiveInputPacket(AController* From, const FLockstepInputPacket& Packet)
+{
+	// Accusé des frames confirmées : jamais en arrière (paquets désordonnés), jamais au-delà du confirmé
+	const int32 PlayerIndex = ServerGetPlayerIndex(From);
+	if (ServerPeers.IsValidIndex(PlayerIndex))
+	{
+		FServerPeer& Peer = ServerPeers[PlayerIndex];
+		Peer.AckFrame = FMath::Clamp(Packet.AckFrame, Peer.AckFrame, ServerNextConfirmFrame);
+	}
+
+	// Fin de partie : seul l'accusé compte encore
+	if (!bRunning)
+		return;
+
+	const int32 Count = FMath::Min(Packet.Inputs.Num(), LockstepConstants::MaxPacketInputs);
+	for (int32 i = 0; i < Count; i++)
+	{
+		const uint32 Frame = Packet.FirstFrame + i;
+		if (Frame >= ServerNextConfirmFrame)
+		{
+			ServerReceiveInput(From, Frame, Packet.Inputs[i]);
+		}
+	}
+}
+
+uint32 ULockstepSubsystem::ServerGetExpectedMask() const
+{
+	// Un joueur déconnecté envoie implicitement des inputs vides
+	uint32 Mask = 0;
+	for (int32 i = 0; i < ServerPlayers.Num(); i++)
+	{
+		if (ServerPlayers[i].IsValid())
+		{
+			Mask |= 1u << i;
+		}
+	}
+	return Mask;
+}
+
+void ULockstepSubsystem::ServerTryConfirmFrames()
+{
+	const uint32 Expected = ServerGetExpectedMask();
+
+	// Confirmation strictement dans l'ordre des frames
+	while (FPendingFrame* Pending = ServerPendingFrames.Find(ServerNextConfirmFrame))
+	{
+		if ((Pending->ReceivedMask & Expected) != Expected)
+			break;
+
+		const uint32 Frame = ServerNextConfirmFrame;
+		TArray<FLockstepInput> Inputs = MoveTemp(Pending->Inputs);
+		ServerPendingFrames.Remove(Frame);
+		ServerNextConfirmFrame++;
+
+		// Simulation locale (serveur dédié ou hôte) : sans passer par le réseau
+		ReceiveConfirmedFrame(Frame, Inputs);
+
+		// Clients distants : ServerSendConfirmedFrames en fin de Tick
+		ServerConfirmedHistory.Add(Frame, MoveTemp(Inputs));
+	}
+}
+
+void ULockstepSubsystem::ServerSendConfirmedFrames()
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	const uint8 NumPlayers = static_cast<uint8>(ServerPlayers.Num());
+	uint32 OldestNeeded = ServerNextConfirmFrame;
+
+	for (int32 i = 0; i < ServerPlayers.Num(); i++)
+	{
+		ACustomPlayerController* PC = Cast<ACustomPlayerController>(ServerPlayers[i].Get());
+		if (!PC || PC->IsLocalController())
+			continue;
+
+		FServerPeer& Peer = ServerPeers[i];
+		OldestNeeded = FMath::Min(OldestNeeded, Peer.AckFrame);
+		if (Peer.AckFrame >= ServerNextConfirmFrame)
+			continue;
+
+		// Nouvelle frame confirmée ; sinon seulement un renvoi de temps en temps
+		if (Peer.SentUntilFrame == ServerNextConfirmFrame && Now - Peer.LastSendSeconds < InputResendSeconds)
+			continue;
+
+		// Les plus anciennes d'abord : ce sont elles qui bloquent le client
+		FLockstepFramePacket Packet;
+		Packet.FirstFrame = Peer.AckFrame;
+		Packet.NumPlayers = NumPlayers;
+		const uint32 LastFrame = FMath::Min(ServerNextConfirmFrame, Peer.AckFrame + LockstepConstants::MaxPacketFrames);
+		for (uint32 Frame = Peer.AckFrame; Frame < LastFrame; Frame++)
+		{
+			const TArray<FLockstepInput>* Inputs = ServerConfirmedHistory.Find(Frame);
+			if (!Inputs)
+				break;
+			Packet.Inputs.Append(*Inputs);
+		}
+
+		PC->Client_ReceiveLockstepFrames(Packet);
+		Peer.SentUntilFrame = ServerNextConfirmFrame;
+		Peer.LastSendSeconds = Now;
+	}
+
+	// Accusées par tous les clients distants (ou leur controller a disparu)
+	for (auto It = ServerConfirmedHistory.CreateIterator(); It; ++It)
+	{
+		if (It.Key() < OldestNeeded)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+int32 ULockstepSubsystem::ServerGetPlayerIndex(const AController* Controller) const
+{
+	for (int32 i = 0; i < ServerPlayers.Num(); i++)
+	{
+		if (ServerPlayers[i].Get() == Controller)
+			return i;
+	}
+	return INDEX_NONE;
+}
+
+// ============================================================
+//  Serveur : détection de désync
+// ============================================================
+
+void ULockstepSubsystem::ServerReceiveTurnChecksum(ACustomPlayerController* From, int32 Turn, uint32 Checksum)
+{
+	const int32 PlayerIndex = ServerGetPlayerIndex(From);
+	if (PlayerIndex == INDEX_NONE)
+		return;
+
+	ServerCheckChecksum(Turn, PlayerIndex, Checksum);
+}
+
+void ULockstepSubsystem::ServerCheckChecksum(int32 Turn, int32 PlayerIndex, uint32 Checksum)
+{
+	if (PlayerIndex == INDEX_NONE)
+	{
+		// Checksum de référence (simulation du serveur) : vérifie les rapports en attente
+		ServerTurnChecksums.Add(Turn, Checksum);
+
+		TArray<TPair<int32, uint32>> Reports;
+		ServerPendingReports.MultiFind(Turn, Reports);
+		ServerPendingReports.Remove(Turn);
+		for (const TPair<int32, uint32>& Report : Reports)
+		{
+			ServerCheckChecksum(Turn, Report.Key, Report.Value);
+		}
+
+		// On ne garde que l'historique récent
+		ServerTurnChecksums.Remove(Turn - 8);
+		return;
+	}
+
+	const uint32* Expected = ServerTurnChecksums.Find(Turn);
+	if (!Expected)
+	{
+		ServerPendingReports.Add(Turn, TPair<int32, uint32>(PlayerIndex, Checksum));
+		return;
+	}
+
+	if (*Expected != Checksum)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Lockstep: DESYNC tour %d joueur %d (serveur %08x, client %08x)."),
+			Turn, PlayerIndex, *Expected, Checksum);
+		OnDesync.Broadcast(Turn, PlayerIndex);
+	}
+}
+
+// ============================================================
+//  Présentation
+// ============================================================
+
+void ULockstepSubsystem::BindWormActor(int32 WormIndex, AActor* Actor)
+{
+	if (!Actor)
+	{
+		BoundActors.Remove(WormIndex);
+		return;
+	}
+
+	// La position vient de la simulation : plus de mouvement répliqué ni simulé
+	if (Actor->HasAuthority())
+	{
+		Actor->SetReplicateMovement(false);
+	}
+	if (ACharacter* Character = Cast<ACharacter>(Actor))
+	{
+		Character->GetCharacterMovement()->DisableMovement();
+	}
+
+	BoundActors.Add(WormIndex, Actor);
+
+	// Liaison en cours de partie (réplication tardive) : placé sans attendre la frame suivante
+	if (bRunning)
+	{
+		SyncBoundActors();
+	}
+}
+
+void ULockstepSubsystem::SyncBoundActors()
+{
+	const TArray<FLockstepWorm>& Worms = Simulation.GetState().Worms;
+	for (const TPair<int32, TWeakObjectPtr<AActor>>& Pair : BoundActors)
+	{
+		AActor* Actor = Pair.Value.Get();
+		if (!Actor || !Worms.IsValidIndex(Pair.Key))
+			continue;
+
+		const FLockstepWorm& Worm = Worms[Pair.Key];
+		Actor->SetActorLocation(Worm.Position.ToVector(Actor->GetActorLocation().Y));
+		Actor->SetActorHiddenInGame(!Worm.bAlive);
+	}
+}
+
+ACustomPlayerController* ULockstepSubsystem::GetLocalController() const
+{
+	UWorld* World = GetWorld();
+	return World ? Cast<ACustomPlayerController>(World->GetFirstPlayerController()) : nullptr;
+}
+
+// ============================================================
+//  Statistiques de match (serveur)
+//
+//  Le game thread ne fait que remplir des FMatchStatsRecord et les
+//  pousser dans la file du FMatchStatsWriter ; encodage et disque
+//  sont sur son thread.
+// ============================================================
+
+void ULockstepSubsystem::StatsBeginMatch()
+{
+	// Tous les clients simulent la même partie : un seul journal, celui du serveur
+	const UWorld* World = GetWorld();
+	UWormsGameInstance* GI = World ? Cast<UWormsGameInstance>(World->GetGameInstance()) : nullptr;
+	bStatsRecording = bRecordMatchStats && GI && World->GetNetMode() != NM_Client;
+	if (!bStatsRecording)
+		return;
+
+	StatsWriter = &GI->GetMatchStatsWriter();
+
+	const FLockstepMatchConfig& Config = Simulation.GetConfig();
+	FMatchStatsRecord Record;
+	Record.Type = EMatchStatsRecord::MatchBegin;
+	Record.StartTicksUtc = FDateTime::UtcNow().GetTicks();
+	Record.NumPlayers = static_cast<uint8>(Config.NumPlayers);
+	Record.UnitsPerPlayer = static_cast<uint8>(Config.UnitsPerPlayer);
+	Record.UnitLife = Config.UnitLife;
+	Record.Seed = Config.Seed;
+	Record.TurnsBeforeWater = Config.TurnsBeforeWater;
+	StatsWriter->Push(Record);
+
+	bStatsShotThisTurn = false;
+	StatsTurnStartFrame = Simulation.GetState().Frame;
+	StatsTurnStartSeconds = FPlatformTime::Seconds();
+}
+
+void ULockstepSubsystem::StatsRecordFrame(uint32 Frame, int32 Turn, TConstArrayView<FLockstepInput> Inputs,
+	int32 ActivePlayer, bool bShotBefore, bool bTurnEnded, uint32 Checksum)
+{
+	const FLockstepState& State = Simulation.GetState();
+
+	// Tir : le drapeau passe à true pendant cette frame (un tir ne clôt jamais le tour dans la même frame)
+	if (!bShotBefore && State.bShotFiredThisTurn)
+	{
+		FMatchStatsRecord Record;
+		Record.Type = EMatchStatsRecord::Shot;
+		Record.Frame = Frame;
+		Record.Turn = Turn;
+		Record.Player = static_cast<uint8>(ActivePlayer);
+		Record.Worm = static_cast<uint8>(FMath::Max(0, State.GetActiveWormIndex()));
+		if (Inputs.IsValidIndex(ActivePlayer))
+		{
+			Record.AimAngle = Inputs[ActivePlayer].AimAngle;
+			Record.Power = Inputs[ActivePlayer].Power;
+		}
+		Record.WindRaw = State.Wind.Raw;
+		StatsWriter->Push(Record);
+		bStatsShotThisTurn = true;
+	}
+
+	for (const FLockstepDamageOp& Op : Simulation.GetLastDamageOps())
+	{
+		if (!State.Worms.IsValidIndex(Op.WormIndex))
+			continue;
+
+		const FLockstepWorm& Worm = State.Worms[Op.WormIndex];
+
+		EMatchStatsCause Cause = EMatchStatsCause::Weapon;
+		switch (Op.Cause)
+		{
+		case ELockstepDamageCause::Fall:  Cause = EMatchStatsCause::Fall; break;
+		case ELockstepDamageCause::Water: Cause = EMatchStatsCause::Water; break;
+		default: break;
+		}
+
+		FMatchStatsRecord Record;
+		Record.Type = EMatchStatsRecord::Damage;
+		Record.Frame = Frame;
+		Record.Turn = Turn;
+		Record.Player = Worm.OwnerPlayer;
+		Record.Worm = Op.WormIndex;
+		Record.Damage = Op.Damage;
+		Record.Cause = Cause;
+		Record.bKill = Op.bKill;
+		StatsWriter->Push(Record);
+
+		if (Op.bKill)
+		{
+			Record.Type = EMatchStatsRecord::Death;
+			StatsWriter->Push(Record);
+		}
+	}
+
+	if (!bTurnEnded)
+		return;
+
+	const double Now = FPlatformTime::Seconds();
+	FMatchStatsRecord Record;
+	Record.Type = EMatchStatsRecord::TurnEnd;
+	Record.Frame = Frame;
+	Record.Turn = Turn;
+	Record.Player = static_cast<uint8>(ActivePlayer);
+	Record.TurnTicks = static_cast<int32>(Frame + 1 - StatsTurnStartFrame);
+	Record.TurnMs = static_cast<uint32>((Now - StatsTurnStartSeconds) * 1000.0);
+	Record.WaterRow = State.Water.GetRow();
+	Record.bShot = bStatsShotThisTurn;
+	Record.Checksum = Checksum;
+	StatsWriter->Push(Record);
+
+	bStatsShotThisTurn = false;
+	StatsTurnStartFrame = Frame + 1;
+	StatsTurnStartSeconds = Now;
+}
+
+void ULockstepSubsystem::StatsEndMatch()
+{
+	if (!bStatsRecording)
+		return;
+
+	bStatsRecording = false;
+
+	const FLockstepState& State = Simulation.GetState();
+	const bool bComplete = Simulation.CountAlivePlayers() <= 1;
+
+	// Vainqueur : propriétaire du dernier worm vivant, 0xFF pour une égalité ou un match interrompu
+	uint8 Winner = 0xFF;
+	if (bComplete)
+	{
+		for (const FLockstepWorm& Worm : State.Worms)
+		{
+			if (Worm.bAlive)
+			{
+				Winner = Worm.OwnerPlayer;
+				break;
+			}
+		}
+	}
+
+	FMatchStatsRecord Record;
+	Record.Type = EMatchStatsRecord::MatchEnd;
+	Record.Frame = State.Frame;
+	Record.Turn = State.Turn;
+	Record.Player = Winner;
+	Record.bComplete = bComplete;
+	StatsWriter->Push(Record);
+
+	// Fin de match : inutile d'attendre la période pour que le match soit sur disque
+	StatsWriter->Flush();
+}
+
+// ============================================================
+//  Console : Worms.BotMatch [NumBots]
+//  Serveur headless : -ExecCmds="Worms.BotMatch 4" lance une partie
+//  100 % bots, rejouable à l'identique pour les soaks de perf.
+// ============================================================
+static FAutoConsoleCommandWithWorldAndArgs GBotMatchCommand(
+	TEXT("Worms.BotMatch"),
+	TEXT("Lance une partie lockstep avec NumBots bots en plus des joueurs connectes. Usage: Worms.BotMatch [NumBots]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		ULockstepSubsystem* Lockstep = World ? World->GetSubsystem<ULockstepSubsystem>() : nullptr;
+		if (!Lockstep)
+			return;
+
+		const int32 NumBots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 4;
+		// Complété par StartLockstepMatch pour que joueurs + bots >= 2
+		Lockstep->StartBotMatch(FMath::Clamp(NumBots, 0, LockstepConstants::MaxPlayers));
+	})
+);
\ No newline at end of file
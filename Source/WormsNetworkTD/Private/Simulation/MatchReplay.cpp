@@ -0,0 +1,612 @@
+#include "Simulation/MatchReplay.h"
+#include "Profiling/LockstepBenchmark.h"
+#include "Profiling/ProfilingReport.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Compression.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	enum class EReplayChunk : uint8
+	{
+		Keyframe = 1,
+		Turn = 2,
+		End = 0xFF
+	};
+
+	void SerializeConfig(FArchive& Ar, FLockstepMatchConfig& Config)
+	{
+		Ar << Config.NumPlayers;
+		Ar << Config.UnitsPerPlayer;
+		Ar << Config.UnitLife;
+		Ar << Config.TicksPerTurn;
+		Ar << Config.Seed;
+		Ar << Config.MapWidthCells;
+		Ar << Config.MapHeightCells;
+		Ar << Config.TurnsBeforeWater;
+		Ar << Config.WaterRiseCells;
+	}
+
+	void SerializeDamageOp(FArchive& Ar, FLockstepDamageOp& Op)
+	{
+		Ar << Op.Frame;
+		Ar << Op.WormIndex;
+		Ar << Op.Damage;
+		Ar << Op.Impulse.X.Raw;
+		Ar << Op.Impulse.Z.Raw;
+		uint8 Cause = static_cast<uint8>(Op.Cause);
+		Ar << Cause;
+		Op.Cause = static_cast<ELockstepDamageCause>(Cause);
+	}
+
+	bool IsSameDamage(const FLockstepDamageOp& A, const FLockstepDamageOp& B)
+	{
+		return A.Frame == B.Frame && A.WormIndex == B.WormIndex && A.Damage == B.Damage
+			&& A.Impulse == B.Impulse && A.Cause == B.Cause;
+	}
+
+	bool IsIdleFrame(TConstArrayView<FLockstepInput> Inputs)
+	{
+		for (const FLockstepInput& Input : Inputs)
+		{
+			if (!(Input == FLockstepInput()))
+				return false;
+		}
+		return true;
+	}
+}
+
+// ============================================================
+//  Écriture
+// ============================================================
+
+void FMatchReplayWriter::Begin(const FLockstepMatchConfig& Config, const FLockstepState& InitialState)
+{
+	Buffer.Reset();
+	Keyframes.Reset();
+	Writer = MakeUnique<FMemoryWriter>(Buffer);
+	NumPlayers = Config.NumPlayers;
+	bRecording = true;
+
+	uint32 Magic = MatchReplayConstants::Magic;
+	uint32 Version = MatchReplayConstants::Version;
+	FLockstepMatchConfig ConfigCopy = Config;
+	*Writer << Magic;
+	*Writer << Version;
+	SerializeConfig(*Writer, ConfigCopy);
+
+	WriteKeyframe(InitialState);
+
+	CurrentTurn = FMatchReplayTurn();
+	CurrentTurn.Turn = InitialState.Turn;
+	CurrentTurn.StartFrame = InitialState.Frame;
+	TurnBits = MakeUnique<FBitWriter>(0, true);
+}
+
+void FMatchReplayWriter::WriteKeyframe(const FLockstepState& State)
+{
+	TArray<uint8> Raw;
+	FMemoryWriter RawWriter(Raw);
+	const_cast<FLockstepState&>(State).Serialize(RawWriter);
+
+	// Le terrain RLE se compresse encore bien (colonnes répétitives)
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Raw.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Raw.GetData(), Raw.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Replay: compression du keyframe echouee (frame %u)."), State.Frame);
+		return;
+	}
+	Compressed.SetNum(CompressedSize);
+
+	FMatchReplayKeyframe& Keyframe = Keyframes.AddDefaulted_GetRef();
+	Keyframe.Frame = State.Frame;
+	Keyframe.Turn = State.Turn;
+	Keyframe.Offset = Writer->Tell();
+
+	uint8 Type = static_cast<uint8>(EReplayChunk::Keyframe);
+	uint32 Frame = State.Frame;
+	int32 Turn = State.Turn;
+	int32 RawSize = Raw.Num();
+	*Writer << Type;
+	*Writer << Frame;
+	*Writer << Turn;
+	*Writer << RawSize;
+	*Writer << Compressed;
+}
+
+void FMatchReplayWriter::RecordFrame(uint32 Frame, TConstArrayView<FLockstepInput> Inputs, TConstArrayView<FLockstepDamageOp> DamageOps)
+{
+	if (!bRecording)
+		return;
+
+	// La grande majorité des frames n'a aucun input : 1 bit
+	const bool bIdle = IsIdleFrame(Inputs);
+	TurnBits->WriteBit(bIdle ? 0 : 1);
+	if (!bIdle)
+	{
+		for (int32 p = 0; p < NumPlayers; p++)
+		{
+			FLockstepInput Input = Inputs.IsValidIndex(p) ? Inputs[p] : FLockstepInput();
+			bool bSuccess = false;
+			Input.NetSerialize(*TurnBits, nullptr, bSuccess);
+		}
+	}
+
+	CurrentTurn.NumFrames++;
+	CurrentTurn.DamageOps.Append(DamageOps.GetData(), DamageOps.Num());
+}
+
+void FMatchReplayWriter::RecordTurnEnd(int32 Turn, uint32 Checksum, const FLockstepState& State)
+{
+	if (!bRecording)
+		return;
+
+	CurrentTurn.Checksum = Checksum;
+	CurrentTurn.bComplete = true;
+	FlushTurn();
+
+	if (State.Turn % MatchReplayConstants::KeyframeIntervalTurns == 0)
+	{
+		WriteKeyframe(State);
+	}
+
+	CurrentTurn = FMatchReplayTurn();
+	CurrentTurn.Turn = State.Turn;
+	CurrentTurn.StartFrame = State.Frame;
+	TurnBits = MakeUnique<FBitWriter>(0, true);
+}
+
+void FMatchReplayWriter::FlushTurn()
+{
+	uint8 Type = static_cast<uint8>(EReplayChunk::Turn);
+	int64 NumBits = TurnBits->GetNumBits();
+	TArray<uint8> Packed(TurnBits->GetData(), static_cast<int32>(TurnBits->GetNumBytes()));
+
+	*Writer << Type;
+	*Writer << CurrentTurn.Turn;
+	*Writer << CurrentTurn.StartFrame;
+	*Writer << CurrentTurn.NumFrames;
+	*Writer << CurrentTurn.Checksum;
+	*Writer << CurrentTurn.bComplete;
+	*Writer << NumBits;
+	*Writer << Packed;
+
+	int32 NumOps = CurrentTurn.DamageOps.Num();
+	*Writer << NumOps;
+	for (FLockstepDamageOp& Op : CurrentTurn.DamageOps)
+	{
+		SerializeDamageOp(*Writer, Op);
+	}
+}
+
+bool FMatchReplayWriter::Finalize(TArray<uint8>& OutData)
+{
+	if (!bRecording)
+		return false;
+
+	if (CurrentTurn.NumFrames > 0)
+	{
+		FlushTurn();
+	}
+
+	uint8 Type = static_cast<uint8>(EReplayChunk::End);
+	*Writer << Type;
+
+	// Index des keyframes en fin de fichier, retrouvé via le dernier int64
+	int64 IndexOffset = Writer->Tell();
+	int32 NumKeyframes = Keyframes.Num();
+	*Writer << NumKeyframes;
+	for (FMatchReplayKeyframe& Keyframe : Keyframes)
+	{
+		*Writer << Keyframe.Frame;
+		*Writer << Keyframe.Turn;
+		*Writer << Keyframe.Offset;
+	}
+	*Writer << IndexOffset;
+
+	bRecording = false;
+	Writer.Reset();
+	TurnBits.Reset();
+
+	OutData = MoveTemp(Buffer);
+	Buffer.Reset();
+	return true;
+}
+
+bool FMatchReplayWriter::Finish(const FString& Path)
+{
+	TArray<uint8> Data;
+	if (!Finalize(Data))
+		return false;
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	const bool bSaved = FFileHelper::SaveArrayToFile(Data, *Path);
+	UE_LOG(LogTemp, Warning, TEXT("Replay: %s (%d octets, %d keyframes)."),
+		bSaved ? *Path : TEXT("ECHEC d'ecriture"), Data.Num(), Keyframes.Num());
+	return bSaved;
+}
+
+TFuture<bool> FMatchReplayWriter::SaveAsync(const FString& Path, TArray<uint8>&& Data)
+{
+	return Async(EAsyncExecution::ThreadPool, [Path, Data = MoveTemp(Data)]()
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+		const bool bSaved = FFileHelper::SaveArrayToFile(Data, *Path);
+		UE_LOG(LogTemp, Warning, TEXT("Replay: %s (%d octets)."), bSaved ? *Path : TEXT("ECHEC d'ecriture"), Data.Num());
+		return bSaved;
+	});
+}
+
+FString FMatchReplayWriter::MakeDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"),
+		FString::Printf(TEXT("Match_%s%s"), *FDateTime::Now().ToString(), MatchReplayConstants::FileExtension));
+}
+
+// ============================================================
+//  Lecture
+// ============================================================
+
+bool FMatchReplayReader::Open(const FString& Path)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Replay: impossible de lire %s."), *Path);
+		return false;
+	}
+	return OpenFromMemory(MoveTemp(FileData));
+}
+
+bool FMatchReplayReader::OpenFromMemory(TArray<uint8>&& InData)
+{
+	Data = MoveTemp(InData);
+	Keyframes.Reset();
+	Turns.Reset();
+	DecodedTurnIndex = INDEX_NONE;
+	return Parse();
+}
+
+bool FMatchReplayReader::Parse()
+{
+	if (Data.Num() < 16)
+		return false;
+
+	FMemoryReader Ar(Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != MatchReplayConstants::Magic || Version != MatchReplayConstants::Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Replay: en-tete invalide (magic %08x, version %u)."), Magic, Version);
+		return false;
+	}
+	SerializeConfig(Ar, Config);
+	const int64 ChunksStart = Ar.Tell();
+
+	// ----- Index des keyframes -----
+	int64 IndexOffset = 0;
+	Ar.Seek(Data.Num() - sizeof(int64));
+	Ar << IndexOffset;
+	if (IndexOffset <= 0 || IndexOffset >= Data.Num())
+		return false;
+
+	Ar.Seek(IndexOffset);
+	int32 NumKeyframes = 0;
+	Ar << NumKeyframes;
+	if (NumKeyframes <= 0 || NumKeyframes > Data.Num())
+		return false;
+
+	Keyframes.SetNum(NumKeyframes);
+	for (FMatchReplayKeyframe& Keyframe : Keyframes)
+	{
+		Ar << Keyframe.Frame;
+		Ar << Keyframe.Turn;
+		Ar << Keyframe.Offset;
+	}
+
+	// ----- Chunks de tours (les keyframes sont sautés) -----
+	Ar.Seek(ChunksStart);
+
+	while (!Ar.IsError() && Ar.Tell() < IndexOffset)
+	{
+		uint8 Type = 0;
+		Ar << Type;
+
+		if (Type == static_cast<uint8>(EReplayChunk::End))
+			break;
+
+		if (Type == static_cast<uint8>(EReplayChunk::Keyframe))
+		{
+			uint32 Frame = 0;
+			int32 Turn = 0;
+			int32 RawSize = 0;
+			int32 CompressedSize = 0;
+			Ar << Frame << Turn << RawSize;
+			Ar << CompressedSize;
+			Ar.Seek(Ar.Tell() + CompressedSize);
+			continue;
+		}
+
+		if (Type != static_cast<uint8>(EReplayChunk::Turn))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Replay: chunk inconnu %u a l'offset %lld."), Type, Ar.Tell() - 1);
+			return false;
+		}
+
+		FMatchReplayTurn& Turn = Turns.AddDefaulted_GetRef();
+		Ar << Turn.Turn;
+		Ar << Turn.StartFrame;
+		Ar << Turn.NumFrames;
+		Ar << Turn.Checksum;
+		Ar << Turn.bComplete;
+		Ar << Turn.PackedInputBits;
+		Ar << Turn.PackedInputs;
+
+		int32 NumOps = 0;
+		Ar << NumOps;
+		if (NumOps < 0 || NumOps > Data.Num())
+			return false;
+		Turn.DamageOps.SetNum(NumOps);
+		for (FLockstepDamageOp& Op : Turn.DamageOps)
+		{
+			SerializeDamageOp(Ar, Op);
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+uint32 FMatchReplayReader::GetNumFrames() const
+{
+	return Turns.Num() > 0 ? Turns.Last().StartFrame + Turns.Last().NumFrames : 0;
+}
+
+int32 FMatchReplayReader::FindTurnIndex(uint32 Frame) const
+{
+	// Tours contigus et triés : recherche dichotomique
+	const int32 Index = Algo::UpperBoundBy(Turns, Frame, &FMatchReplayTurn::StartFrame) - 1;
+	if (!Turns.IsValidIndex(Index) || Frame >= Turns[Index].StartFrame + Turns[Index].NumFrames)
+		return INDEX_NONE;
+	return Index;
+}
+
+void FMatchReplayReader::DecodeTurn(int32 TurnIndex) const
+{
+	if (DecodedTurnIndex == TurnIndex)
+		return;
+
+	const FMatchReplayTurn& Turn = Turns[TurnIndex];
+	const int32 NumPlayers = Config.NumPlayers;
+	DecodedInputs.Reset();
+	DecodedInputs.SetNum(Turn.NumFrames * NumPlayers);
+
+	FBitReader Reader(const_cast<uint8*>(Turn.PackedInputs.GetData()), Turn.PackedInputBits);
+	for (uint32 f = 0; f < Turn.NumFrames && !Reader.IsError(); f++)
+	{
+		if (!Reader.ReadBit())
+			continue;
+
+		for (int32 p = 0; p < NumPlayers; p++)
+		{
+			bool bSuccess = false;
+			DecodedInputs[f * NumPlayers + p].NetSerialize(Reader, nullptr, bSuccess);
+		}
+	}
+
+	DecodedTurnIndex = TurnIndex;
+}
+
+bool FMatchReplayReader::GetFrameInputs(uint32 Frame, TArray<FLockstepInput>& OutInputs) const
+{
+	const int32 TurnIndex = FindTurnIndex(Frame);
+	if (TurnIndex == INDEX_NONE)
+		return false;
+
+	DecodeTurn(TurnIndex);
+	const int32 NumPlayers = Config.NumPlayers;
+	const int32 Local = static_cast<int32>(Frame - Turns[TurnIndex].StartFrame);
+	OutInputs.Reset();
+	OutInputs.Append(&DecodedInputs[Local * NumPlayers], NumPlayers);
+	return true;
+}
+
+bool FMatchReplayReader::LoadKeyframe(const FMatchReplayKeyframe& Keyframe, FLockstepSimulation& Sim) const
+{
+	FMemoryReader Ar(Data);
+	Ar.Seek(Keyframe.Offset);
+
+	uint8 Type = 0;
+	uint32 Frame = 0;
+	int32 Turn = 0;
+	int32 RawSize = 0;
+	TArray<uint8> Compressed;
+	Ar << Type << Frame << Turn << RawSize;
+	Ar << Compressed;
+	if (Ar.IsError() || Type != static_cast<uint8>(EReplayChunk::Keyframe) || RawSize <= 0)
+		return false;
+
+	TArray<uint8> Raw;
+	Raw.SetNumUninitialized(RawSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), RawSize, Compressed.GetData(), Compressed.Num()))
+		return false;
+
+	Sim.Init(Config);
+	FMemoryReader StateReader(Raw);
+	Sim.GetMutableState().Serialize(StateReader);
+	return !StateReader.IsError();
+}
+
+bool FMatchReplayReader::SeekToFrame(uint32 Frame, FLockstepSimulation& Sim) const
+{
+	// Dernier keyframe <= Frame
+	const int32 KeyIndex = Algo::UpperBoundBy(Keyframes, Frame, &FMatchReplayKeyframe::Frame) - 1;
+	if (!Keyframes.IsValidIndex(KeyIndex) || !LoadKeyframe(Keyframes[KeyIndex], Sim))
+		return false;
+
+	while (Sim.GetState().Frame < Frame)
+	{
+		if (!StepFrame(Sim))
+			return false;
+	}
+	return true;
+}
+
+bool FMatchReplayReader::StepFrame(FLockstepSimulation& Sim) const
+{
+	TArray<FLockstepInput> Inputs;
+	if (!GetFrameInputs(Sim.GetState().Frame, Inputs))
+		return false;
+
+	Sim.Step(Inputs);
+	return true;
+}
+
+// ============================================================
+//  Vérification headless
+// ============================================================
+
+bool FMatchReplayReader::Verify(FString& OutError) const
+{
+	if (Keyframes.Num() == 0)
+	{
+		OutError = TEXT("aucun keyframe");
+		return false;
+	}
+
+	// La config seule doit reproduire le snapshot initial
+	FLockstepSimulation Sim;
+	Sim.Init(Config);
+	const uint32 InitChecksum = Sim.ComputeChecksum();
+	if (!LoadKeyframe(Keyframes[0], Sim) || Sim.ComputeChecksum() != InitChecksum)
+	{
+		OutError = TEXT("le keyframe initial ne correspond pas a la config");
+		return false;
+	}
+
+	TArray<FLockstepInput> Inputs;
+	for (int32 t = 0; t < Turns.Num(); t++)
+	{
+		const FMatchReplayTurn& Turn = Turns[t];
+		int32 OpCursor = 0;
+		bool bTurnEnded = false;
+
+		for (uint32 f = 0; f < Turn.NumFrames; f++)
+		{
+			const uint32 Frame = Turn.StartFrame + f;
+			if (Sim.GetState().Frame != Frame || !GetFrameInputs(Frame, Inputs))
+			{
+				OutError = FString::Printf(TEXT("flux d'inputs discontinu a la frame %u"), Frame);
+				return false;
+			}
+
+			bTurnEnded = Sim.Step(Inputs);
+
+			for (const FLockstepDamageOp& Op : Sim.GetLastDamageOps())
+			{
+				if (!Turn.DamageOps.IsValidIndex(OpCursor) || !IsSameDamage(Op, Turn.DamageOps[OpCursor]))
+				{
+					OutError = FString::Printf(TEXT("degats divergents au tour %d, frame %u (worm %u)"), Turn.Turn, Frame, Op.WormIndex);
+					return false;
+				}
+				OpCursor++;
+			}
+		}
+
+		if (OpCursor != Turn.DamageOps.Num())
+		{
+			OutError = FString::Printf(TEXT("degats enregistres non reproduits au tour %d"), Turn.Turn);
+			return false;
+		}
+
+		if (Turn.bComplete && (!bTurnEnded || Sim.ComputeChecksum() != Turn.Checksum))
+		{
+			OutError = FString::Printf(TEXT("checksum divergent a la fin du tour %d (%08x attendu, %08x obtenu)"),
+				Turn.Turn, Turn.Checksum, Sim.ComputeChecksum());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ============================================================
+//  Commandes console
+// ============================================================
+
+static FAutoConsoleCommand GReplayVerifyCommand(
+	TEXT("Worms.Replay.Verify"),
+	TEXT("Re-simule un replay et verifie checksums et degats. Sans chemin, enregistre d'abord un match scripte. Usage: Worms.Replay.Verify [Path] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		FString Path = Args.Num() > 0 && !Args[0].Equals(TEXT("exit"), ESearchCase::IgnoreCase) ? Args[0] : FString();
+
+		if (Path.IsEmpty())
+		{
+			// Match scripté (mêmes inputs que Worms.LockstepBench)
+			FLockstepMatchConfig Config;
+			Config.NumPlayers = 4;
+			Config.UnitsPerPlayer = 2;
+			Config.Seed = 1234;
+
+			FLockstepSimulation Sim;
+			Sim.Init(Config);
+			FMatchReplayWriter Writer;
+			Writer.Begin(Sim.GetConfig(), Sim.GetState());
+
+			TArray<FLockstepInput> Inputs;
+			while (Sim.GetState().Turn < 20 && Sim.CountAlivePlayers() > 1)
+			{
+				FLockstepBenchmark::MakeScriptedInputs(Sim.GetState(), Sim.GetConfig().NumPlayers, Inputs);
+				const uint32 Frame = Sim.GetState().Frame;
+				const int32 Turn = Sim.GetState().Turn;
+				const bool bTurnEnded = Sim.Step(Inputs);
+				Writer.RecordFrame(Frame, Inputs, Sim.GetLastDamageOps());
+				if (bTurnEnded)
+				{
+					Writer.RecordTurnEnd(Turn, Sim.ComputeChecksum(), Sim.GetState());
+				}
+			}
+
+			Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"), FString(TEXT("Scripted")) + MatchReplayConstants::FileExtension);
+			Writer.Finish(Path);
+		}
+
+		FMatchReplayReader Reader;
+		if (Reader.Open(Path))
+		{
+			const double VerifyStart = FPlatformTime::Seconds();
+			FString Error;
+			const bool bValid = Reader.Verify(Error);
+			const double VerifyMs = (FPlatformTime::Seconds() - VerifyStart) * 1000.0;
+
+			// Seek au milieu du match : keyframe + au plus KeyframeIntervalTurns tours
+			FLockstepSimulation Sim;
+			const double SeekStart = FPlatformTime::Seconds();
+			const bool bSeek = Reader.SeekToFrame(Reader.GetNumFrames() / 2, Sim);
+			const double SeekMs = (FPlatformTime::Seconds() - SeekStart) * 1000.0;
+
+			UE_LOG(LogTemp, Warning, TEXT("Replay: %s | %lld octets | %u frames | %d tours | %d keyframes | verify %s (%.1f ms) | seek %s (%.2f ms)%s%s"),
+				*Path, IFileManager::Get().FileSize(*Path), Reader.GetNumFrames(), Reader.GetTurns().Num(), Reader.GetKeyframes().Num(),
+				bValid ? TEXT("OK") : TEXT("ECHEC"), VerifyMs, bSeek ? TEXT("OK") : TEXT("ECHEC"), SeekMs,
+				bValid ? TEXT("") : TEXT(" : "), *Error);
+		}
+
+		if (bExit)
+		{
+			RequestEngineExit(TEXT("Replay verify termine"));
+		}
+	})
+);
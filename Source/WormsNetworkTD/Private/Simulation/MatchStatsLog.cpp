@@ -0,0 +1,445 @@
+#include "Simulation/MatchStatsLog.h"
+#include "Simulation/LockstepTypes.h"
+#include "Profiling/ProfilingReport.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	// Magic, Version
+	constexpr int32 FileHeaderSize = 8;
+
+	// Un octet sur disque (FArchive << bool en écrit quatre)
+	void SerializeFlag(FArchive& Ar, bool& bValue)
+	{
+		uint8 Byte = bValue ? 1 : 0;
+		Ar << Byte;
+		bValue = Byte != 0;
+	}
+
+	void SerializeCause(FArchive& Ar, EMatchStatsCause& Cause)
+	{
+		uint8 Byte = static_cast<uint8>(Cause);
+		Ar << Byte;
+		Cause = static_cast<EMatchStatsCause>(Byte);
+	}
+}
+
+void FMatchStatsRecord::Serialize(FArchive& Ar)
+{
+	uint8 TypeByte = static_cast<uint8>(Type);
+	Ar << TypeByte;
+	Type = static_cast<EMatchStatsRecord>(TypeByte);
+
+	switch (Type)
+	{
+	case EMatchStatsRecord::MatchBegin:
+		Ar << StartTicksUtc << NumPlayers << UnitsPerPlayer << UnitLife << Seed << TurnsBeforeWater;
+		break;
+
+	case EMatchStatsRecord::Shot:
+		Ar << Frame << Turn << Player << Worm << AimAngle << Power << WindRaw;
+		break;
+
+	case EMatchStatsRecord::Damage:
+		Ar << Frame << Turn << Player << Worm << Damage;
+		SerializeCause(Ar, Cause);
+		SerializeFlag(Ar, bKill);
+		break;
+
+	case EMatchStatsRecord::Death:
+		Ar << Frame << Turn << Player << Worm;
+		SerializeCause(Ar, Cause);
+		break;
+
+	case EMatchStatsRecord::TurnEnd:
+		Ar << Turn << Player << TurnTicks << TurnMs << WaterRow;
+		SerializeFlag(Ar, bShot);
+		Ar << Checksum;
+		break;
+
+	case EMatchStatsRecord::MatchEnd:
+		Ar << Frame << Turn << Player;
+		SerializeFlag(Ar, bComplete);
+		break;
+
+	default:
+		// Type inconnu (version plus récente) : la longueur permet de le sauter
+		Ar.SetError();
+		break;
+	}
+}
+
+// ============================================================
+//  Écriture
+// ============================================================
+
+FMatchStatsWriter::FMatchStatsWriter(const FString& InPath)
+	: Path(InPath)
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("MatchStatsWriter"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MatchStats: pas de thread d'ecriture, vidage a la destruction."));
+	}
+}
+
+FMatchStatsWriter::~FMatchStatsWriter()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+	else
+	{
+		// Sans thread : Run sur l'appelant, ouverture et un seul vidage
+		bStopRequested = true;
+		Run();
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+FString FMatchStatsWriter::MakeDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MatchStats"),
+		FString::Printf(TEXT("Stats_%s%s"), *FDateTime::Now().ToString(), MatchStatsConstants::FileExtension));
+}
+
+void FMatchStatsWriter::Push(const FMatchStatsRecord& Record)
+{
+	Queue.Enqueue(Record);
+}
+
+void FMatchStatsWriter::Flush()
+{
+	WakeEvent->Trigger();
+}
+
+void FMatchStatsWriter::Stop()
+{
+	bStopRequested = true;
+	WakeEvent->Trigger();
+}
+
+uint32 FMatchStatsWriter::Run()
+{
+	// Ouverture sur ce thread aussi : le game thread ne touche jamais au disque
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	const bool bNewFile = PlatformFile.FileSize(*Path) <= 0;
+
+	File.Reset(PlatformFile.OpenWrite(*Path, true, false));
+	if (!File)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MatchStats: ouverture de %s impossible, statistiques perdues."), *Path);
+	}
+	else if (bNewFile)
+	{
+		uint32 Magic = MatchStatsConstants::Magic;
+		uint32 Version = MatchStatsConstants::Version;
+		Scratch.Reset();
+		FMemoryWriter Header(Scratch);
+		Header << Magic << Version;
+		File->Write(Scratch.GetData(), Scratch.Num());
+	}
+
+	// Ne lit pas Thread : Create peut lancer Run avant que le constructeur l'ait assigné
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(MatchStatsConstants::FlushIntervalMs);
+		Drain();
+	}
+	Drain();
+
+	File.Reset();
+	return 0;
+}
+
+void FMatchStatsWriter::Drain()
+{
+	Scratch.Reset();
+	FMemoryWriter Writer(Scratch);
+
+	int64 Count = 0;
+	FMatchStatsRecord Record;
+	while (Queue.Dequeue(Record))
+	{
+		// Longueur réservée puis réécrite une fois l'enregistrement encodé
+		const int64 LengthOffset = Writer.Tell();
+		uint16 Length = 0;
+		Writer << Length;
+
+		Record.Serialize(Writer);
+
+		const int64 End = Writer.Tell();
+		Length = static_cast<uint16>(End - LengthOffset - sizeof(uint16));
+		Writer.Seek(LengthOffset);
+		Writer << Length;
+		Writer.Seek(End);
+		Count++;
+	}
+
+	if (Count == 0)
+		return;
+
+	// Tout le lot en une écriture
+	if (File && File->Write(Scratch.GetData(), Scratch.Num()))
+	{
+		File->Flush();
+		NumWritten += Count;
+	}
+	else
+	{
+		NumDropped += Count;
+	}
+}
+
+// ============================================================
+//  Lecture
+// ============================================================
+
+bool FMatchStatsReader::ReadFile(const FString& Path, TFunctionRef<void(const FMatchStatsRecord&)> Visit, bool& bOutTruncated)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+	{
+		bOutTruncated = false;
+		return false;
+	}
+	return ReadMemory(Data, Visit, bOutTruncated);
+}
+
+bool FMatchStatsReader::ReadMemory(TConstArrayView<uint8> Data, TFunctionRef<void(const FMatchStatsRecord&)> Visit, bool& bOutTruncated)
+{
+	bOutTruncated = false;
+	if (Data.Num() < FileHeaderSize)
+		return false;
+
+	FMemoryReaderView Header(Data.Left(FileHeaderSize));
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Header << Magic << Version;
+	if (Magic != MatchStatsConstants::Magic || Version < 1)
+		return false;
+
+	int32 Offset = FileHeaderSize;
+	while (Offset < Data.Num())
+	{
+		if (Data.Num() - Offset < static_cast<int32>(sizeof(uint16)))
+		{
+			bOutTruncated = true;
+			break;
+		}
+
+		const int32 Length = Data[Offset] | (Data[Offset + 1] << 8);
+		Offset += sizeof(uint16);
+		if (Length == 0 || Data.Num() - Offset < Length)
+		{
+			bOutTruncated = true;
+			break;
+		}
+
+		// Type inconnu ou enregistrement plus court qu'attendu : ignoré, on passe au suivant
+		FMemoryReaderView Reader(Data.Slice(Offset, Length));
+		FMatchStatsRecord Record;
+		Record.Serialize(Reader);
+		if (!Reader.IsError())
+		{
+			Visit(Record);
+		}
+		Offset += Length;
+	}
+	return true;
+}
+
+// ============================================================
+//  Agrégation hors ligne
+//
+//  Lit tous les .wstat d'un dossier en parallèle (un fichier par
+//  tâche, totaux fusionnés à la fin) et résume équilibrage et
+//  exploitation : tirs, dégâts par cause, morts, durée des tours,
+//  hauteur d'eau en fin de match.
+//
+//  Rapport : Saved/Profiling/MatchStats.txt
+//  Console : Worms.MatchStats [Dossier] [exit]
+// ============================================================
+namespace
+{
+	struct FMatchStatsTotals
+	{
+		int64 Bytes = 0;
+		int64 Records = 0;
+		int32 FilesTruncated = 0;
+		int32 FilesInvalid = 0;
+		int32 Matches = 0;
+		int32 MatchesComplete = 0;
+		int64 Turns = 0;
+		int64 TurnsWithShot = 0;
+		int64 TurnTicks = 0;
+		int64 TurnMs = 0;
+		uint32 TurnMsMax = 0;
+		int64 Shots = 0;
+		int64 DamageByCause[3] = {};
+		int64 Kills = 0;
+		int64 DeathsByCause[3] = {};
+		int64 EndWaterRows = 0;
+
+		void Merge(const FMatchStatsTotals& Other)
+		{
+			Bytes += Other.Bytes;
+			Records += Other.Records;
+			FilesTruncated += Other.FilesTruncated;
+			FilesInvalid += Other.FilesInvalid;
+			Matches += Other.Matches;
+			MatchesComplete += Other.MatchesComplete;
+			Turns += Other.Turns;
+			TurnsWithShot += Other.TurnsWithShot;
+			TurnTicks += Other.TurnTicks;
+			TurnMs += Other.TurnMs;
+			TurnMsMax = FMath::Max(TurnMsMax, Other.TurnMsMax);
+			Shots += Other.Shots;
+			Kills += Other.Kills;
+			EndWaterRows += Other.EndWaterRows;
+			for (int32 i = 0; i < 3; i++)
+			{
+				DamageByCause[i] += Other.DamageByCause[i];
+				DeathsByCause[i] += Other.DeathsByCause[i];
+			}
+		}
+	};
+
+	void AggregateFile(const FString& Path, FMatchStatsTotals& Totals)
+	{
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+		{
+			Totals.FilesInvalid++;
+			return;
+		}
+		Totals.Bytes += Data.Num();
+
+		int32 LastWaterRow = 0;
+		bool bTruncated = false;
+		const bool bValid = FMatchStatsReader::ReadMemory(Data, [&Totals, &LastWaterRow](const FMatchStatsRecord& Record)
+		{
+			Totals.Records++;
+			const int32 Cause = FMath::Clamp(static_cast<int32>(Record.Cause), 0, 2);
+
+			switch (Record.Type)
+			{
+			case EMatchStatsRecord::MatchBegin:
+				Totals.Matches++;
+				LastWaterRow = 0;
+				break;
+			case EMatchStatsRecord::Shot:
+				Totals.Shots++;
+				break;
+			case EMatchStatsRecord::Damage:
+				Totals.DamageByCause[Cause] += Record.Damage;
+				Totals.Kills += Record.bKill ? 1 : 0;
+				break;
+			case EMatchStatsRecord::Death:
+				Totals.DeathsByCause[Cause]++;
+				break;
+			case EMatchStatsRecord::TurnEnd:
+				Totals.Turns++;
+				Totals.TurnsWithShot += Record.bShot ? 1 : 0;
+				Totals.TurnTicks += Record.TurnTicks;
+				Totals.TurnMs += Record.TurnMs;
+				Totals.TurnMsMax = FMath::Max(Totals.TurnMsMax, Record.TurnMs);
+				LastWaterRow = Record.WaterRow;
+				break;
+			case EMatchStatsRecord::MatchEnd:
+				Totals.MatchesComplete += Record.bComplete ? 1 : 0;
+				Totals.EndWaterRows += LastWaterRow;
+				break;
+			default:
+				break;
+			}
+		}, bTruncated);
+
+		Totals.FilesInvalid += bValid ? 0 : 1;
+		Totals.FilesTruncated += bTruncated ? 1 : 0;
+	}
+
+	void RunMatchStatsAggregate(const FString& Directory, bool bExitWhenDone)
+	{
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, FString(TEXT("*")) + MatchStatsConstants::FileExtension), true, false);
+
+		// Un total par fichier : aucune synchronisation pendant la lecture
+		TArray<FMatchStatsTotals> PerFile;
+		PerFile.SetNum(Files.Num());
+		ParallelFor(Files.Num(), [&Files, &PerFile, &Directory](int32 Index)
+		{
+			AggregateFile(FPaths::Combine(Directory, Files[Index]), PerFile[Index]);
+		});
+
+		FMatchStatsTotals Totals;
+		for (const FMatchStatsTotals& FileTotals : PerFile)
+		{
+			Totals.Merge(FileTotals);
+		}
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+		const auto PerTurn = [&Totals](double Value) { return Totals.Turns > 0 ? Value / Totals.Turns : 0.0; };
+		const auto PerMatch = [&Totals](double Value) { return Totals.Matches > 0 ? Value / Totals.Matches : 0.0; };
+		const int64 DamageTotal = Totals.DamageByCause[0] + Totals.DamageByCause[1] + Totals.DamageByCause[2];
+
+		FProfilingReport Report(TEXT("MatchStats"), 1, FString::Printf(TEXT("files=%d | dir=%s"), Files.Num(), *Directory));
+		Report.AddInt(TEXT("files_truncated"), Totals.FilesTruncated);
+		Report.AddInt(TEXT("files_invalid"), Totals.FilesInvalid);
+		Report.AddInt(TEXT("records"), Totals.Records);
+		Report.AddInt(TEXT("matches"), Totals.Matches);
+		Report.AddInt(TEXT("matches_complete"), Totals.MatchesComplete);
+		Report.AddInt(TEXT("turns"), Totals.Turns);
+		Report.AddFloat(TEXT("turns_per_match"), PerMatch(Totals.Turns), 2);
+		Report.AddFloat(TEXT("turn_sim_seconds_avg"), PerTurn(Totals.TurnTicks) / LockstepConstants::TickRate, 3);
+		Report.AddFloat(TEXT("turn_wall_ms_avg"), PerTurn(Totals.TurnMs), 1);
+		Report.AddInt(TEXT("turn_wall_ms_max"), Totals.TurnMsMax);
+		Report.AddInt(TEXT("shots"), Totals.Shots);
+		Report.AddFloat(TEXT("shot_turn_ratio"), PerTurn(Totals.TurnsWithShot), 3);
+		Report.AddInt(TEXT("damage_total"), DamageTotal);
+		Report.AddInt(TEXT("damage_weapon"), Totals.DamageByCause[0]);
+		Report.AddInt(TEXT("damage_fall"), Totals.DamageByCause[1]);
+		Report.AddInt(TEXT("damage_water"), Totals.DamageByCause[2]);
+		Report.AddFloat(TEXT("damage_per_shot"), Totals.Shots > 0 ? static_cast<double>(Totals.DamageByCause[0]) / Totals.Shots : 0.0, 2);
+		Report.AddInt(TEXT("kills"), Totals.Kills);
+		Report.AddInt(TEXT("deaths_weapon"), Totals.DeathsByCause[0]);
+		Report.AddInt(TEXT("deaths_fall"), Totals.DeathsByCause[1]);
+		Report.AddInt(TEXT("deaths_water"), Totals.DeathsByCause[2]);
+		Report.AddFloat(TEXT("water_row_end_avg"), Totals.MatchesComplete > 0 ? static_cast<double>(Totals.EndWaterRows) / Totals.MatchesComplete : 0.0, 2);
+		Report.AddFloat(TEXT("read_mb"), Totals.Bytes / (1024.0 * 1024.0), 2);
+		Report.AddFloat(TEXT("aggregate_ms"), ElapsedMs, 1);
+		Report.WriteAndMaybeExit(bExitWhenDone);
+	}
+}
+
+static FAutoConsoleCommand GMatchStatsCommand(
+	TEXT("Worms.MatchStats"),
+	TEXT("Agrege tous les journaux .wstat d'un dossier (defaut : Saved/MatchStats). Usage: Worms.MatchStats [Dossier] [exit]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const bool bExit = FProfilingReport::HasExitArg(Args);
+		const FString Directory = Args.Num() > 0 && !Args[0].Equals(TEXT("exit"), ESearchCase::IgnoreCase)
+			? Args[0]
+			: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MatchStats"));
+		RunMatchStatsAggregate(Directory, bExit);
+	})
+);
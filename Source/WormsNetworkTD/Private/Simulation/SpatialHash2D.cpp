@@ -0,0 +1,167 @@
+#include "Simulation/SpatialHash2D.h"
+
+FSpatialHash2D::FSpatialHash2D(float InCellSize, int32 InNumBuckets)
+	: CellSize(FMath::Max(1.f, InCellSize))
+	, InvCellSize(1.f / FMath::Max(1.f, InCellSize))
+{
+	const int32 NumBuckets = static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(16, InNumBuckets)));
+	BucketMask = static_cast<uint32>(NumBuckets - 1);
+	BucketHeads.Init(INDEX_NONE, NumBuckets);
+}
+
+void FSpatialHash2D::Reset()
+{
+	for (int32& Head : BucketHeads)
+	{
+		Head = INDEX_NONE;
+	}
+	Entries.Reset();
+	FreeList.Reset();
+	NumUsed = 0;
+}
+
+// ============================================================
+//  Entrées
+// ============================================================
+
+int32 FSpatialHash2D::Add(const FVector2D& Position, uint8 Category, int32 UserData)
+{
+	const int32 Handle = FreeList.Num() > 0 ? FreeList.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+
+	FEntry& Entry = Entries[Handle];
+	Entry.Position = Position;
+	Entry.Cell = ToCell(Position);
+	Entry.UserData = UserData;
+	Entry.Category = Category;
+	Entry.bUsed = true;
+
+	Link(Handle);
+	NumUsed++;
+	return Handle;
+}
+
+void FSpatialHash2D::Remove(int32 Handle)
+{
+	if (!IsValidHandle(Handle))
+		return;
+
+	Unlink(Handle);
+	Entries[Handle] = FEntry();
+	FreeList.Add(Handle);
+	NumUsed--;
+}
+
+void FSpatialHash2D::Update(int32 Handle, const FVector2D& Position)
+{
+	if (!IsValidHandle(Handle))
+		return;
+
+	FEntry& Entry = Entries[Handle];
+	Entry.Position = Position;
+
+	const FIntPoint NewCell = ToCell(Position);
+	if (NewCell == Entry.Cell)
+		return;
+
+	Unlink(Handle);
+	Entry.Cell = NewCell;
+	Link(Handle);
+}
+
+void FSpatialHash2D::Link(int32 Handle)
+{
+	FEntry& Entry = Entries[Handle];
+	int32& Head = BucketHeads[BucketOf(Entry.Cell)];
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = Handle;
+	}
+	Head = Handle;
+}
+
+void FSpatialHash2D::Unlink(int32 Handle)
+{
+	FEntry& Entry = Entries[Handle];
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		BucketHeads[BucketOf(Entry.Cell)] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+// ============================================================
+//  Requêtes
+// ============================================================
+
+template<typename FunctorType>
+void FSpatialHash2D::ForEachInRadius(const FVector2D& Center, float Radius, uint8 CategoryMask, FunctorType&& Functor) const
+{
+	const double RadiusSq = static_cast<double>(Radius) * Radius;
+	const FIntPoint MinCell = ToCell(Center - FVector2D(Radius, Radius));
+	const FIntPoint MaxCell = ToCell(Center + FVector2D(Radius, Radius));
+
+	for (int32 CY = MinCell.Y; CY <= MaxCell.Y; CY++)
+	{
+		for (int32 CX = MinCell.X; CX <= MaxCell.X; CX++)
+		{
+			const FIntPoint Cell(CX, CY);
+			for (int32 Handle = BucketHeads[BucketOf(Cell)]; Handle != INDEX_NONE; Handle = Entries[Handle].Next)
+			{
+				const FEntry& Entry = Entries[Handle];
+
+				// Collision de hash : l'entrée appartient à une autre cellule
+				if (Entry.Cell != Cell || !(Entry.Category & CategoryMask))
+					continue;
+
+				const double DistSq = FVector2D::DistSquared(Entry.Position, Center);
+				if (DistSq <= RadiusSq)
+				{
+					Functor(Handle, static_cast<float>(DistSq));
+				}
+			}
+		}
+	}
+}
+
+void FSpatialHash2D::QueryRadiusBatch(TConstArrayView<FSpatialBlast> Blasts, FSpatialBatchResult& OutResult) const
+{
+	OutResult.Hits.Reset();
+	OutResult.BlastOffsets.Reset(Blasts.Num() + 1);
+
+	for (int32 i = 0; i < Blasts.Num(); i++)
+	{
+		const FSpatialBlast& Blast = Blasts[i];
+		OutResult.BlastOffsets.Add(OutResult.Hits.Num());
+
+		ForEachInRadius(Blast.Center, Blast.Radius, Blast.CategoryMask, [&OutResult, i](int32 Handle, float DistSq)
+		{
+			OutResult.Hits.Add({ i, Handle, DistSq });
+		});
+	}
+
+	OutResult.BlastOffsets.Add(OutResult.Hits.Num());
+}
+
+void FSpatialHash2D::QueryRadius(const FVector2D& Center, float Radius, uint8 CategoryMask, TArray<int32>& OutHandles) const
+{
+	OutHandles.Reset();
+	ForEachInRadius(Center, Radius, CategoryMask, [&OutHandles](int32 Handle, float)
+	{
+		OutHandles.Add(Handle);
+	});
+}
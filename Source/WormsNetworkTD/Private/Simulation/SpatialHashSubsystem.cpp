@@ -0,0 +1,98 @@
+#include "Simulation/SpatialHashSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+void USpatialHashSubsystem::Deinitialize()
+{
+	for (const FRegisteredActor& Entry : Registered)
+	{
+		if (USceneComponent* Root = Entry.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Entry.TransformHandle);
+		}
+	}
+
+	Registered.Reset();
+	ActorToHandle.Reset();
+	Hash.Reset();
+
+	Super::Deinitialize();
+}
+
+// ============================================================
+//  Enregistrement
+// ============================================================
+
+void USpatialHashSubsystem::RegisterActor(AActor* Actor, uint8 Category)
+{
+	if (!Actor || !Actor->GetRootComponent() || ActorToHandle.Contains(Actor))
+		return;
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	const int32 Handle = Hash.Add(ToPlane(Root->GetComponentLocation()), Category);
+
+	if (!Registered.IsValidIndex(Handle))
+	{
+		Registered.SetNum(Handle + 1);
+	}
+
+	FRegisteredActor& Entry = Registered[Handle];
+	Entry.Actor = Actor;
+	Entry.Root = Root;
+	Entry.TransformHandle = Root->TransformUpdated.AddUObject(this, &USpatialHashSubsystem::HandleTransformUpdated, Handle);
+
+	ActorToHandle.Add(Actor, Handle);
+}
+
+void USpatialHashSubsystem::UnregisterActor(AActor* Actor)
+{
+	int32 Handle = INDEX_NONE;
+	if (!ActorToHandle.RemoveAndCopyValue(Actor, Handle))
+		return;
+
+	FRegisteredActor& Entry = Registered[Handle];
+	if (USceneComponent* Root = Entry.Root.Get())
+	{
+		Root->TransformUpdated.Remove(Entry.TransformHandle);
+	}
+	Entry = FRegisteredActor();
+
+	Hash.Remove(Handle);
+}
+
+void USpatialHashSubsystem::HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 Handle)
+{
+	// O(1) : simple écriture si l'acteur reste dans sa cellule
+	Hash.Update(Handle, ToPlane(Component->GetComponentLocation()));
+}
+
+// ============================================================
+//  Requêtes
+// ============================================================
+
+void USpatialHashSubsystem::QueryExplosions(TConstArrayView<FSpatialBlast> Blasts, FSpatialBatchResult& OutResult) const
+{
+	Hash.QueryRadiusBatch(Blasts, OutResult);
+}
+
+TArray<AActor*> USpatialHashSubsystem::QueryRadius(FVector Center, float Radius) const
+{
+	TArray<int32> Handles;
+	Hash.QueryRadius(ToPlane(Center), Radius, SpatialCategory::All, Handles);
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(Handles.Num());
+	for (const int32 Handle : Handles)
+	{
+		if (AActor* Actor = GetActor(Handle))
+		{
+			Actors.Add(Actor);
+		}
+	}
+	return Actors;
+}
+
+AActor* USpatialHashSubsystem::GetActor(int32 Handle) const
+{
+	return Registered.IsValidIndex(Handle) ? Registered[Handle].Actor.Get() : nullptr;
+}
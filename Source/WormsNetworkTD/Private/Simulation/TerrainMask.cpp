@@ -0,0 +1,164 @@
+#include "Simulation/TerrainMask.h"
+#include "Misc/Crc.h"
+
+// ============================================================
+//  Construction
+// ============================================================
+
+void FTerrainMask::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	WordsPerRow = (Width + 63) >> 6;
+	Bits.SetNumZeroed(WordsPerRow * Height);
+}
+
+void FTerrainMask::SetSolid(int32 X, int32 Y, bool bSolid)
+{
+	if (!IsValidCell(X, Y))
+		return;
+
+	uint64& Word = Bits[Y * WordsPerRow + (X >> 6)];
+	const uint64 Mask = 1ull << (X & 63);
+	Word = bSolid ? (Word | Mask) : (Word & ~Mask);
+}
+
+void FTerrainMask::FillColumnsFromHeights(const TArray<int32>& ColumnHeights)
+{
+	for (int32 X = 0; X < Width && X < ColumnHeights.Num(); X++)
+	{
+		const int32 Top = FMath::Clamp(ColumnHeights[X], 0, Height);
+		for (int32 Y = 0; Y < Top; Y++)
+		{
+			SetSolid(X, Y, true);
+		}
+	}
+}
+
+// ============================================================
+//  Destruction
+// ============================================================
+
+bool FTerrainMask::CarveCircle(int32 CenterX, int32 CenterY, int32 Radius, int32& OutMinRow, int32& OutMaxRow)
+{
+	OutMinRow = INDEX_NONE;
+	OutMaxRow = INDEX_NONE;
+
+	if (Radius <= 0 || Width == 0)
+		return false;
+
+	const int32 MinY = FMath::Max(0, CenterY - Radius);
+	const int32 MaxY = FMath::Min(Height - 1, CenterY + Radius);
+	const int32 R2 = Radius * Radius;
+	bool bChanged = false;
+
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		// Demi-largeur entière de la corde à cette hauteur
+		const int32 DY = Y - CenterY;
+		int32 Half = 0;
+		while ((Half + 1) * (Half + 1) + DY * DY <= R2)
+		{
+			Half++;
+		}
+
+		const int32 X0 = FMath::Max(0, CenterX - Half);
+		const int32 X1 = FMath::Min(Width - 1, CenterX + Half);
+		if (X0 > X1)
+			continue;
+
+		// Efface la plage [X0, X1] mot par mot
+		uint64* Row = &Bits[Y * WordsPerRow];
+		bool bRowChanged = false;
+		for (int32 W = X0 >> 6; W <= (X1 >> 6); W++)
+		{
+			const int32 Lo = FMath::Max(X0, W << 6) & 63;
+			const int32 Hi = FMath::Min(X1, (W << 6) + 63) & 63;
+			const uint64 HiMask = Hi == 63 ? ~0ull : ((1ull << (Hi + 1)) - 1);
+			const uint64 Mask = HiMask & ~((1ull << Lo) - 1);
+			if (Row[W] & Mask)
+			{
+				Row[W] &= ~Mask;
+				bRowChanged = true;
+			}
+		}
+
+		if (bRowChanged)
+		{
+			bChanged = true;
+			OutMinRow = OutMinRow == INDEX_NONE ? Y : FMath::Min(OutMinRow, Y);
+			OutMaxRow = FMath::Max(OutMaxRow, Y);
+		}
+	}
+
+	return bChanged;
+}
+
+// ============================================================
+//  Requêtes
+// ============================================================
+
+int32 FTerrainMask::FindGroundBelow(int32 X, int32 MaxY) const
+{
+	if (X < 0 || X >= Width)
+		return INDEX_NONE;
+
+	for (int32 Y = FMath::Min(MaxY, Height - 1); Y >= 0; Y--)
+	{
+		if (IsSolid(X, Y))
+			return Y;
+	}
+	return INDEX_NONE;
+}
+
+uint32 FTerrainMask::ComputeHash(uint32 Crc) const
+{
+	Crc = FCrc::MemCrc32(&Width, sizeof(Width), Crc);
+	Crc = FCrc::MemCrc32(&Height, sizeof(Height), Crc);
+	return FCrc::MemCrc32(Bits.GetData(), Bits.Num() * sizeof(uint64), Crc);
+}
+
+void FTerrainMask::Serialize(FArchive& Ar)
+{
+	Ar << Width;
+	Ar << Height;
+
+	if (Ar.IsLoading())
+	{
+		Init(Width, Height);
+	}
+
+	// Le masque est majoritairement fait de mots pleins ou vides :
+	// encodage RLE simple (valeur, nombre de répétitions).
+	if (Ar.IsSaving())
+	{
+		int32 i = 0;
+		while (i < Bits.Num())
+		{
+			uint64 Value = Bits[i];
+			uint32 Run = 1;
+			while (i + static_cast<int32>(Run) < Bits.Num() && Bits[i + Run] == Value)
+			{
+				Run++;
+			}
+			Ar << Value;
+			Ar.SerializeIntPacked(Run);
+			i += Run;
+		}
+	}
+	else
+	{
+		int32 i = 0;
+		while (i < Bits.Num() && !Ar.IsError())
+		{
+			uint64 Value = 0;
+			uint32 Run = 0;
+			Ar << Value;
+			Ar.SerializeIntPacked(Run);
+			for (uint32 k = 0; k < Run && i < Bits.Num(); k++)
+			{
+				Bits[i++] = Value;
+			}
+		}
+	}
+}
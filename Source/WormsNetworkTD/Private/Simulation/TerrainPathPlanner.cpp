@@ -0,0 +1,74 @@
+#include "Simulation/TerrainPathPlanner.h"
+
+int32 FTerrainPathPlanner::FindFeetY(const FTerrainMask& Terrain, int32 X, int32 FeetY)
+{
+	if (X < 0 || X >= Terrain.GetWidth())
+		return INDEX_NONE;
+
+	int32 NewFeetY = INDEX_NONE;
+
+	if (!Terrain.IsSolid(X, FeetY))
+	{
+		// Même niveau ou descente : premier sol sous les pieds
+		const int32 Ground = Terrain.FindGroundBelow(X, FeetY - 1);
+		if (Ground == INDEX_NONE || FeetY - (Ground + 1) > MaxDropCells)
+			return INDEX_NONE;
+		NewFeetY = Ground + 1;
+	}
+	else
+	{
+		// Montée : première cellule libre au-dessus du rebord
+		for (int32 Y = FeetY + 1; Y <= FeetY + MaxJumpCells; Y++)
+		{
+			if (!Terrain.IsSolid(X, Y))
+			{
+				NewFeetY = Y;
+				break;
+			}
+		}
+		if (NewFeetY == INDEX_NONE)
+			return INDEX_NONE;
+	}
+
+	// Le corps occupe deux cellules
+	return Terrain.IsSolid(X, NewFeetY + 1) ? INDEX_NONE : NewFeetY;
+}
+
+int32 FTerrainPathPlanner::PlanWalk(const FTerrainMask& Terrain, int32 FromX, int32 FromFeetY, int32 ToX,
+	int32 MaxColumns, int32 WaterRow, TArray<FTerrainPathStep>& OutSteps)
+{
+	OutSteps.Reset();
+	if (FromX == ToX)
+		return FromX;
+
+	const int32 Dir = ToX > FromX ? 1 : -1;
+	int32 X = FromX;
+	int32 FeetY = FromFeetY;
+
+	for (int32 i = 0; i < MaxColumns && X != ToX; i++)
+	{
+		const int32 NextX = X + Dir;
+		const int32 NextFeetY = FindFeetY(Terrain, NextX, FeetY);
+		if (NextFeetY == INDEX_NONE || NextFeetY < WaterRow)
+			break;
+
+		const bool bJump = NextFeetY - FeetY > 1;
+		if (bJump)
+		{
+			// Il faut pouvoir monter sur place avant de passer le rebord
+			bool bHeadroom = true;
+			for (int32 Y = FeetY + 2; Y <= NextFeetY + 1 && bHeadroom; Y++)
+			{
+				bHeadroom = !Terrain.IsSolid(X, Y);
+			}
+			if (!bHeadroom)
+				break;
+		}
+
+		OutSteps.Add({ NextX, NextFeetY, bJump });
+		X = NextX;
+		FeetY = NextFeetY;
+	}
+
+	return X;
+}
@@ -0,0 +1,281 @@
+#include "Simulation/TrajectorySolver.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	constexpr float InvCellSize = 1.f / FTerrainMask::CellSize;
+
+	void MakeLaunch(const FTrajectoryParams& Params, const FTrajectoryCandidate& Candidate,
+		float& OutPX, float& OutPZ, float& OutVX, float& OutVZ)
+	{
+		const float Speed = Params.MaxSpeed * FMath::Clamp(Candidate.Power01, 0.f, 1.f);
+		const float Radians = FMath::DegreesToRadians(Candidate.AngleDegrees);
+
+		OutPX = static_cast<float>(Params.Origin.X);
+		OutPZ = static_cast<float>(Params.Origin.Y) + TrajectoryConstants::SpawnHeight;
+		OutVX = FMath::Cos(Radians) * Speed;
+		OutVZ = FMath::Sin(Radians) * Speed;
+	}
+
+	/** Sortie de map : même règle que FLockstepSimulation::StepProjectiles. */
+	FORCEINLINE bool IsLost(float PX, float PZ, float MapWidth)
+	{
+		return PZ < 0.f || PX < 0.f || PX > MapWidth;
+	}
+
+	/**
+	 * Intégration scalaire d'un tir. Visitor(Tick, PX, PZ) est appelé à
+	 * chaque fin de tick encore en vol.
+	 */
+	template<typename VisitorType>
+	FTrajectoryImpact Integrate(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+		const FTrajectoryCandidate& Candidate, VisitorType&& Visitor)
+	{
+		const float MapWidth = static_cast<float>(Terrain.GetWidth() * FTerrainMask::CellSize);
+		const float WindDt = Params.Wind * TrajectoryConstants::Dt;
+		const float GravityDt = Params.Gravity * TrajectoryConstants::Dt;
+
+		float PX, PZ, VX, VZ;
+		MakeLaunch(Params, Candidate, PX, PZ, VX, VZ);
+
+		FTrajectoryImpact Impact;
+		for (int32 Tick = 1; Tick <= Params.MaxTicks; Tick++)
+		{
+			VX = VX + WindDt;
+			VZ = VZ + GravityDt;
+			const float DX = VX * TrajectoryConstants::Dt;
+			const float DZ = VZ * TrajectoryConstants::Dt;
+			const int32 Substeps = TrajectoryConstants::GetSubsteps(DX, DZ);
+			const float SX = DX / static_cast<float>(Substeps);
+			const float SZ = DZ / static_cast<float>(Substeps);
+
+			for (int32 s = 0; s < Substeps; s++)
+			{
+				PX = PX + SX;
+				PZ = PZ + SZ;
+
+				const bool bLost = IsLost(PX, PZ, MapWidth);
+				if (bLost || Terrain.IsSolid(FMath::FloorToInt(PX * InvCellSize), FMath::FloorToInt(PZ * InvCellSize)))
+				{
+					Impact.Position = FVector2D(PX, PZ);
+					Impact.Ticks = Tick;
+					Impact.bHitTerrain = !bLost;
+					return Impact;
+				}
+			}
+
+			Visitor(Tick, PX, PZ);
+		}
+
+		Impact.Position = FVector2D(PX, PZ);
+		Impact.Ticks = Params.MaxTicks;
+		return Impact;
+	}
+}
+
+// ============================================================
+//  Scalaire
+// ============================================================
+
+FTrajectoryImpact FTrajectorySolver::SimulateOne(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+	const FTrajectoryCandidate& Candidate)
+{
+	return Integrate(Terrain, Params, Candidate, [](int32, float, float) {});
+}
+
+FTrajectoryImpact FTrajectorySolver::BuildPreview(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+	const FTrajectoryCandidate& Candidate, TArray<FVector2D>& OutPoints, int32 PointEveryTicks)
+{
+	OutPoints.Reset();
+	const int32 Every = FMath::Max(1, PointEveryTicks);
+
+	float PX, PZ, VX, VZ;
+	MakeLaunch(Params, Candidate, PX, PZ, VX, VZ);
+	OutPoints.Add(FVector2D(PX, PZ));
+
+	const FTrajectoryImpact Impact = Integrate(Terrain, Params, Candidate, [&OutPoints, Every](int32 Tick, float X, float Z)
+	{
+		if (Tick % Every == 0)
+		{
+			OutPoints.Add(FVector2D(X, Z));
+		}
+	});
+
+	OutPoints.Add(Impact.Position);
+	return Impact;
+}
+
+// ============================================================
+//  SIMD : LaneCount candidats par paquet
+// ============================================================
+
+void FTrajectorySolver::SimulateBatch(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+	TConstArrayView<FTrajectoryCandidate> Candidates, TArrayView<FTrajectoryImpact> OutImpacts)
+{
+	check(OutImpacts.Num() == Candidates.Num());
+	constexpr int32 Lanes = TrajectoryConstants::LaneCount;
+
+	const float MapWidth = static_cast<float>(Terrain.GetWidth() * FTerrainMask::CellSize);
+	const VectorRegister4Float WindDt = VectorSetFloat1(Params.Wind * TrajectoryConstants::Dt);
+	const VectorRegister4Float GravityDt = VectorSetFloat1(Params.Gravity * TrajectoryConstants::Dt);
+	const VectorRegister4Float DtV = VectorSetFloat1(TrajectoryConstants::Dt);
+	const VectorRegister4Float InvCell = VectorSetFloat1(InvCellSize);
+
+	alignas(16) float PX[Lanes], PZ[Lanes], VX[Lanes], VZ[Lanes];
+	alignas(16) float SX[Lanes], SZ[Lanes];
+	alignas(16) int32 CellX[Lanes], CellZ[Lanes];
+	int32 Substeps[Lanes];
+
+	for (int32 Base = 0; Base < Candidates.Num(); Base += Lanes)
+	{
+		const int32 NumLanes = FMath::Min(Lanes, Candidates.Num() - Base);
+
+		// Voies inutilisées du dernier paquet : copie du dernier candidat, jamais lue
+		bool bDone[Lanes];
+		for (int32 L = 0; L < Lanes; L++)
+		{
+			MakeLaunch(Params, Candidates[Base + FMath::Min(L, NumLanes - 1)], PX[L], PZ[L], VX[L], VZ[L]);
+			bDone[L] = L >= NumLanes;
+		}
+
+		VectorRegister4Float X = VectorLoadAligned(PX);
+		VectorRegister4Float Z = VectorLoadAligned(PZ);
+		VectorRegister4Float VelX = VectorLoadAligned(VX);
+		VectorRegister4Float VelZ = VectorLoadAligned(VZ);
+
+		int32 InFlight = NumLanes;
+		int32 Tick = 1;
+		for (; Tick <= Params.MaxTicks && InFlight > 0; Tick++)
+		{
+			VelX = VectorAdd(VelX, WindDt);
+			VelZ = VectorAdd(VelZ, GravityDt);
+
+			// Sous-pas propres à chaque voie (règle de la simulation) : le pas est
+			// calculé en scalaire, la boucle va jusqu'au plus grand nombre de sous-pas
+			VectorStoreAligned(VectorMultiply(VelX, DtV), SX);
+			VectorStoreAligned(VectorMultiply(VelZ, DtV), SZ);
+			int32 TickSubsteps = 1;
+			for (int32 L = 0; L < Lanes; L++)
+			{
+				Substeps[L] = TrajectoryConstants::GetSubsteps(SX[L], SZ[L]);
+				SX[L] = SX[L] / static_cast<float>(Substeps[L]);
+				SZ[L] = SZ[L] / static_cast<float>(Substeps[L]);
+				TickSubsteps = bDone[L] ? TickSubsteps : FMath::Max(TickSubsteps, Substeps[L]);
+			}
+			VectorRegister4Float StepX = VectorLoadAligned(SX);
+			VectorRegister4Float StepZ = VectorLoadAligned(SZ);
+
+			for (int32 s = 0; s < TickSubsteps && InFlight > 0; s++)
+			{
+				// Voie qui a fini ses sous-pas pour ce tick : pas nul, elle attend les autres
+				bool bStepChanged = false;
+				for (int32 L = 0; L < Lanes; L++)
+				{
+					if (s > 0 && s == Substeps[L])
+					{
+						SX[L] = 0.f;
+						SZ[L] = 0.f;
+						bStepChanged = true;
+					}
+				}
+				if (bStepChanged)
+				{
+					StepX = VectorLoadAligned(SX);
+					StepZ = VectorLoadAligned(SZ);
+				}
+
+				X = VectorAdd(X, StepX);
+				Z = VectorAdd(Z, StepZ);
+
+				VectorStoreAligned(X, PX);
+				VectorStoreAligned(Z, PZ);
+				VectorIntStore(VectorFloatToInt(VectorFloor(VectorMultiply(X, InvCell))), CellX);
+				VectorIntStore(VectorFloatToInt(VectorFloor(VectorMultiply(Z, InvCell))), CellZ);
+
+				// Seul accès non vectorisé : un bit du masque par voie en vol
+				for (int32 L = 0; L < NumLanes; L++)
+				{
+					if (bDone[L])
+						continue;
+
+					const bool bLost = IsLost(PX[L], PZ[L], MapWidth);
+					if (bLost || Terrain.IsSolid(CellX[L], CellZ[L]))
+					{
+						FTrajectoryImpact& Impact = OutImpacts[Base + L];
+						Impact.Position = FVector2D(PX[L], PZ[L]);
+						Impact.Ticks = Tick;
+						Impact.bHitTerrain = !bLost;
+						bDone[L] = true;
+						InFlight--;
+					}
+				}
+			}
+		}
+
+		// Toujours en vol à MaxTicks
+		VectorStoreAligned(X, PX);
+		VectorStoreAligned(Z, PZ);
+		for (int32 L = 0; L < NumLanes; L++)
+		{
+			if (!bDone[L])
+			{
+				FTrajectoryImpact& Impact = OutImpacts[Base + L];
+				Impact.Position = FVector2D(PX[L], PZ[L]);
+				Impact.Ticks = Params.MaxTicks;
+				Impact.bHitTerrain = false;
+			}
+		}
+	}
+}
+
+// ============================================================
+//  Recherche de tir (bots)
+// ============================================================
+
+bool FTrajectorySolver::FindBestShot(const FTerrainMask& Terrain, const FTrajectoryParams& Params, const FVector2D& Target,
+	int32 AngleSteps, int32 PowerSteps, float MinSelfDistance,
+	FTrajectoryCandidate& OutBest, float& OutMissDistance)
+{
+	AngleSteps = FMath::Max(1, AngleSteps);
+	PowerSteps = FMath::Max(1, PowerSteps);
+
+	TArray<FTrajectoryCandidate> Candidates;
+	Candidates.Reserve(AngleSteps * PowerSteps);
+	for (int32 a = 0; a < AngleSteps; a++)
+	{
+		const float Angle = (a + 0.5f) * 180.f / AngleSteps;
+		for (int32 p = 0; p < PowerSteps; p++)
+		{
+			Candidates.Add({ Angle, static_cast<float>(p + 1) / PowerSteps });
+		}
+	}
+
+	TArray<FTrajectoryImpact> Impacts;
+	Impacts.SetNumUninitialized(Candidates.Num());
+	SimulateBatch(Terrain, Params, Candidates, Impacts);
+
+	const double MinSelfSq = static_cast<double>(MinSelfDistance) * MinSelfDistance;
+	double BestSq = TNumericLimits<double>::Max();
+	int32 BestIndex = INDEX_NONE;
+
+	for (int32 i = 0; i < Impacts.Num(); i++)
+	{
+		const FTrajectoryImpact& Impact = Impacts[i];
+		if (!Impact.bHitTerrain || FVector2D::DistSquared(Impact.Position, Params.Origin) <= MinSelfSq)
+			continue;
+
+		const double DistSq = FVector2D::DistSquared(Impact.Position, Target);
+		if (DistSq < BestSq)
+		{
+			BestSq = DistSq;
+			BestIndex = i;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+		return false;
+
+	OutBest = Candidates[BestIndex];
+	OutMissDistance = static_cast<float>(FMath::Sqrt(BestSq));
+	return true;
+}
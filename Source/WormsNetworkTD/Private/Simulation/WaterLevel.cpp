@@ -0,0 +1,122 @@
+#include "Simulation/WaterLevel.h"
+#include "Algo/BinarySearch.h"
+
+// ============================================================
+//  FWaterLevel
+// ============================================================
+
+void FWaterLevel::Init(const FTerrainMask& Terrain, int32 InRow)
+{
+	Width = Terrain.GetWidth();
+	Height = Terrain.GetHeight();
+	WordsPerRow = Terrain.GetWordsPerRow();
+	WaterBits.SetNumZeroed(WordsPerRow * Height);
+	Row = 0;
+
+	RaiseTo(InRow, Terrain);
+}
+
+int32 FWaterLevel::RaiseTo(int32 NewRow, const FTerrainMask& Terrain)
+{
+	NewRow = FMath::Clamp(NewRow, 0, Height);
+	if (NewRow <= Row)
+		return 0;
+
+	// Seules les lignes [Row, NewRow) passent sous l'eau
+	for (int32 Y = Row; Y < NewRow; Y++)
+	{
+		RebuildRow(Terrain, Y);
+	}
+
+	const int32 Processed = NewRow - Row;
+	Row = NewRow;
+	return Processed;
+}
+
+void FWaterLevel::OnTerrainChanged(const FTerrainMask& Terrain, int32 MinRow, int32 MaxRow)
+{
+	if (MinRow == INDEX_NONE)
+		return;
+
+	// Un trou creusé au-dessus de la ligne d'eau ne change rien
+	const int32 Last = FMath::Min(MaxRow, Row - 1);
+	for (int32 Y = FMath::Max(0, MinRow); Y <= Last; Y++)
+	{
+		RebuildRow(Terrain, Y);
+	}
+}
+
+void FWaterLevel::RebuildRow(const FTerrainMask& Terrain, int32 Y)
+{
+	const uint64* Solid = Terrain.GetRow(Y);
+	uint64* Water = &WaterBits[Y * WordsPerRow];
+
+	for (int32 W = 0; W < WordsPerRow; W++)
+	{
+		Water[W] = ~Solid[W];
+	}
+
+	// Masque les bits au-delà de Width dans le dernier mot
+	if (const int32 Tail = Width & 63)
+	{
+		Water[WordsPerRow - 1] &= (1ull << Tail) - 1;
+	}
+}
+
+// ============================================================
+//  FHeightIndex
+// ============================================================
+
+void FHeightIndex::Reset(int32 NumEntries)
+{
+	Sorted.Reset(NumEntries);
+	Heights.Init(0, NumEntries);
+	Removed.Init(false, NumEntries);
+
+	for (int32 i = 0; i < NumEntries; i++)
+	{
+		Sorted.Add({ 0, i });
+	}
+}
+
+void FHeightIndex::SetHeight(int32 Index, FFixed Z)
+{
+	if (!Heights.IsValidIndex(Index) || Removed[Index] || Heights[Index] == Z.Raw)
+		return;
+
+	const FEntry Old{ Heights[Index], Index };
+	const int32 OldPos = Algo::LowerBound(Sorted, Old);
+	if (Sorted.IsValidIndex(OldPos) && Sorted[OldPos].Index == Index)
+	{
+		Sorted.RemoveAt(OldPos, EAllowShrinking::No);
+	}
+
+	const FEntry New{ Z.Raw, Index };
+	Sorted.Insert(New, Algo::LowerBound(Sorted, New));
+	Heights[Index] = Z.Raw;
+}
+
+void FHeightIndex::Remove(int32 Index)
+{
+	if (!Heights.IsValidIndex(Index) || Removed[Index])
+		return;
+
+	const int32 Pos = Algo::LowerBound(Sorted, FEntry{ Heights[Index], Index });
+	if (Sorted.IsValidIndex(Pos) && Sorted[Pos].Index == Index)
+	{
+		Sorted.RemoveAt(Pos, EAllowShrinking::No);
+	}
+	Removed[Index] = true;
+}
+
+void FHeightIndex::CollectBelow(FFixed Z, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+
+	// Première entrée >= Z : tout ce qui précède est sous l'eau
+	const int32 End = Algo::LowerBound(Sorted, FEntry{ Z.Raw, MIN_int32 });
+	for (int32 i = 0; i < End; i++)
+	{
+		OutIndices.Add(Sorted[i].Index);
+	}
+}
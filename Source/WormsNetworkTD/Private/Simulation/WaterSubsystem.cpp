@@ -0,0 +1,63 @@
+#include "Simulation/WaterSubsystem.h"
+#include "Simulation/LockstepSubsystem.h"
+#include "Simulation/TerrainMask.h"
+#include "Actors/WormsMatchInfo.h"
+#include "WormsGameInstance.h"
+#include "Engine/World.h"
+
+void UWaterSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Menu et previews : pas de match, pas d'acteur répliqué à porter
+	if (InWorld.GetNetMode() == NM_Client || !UWormsGameInstance::IsMatchWorld(&InWorld))
+		return;
+
+	// Le serveur possède l'acteur répliqué qui porte le niveau
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	MatchInfo = InWorld.SpawnActor<AWormsMatchInfo>(Params);
+
+	if (ULockstepSubsystem* Lockstep = InWorld.GetSubsystem<ULockstepSubsystem>())
+	{
+		TurnEndedHandle = Lockstep->OnTurnEnded.AddUObject(this, &UWaterSubsystem::HandleTurnEnded);
+	}
+}
+
+void UWaterSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (ULockstepSubsystem* Lockstep = World->GetSubsystem<ULockstepSubsystem>())
+		{
+			Lockstep->OnTurnEnded.Remove(TurnEndedHandle);
+		}
+	}
+
+	MatchInfo = nullptr;
+	Super::Deinitialize();
+}
+
+float UWaterSubsystem::GetWaterWorldZ() const
+{
+	return static_cast<float>(WaterRow * FTerrainMask::CellSize);
+}
+
+void UWaterSubsystem::HandleTurnEnded(int32 Turn, uint32 Checksum)
+{
+	const ULockstepSubsystem* Lockstep = GetWorld()->GetSubsystem<ULockstepSubsystem>();
+	if (!Lockstep || !MatchInfo)
+		return;
+
+	// Une seule valeur quantifiée part sur le réseau, et seulement si elle change
+	MatchInfo->SetWaterLevelRow(Lockstep->GetSimulation().GetState().Water.GetRow());
+}
+
+void UWaterSubsystem::HandleWaterLevelRow(int32 Row)
+{
+	if (Row == WaterRow)
+		return;
+
+	WaterRow = Row;
+	OnWaterLevelChanged.Broadcast(GetWaterWorldZ(), WaterRow);
+}
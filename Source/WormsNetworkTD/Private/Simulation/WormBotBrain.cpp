@@ -0,0 +1,182 @@
+#include "Simulation/WormBotBrain.h"
+
+namespace
+{
+	// ----- Recherche de tir (~2300 candidats, quelques ms) -----
+	constexpr int32 ShotAngleSteps = 72;
+	constexpr int32 ShotPowerSteps = 32;
+	constexpr float ShotGoodEnough = 32.f;
+	constexpr float MinSelfDistance = 96.f;   // 1.5 x rayon d'explosion
+
+	// ----- Marche -----
+	constexpr int32 MaxWalkColumns = 60;
+	constexpr int32 MaxWalkFrames = 5 * LockstepConstants::TickRate;
+	constexpr int32 MaxStuckFrames = LockstepConstants::TickRate / 2;
+
+	// Pause avant de tirer (le joueur adverse voit la visée)
+	constexpr int32 AimDelayFrames = LockstepConstants::TickRate / 3;
+
+	int32 FeetCell(const FLockstepWorm& Worm)
+	{
+		return FTerrainMask::WorldToCell(Worm.Position.Z);
+	}
+}
+
+void FWormBotBrain::Reset(int32 InPlayerIndex)
+{
+	*this = FWormBotBrain();
+	PlayerIndex = InPlayerIndex;
+}
+
+// ============================================================
+//  Décision par frame
+// ============================================================
+
+FLockstepInput FWormBotBrain::Think(const FLockstepState& State)
+{
+	FLockstepInput Input;
+
+	const int32 WormIndex = State.GetActiveWormIndex();
+	if (State.ActivePlayer != PlayerIndex || !State.Worms.IsValidIndex(WormIndex) || !State.Worms[WormIndex].bAlive)
+	{
+		Phase = EPhase::Waiting;
+		return Input;
+	}
+
+	const FLockstepWorm& Self = State.Worms[WormIndex];
+	if (State.Turn != PlannedTurn)
+	{
+		PlannedTurn = State.Turn;
+		PlanTurn(State, Self);
+	}
+
+	if (State.bShotFiredThisTurn && Phase != EPhase::Retreating)
+	{
+		Phase = EPhase::Retreating;
+		MoveDir = -MoveDir;
+	}
+
+	const int32 CellX = FTerrainMask::WorldToCell(Self.Position.X);
+
+	switch (Phase)
+	{
+	case EPhase::Walking:
+	{
+		StuckFrames = CellX == LastCellX ? StuckFrames + 1 : 0;
+		LastCellX = CellX;
+
+		if (CellX == WalkEndX || ++WalkFrames > MaxWalkFrames || StuckFrames > MaxStuckFrames)
+		{
+			PlanShot(State, Self);
+			break;
+		}
+
+		Input.MoveAxis = static_cast<int8>(MoveDir);
+
+		// Saut si la prochaine colonne du chemin l'exige
+		const int32 NextX = CellX + MoveDir;
+		const FTerrainPathStep* Next = Path.FindByPredicate([NextX](const FTerrainPathStep& Step) { return Step.CellX == NextX; });
+		if (Next && Next->bJump && Self.bGrounded)
+		{
+			Input.Buttons |= LockstepConstants::Button_Jump;
+		}
+		break;
+	}
+
+	case EPhase::Aiming:
+		if (--AimFramesLeft <= 0)
+		{
+			// Même quantification que ULockstepSubsystem::QueueFire
+			Input.Buttons |= LockstepConstants::Button_Fire;
+			Input.AimAngle = static_cast<uint16>(FMath::RoundToInt(FMath::Fmod(Shot.AngleDegrees, 360.f) / 360.f * 65536.f) & 0xFFFF);
+			Input.Power = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Shot.Power01 * 255.f), 0, 255));
+		}
+		break;
+
+	case EPhase::Retreating:
+		// Un pas à la fois, jamais vers un trou ou l'eau
+		if (Self.bGrounded && FTerrainPathPlanner::FindFeetY(State.Terrain, CellX + MoveDir, FeetCell(Self)) >= State.Water.GetRow())
+		{
+			Input.MoveAxis = static_cast<int8>(MoveDir);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return Input;
+}
+
+// ============================================================
+//  Planification
+// ============================================================
+
+void FWormBotBrain::PlanTurn(const FLockstepState& State, const FLockstepWorm& Self)
+{
+	// Cible : ennemi vivant le plus proche
+	const FVector2D SelfPosition = Self.Position.ToPlane();
+	double BestDistSq = TNumericLimits<double>::Max();
+	for (const FLockstepWorm& Other : State.Worms)
+	{
+		if (!Other.bAlive || Other.OwnerPlayer == PlayerIndex)
+			continue;
+
+		const FVector2D OtherPosition = Other.Position.ToPlane();
+		const double DistSq = FVector2D::DistSquared(SelfPosition, OtherPosition);
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			TargetPosition = OtherPosition;
+		}
+	}
+
+	if (BestDistSq == TNumericLimits<double>::Max())
+	{
+		Phase = EPhase::Waiting;
+		return;
+	}
+
+	MoveDir = TargetPosition.X >= SelfPosition.X ? 1 : -1;
+
+	Phase = EPhase::Waiting;
+	PlanShot(State, Self);
+}
+
+void FWormBotBrain::PlanShot(const FLockstepState& State, const FLockstepWorm& Self)
+{
+	FTrajectoryParams Params;
+	Params.Origin = Self.Position.ToPlane();
+	Params.Wind = State.Wind.ToFloat();
+
+	float MissDistance = 0.f;
+	const bool bFound = FTrajectorySolver::FindBestShot(State.Terrain, Params, TargetPosition,
+		ShotAngleSteps, ShotPowerSteps, MinSelfDistance, Shot, MissDistance);
+
+	// Premier essai du tour : mauvais angle de tir, on tente de se rapprocher
+	if (Phase != EPhase::Walking && (!bFound || MissDistance > ShotGoodEnough))
+	{
+		const int32 CellX = FTerrainMask::WorldToCell(Self.Position.X);
+		WalkEndX = FTerrainPathPlanner::PlanWalk(State.Terrain, CellX, FeetCell(Self),
+			FTerrainMask::WorldToCell(static_cast<float>(TargetPosition.X)), MaxWalkColumns, State.Water.GetRow(), Path);
+
+		if (Path.Num() > 0)
+		{
+			Phase = EPhase::Walking;
+			WalkFrames = 0;
+			StuckFrames = 0;
+			LastCellX = CellX;
+			return;
+		}
+	}
+
+	if (!bFound)
+	{
+		// Rien ne touche le sol : tir en cloche vers la cible
+		Shot.AngleDegrees = MoveDir > 0 ? 60.f : 120.f;
+		Shot.Power01 = 0.7f;
+	}
+
+	Phase = EPhase::Aiming;
+	AimFramesLeft = AimDelayFrames;
+}
@@ -0,0 +1,87 @@
+#include "Simulation/WormSnapshot.h"
+#include "Actors/CustomPaperCharacter.h"
+
+FWormSnapshot FWormSnapshot::Lerp(const FWormSnapshot& A, const FWormSnapshot& B, double Time)
+{
+	const double Span = B.Time - A.Time;
+	const float Alpha = Span > 0.0 ? static_cast<float>(FMath::Clamp((Time - A.Time) / Span, 0.0, 1.0)) : 0.f;
+
+	FWormSnapshot Result = A;
+	Result.Time = Time;
+	Result.Location = FMath::Lerp(A.Location, B.Location, Alpha);
+	Result.Velocity = FMath::Lerp(A.Velocity, B.Velocity, Alpha);
+	return Result;
+}
+
+// ============================================================
+//  Historique
+// ============================================================
+
+void FWormSnapshotHistory::Push(const FWormSnapshot& Snapshot)
+{
+	// Deux ticks au même temps serveur (correction reçue) : on garde le plus récent
+	if (Count > 0 && Snapshot.Time <= Latest().Time)
+	{
+		Slots[(Head - 1 + Capacity) % Capacity] = Snapshot;
+		return;
+	}
+
+	Slots[Head] = Snapshot;
+	Head = (Head + 1) % Capacity;
+	Count = FMath::Min(Count + 1, Capacity);
+}
+
+bool FWormSnapshotHistory::Sample(double Time, FWormSnapshot& OutSnapshot) const
+{
+	if (Count == 0 || Time < Get(0).Time)
+		return false;
+
+	if (Time >= Latest().Time)
+	{
+		OutSnapshot = Latest();
+		return true;
+	}
+
+	// Dichotomie : temps croissants dans l'ordre de l'anneau
+	int32 Low = 0;
+	int32 High = Count - 1;
+	while (High - Low > 1)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Get(Mid).Time <= Time)
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	OutSnapshot = FWormSnapshot::Lerp(Get(Low), Get(High), Time);
+	return true;
+}
+
+// ============================================================
+//  Retour arrière
+// ============================================================
+
+FScopedWormRewind::FScopedWormRewind(ACustomPaperCharacter* InWorm, double Time)
+	: Worm(InWorm)
+{
+	FWormSnapshot Past;
+	if (!Worm || !Worm->GetSnapshotHistory().Sample(Time, Past))
+		return;
+
+	Saved = Worm->CaptureSnapshot();
+	Worm->RestoreSnapshot(Past, false);
+	bRewound = true;
+}
+
+FScopedWormRewind::~FScopedWormRewind()
+{
+	if (bRewound && IsValid(Worm))
+	{
+		Worm->RestoreSnapshot(Saved, false);
+	}
+}
@@ -6,6 +6,10 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "Beacon/LobbyBeaconClient.h"
 #include "Actors/CustomPlayerController.h"
+#include "Assets/AssetPreloadSubsystem.h"
+#include "Profile/PlayerProfileSubsystem.h"
+#include "Profiling/StartupTrace.h"
+#include "Misc/App.h"
 
 // ============================================================
 //  Initialisation
@@ -15,11 +19,15 @@ void UUIMenu::NativeConstruct()
 {
 	Super::NativeConstruct();
 
+	FStartupTrace::Mark(StartupTraceMarkers::MenuConstructed);
+
 	SessionSubsystem = GetGameInstance()->GetSubsystem<UOnlineSessionSubsystem>();
 	if (SessionSubsystem)
 	{
 		SessionSubsystem->OnFindSessionsCompleteEvent.AddDynamic(this, &UUIMenu::HandleFindSessionsCompleted);
+		SessionSubsystem->OnRoomListPatched.AddDynamic(this, &UUIMenu::HandleRoomListPatched);
 		SessionSubsystem->OnLobbysUpdated.AddDynamic(this, &UUIMenu::HandleLobbyUpdated);
+		SessionSubsystem->OnLobbyClosed.AddDynamic(this, &UUIMenu::HandleLobbyClosed);
 
 		// HandleBeaconCreated est connecté ici (une seule fois) pour rebinder OnLobbyUpdated
 		// si le BeaconClient est recréé après un CustomJoinSession
@@ -30,7 +38,46 @@ void UUIMenu::NativeConstruct()
 		UE_LOG(LogTemp, Error, TEXT("UUIMenu::NativeConstruct: SessionSubsystem introuvable."));
 	}
 
+	PreloadSubsystem = GetGameInstance()->GetSubsystem<UAssetPreloadSubsystem>();
+	if (PreloadSubsystem)
+	{
+		PreloadSubsystem->OnPreloadedAssetsChanged.AddDynamic(this, &UUIMenu::HandlePreloadedAssetsChanged);
+	}
+
+	ProfileSubsystem = GetGameInstance()->GetSubsystem<UPlayerProfileSubsystem>();
+	if (ProfileSubsystem)
+	{
+		ProfileSubsystem->OnProfileLoaded.AddDynamic(this, &UUIMenu::HandleProfileLoaded);
+	}
+
 	SetupMenu();
+
+	// Profil déjà lu avant la construction du menu : pas de OnProfileLoaded à attendre
+	if (ProfileSubsystem && ProfileSubsystem->IsLoaded())
+	{
+		HandleProfileLoaded();
+	}
+
+	// En headless (-nullrhi) aucun paint n'aura lieu : le menu est
+	// considéré interactif dès qu'il est construit et bindé.
+	if (!FApp::CanEverRender())
+	{
+		FStartupTrace::Finish();
+	}
+}
+
+int32 UUIMenu::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+	int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if (!FStartupTrace::IsFinished())
+	{
+		FStartupTrace::Mark(StartupTraceMarkers::MenuFirstPaint);
+		FStartupTrace::Finish();
+	}
+
+	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements,
+		LayerId, InWidgetStyle, bParentEnabled);
 }
 
 // ============================================================
@@ -124,11 +171,14 @@ void UUIMenu::OnCreateRoomClicked()
 
 void UUIMenu::OnJoinRoomClicked()
 {
-	// Quick Join : on cherche les sessions et on rejoint la première trouvée
+	// Quick Join : on cherche les sessions et on rejoint la première qui accepte
 	bIsQuickJoin = true;
 	if (SessionSubsystem)
 	{
-		SessionSubsystem->FindSessions(LobbyConstants::MaxSearchResults, true);
+		// Tous modes, mais uniquement des rooms où il reste une place
+		FRoomQueryFilter Filter;
+		Filter.bRequireFreeSlot = true;
+		SessionSubsystem->FindSessionsFiltered(LobbyConstants::MaxSearchResults, true, Filter);
 	}
 }
 
@@ -136,13 +186,8 @@ void UUIMenu::OnFindRoomClicked()
 {
 	ShowFindRoom();
 
-	// Réinitialise le filtre sur "Tous"
+	// Réinitialise le filtre sur "Tous" (lance la recherche)
 	OnCheckBoxAllClicked(true);
-
-	if (SessionSubsystem)
-	{
-		SessionSubsystem->FindSessions(LobbyConstants::MaxSearchResults, true);
-	}
 }
 
 void UUIMenu::OnSettingsClicked()
@@ -173,28 +218,27 @@ void UUIMenu::OnOpenRoomClicked()
 	if (!SessionSubsystem)
 		return;
 
-	const int32 MaxPlayers = GetMaxPlayersForGameMode(SelectedGameMode);
-
 	// Prépare les infos de l'hôte AVANT CreateSession() pour qu'elles soient
 	// disponibles dès que le beacon host est prêt et se connecte à lui-même.
-	// TODO: remplacer PlayerName par le vrai nom depuis le GameInstance / profil.
-	FPlayerLobbyInfo HostInfo;
-	HostInfo.PlayerName = TEXT("Player 1");
+	// Nom et icônes viennent du profil local
+	FPlayerLobbyInfo HostInfo = ProfileSubsystem ? ProfileSubsystem->MakeLobbyInfo() : FPlayerLobbyInfo();
 	HostInfo.UnitNB = SelectedUnitCount;
-	HostInfo.ProfileIcon = 0;
-	HostInfo.TeamIcon = 0;
-	HostInfo.PlayerId = static_cast<int32>(FPlatformTime::Cycles() & 0x7FFFFFFF);
+	// PlayerId laissé à 0 : l'index de l'hôte est attribué par CreateHostBeacon()
 	SessionSubsystem->SetHostPlayerInfo(HostInfo);
 
-	SessionSubsystem->CreateSession(
-		TEXT("MyGameSession"),
-		MaxPlayers,
-		true,
-		SelectedGameMode,
-		SelectedUnitLife,
-		SelectedUnitCount,
-		SelectedTurnsBeforeWater
-	);
+	FRoomSettings RoomSettings;
+	RoomSettings.RoomName = TEXT("MyGameSession");
+	RoomSettings.GameMode = SelectedGameMode;
+	RoomSettings.UnitLife = SelectedUnitLife;
+	RoomSettings.UnitCount = SelectedUnitCount;
+	RoomSettings.TurnsBeforeWater = SelectedTurnsBeforeWater;
+	SessionSubsystem->CreateSession(RoomSettings, true);
+
+	// Sauvegarde différée, hors game thread
+	if (ProfileSubsystem)
+	{
+		ProfileSubsystem->SetLastRoomSettings(RoomSettings);
+	}
 
 	// L'UI des joueurs sera peuplée par HandleLobbyUpdated() dès que le beacon
 	// de l'hôte aura validé sa connexion locale et diffusé ConnectedPlayers.
@@ -215,8 +259,7 @@ void UUIMenu::OnOpenRoomClicked()
 
 void UUIMenu::OnCloseRoomClicked()
 {
-	// TODO : kick des joueurs présents dans la room avant de détruire
-
+	// Les joueurs présents sont prévenus par CloseRoom() et reviennent au menu d'eux-mêmes
 	if (VB_PlayersInfos)
 		VB_PlayersInfos->ClearChildren();
 	PlayersInfosUI.Empty();
@@ -233,7 +276,7 @@ void UUIMenu::OnCloseRoomClicked()
 		Btn_CloseRoom->SetVisibility(ESlateVisibility::HitTestInvisible);
 
 	if (SessionSubsystem)
-		SessionSubsystem->DestroySession();
+		SessionSubsystem->CloseRoom();
 }
 
 void UUIMenu::OnStartGameClicked()
@@ -247,14 +290,22 @@ void UUIMenu::OnStartGameClicked()
 	// Chaque PC pose son flag bGameStarted et cache son menu via le RPC
 	// Client_NotifyGameStarting, ce qui évite que BeginPlay recrée le menu
 	// sur la nouvelle map (le PlayerController survit au travel non-seamless).
+	int32 NumNotified = 0;
 	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
 	{
 		if (ACustomPlayerController* PC = Cast<ACustomPlayerController>(It->Get()))
 		{
 			PC->Client_NotifyGameStarting();
+			NumNotified++;
 		}
 	}
 
+	// La partie lockstep attend ces joueurs sur la map de jeu (ULockstepSubsystem)
+	if (UWormsGameInstance* GI = Cast<UWormsGameInstance>(World->GetGameInstance()))
+	{
+		GI->ExpectedMatchPlayers = NumNotified;
+	}
+
 	// TODO : remplacer par le nom de la vraie map de jeu.
 	World->ServerTravel(TEXT("/Game/Maps/Lobby?listen"));
 }
@@ -268,7 +319,7 @@ void UUIMenu::OnQuitLobbyClicked()
 
 void UUIMenu::OnGameModeChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
 {
-	SelectedGameMode = SelectedItem;
+	SelectedGameMode = ParseGameMode(SelectedItem);
 }
 
 void UUIMenu::OnWaterRisingChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
@@ -293,10 +344,21 @@ void UUIMenu::OnUnitCountChanged(FString SelectedItem, ESelectInfo::Type Selecti
 void UUIMenu::OnCloseFindRoomClicked()
 {
 	ShowMainMenu();
-	OnCheckBoxAllClicked(true);
+	ResetModeFilter();
+
+	if (SessionSubsystem)
+	{
+		SessionSubsystem->StopRoomListSubscription();
+	}
 }
 
 void UUIMenu::OnCheckBoxAllClicked(bool bIsChecked)
+{
+	ResetModeFilter();
+	OnRefreshRoomsClicked();
+}
+
+void UUIMenu::ResetModeFilter()
 {
 	bCheckBoxAll = true;
 	bCheckBox1V1 = false;
@@ -325,6 +387,8 @@ void UUIMenu::OnCheckBox1V1Clicked(bool bIsChecked)
 	if (CheckBox_1V1) CheckBox_1V1->SetIsChecked(bCheckBox1V1);
 	if (CheckBox_2V2) CheckBox_2V2->SetIsChecked(bCheckBox2V2);
 	if (CheckBox_FFA) CheckBox_FFA->SetIsChecked(bCheckBoxFFA);
+
+	OnRefreshRoomsClicked();
 }
 
 void UUIMenu::OnCheckBox2V2Clicked(bool bIsChecked)
@@ -342,6 +406,8 @@ void UUIMenu::OnCheckBox2V2Clicked(bool bIsChecked)
 	if (CheckBox_1V1) CheckBox_1V1->SetIsChecked(bCheckBox1V1);
 	if (CheckBox_2V2) CheckBox_2V2->SetIsChecked(bCheckBox2V2);
 	if (CheckBox_FFA) CheckBox_FFA->SetIsChecked(bCheckBoxFFA);
+
+	OnRefreshRoomsClicked();
 }
 
 void UUIMenu::OnCheckBoxFFAClicked(bool bIsChecked)
@@ -359,6 +425,8 @@ void UUIMenu::OnCheckBoxFFAClicked(bool bIsChecked)
 	if (CheckBox_1V1) CheckBox_1V1->SetIsChecked(bCheckBox1V1);
 	if (CheckBox_2V2) CheckBox_2V2->SetIsChecked(bCheckBox2V2);
 	if (CheckBox_FFA) CheckBox_FFA->SetIsChecked(bCheckBoxFFA);
+
+	OnRefreshRoomsClicked();
 }
 
 void UUIMenu::OnRefreshRoomsClicked()
@@ -372,7 +440,29 @@ void UUIMenu::OnRefreshRoomsClicked()
 		RoomInfosUI.Empty();
 	}
 
-	SessionSubsystem->FindSessions(LobbyConstants::MaxSearchResults, true);
+	// Liste en direct : (ré)abonnement, les lignes arrivent par HandleRoomListPatched
+	if (bLiveRoomList)
+	{
+		FoundSessions.Reset();
+		if (SessionSubsystem->StartRoomListSubscription(MakeQueryFilter()))
+			return;
+	}
+
+	// Le filtre part avec la requête : les rooms hors filtre ne répondent pas
+	SessionSubsystem->FindSessionsFiltered(LobbyConstants::MaxSearchResults, true, MakeQueryFilter());
+}
+
+FRoomQueryFilter UUIMenu::MakeQueryFilter() const
+{
+	FRoomQueryFilter Filter;
+	if (!bCheckBoxAll)
+	{
+		Filter.ModeMask = 0;
+		Filter.SetModeAllowed(EWormsGameMode::OneVsOne, bCheckBox1V1);
+		Filter.SetModeAllowed(EWormsGameMode::TwoVsTwo, bCheckBox2V2);
+		Filter.SetModeAllowed(EWormsGameMode::FFA, bCheckBoxFFA);
+	}
+	return Filter;
 }
 
 void UUIMenu::OnJoinLobbyClicked(int32 Index)
@@ -381,6 +471,7 @@ void UUIMenu::OnJoinLobbyClicked(int32 Index)
 		return;
 
 	SelectedSessionIndex = Index;
+	SessionSubsystem->StopRoomListSubscription();
 	SessionSubsystem->CustomJoinSession(FoundSessions[SelectedSessionIndex]);
 	HideRoomSettingsForJoiningPlayer();
 }
@@ -461,11 +552,23 @@ void UUIMenu::AddRoomInfoUI(FString RoomName, int32 RoomModeID, int32 PlayerInRo
 	if (!RoomInfoWidget)
 		return;
 
+	RoomInfoWidget->SessionIndex = SessionIndex;
+	ApplyRoomInfo(RoomInfoWidget, RoomName, RoomModeID, PlayerInRoom, MaxPlayerInRoom, RoomPing);
+
+	if (RoomInfoWidget->Btn_JoinLobby)
+		RoomInfoWidget->OnJoinClicked.AddDynamic(this, &UUIMenu::OnJoinLobbyClicked);
+
+	FindRoomScrollBox->AddChild(RoomInfoWidget);
+	RoomInfosUI.Add(RoomInfoWidget);
+}
+
+void UUIMenu::ApplyRoomInfo(URoomInfoTemplate* RoomInfoWidget, const FString& RoomName, int32 RoomModeID,
+	int32 PlayerInRoom, int32 MaxPlayerInRoom, int32 RoomPing) const
+{
 	RoomInfoWidget->RoomName = RoomName;
 	RoomInfoWidget->PlayerInRoom = PlayerInRoom;
 	RoomInfoWidget->MaxPlayerInRoom = MaxPlayerInRoom;
 	RoomInfoWidget->RoomPing = RoomPing;
-	RoomInfoWidget->SessionIndex = SessionIndex;
 	RoomInfoWidget->PlayersText = FString::Printf(TEXT("Players : %d/%d"), PlayerInRoom, MaxPlayerInRoom);
 
 	// Texte du mode de jeu via les constantes partagées
@@ -474,13 +577,19 @@ void UUIMenu::AddRoomInfoUI(FString RoomName, int32 RoomModeID, int32 PlayerInRo
 		RoomInfoWidget->RoomModeID = RoomModeID;
 		const FString ModeNames[] = { TEXT("GameMode : 1V1"), TEXT("GameMode : 2V2"), TEXT("GameMode : FFA") };
 		RoomInfoWidget->RoomModeText = ModeNames[RoomModeID];
+		if (PreloadSubsystem)
+			RoomInfoWidget->RoomModeIcon = PreloadSubsystem->GetRoomModeIcon(RoomModeID);
 	}
+}
 
-	if (RoomInfoWidget->Btn_JoinLobby)
-		RoomInfoWidget->OnJoinClicked.AddDynamic(this, &UUIMenu::OnJoinLobbyClicked);
-
-	FindRoomScrollBox->AddChild(RoomInfoWidget);
-	RoomInfosUI.Add(RoomInfoWidget);
+URoomInfoTemplate* UUIMenu::FindRoomInfoUI(int32 SessionIndex) const
+{
+	for (URoomInfoTemplate* RoomInfoWidget : RoomInfosUI)
+	{
+		if (RoomInfoWidget && RoomInfoWidget->SessionIndex == SessionIndex)
+			return RoomInfoWidget;
+	}
+	return nullptr;
 }
 
 // ============================================================
@@ -500,6 +609,7 @@ void UUIMenu::AddPlayerInfoUI(const FPlayerLobbyInfo& PlayerInfo)
 	PlayerInfoWidget->UnitNB = PlayerInfo.UnitNB;
 	PlayerInfoWidget->ProfileIcon = PlayerInfo.ProfileIcon;
 	PlayerInfoWidget->TeamIcon = PlayerInfo.TeamIcon;
+	ApplyPlayerIcons(PlayerInfoWidget);
 
 	VB_PlayersInfos->AddChild(PlayerInfoWidget);
 	PlayersInfosUI.Add(PlayerInfoWidget);
@@ -545,6 +655,39 @@ void UUIMenu::UpdateRoomStatusUI(bool bIsOpen, int32 CurrentPlayers)
 	}
 }
 
+void UUIMenu::ApplyRoomSettingsToUI(const FRoomSettings& Settings)
+{
+	// Une option absente de la ComboBox (valeur d'une ancienne version) garde la sélection courante
+	const auto Select = [](UComboBoxString* Choice, const FString& Option)
+	{
+		if (!Choice || Choice->FindOptionIndex(Option) == INDEX_NONE)
+			return false;
+
+		Choice->SetSelectedOption(Option);
+		return true;
+	};
+
+	// Valeur et affichage restent alignés, même si la ComboBox n'est pas encore construite
+	if (Select(GameModeChoice, GetGameModeLabel(Settings.GameMode)))
+		SelectedGameMode = Settings.GameMode;
+	if (Select(WaterRisingChoice, FString::FromInt(Settings.TurnsBeforeWater)))
+		SelectedTurnsBeforeWater = Settings.TurnsBeforeWater;
+	if (Select(UnitLifeChoice, FString::FromInt(Settings.UnitLife)))
+		SelectedUnitLife = Settings.UnitLife;
+	if (Select(UnitCountChoice, FString::FromInt(Settings.UnitCount)))
+		SelectedUnitCount = Settings.UnitCount;
+}
+
+void UUIMenu::ApplyPlayerIcons(UUserInfoTemplate* PlayerInfoWidget) const
+{
+	if (!PlayerInfoWidget || !PreloadSubsystem)
+		return;
+
+	PlayerInfoWidget->ProfileIconTexture = PreloadSubsystem->GetProfileIcon(PlayerInfoWidget->ProfileIcon);
+	PlayerInfoWidget->TeamIconTexture = PreloadSubsystem->GetTeamIcon(PlayerInfoWidget->TeamIcon);
+	PlayerInfoWidget->UpdateValues();
+}
+
 // ============================================================
 //  CALLBACKS DELEGATES — Session / Beacon
 // ============================================================
@@ -565,7 +708,8 @@ void UUIMenu::HandleFindSessionsCompleted(const TArray<FCustomSessionInfo>& Sess
 		bIsQuickJoin = false;
 		if (FoundSessions.Num() > 0)
 		{
-			SessionSubsystem->CustomJoinSession(FoundSessions[0]);
+			// Room pleine entre la recherche et la réservation : on enchaîne sur la suivante
+			SessionSubsystem->JoinFirstAvailable(FoundSessions);
 			HideRoomSettingsForJoiningPlayer();
 		}
 		else
@@ -599,17 +743,60 @@ void UUIMenu::HandleFindSessionsCompleted(const TArray<FCustomSessionInfo>& Sess
 	}
 }
 
+void UUIMenu::HandleRoomListPatched(const FCustomSessionInfo& Room, ERoomListChange Change)
+{
+	// Les index de FoundSessions restent stables : une room fermée laisse une entrée vide
+	const int32 Index = FoundSessions.IndexOfByPredicate([&Room](const FCustomSessionInfo& Session)
+	{
+		return Session.BeaconPort == Room.BeaconPort && Session.HostAddress == Room.HostAddress;
+	});
+
+	if (Change == ERoomListChange::Removed)
+	{
+		if (Index == INDEX_NONE)
+			return;
+
+		if (URoomInfoTemplate* RoomInfoWidget = FindRoomInfoUI(Index))
+		{
+			RoomInfoWidget->RemoveFromParent();
+			RoomInfosUI.Remove(RoomInfoWidget);
+		}
+		FoundSessions[Index] = FCustomSessionInfo();
+		return;
+	}
+
+	if (Index == INDEX_NONE)
+	{
+		const int32 NewIndex = FoundSessions.Add(Room);
+		AddRoomInfoUI(Room.SessionName, GetGameModeID(Room.GameMode), Room.CurrentPlayers, Room.MaxPlayers, Room.Ping, NewIndex);
+		return;
+	}
+
+	// Patch en place : la ligne existante garde sa position et son bouton
+	FoundSessions[Index] = Room;
+	if (URoomInfoTemplate* RoomInfoWidget = FindRoomInfoUI(Index))
+	{
+		ApplyRoomInfo(RoomInfoWidget, Room.SessionName, GetGameModeID(Room.GameMode), Room.CurrentPlayers, Room.MaxPlayers, Room.Ping);
+		RoomInfoWidget->UpdateValues();
+	}
+}
+
 bool UUIMenu::PassFilter(const FCustomSessionInfo& Session) const
 {
+	// Déjà filtré à la source ; garde-fou si les cases ont changé pendant la recherche
 	if (bCheckBoxAll)  return true;
-	if (bCheckBox1V1 && Session.GameMode == LobbyConstants::GameMode_1V1) return true;
-	if (bCheckBox2V2 && Session.GameMode == LobbyConstants::GameMode_2V2) return true;
-	if (bCheckBoxFFA && Session.GameMode == LobbyConstants::GameMode_FFA) return true;
+	if (bCheckBox1V1 && Session.GameMode == EWormsGameMode::OneVsOne) return true;
+	if (bCheckBox2V2 && Session.GameMode == EWormsGameMode::TwoVsTwo) return true;
+	if (bCheckBoxFFA && Session.GameMode == EWormsGameMode::FFA) return true;
 	return false;
 }
 
 void UUIMenu::HandleLobbyUpdated(const TArray<FPlayerLobbyInfo>& Players)
 {
+	// Le lobby est le moment idéal pour streamer icônes et flipbooks de la partie
+	if (PreloadSubsystem)
+		PreloadSubsystem->PreloadForLobby(Players);
+
 	if (!VB_PlayersInfos)
 		return;
 
@@ -625,6 +812,17 @@ void UUIMenu::HandleLobbyUpdated(const TArray<FPlayerLobbyInfo>& Players)
 	UpdatePlayerCountText(Players.Num());
 }
 
+void UUIMenu::HandleLobbyClosed()
+{
+	UE_LOG(LogTemp, Warning, TEXT("HandleLobbyClosed: room fermee par l'hote."));
+
+	if (VB_PlayersInfos)
+		VB_PlayersInfos->ClearChildren();
+	PlayersInfosUI.Empty();
+
+	ShowMainMenu();
+}
+
 void UUIMenu::HandleBeaconCreated(ALobbyBeaconClient* BeaconClient)
 {
 	// BeaconClient est fourni directement par le delegate OnBeaconClientCreated.
@@ -644,4 +842,33 @@ void UUIMenu::HandleBeaconCreated(ALobbyBeaconClient* BeaconClient)
 	}
 
 	UE_LOG(LogTemp, Warning, TEXT("HandleBeaconCreated: beacon client binde (%p)."), BeaconClient);
+}
+
+// ============================================================
+//  CALLBACKS DELEGATES — Préchargement
+// ============================================================
+
+void UUIMenu::HandlePreloadedAssetsChanged()
+{
+	for (UUserInfoTemplate* PlayerInfoWidget : PlayersInfosUI)
+	{
+		ApplyPlayerIcons(PlayerInfoWidget);
+	}
+
+	for (URoomInfoTemplate* RoomInfoWidget : RoomInfosUI)
+	{
+		if (RoomInfoWidget && PreloadSubsystem)
+		{
+			RoomInfoWidget->RoomModeIcon = PreloadSubsystem->GetRoomModeIcon(RoomInfoWidget->RoomModeID);
+			RoomInfoWidget->UpdateValues();
+		}
+	}
+}
+
+void UUIMenu::HandleProfileLoaded()
+{
+	if (ProfileSubsystem)
+	{
+		ApplyRoomSettingsToUI(ProfileSubsystem->GetProfile().LastRoomSettings);
+	}
 }
\ No newline at end of file
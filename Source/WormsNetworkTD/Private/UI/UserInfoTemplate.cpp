@@ -3,3 +3,6 @@
 
 #include "UI/UserInfoTemplate.h"
 
+void UUserInfoTemplate::UpdateValues_Implementation()
+{
+}
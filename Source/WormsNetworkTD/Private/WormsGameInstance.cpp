@@ -1 +1,34 @@
-#include "WormsGameInstance.h"
\ No newline at end of file
+#include "WormsGameInstance.h"
+#include "Profiling/StartupTrace.h"
+#include "Engine/World.h"
+
+void UWormsGameInstance::Init()
+{
+	Super::Init();
+	FStartupTrace::Mark(StartupTraceMarkers::GameInstanceInit);
+}
+
+void UWormsGameInstance::Shutdown()
+{
+	// Attend le dernier vidage du thread d'ecriture (fin de session, hors gameplay)
+	MatchStatsWriter.Reset();
+	Super::Shutdown();
+}
+
+FMatchStatsWriter& UWormsGameInstance::GetMatchStatsWriter()
+{
+	if (!MatchStatsWriter)
+	{
+		MatchStatsWriter = MakeUnique<FMatchStatsWriter>(FMatchStatsWriter::MakeDefaultPath());
+	}
+	return *MatchStatsWriter;
+}
+
+bool UWormsGameInstance::IsMatchWorld(const UWorld* World)
+{
+	if (!World || !World->IsGameWorld())
+		return false;
+
+	const UWormsGameInstance* GI = Cast<UWormsGameInstance>(World->GetGameInstance());
+	return GI && GI->bGameStarted;
+}
\ No newline at end of file
@@ -2,9 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "PaperCharacter.h"
-#include "Camera/CameraComponent.h"
-#include "GameFramework/SpringArmComponent.h"
 #include "PaperFlipbookComponent.h"
+#include "Simulation/WormSnapshot.h"
 #include "CustomPaperCharacter.generated.h"
 
 UENUM(BlueprintType)
@@ -23,44 +22,117 @@ class WORMSNETWORKTD_API ACustomPaperCharacter : public APaperCharacter
 
 public:
 
-	ACustomPaperCharacter();
+	/**
+	 * Sans UPaperFlipbookComponent : le sprite est rendu par UWormSpriteBatchSubsystem.
+	 * Sans caméra non plus : AWormsCameraManager suit le worm actif.
+	 */
+	ACustomPaperCharacter(const FObjectInitializer& ObjectInitializer);
 
 	virtual void Tick(float DeltaTime) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	/* ================= DÉGÂTS ================= */
+
+	/**
+	 * Serveur : applique le total résolu par UDamageResolutionSubsystem
+	 * pour ce lot. Renvoie les PV restants ; à 0, le worm est mort.
+	 */
+	int32 ApplyResolvedDamage(int32 Damage);
+
+	UFUNCTION(BlueprintPure, Category = "Damage")
+	bool IsAlive() const { return Health > 0; }
+
+	virtual void Landed(const FHitResult& Hit) override;
+
+	/* ================= SNAPSHOTS ================= */
+
+	/** État gameplay courant, horodaté au temps serveur. */
+	FWormSnapshot CaptureSnapshot() const;
+
+	/**
+	 * Réapplique un snapshot. bFullState : aussi PV, animation, direction et
+	 * mode de mouvement (réconciliation) ; sinon position et vitesse seules
+	 * (retour arrière temporaire, cf. FScopedWormRewind).
+	 */
+	void RestoreSnapshot(const FWormSnapshot& Snapshot, bool bFullState = true);
+
+	/** Rempli chaque tick sur le serveur et le client propriétaire si bRecordSnapshotHistory. */
+	const FWormSnapshotHistory& GetSnapshotHistory() const { return SnapshotHistory; }
+
+	/**
+	 * Capture de l'historique à chaque tick. Désactivée par défaut : aucune
+	 * validation de tir ni réconciliation ne la consomme encore.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Snapshots")
+	bool bRecordSnapshotHistory = false;
+
 protected:
 
+	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	void UpdateAnimations();
 
+	/**
+	 * Résout un flipbook soft. Normalement déjà résident grâce au
+	 * préchargement du lobby (UAssetPreloadSubsystem) ; sinon chargement
+	 * synchrone de secours, loggé pour repérer les trous du preload.
+	 */
+	UPaperFlipbook* ResolveFlipbook(const TSoftObjectPtr<UPaperFlipbook>& Flipbook) const;
+
 	UFUNCTION()
 	void OnRep_PlayerAnimState();
 
-public:
+	/** Entrée dans UWormSpriteBatchSubsystem (INDEX_NONE sur serveur dédié). */
+	int32 SpriteHandle = INDEX_NONE;
 
-	/* ================= CAMERA ================= */
+	/** Temps serveur (GetServerWorldTimeSeconds côté client). */
+	double GetSnapshotTime() const;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
-	TObjectPtr<UCameraComponent> Camera;
+	FWormSnapshotHistory SnapshotHistory;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
-	TObjectPtr<USpringArmComponent> SpringArm;
+public:
+
+	/* ================= DÉGÂTS ================= */
+
+	// Répliqué comme propriété simple ; les effets passent par les événements de lot
+	UPROPERTY(Replicated, EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	int32 Health = 100;
 
 	/* ================= ANIMATION ================= */
 
 	UPROPERTY(ReplicatedUsing = OnRep_PlayerAnimState, BlueprintReadOnly, Category = "Sprite")
 	EPlayerState PlayerAnimState = EPlayerState::Idle;
 
+	// Soft refs : le CDO ne force plus le chargement des flipbooks au load de la map.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sprite")
-	TObjectPtr<UPaperFlipbook> IdleAnim;
+	TSoftObjectPtr<UPaperFlipbook> IdleAnim;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sprite")
-	TObjectPtr<UPaperFlipbook> RunAnim;
+	TSoftObjectPtr<UPaperFlipbook> RunAnim;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sprite")
-	TObjectPtr<UPaperFlipbook> JumpAnim;
+	TSoftObjectPtr<UPaperFlipbook> JumpAnim;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sprite")
-	TObjectPtr<UPaperFlipbook> FallAnim;
+	TSoftObjectPtr<UPaperFlipbook> FallAnim;
+
+	/**
+	 * Placement du sprite par rapport à la capsule. Reprend la position
+	 * relative qu'avait le composant Sprite de BP_PaperCharacter (0, 0, -2) :
+	 * ce composant n'existe plus, la valeur du BP n'est plus lue.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprite")
+	FVector SpriteOffset = FVector(0.f, 0.f, -2.f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprite")
+	float SpriteScale = 1.f;
+
+	/** Teinte de l'instance (couleur d'équipe). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sprite")
+	FLinearColor SpriteTint = FLinearColor::White;
 
 	UPROPERTY(ReplicatedUsing = OnRep_FacingDirection)
 	float FacingDirection = 1.f;
@@ -70,4 +142,20 @@ public:
 
 	UFUNCTION(Server, Reliable)
 	void Server_SetFacingDirection(float NewDirection);
+
+	/* ================= LOCKSTEP ================= */
+
+	/** Serveur : lie ce worm à son index de simulation, sur toutes les machines. */
+	void SetLockstepWormIndex(int32 WormIndex);
+
+	int32 GetLockstepWormIndex() const { return LockstepWormIndex; }
+
+protected:
+
+	/** Index du worm dans FLockstepState::Worms (INDEX_NONE hors partie lockstep). */
+	UPROPERTY(ReplicatedUsing = OnRep_LockstepWormIndex)
+	int32 LockstepWormIndex = INDEX_NONE;
+
+	UFUNCTION()
+	void OnRep_LockstepWormIndex();
 };
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "CustomPaperCharacter.h"
 #include "UI/UIMenu.h"
 #include "WormsGameInstance.h"
+#include "Simulation/LockstepTypes.h"
 #include "CustomPlayerController.generated.h"
 
 USTRUCT(BlueprintType)
@@ -33,6 +34,10 @@ class WORMSNETWORKTD_API ACustomPlayerController : public APlayerController
 {
 	GENERATED_BODY()
 
+public:
+	/** Camra de match partage (AWormsCameraManager) au lieu de celle du pawn. */
+	ACustomPlayerController();
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
@@ -87,4 +92,31 @@ public:
 	 */
 	UFUNCTION(Client, Reliable)
 	void Client_NotifyGameStarting();
+
+	// ----- Lockstep (cf. ULockstepSubsystem) -----
+
+	/** Lance la simulation lockstep locale avec l'index attribu par le serveur. */
+	UFUNCTION(Client, Reliable)
+	void Client_StartLockstep(const FLockstepMatchConfig& Config, int32 PlayerIndex);
+
+	/**
+	 * Inputs locaux pas encore confirms (frames dj dcales de InputDelayFrames).
+	 * Un seul envoi par frame rseau ; la redondance remplace la fiabilit.
+	 */
+	UFUNCTION(Server, Unreliable)
+	void Server_SubmitLockstepInputs(const FLockstepInputPacket& Packet);
+
+	/**
+	 * Frames confirmes que le client n'a pas encore accuses (inputs de tous
+	 * les joueurs, dans l'ordre des index). Renvoyes jusqu' l'accus.
+	 */
+	UFUNCTION(Client, Unreliable)
+	void Client_ReceiveLockstepFrames(const FLockstepFramePacket& Packet);
+
+	/** Checksum de fin de tour, compar  la simulation du serveur. */
+	UFUNCTION(Server, Reliable)
+	void Server_ReportTurnChecksum(int32 Turn, uint32 Checksum);
+
+private:
+	class ULockstepSubsystem* GetRunningLockstep() const;
 };
\ No newline at end of file
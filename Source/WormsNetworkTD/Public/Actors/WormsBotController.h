@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "Simulation/WormBotBrain.h"
+#include "WormsBotController.generated.h"
+
+// ============================================================
+//  Contrôleur de bot (serveur uniquement)
+//
+//  Occupe un slot de joueur lockstep comme un ACustomPlayerController :
+//  ULockstepSubsystem lui demande son input à chaque frame échantillonnée
+//  et le fait passer par le même chemin que Server_SubmitLockstepInputs
+//  (agrégation, relais, simulation). Le worm reste piloté par la
+//  simulation ; le bot ne fait que produire des FLockstepInput.
+//  Créés par ULockstepSubsystem pour compléter les rooms FFA, ou par
+//  Worms.BotMatch pour les parties 100 % bots (soak serveur headless).
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API AWormsBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AWormsBotController();
+
+	/** Slot attribué par ULockstepSubsystem::StartLockstepMatch. */
+	void BeginLockstep(int32 PlayerIndex);
+
+	/** Input du bot pour la prochaine frame échantillonnée. */
+	FLockstepInput MakeLockstepInput(const FLockstepState& State);
+
+	int32 GetLockstepPlayerIndex() const { return Brain.GetPlayerIndex(); }
+
+private:
+	FWormBotBrain Brain;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "WormsCameraManager.generated.h"
+
+// ============================================================
+//  Caméra de match (une par joueur local)
+//
+//  Remplace le SpringArm + UCameraComponent de chaque worm. La cible
+//  est choisie ici plutôt que par SetViewTarget :
+//   - lockstep : premier projectile en vol, sinon worm actif,
+//   - sinon : pawn possédé (ou cible de vue courante).
+//  Suivi prédictif : visée en avant de la vitesse (LookAheadSeconds),
+//  lissage exponentiel, cadrage borné à la largeur du terrain.
+//
+//  Publie le rectangle XZ visible (élargi de CullMargin) : seule
+//  source pour les systèmes qui ignorent ce qui est hors écran
+//  (UWormSpriteBatchSubsystem, visuels du terrain).
+// ============================================================
+UCLASS(Config = Game)
+class WORMSNETWORKTD_API AWormsCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+public:
+	AWormsCameraManager();
+
+	/** Rectangle XZ visible à la dernière frame, marge comprise. Faux avant la première frame. */
+	bool GetVisibleRect(FBox2D& OutRect) const;
+
+	/** Rectangle visible du premier joueur local du monde (rien sur serveur dédié). */
+	static bool GetLocalVisibleRect(const UWorld* World, FBox2D& OutRect);
+
+protected:
+	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+
+	/** Distance de la caméra au plan de jeu (Y = 0), ex-TargetArmLength. */
+	UPROPERTY(Config)
+	float CameraDistance = 500.f;
+
+	/** Avance de la visée sur la trajectoire de la cible. */
+	UPROPERTY(Config)
+	float LookAheadSeconds = 0.35f;
+
+	UPROPERTY(Config)
+	float MaxLookAhead = 400.f;
+
+	/** Temps de lissage (s) : worm, puis projectile (plus nerveux). */
+	UPROPERTY(Config)
+	float FollowSmoothTime = 0.25f;
+
+	UPROPERTY(Config)
+	float ProjectileSmoothTime = 0.08f;
+
+	/** Marge du rectangle publié : un sprite à cheval sur le bord reste à jour. */
+	UPROPERTY(Config)
+	float CullMargin = 256.f;
+
+private:
+	/** Position et vitesse de la cible dans le plan XZ ; bornes du terrain si connues. */
+	bool FindFocus(const AActor* ViewTarget, FVector2D& OutPosition, FVector2D& OutVelocity,
+		bool& bOutProjectile, float& OutMapWidth) const;
+
+	/** Demi-largeur et demi-hauteur du plan de jeu vu depuis POV. */
+	FVector2D ComputeHalfExtents(const FMinimalViewInfo& POV) const;
+
+	FVector2D SmoothedFocus = FVector2D::ZeroVector;
+	bool bHasFocus = false;
+
+	FBox2D VisibleRect = FBox2D(ForceInit);
+	bool bHasVisibleRect = false;
+};
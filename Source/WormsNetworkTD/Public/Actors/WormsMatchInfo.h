@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Simulation/DamageTypes.h"
+#include "WormsMatchInfo.generated.h"
+
+// ============================================================
+//  État de match répliqué, toujours pertinent
+//
+//  Porte les quelques valeurs globales que les clients hors
+//  simulation (UI, spectateurs, arrivées tardives) doivent voir.
+//  Chaque valeur est quantifiée au plus juste : le niveau d'eau
+//  est un simple nombre de lignes de cellules (uint16).
+//  Les dégâts partent en une liste d'événements par lot
+//  (UDamageResolutionSubsystem), pas en RPC par worm.
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API AWormsMatchInfo : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AWormsMatchInfo();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Serveur uniquement. */
+	void SetWaterLevelRow(int32 Row);
+
+	int32 GetWaterLevelRow() const { return WaterLevelRow; }
+
+	/** Serveur uniquement : un lot résolu, garde les MaxReplicatedEvents derniers. */
+	void AppendDamageEvents(const TArray<FWormsDamageEvent>& Events);
+
+protected:
+	/** Nombre de lignes FTerrainMask sous l'eau. */
+	UPROPERTY(ReplicatedUsing = OnRep_WaterLevelRow)
+	uint16 WaterLevelRow = 0;
+
+	UFUNCTION()
+	void OnRep_WaterLevelRow();
+
+	/** Derniers événements de dégâts, Serial croissant. */
+	UPROPERTY(ReplicatedUsing = OnRep_DamageEvents)
+	TArray<FWormsDamageEvent> DamageEvents;
+
+	UFUNCTION()
+	void OnRep_DamageEvents();
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "Beacon/LobbyTypes.h"
+#include "AssetPreloadSubsystem.generated.h"
+
+class UWormsMatchAssets;
+class UTexture2D;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPreloadedAssetsChanged);
+
+// ============================================================
+//  Subsystem de préchargement asynchrone
+//  Profite du temps passé dans le lobby pour streamer les flipbooks
+//  de la partie et les icônes choisies par les joueurs.
+// ============================================================
+UCLASS(Config = Game)
+class WORMSNETWORKTD_API UAssetPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+public:
+	/**
+	 * Démarre (ou complète) le préchargement pour le roster courant.
+	 * Les icônes qui ne sont plus utilisées par aucun joueur sont relâchées
+	 * pour ne pas gonfler le pic mémoire au moment du travel.
+	 */
+	void PreloadForLobby(const TArray<FPlayerLobbyInfo>& Players);
+
+	/** Démarre le chargement du bundle "Match" (flipbooks des worms). */
+	void PreloadMatchBundle();
+
+	/** Relâche tout (retour au menu principal). */
+	void ReleaseAll();
+
+	/** Textures déjà résidentes, nullptr si pas encore chargées. */
+	UTexture2D* GetProfileIcon(int32 Index) const;
+	UTexture2D* GetTeamIcon(int32 Index) const;
+	UTexture2D* GetRoomModeIcon(int32 Index) const;
+
+	/** Diffusé à chaque fin de chargement (l'UI rafraîchit ses icônes). */
+	UPROPERTY(BlueprintAssignable)
+	FOnPreloadedAssetsChanged OnPreloadedAssetsChanged;
+
+private:
+	/** Nom du primary asset UWormsMatchAssets à utiliser (DefaultGame.ini). */
+	UPROPERTY(Config)
+	FName MatchAssetsName = TEXT("DA_MatchAssets");
+
+	/** Catalogue résolu une fois le primary asset chargé. */
+	UPROPERTY()
+	TObjectPtr<UWormsMatchAssets> MatchAssets;
+
+	TSharedPtr<FStreamableHandle> CatalogHandle;
+	TSharedPtr<FStreamableHandle> MatchBundleHandle;
+
+	/** Handles par icône : clé = (catégorie << 16) | index. */
+	TMap<int32, TSharedPtr<FStreamableHandle>> IconHandles;
+
+	/** Dernier roster reçu avant que le catalogue soit prêt. */
+	TArray<FPlayerLobbyInfo> PendingPlayers;
+	bool bMatchBundleRequested = false;
+
+	void OnCatalogLoaded();
+	void RequestIcon(int32 Key, const TSoftObjectPtr<UTexture2D>& Icon);
+	void HandleAssetsLoaded();
+
+	static UTexture2D* ResolveIcon(const TArray<TSoftObjectPtr<UTexture2D>>* Icons, int32 Index);
+	static int32 MakeIconKey(uint8 Category, int32 Index) { return (static_cast<int32>(Category) << 16) | (Index & 0xFFFF); }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PaperFlipbook.h"
+#include "Engine/Texture2D.h"
+#include "WormsMatchAssets.generated.h"
+
+// ============================================================
+//  Types / bundles de primary assets
+// ============================================================
+namespace WormsAssetConstants
+{
+	// Type de primary asset scanné par l'AssetManager (cf. DefaultGame.ini)
+	static const FName MatchAssetsType = TEXT("WormsMatchAssets");
+
+	// Bundle chargé pendant le lobby (flipbooks des personnages)
+	static const FName Bundle_Match = TEXT("Match");
+}
+
+/**
+ * Catalogue des assets d'une partie, référencés UNIQUEMENT en soft.
+ * Rien n'est chargé tant que UAssetPreloadSubsystem ne le demande pas :
+ * les icônes sont indexées par FPlayerLobbyInfo::ProfileIcon / TeamIcon.
+ */
+UCLASS(BlueprintType)
+class WORMSNETWORKTD_API UWormsMatchAssets : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override
+	{
+		return FPrimaryAssetId(WormsAssetConstants::MatchAssetsType, GetFName());
+	}
+
+	/** Flipbooks des worms (Idle / Run / Jump / Fall), préchargés pendant le lobby. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character", meta = (AssetBundles = "Match"))
+	TArray<TSoftObjectPtr<UPaperFlipbook>> CharacterFlipbooks;
+
+	/** Content/ExternalAssets/UI/PlayerIcon/*, index = FPlayerLobbyInfo::ProfileIcon. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	TArray<TSoftObjectPtr<UTexture2D>> ProfileIcons;
+
+	/** Content/ExternalAssets/UI/TeamIcon/*, index = FPlayerLobbyInfo::TeamIcon. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	TArray<TSoftObjectPtr<UTexture2D>> TeamIcons;
+
+	/** Content/ExternalAssets/UI/RoomMode/*, index = GetGameModeID(). */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	TArray<TSoftObjectPtr<UTexture2D>> RoomModeIcons;
+};
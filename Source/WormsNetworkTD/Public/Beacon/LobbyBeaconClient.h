@@ -3,10 +3,14 @@
 #include "CoreMinimal.h"
 #include "OnlineBeaconClient.h"
 #include "Beacon/LobbyTypes.h"
+#include "Beacon/LobbyChatChannel.h"
+#include "Network/RoomSettings.h"
+#include "Engine/NetDriver.h"
 #include "LobbyBeaconClient.generated.h"
 
 DECLARE_DELEGATE_OneParam(FOnRequestValidate, bool /*bValidated*/);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLobbyUpdated, const TArray<FPlayerLobbyInfo>&, Players);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLobbyEvents, const TArray<FLobbyChannelEvent>&, Events);
 
 UCLASS()
 class WORMSNETWORKTD_API ALobbyBeaconClient : public AOnlineBeaconClient
@@ -22,15 +26,59 @@ public:
 
 	bool ConnectToServer(FURL& Url);
 
+#if DO_ENABLE_NET_TEST
+	/**
+	 * Conditions rseau mules, appliques ds la cration du NetDriver
+	 * (avant la poigne de main).  renseigner avant ConnectToServer().
+	 */
+	TOptional<FPacketSimulationSettings> PacketSimulation;
+#endif
+
+	/** Connexion tablie avec le host (rservation pas forcment demande). */
+	bool IsConnected() const { return GetConnectionState() == EBeaconConnectionState::Open; }
+
+	/** Appel  l'ouverture de la connexion, avant toute rservation. */
+	FSimpleDelegate OnBeaconConnected;
+
+	/**
+	 * Connexion perdue APRS l'admission (hte parti) : dclenche la
+	 * migration d'hte. Un chec avant l'admission passe par OnRequestValidate.
+	 */
+	FSimpleDelegate OnHostLost;
+
+	/** La room a t ferme par l'hte (Client_RoomClosing) : retour au menu sans attendre de timeout. */
+	FSimpleDelegate OnRoomClosed;
+
 	// ----- Rservation -----
 
+	/**
+	 * true : la rservation part ds la connexion (comportement historique).
+	 * false : connexion tenue au chaud par ULobbyBeaconPool, la rservation
+	 * attend RequestReservation().
+	 */
+	bool bAutoReserve = true;
+
+	/**
+	 * Demande une place : immdiatement si la connexion est ouverte (un seul
+	 * aller-retour RPC), sinon ds OnConnected. Rejouable aprs un refus.
+	 * Un PlayerId dj connu part avec la demande : aprs une migration, le
+	 * nouvel hte y reconnat une place reprise de l'ancien roster.
+	 */
+	void RequestReservation();
+
+	/** (Serveur) Ce client dtient une place : seul destinataire du roster. */
+	bool HasReservation() const { return AssignedPlayerId != 0; }
+
+	/** (Serveur) Index compact attribu  cette connexion, 0 sans place. */
+	int32 GetAssignedPlayerId() const { return AssignedPlayerId; }
+
 	/** (Client -> Serveur) Demande une place dans le lobby. */
 	UFUNCTION(Server, Reliable)
-	void Server_RequestReservation(const FUniqueNetIdRepl& PlayerNetId);
+	void Server_RequestReservation(const FUniqueNetIdRepl& PlayerNetId, int32 PlayerId);
 
-	/** (Serveur -> Client) Rservation accorde. */
+	/** (Serveur -> Client) Rservation accorde, avec le PlayerId attribu par le host. */
 	UFUNCTION(Client, Reliable)
-	void Client_ReservationAccepted();
+	void Client_ReservationAccepted(int32 PlayerId);
 
 	/** (Serveur -> Client) Rservation refuse (lobby plein). */
 	UFUNCTION(Client, Reliable)
@@ -56,11 +104,97 @@ public:
 	UFUNCTION(Server, Reliable)
 	void Server_SendLobbyInfo(const FPlayerLobbyInfo& PlayerInfo);
 
-	/** (Serveur -> Client) Reoit la liste complte du lobby mise  jour. */
+	/**
+	 * (Serveur -> Client) Reoit la liste complte du lobby mise  jour.
+	 * Revision crot  chaque changement et se poursuit chez l'hte lu.
+	 */
 	UFUNCTION(Client, Reliable)
-	void Client_ReceiveLobbyUpdate(const TArray<FPlayerLobbyInfo>& Players);
+	void Client_ReceiveLobbyUpdate(const TArray<FPlayerLobbyInfo>& Players, int32 Revision, int32 InHostPlayerId);
+
+	/** (Serveur -> Client) Settings de la room, envoys  l'admission. */
+	UFUNCTION(Client, Reliable)
+	void Client_ReceiveRoomSettings(const FRoomSettings& Settings);
+
+	// ----- Fermeture de la room -----
+
+	/** (Serveur -> Client) L'hte ferme la room : pas de migration, acquittement immdiat. */
+	UFUNCTION(Client, Reliable)
+	void Client_RoomClosing();
+
+	/** (Client -> Serveur) Fermeture reue : l'hte n'attend plus ce client. */
+	UFUNCTION(Server, Reliable)
+	void Server_AckRoomClosing();
 
 	/** Diffus  chaque mise  jour de la liste des joueurs. */
 	UPROPERTY(BlueprintAssignable)
 	FOnLobbyUpdated OnLobbyUpdated;
+
+	/** Dernire liste reue du host (copie locale du roster). */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FPlayerLobbyInfo> LobbyPlayers;
+
+	// ----- Copie locale pour la migration d'hte -----
+
+	/** Rvision de LobbyPlayers ; une mise  jour plus ancienne est ignore. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 RosterRevision = 0;
+
+	/** PlayerId du joueur qui hberge : exclu de l'lection  son dpart. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 HostPlayerId = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FRoomSettings RoomSettings;
+
+	/** Client : place accorde par le host (une perte de connexion devient OnHostLost). */
+	bool IsAdmitted() const { return bAdmitted; }
+
+	// ----- Canal chat / prt -----
+
+	/** Nombre de messages gards localement (mme borne que l'historique de l'hte). */
+	static constexpr int32 MaxChatLog = FLobbyChatChannel::HistoryCapacity;
+
+	/** (Client -> Serveur) Message de chat ; dbit limit et tronqu par l'hte. */
+	UFUNCTION(Server, Reliable)
+	void Server_SendChat(const FString& Text);
+
+	/** (Client -> Serveur) Bascule prt / pas prt. */
+	UFUNCTION(Server, Reliable)
+	void Server_SetReady(bool bReady);
+
+	/** (Serveur -> Client) Lot d'vnements accumuls par l'hte pendant un intervalle. */
+	UFUNCTION(Client, Reliable)
+	void Client_ReceiveLobbyEvents(const TArray<FLobbyChannelEvent>& Events);
+
+	/** (Serveur -> Client) tats prts et historique compress,  l'admission. Remplace l'tat local. */
+	UFUNCTION(Client, Reliable)
+	void Client_ReceiveChatHistory(const TArray<uint8>& Chunk, int32 RawSize, bool bCompressed);
+
+	/** Diffus  chaque lot reu (l'historique d'admission compris). */
+	UPROPERTY(BlueprintAssignable)
+	FOnLobbyEvents OnLobbyEvents;
+
+	/** Derniers messages reus, du plus ancien au plus rcent. */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FLobbyChannelEvent> ChatLog;
+
+	bool IsPlayerReady(int32 PlayerId) const { return ReadyPlayerIds.Contains(PlayerId); }
+
+protected:
+	// ----- Surcharge AOnlineBeacon -----
+	virtual bool InitBase() override;
+
+private:
+	/** Applique un lot  ChatLog / ReadyPlayerIds puis le diffuse. */
+	void ApplyLobbyEvents(const TArray<FLobbyChannelEvent>& Events);
+
+	TSet<int32> ReadyPlayerIds;
+
+	bool bAdmitted = false;
+
+	/** Serveur : une seule place (et un seul index) par connexion, mme si la demande est rejoue. */
+	int32 AssignedPlayerId = 0;
+
+	/** Serveur : identit prsente  la rservation accorde, recopie dans le roster. */
+	FUniqueNetIdRepl ReservedNetId;
 };
\ No newline at end of file
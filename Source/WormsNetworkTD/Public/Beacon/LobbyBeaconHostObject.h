@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "OnlineBeaconHostObject.h"
 #include "Beacon/LobbyTypes.h"
+#include "Beacon/LobbyChatChannel.h"
+#include "Network/RoomSettings.h"
+#include "GameFramework/OnlineReplStructs.h"
 #include "LobbyBeaconHostObject.generated.h"
 
 // Forward declaration (vite d'inclure le .h complet ici)
@@ -35,25 +38,139 @@ public:
 	UPROPERTY()
 	int32 RoomUnitCount = 1;
 
-	/** Liste des joueurs connects (tat de rfrence ct serveur). */
+	/** Settings de la room, copis chez chaque client admis (migration d'hte). */
+	UPROPERTY()
+	FRoomSettings RoomSettings;
+
+	/**
+	 * Liste des joueurs connects (tat de rfrence ct serveur).
+	 * Tableau dense : un dpart dplace le dernier joueur dans le trou,
+	 * PlayerToSlot donne la position d'un PlayerId.
+	 */
 	UPROPERTY()
 	TArray<FPlayerLobbyInfo> ConnectedPlayers;
 
+	/** +1  chaque diffusion de ConnectedPlayers. */
+	UPROPERTY()
+	int32 RosterRevision = 0;
+
+	/** PlayerId du joueur qui hberge ce beacon. */
+	UPROPERTY()
+	int32 HostPlayerId = 0;
+
 	// ----- Interface publique -----
 
+	/**
+	 * Accorde une place et renvoie le PlayerId du joueur (0 = refus : room
+	 * pleine ou en fermeture). Le PlayerId est le plus petit index libre ;
+	 * un mme FUniqueNetIdRepl retrouve son index s'il est libre. Preferred
+	 * n'est honor que pour l'index rserv  l'hte, ou pour une place
+	 * reprise aprs migration par l'identit qui la tenait.
+	 */
+	int32 GrantReservation(const FUniqueNetIdRepl& PlayerNetId, int32 PreferredPlayerId);
+
 	/**
 	 * Ajoute ou met  jour un joueur dans ConnectedPlayers,
 	 * puis diffuse la mise  jour  tous les clients.
+	 * PlayerInfo.PlayerId doit avoir t accord par GrantReservation().
 	 */
 	void RegisterOrUpdatePlayer(const FPlayerLobbyInfo& PlayerInfo);
 
 	/**
 	 * Retire un joueur de ConnectedPlayers par son PlayerId,
-	 * libre un slot et diffuse la mise  jour.
+	 * libre son slot et son index, et diffuse la mise  jour.
 	 */
 	void UnregisterPlayer(int32 PlayerId);
 
+	/** Recherche O(1) ; nullptr si le joueur n'a pas (encore) envoy ses infos. */
+	const FPlayerLobbyInfo* FindPlayer(int32 PlayerId) const;
+
+	// ----- Migration d'hte -----
+
+	/**
+	 * Reprend le roster de l'hte parti : les joueurs restent affichs et
+	 * gardent leur place, rserve pendant MigrationGraceSeconds en attendant
+	 * leur reconnexion. La rvision repart de celle des clients.
+	 */
+	void AdoptMigratedRoster(const TArray<FPlayerLobbyInfo>& Players, int32 PriorRevision);
+
+	// ----- Fermeture de la room -----
+
+	/**
+	 * Envoie Client_RoomClosing  tous les clients admis, attend leurs
+	 * acquittements (CloseAckTimeoutSeconds au plus ; une dconnexion vaut
+	 * acquittement), libre toutes les places en un lot puis appelle OnClosed.
+	 * Les rservations sont refuses pendant ce temps.
+	 */
+	void BeginClose(FSimpleDelegate OnClosed);
+
+	void AcknowledgeClose(ALobbyBeaconClient* Client);
+
+	bool IsClosing() const { return bClosing; }
+
+	// ----- Canal chat / prt -----
+
+	/**
+	 * Entres d'un client admis, passes au seau  jetons de son joueur.
+	 * Les entres acceptes partent au prochain FlushChat(), en un RPC
+	 * par client, au plus FlushIntervalSeconds plus tard.
+	 */
+	void PostChat(ALobbyBeaconClient* Client, const FString& Text);
+	void PostReady(ALobbyBeaconClient* Client, bool bReady);
+
+	/** Envoie tats prts et historique en un bloc compress ( l'admission). */
+	void SendChatHistory(ALobbyBeaconClient* Client);
+
 private:
+	FLobbyChatChannel ChatChannel;
+	FTimerHandle ChatFlushTimer;
+
+	/** Arme le flush s'il ne l'est pas : aucun timer tant que le canal est muet. */
+	void ScheduleChatFlush();
+	void FlushChat();
+
+	/** Excluded ne reoit pas le lot (arrivant qui aura dj ces entres dans l'historique). */
+	void FlushChatExcept(const ALobbyBeaconClient* Excluded);
+
+	bool bClosing = false;
+	/** Clients prvenus dont l'acquittement n'est pas encore arriv. */
+	UPROPERTY()
+	TArray<ALobbyBeaconClient*> PendingCloseAcks;
+
+	FSimpleDelegate OnCloseFinished;
+	FTimerHandle CloseTimer;
+	double CloseStartSeconds = 0.0;
+
+	/** Libre rservations et roster en une fois, puis rend la main  l'appelant de BeginClose. */
+	void FinishClose();
+
+	/** Places reprises dont le joueur ne s'est pas encore reconnect, avec l'identit qui les tenait. */
+	TMap<int32, FUniqueNetIdRepl> MigratedPlayerIds;
+
+	FTimerHandle MigrationGraceTimer;
+
+	/** Fin du dlai de grce : les places non reprises sont libres. */
+	void ExpireMigratedSlots();
+
+	// ----- Index des joueurs -----
+
+	/** PlayerId -> position dans ConnectedPlayers. */
+	TMap<int32, int32> PlayerToSlot;
+
+	/** Index attribus (place rserve, infos reues ou non). */
+	TSet<int32> AssignedPlayerIds;
+
+	/** Dernier index de chaque identit : un joueur qui revient le retrouve s'il est libre. */
+	TMap<FUniqueNetIdRepl, int32> NetIdToPlayerId;
+
+	int32 AllocatePlayerId(const FUniqueNetIdRepl& PlayerNetId, int32 PreferredPlayerId) const;
+
+	/** Retire l'entre du roster (swap avec la dernire) ; faux si absente. */
+	bool RemoveFromRoster(int32 PlayerId);
+
+	/** Reconstruit PlayerToSlot aprs un remplacement complet de ConnectedPlayers. */
+	void RebuildPlayerIndex();
+
 	/** Liste des clients beacon actuellement connects. */
 	UPROPERTY()
 	TArray<ALobbyBeaconClient*> ConnectedClients;
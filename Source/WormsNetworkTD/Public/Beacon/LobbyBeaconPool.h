@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "LobbyBeaconPool.generated.h"
+
+class ALobbyBeaconClient;
+
+USTRUCT()
+struct FPooledBeacon
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<ALobbyBeaconClient> Client = nullptr;
+
+	double LastUsedSeconds = 0.0;
+};
+
+// ============================================================
+//  Pool de connexions beacon (côté joueur)
+//
+//  Une connexion par host "adresse:port", gardée ouverte après un
+//  refus de réservation : retenter la même room, ou réserver sur une
+//  room déjà préchauffée, coûte un aller-retour RPC au lieu d'un
+//  handshake complet. Les clients du pool ne réservent pas à la
+//  connexion (bAutoReserve = false) ; le host ne leur envoie rien
+//  tant qu'ils n'ont pas de place.
+//
+//  Une connexion admise sort du pool (Detach) et devient la connexion
+//  du lobby. Connexions fermées ou inactives depuis IdleSeconds
+//  détruites au Tick ; au-delà de MaxConnections, la moins récemment
+//  utilisée est évincée. Possédé par UOnlineSessionSubsystem.
+// ============================================================
+UCLASS(Config = Game)
+class WORMSNETWORKTD_API ULobbyBeaconPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Connexion ouverte ou en cours vers le host, créée si besoin. nullptr si le spawn échoue. */
+	ALobbyBeaconClient* Acquire(UWorld* World, const FString& Address, int32 Port);
+
+	/** Retire Client du pool sans le détruire (réservation acceptée). */
+	void Detach(ALobbyBeaconClient* Client);
+
+	void Tick(double Now);
+
+	/** Ferme toutes les connexions du pool. */
+	void Reset();
+
+	int32 Num() const { return Connections.Num(); }
+
+protected:
+	UPROPERTY(Config)
+	int32 MaxConnections = 4;
+
+	UPROPERTY(Config)
+	float IdleSeconds = 30.f;
+
+private:
+	static FString MakeKey(const FString& Address, int32 Port);
+	void EvictLeastRecentlyUsed();
+
+	UPROPERTY()
+	TMap<FString, FPooledBeacon> Connections;
+};
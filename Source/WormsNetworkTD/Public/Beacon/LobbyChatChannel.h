@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Beacon/LobbyTypes.h"
+
+/** Seau à jetons d'un joueur : rafale de Capacity messages, puis RefillPerSecond. */
+struct FLobbyTokenBucket
+{
+	float Tokens = 0.f;
+	double LastRefillSeconds = 0.0;
+
+	bool TryConsume(double Now, float Capacity, float RefillPerSecond, float Cost);
+};
+
+// ============================================================
+//  Canal chat / prêt du lobby (côté hôte)
+//
+//  Séparé du roster : un message ou un changement d'état prêt ne
+//  rediffuse pas ConnectedPlayers. Le flux :
+//   - chaque entrée passe le seau à jetons de son auteur (débit borné
+//     par joueur, refus silencieux au-delà),
+//   - les entrées acceptées s'accumulent dans Pending ; l'hôte les
+//     envoie en UN RPC par client et par FlushIntervalSeconds
+//     (deux bascules prêt du même joueur n'en font qu'une),
+//   - les messages entrent dans un anneau de HistoryCapacity entrées ;
+//     un arrivant reçoit états prêts + anneau en un bloc compressé.
+//  Non UObject : possédé par ALobbyBeaconHostObject.
+// ============================================================
+class WORMSNETWORKTD_API FLobbyChatChannel
+{
+public:
+	static constexpr int32 MaxMessageChars = 160;
+	static constexpr int32 HistoryCapacity = 64;
+	static constexpr float BucketCapacity = 5.f;
+	static constexpr float BucketRefillPerSecond = 1.f;
+	static constexpr float FlushIntervalSeconds = 0.1f;
+
+	/** Faux si le texte est vide ou si l'auteur a épuisé ses jetons. */
+	bool PostChat(int32 PlayerId, const FString& Text, double Now);
+
+	/** Faux si l'état ne change pas ou si l'auteur a épuisé ses jetons. */
+	bool PostReady(int32 PlayerId, bool bReady, double Now);
+
+	/** Joueur parti : son état prêt et son seau sont oubliés (l'index peut être réattribué). */
+	void RemovePlayer(int32 PlayerId);
+
+	bool HasPending() const { return Pending.Num() > 0; }
+	TArray<FLobbyChannelEvent> TakePending();
+
+	bool IsReady(int32 PlayerId) const { return ReadyPlayers.Contains(PlayerId); }
+
+	/**
+	 * États prêts puis messages, du plus ancien au plus récent, compressés (zlib).
+	 * Envoyés bruts (bOutCompressed faux) si la compression échoue ou ne gagne rien.
+	 */
+	void BuildHistoryChunk(TArray<uint8>& OutChunk, int32& OutRawSize, bool& bOutCompressed) const;
+	static bool ReadHistoryChunk(const TArray<uint8>& Chunk, int32 RawSize, bool bCompressed, TArray<FLobbyChannelEvent>& OutEvents);
+
+	void Reset();
+
+private:
+	FLobbyTokenBucket& GetBucket(int32 PlayerId, double Now);
+	void AddToHistory(const FLobbyChannelEvent& Event);
+
+	/** Anneau : HistoryHead = prochaine case écrite (la plus ancienne une fois plein). */
+	TArray<FLobbyChannelEvent> History;
+	int32 HistoryHead = 0;
+
+	TArray<FLobbyChannelEvent> Pending;
+	TMap<int32, FLobbyTokenBucket> Buckets;
+	TSet<int32> ReadyPlayers;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameFramework/OnlineReplStructs.h"
 #include "LobbyTypes.generated.h"
 
 // ============================================================
@@ -11,43 +12,111 @@ namespace LobbyConstants
 	// Port d'coute du beacon host
 	static constexpr int32 BeaconPort = 7787;
 
+	// PlayerId : index compact attribu par l'hte (1..MaxPlayerIndex, 0 = aucun), tient sur un octet
+	static constexpr int32 MaxPlayerIndex = 255;
+
+	// Port UDP de la dcouverte LAN filtre (FLanRoomDiscovery)
+	static constexpr int32 LanDiscoveryPort = 14010;
+
+	// Nonce commun du flux de mises  jour LAN : un push d'hte atteint tous les abonns
+	static constexpr uint64 LanRoomFeedNonce = 0x574F524D53464545ull;
+
+	// Migration d'hte : dlai de reconnexion vers l'lu avant d'lire le suivant
+	static constexpr double MigrationConnectTimeoutSeconds = 3.0;
+
+	// Migration d'hte : intervalle entre deux tentatives vers l'lu
+	static constexpr double MigrationRetrySeconds = 0.25;
+
+	// Migration d'hte : l'ancien hte est retent pendant ce dlai avant toute lection
+	// (une coupure de notre seul lien ne doit pas crer un second lobby)
+	static constexpr double HostLossConfirmSeconds = 2.0;
+
+	// Migration d'hte : dure de vie d'une place reprise mais pas encore reconnecte
+	static constexpr float MigrationGraceSeconds = 10.f;
+
+	// Fermeture de room : attente max des acquittements avant de librer les places
+	static constexpr float CloseAckTimeoutSeconds = 0.5f;
+
 	// Nombre max de rsultats de recherche
 	static constexpr int32 MaxSearchResults = 100;
 
-	// Cls des settings de session
-	static const FName Key_SessionName = TEXT("SETTING_SESSIONNAME");
-	static const FName Key_GameMode = TEXT("GAME_MODE");
-	static const FName Key_UnitLife = TEXT("UNIT_LIFE");
-	static const FName Key_UnitCount = TEXT("UNIT_COUNT");
-	static const FName Key_TurnsBeforeWater = TEXT("TURNS_BEFORE_WATER");
+	// Cl unique des settings de room : blob FRoomSettings versionn
+	static const FName Key_RoomSettings = TEXT("ROOM_SETTINGS");
 
-	// Identifiants de modes de jeu
+	// Mode seul (int32), pour le filtre ct service en ligne
+	static const FName Key_RoomMode = TEXT("ROOM_MODE");
+
+	// Libells des modes de jeu (combo box de l'UI)
 	static const FString GameMode_1V1 = TEXT("1V1");
 	static const FString GameMode_2V2 = TEXT("2V2");
 	static const FString GameMode_FFA = TEXT("FFA");
 }
 
+// ============================================================
+//  Modes de jeu
+//  Valeur = ID numrique de l'UI (icnes RoomMode) et octet du blob :
+//  ne pas rordonner, ajouter  la fin.
+// ============================================================
+UENUM(BlueprintType)
+enum class EWormsGameMode : uint8
+{
+	OneVsOne  UMETA(DisplayName = "1V1"),
+	TwoVsTwo  UMETA(DisplayName = "2V2"),
+	FFA       UMETA(DisplayName = "FFA"),
+	Count     UMETA(Hidden)
+};
+
+// ============================================================
+//  Liste de rooms en direct : nature d'un patch de ligne
+// ============================================================
+UENUM(BlueprintType)
+enum class ERoomListChange : uint8
+{
+	Added,
+	Updated,
+	Removed
+};
+
+// ============================================================
+//  Helper : libell de l'UI <-> GameMode
+// ============================================================
+inline EWormsGameMode ParseGameMode(const FString& Label)
+{
+	if (Label == LobbyConstants::GameMode_2V2) return EWormsGameMode::TwoVsTwo;
+	if (Label == LobbyConstants::GameMode_FFA) return EWormsGameMode::FFA;
+	return EWormsGameMode::OneVsOne; // fallback
+}
+
+inline const FString& GetGameModeLabel(EWormsGameMode GameMode)
+{
+	switch (GameMode)
+	{
+	case EWormsGameMode::TwoVsTwo: return LobbyConstants::GameMode_2V2;
+	case EWormsGameMode::FFA:      return LobbyConstants::GameMode_FFA;
+	default:                       return LobbyConstants::GameMode_1V1;
+	}
+}
+
 // ============================================================
 //  Helper : GameMode -> nombre max de joueurs
 // ============================================================
-inline int32 GetMaxPlayersForGameMode(const FString& GameMode)
+inline int32 GetMaxPlayersForGameMode(EWormsGameMode GameMode)
 {
-	if (GameMode == LobbyConstants::GameMode_1V1) return 2;
-	if (GameMode == LobbyConstants::GameMode_2V2) return 4;
-	if (GameMode == LobbyConstants::GameMode_FFA) return 4;
-	return 2; // fallback
+	switch (GameMode)
+	{
+	case EWormsGameMode::TwoVsTwo: return 4;
+	case EWormsGameMode::FFA:      return 4;
+	default:                       return 2;
+	}
 }
 
 // ============================================================
 //  Helper : GameMode -> ID numrique (pour l'UI)
 //  0 = 1V1 | 1 = 2V2 | 2 = FFA
 // ============================================================
-inline int32 GetGameModeID(const FString& GameMode)
+inline int32 GetGameModeID(EWormsGameMode GameMode)
 {
-	if (GameMode == LobbyConstants::GameMode_1V1) return 0;
-	if (GameMode == LobbyConstants::GameMode_2V2) return 1;
-	if (GameMode == LobbyConstants::GameMode_FFA) return 2;
-	return 0;
+	return static_cast<int32>(GameMode);
 }
 
 // ============================================================
@@ -70,7 +139,48 @@ struct FPlayerLobbyInfo
 	UPROPERTY(BlueprintReadWrite)
 	int32 TeamIcon = 0;
 
-	// Identifiant unique du joueur (pour dduplication ct host)
+	// Index compact attribu par l'hte  la rservation (li au FUniqueNetIdRepl) ;
+	// tient sur un octet dans les messages de jeu. 0 = pas encore admis.
 	UPROPERTY(BlueprintReadWrite)
 	int32 PlayerId = 0;
+
+	// Adresse du joueur vue par l'hte (renseigne par lui) : cible d'une migration d'hte
+	UPROPERTY(BlueprintReadOnly)
+	FString NetAddress = TEXT("");
+
+	// Identit qui a obtenu PlayerId (renseigne par l'hte) : aprs une migration,
+	// seule elle peut reprendre la place
+	UPROPERTY()
+	FUniqueNetIdRepl UniqueNetId;
+};
+
+// ============================================================
+//  Canal chat / prt du lobby (hors roster)
+// ============================================================
+UENUM(BlueprintType)
+enum class ELobbyEventKind : uint8
+{
+	Chat,
+	Ready
+};
+
+USTRUCT(BlueprintType)
+struct FLobbyChannelEvent
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	ELobbyEventKind Kind = ELobbyEventKind::Chat;
+
+	// Index compact de l'auteur (FPlayerLobbyInfo::PlayerId)
+	UPROPERTY(BlueprintReadOnly)
+	int32 PlayerId = 0;
+
+	// Ready : nouvel tat du joueur
+	UPROPERTY(BlueprintReadOnly)
+	bool bReady = false;
+
+	// Chat : texte du message (tronqu par l'hte)
+	UPROPERTY(BlueprintReadOnly)
+	FString Text = TEXT("");
 };
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LANBeacon.h"
+#include "Network/RoomSettings.h"
+
+/** Room annoncée sur le LAN (réponse d'un hôte). */
+struct FLanRoomAdvert
+{
+	FRoomSettings Settings;
+	int32 CurrentPlayers = 0;
+	int32 MaxPlayers = 0;
+
+	/** Adresse du beacon host : IPv4 "a.b.c.d" et port. */
+	FString HostAddress;
+	int32 BeaconPort = 0;
+
+	/**
+	 * Depuis le début de la recherche (même approximation que OnlineSubsystemNull).
+	 * INDEX_NONE : inconnu (room entendue hors de la fenêtre du snapshot).
+	 */
+	int32 PingMs = 0;
+};
+
+DECLARE_DELEGATE_OneParam(FOnLanRoomsFound, const TArray<FLanRoomAdvert>& /*Rooms*/);
+DECLARE_DELEGATE_TwoParams(FOnLanRoomChanged, ERoomListChange /*Change*/, const FLanRoomAdvert& /*Room*/);
+
+// ============================================================
+//  Découverte de rooms sur le LAN, filtrée côté hôte
+//
+//  Remplace la recherche LAN de l'OnlineSubsystem (qui répond pour
+//  toute session et laisse le client trier). Même transport UDP
+//  broadcast (FLANSession), sur un port dédié :
+//   - requête : en-tête FLANSession + FRoomQueryFilter (5 octets),
+//   - l'hôte évalue le filtre et ne répond que si sa room correspond,
+//   - réponse : adresse du beacon, joueurs, blob FRoomSettings.
+//
+//  Abonnement (liste en direct) : l'abonné envoie la même requête
+//  avec un drapeau d'abonnement, renouvelée avant expiration du bail.
+//  Tant qu'un bail court, l'hôte pousse ses changements sur le nonce
+//  commun LanRoomFeedNonce (un broadcast, tous les abonnés) :
+//   - Added : annonce complète (nouvelle room, settings changés,
+//     battement périodique qui rattrape un paquet perdu),
+//   - Updated : nombre de joueurs seul,
+//   - Removed : room fermée ; sans nouvelles, l'abonné l'expire.
+//  Non UObject : possédée et tickée par UOnlineSessionSubsystem.
+// ============================================================
+class WORMSNETWORKTD_API FLanRoomDiscovery
+{
+public:
+	/** Hôte : état courant de la room, lu à chaque requête. Faux = ne pas répondre. */
+	using FGetAdvert = TFunction<bool(FLanRoomAdvert& /*OutAdvert*/)>;
+
+	~FLanRoomDiscovery();
+
+	bool StartHosting(FGetAdvert InGetAdvert);
+	void StopHosting();
+	bool IsHosting() const { return bHosting; }
+
+	/** Client : une recherche à la fois (une nouvelle remplace la précédente). */
+	bool StartSearch(const FRoomQueryFilter& Filter, int32 MaxResults, FOnLanRoomsFound InOnFound);
+	void CancelSearch();
+	bool IsSearching() const { return bSearching; }
+
+	/** Client : liste en direct filtrée, un appel de OnChanged par patch de ligne. */
+	bool StartWatching(const FRoomQueryFilter& Filter, FOnLanRoomChanged InOnChanged);
+	void StopWatching();
+	bool IsWatching() const { return bWatching; }
+
+	void Tick(float DeltaTime);
+
+	// ----- Format des paquets (aussi utilisé par Worms.LanDiscoveryBench) -----
+
+	static constexpr int32 QueryPayloadSize = 5;
+
+	/** Abonné : renouvellement du bail. Hôte : annonce complète sans changement. */
+	static constexpr double RenewSeconds = 4.0;
+	static constexpr double HeartbeatSeconds = 15.0;
+
+	static void WriteQueryPayload(const FRoomQueryFilter& Filter, uint8 (&OutPayload)[QueryPayloadSize]);
+	static bool ReadQueryPayload(const uint8* Data, int32 Size, FRoomQueryFilter& OutFilter);
+
+	/** Faux si la room ne correspond pas au filtre : l'hôte se tait. */
+	static bool BuildReplyPayload(const FRoomQueryFilter& Filter, const FLanRoomAdvert& Advert, TArray<uint8>& OutPayload);
+	static bool ReadReplyPayload(const uint8* Data, int32 Size, FLanRoomAdvert& OutAdvert);
+
+	/** Push d'abonnement. Updated et Removed n'embarquent pas les settings. */
+	static void WriteUpdatePayload(ERoomListChange Change, const FLanRoomAdvert& Advert, TArray<uint8>& OutPayload);
+	static bool ReadUpdatePayload(const uint8* Data, int32 Size, ERoomListChange& OutChange, FLanRoomAdvert& OutAdvert);
+
+private:
+	void HandleQuery(uint8* PacketData, int32 PacketLength, uint64 ClientNonce);
+	void HandleReply(uint8* PacketData, int32 PacketLength);
+	void HandleSearchTimeout();
+	void FinishSearch();
+
+	void RenewWatch();
+	void PushRoomState(double Now);
+	void BroadcastUpdate(ERoomListChange Change, const FLanRoomAdvert& Advert);
+	void HandleUpdate(uint8* PacketData, int32 PacketLength);
+	void ExpireWatchedRooms(double Now);
+
+	struct FWatchedRoom
+	{
+		FLanRoomAdvert Advert;
+		double LastHeardSeconds = 0.0;
+	};
+
+	FLANSession HostSession;
+	FLANSession SearchSession;
+
+	FGetAdvert GetAdvert;
+	bool bHosting = false;
+
+	// Hôte : bail d'abonnement et dernier état poussé
+	double WatchedUntilSeconds = 0.0;
+	uint8 WatchModeMask = 0;
+	bool bPushedAny = false;
+	FLanRoomAdvert LastPushed;
+	double NextHeartbeatSeconds = 0.0;
+	double NextPushSeconds = 0.0;
+
+	FRoomQueryFilter SearchFilter;
+	int32 SearchMaxResults = 0;
+	double SearchStartSeconds = 0.0;
+	TArray<FLanRoomAdvert> SearchResults;
+	FOnLanRoomsFound OnFound;
+	bool bSearching = false;
+
+	/** Fin de recherche différée au Tick : jamais de StopLANSession pendant FLANSession::Tick. */
+	bool bSearchDone = false;
+
+	// Abonné : rooms connues, clé "adresse:port"
+	FLANSession WatchSession;
+	FRoomQueryFilter WatchFilter;
+	FOnLanRoomChanged OnChanged;
+	TMap<FString, FWatchedRoom> WatchedRooms;
+	TArray<TPair<ERoomListChange, FLanRoomAdvert>> PendingChanges;
+	double WatchStartSeconds = 0.0;
+	double NextRenewSeconds = 0.0;
+	bool bWatching = false;
+};
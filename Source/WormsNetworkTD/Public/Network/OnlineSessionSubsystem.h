@@ -5,10 +5,15 @@
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Beacon/LobbyTypes.h"
+#include "Network/RoomSettings.h"
+#include "Network/LanRoomDiscovery.h"
+#include "Containers/Ticker.h"
 #include "OnlineSessionSubsystem.generated.h"
 
 // Forward declaration pour viter l'inclusion circulaire
 class ALobbyBeaconClient;
+class ALobbyBeaconHostObject;
+class ULobbyBeaconPool;
 class AOnlineBeaconHost;
 
 // ============================================================
@@ -28,15 +33,28 @@ struct FCustomSessionInfo
 	UPROPERTY(BlueprintReadOnly)
 	int32 MaxPlayers = 0;
 
+	/** INDEX_NONE : inconnu (room LAN apparue dans la liste en direct). */
 	UPROPERTY(BlueprintReadOnly)
 	int32 Ping = 0;
 
 	// Index dans le tableau SearchResults  utilis pour rejoindre la session
+	// (INDEX_NONE pour une room trouve par FLanRoomDiscovery)
 	UPROPERTY(BlueprintReadOnly)
 	int32 SessionSearchResultIndex = 0;
 
+	// Adresse du beacon host annonce sur le LAN ; vide = rsultat du service en ligne
 	UPROPERTY(BlueprintReadOnly)
-	FString GameMode = TEXT("");
+	FString HostAddress;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 BeaconPort = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	EWormsGameMode GameMode = EWormsGameMode::OneVsOne;
+
+	/** Blob Key_RoomSettings dcod une fois,  la rception du rsultat. */
+	UPROPERTY(BlueprintReadOnly)
+	FRoomSettings Settings;
 };
 
 // ============================================================
@@ -46,6 +64,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFindGameSessionsComplete,
 	const TArray<FCustomSessionInfo>&, SessionResults,
 	bool, Successful);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRoomListPatched,
+	const FCustomSessionInfo&, Room,
+	ERoomListChange, Change);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSessionJoinCompleted,
 	bool, bWasSuccessful);
 
@@ -55,6 +77,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBeaconClientCreated,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLobbysUpdated,
 	const TArray<FPlayerLobbyInfo>&, Players);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLobbyClosed);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLobbyChannelEvents,
+	const TArray<FLobbyChannelEvent>&, Events);
+
 // ============================================================
 //  Subsystem
 // ============================================================
@@ -69,7 +96,9 @@ protected:
 
 public:
 	// ----- Interface de session -----
+	// Rsolue paresseusement : toujours passer par EnsureSessionInterface().
 	IOnlineSessionPtr Session;
+	bool EnsureSessionInterface();
 	TSharedPtr<FOnlineSessionSettings> LastSessionSettings;
 
 	// ----- Cration de session -----
@@ -98,16 +127,42 @@ public:
 public:
 	// ----- API publique -----
 
+	/** Nombre de places dduit du mode de jeu (GetMaxPlayersForGameMode). */
 	UFUNCTION(BlueprintCallable, Category = "Session")
-	void CreateSession(const FString& SessionName, int32 NumPublicConnections, bool bIsLanMatch,
-		const FString& GameMode, int32 UnitLife, int32 UnitCount, int32 TurnsBeforeWater);
+	void CreateSession(const FRoomSettings& RoomSettings, bool bIsLanMatch);
+
+	/** Settings de la room hberge (valides tant que LastSessionSettings l'est). */
+	const FRoomSettings& GetHostedRoomSettings() const { return HostedRoomSettings; }
 
+	/** Recherche sans filtre (quivaut  FindSessionsFiltered avec un FRoomQueryFilter par dfaut). */
 	UFUNCTION(BlueprintCallable, Category = "Session")
 	void FindSessions(int32 MaxSearchResults, bool bIsLANQuery);
 
+	/**
+	 * Recherche filtre  la source : en ligne, le filtre devient des
+	 * QuerySettings valus par le service ; en LAN, il est envoy dans la
+	 * requte broadcast et seuls les htes qui correspondent rpondent.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void FindSessionsFiltered(int32 MaxSearchResults, bool bIsLANQuery, const FRoomQueryFilter& Filter);
+
 	UPROPERTY(BlueprintAssignable, Category = "Session")
 	FOnFindGameSessionsComplete OnFindSessionsCompleteEvent;
 
+	/**
+	 * Liste de rooms en direct (LAN) : au lieu de relancer des recherches,
+	 * les htes poussent leurs changements et chaque ligne arrive en
+	 * patch via OnRoomListPatched. Un nouvel appel remplace le filtre.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	bool StartRoomListSubscription(const FRoomQueryFilter& Filter);
+
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void StopRoomListSubscription();
+
+	UPROPERTY(BlueprintAssignable, Category = "Session")
+	FOnRoomListPatched OnRoomListPatched;
+
 	/**
 	 * Rejoint une session via Beacon (pas de ServerTravel immdiat).
 	 * Le beacon sert  valider la rservation et synchroniser le lobby.
@@ -115,9 +170,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Session")
 	void CustomJoinSession(const FCustomSessionInfo& SessionInfo);
 
+	/**
+	 * Rserve dans la premire room qui accepte, dans l'ordre donn. Un
+	 * refus passe  la suivante sans reconnexion : la room suivante est
+	 * prchauffe pendant la rservation en cours (ULobbyBeaconPool).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void JoinFirstAvailable(const TArray<FCustomSessionInfo>& Candidates);
+
 	UFUNCTION(BlueprintCallable, Category = "Session")
 	void DestroySession();
 
+	/**
+	 * Fermeture propre de la room hberge : les clients sont prvenus en un
+	 * message et quittent le lobby en un aller simple ; la session et le
+	 * beacon host sont dtruits aprs leurs acquittements (DestroySession).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void CloseRoom();
+
 	/** Cre/met  jour un setting custom dans la session en cours. */
 	template<typename ValueType>
 	void UpdateCustomSetting(const FName& KeyName, const ValueType& Value,
@@ -146,11 +217,32 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnLobbysUpdated OnLobbysUpdated;
 
+	/** Client : l'hte a ferm la room, le beacon client est dj nettoy. */
+	UPROPERTY(BlueprintAssignable)
+	FOnLobbyClosed OnLobbyClosed;
+
+	// ----- Chat / prt du lobby -----
+
+	/** Message de chat vers l'hte (canal spar du roster, dbit limit). */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void SendLobbyChat(const FString& Text);
+
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void SetLobbyReady(bool bReady);
+
+	/** Lots chat / prt reus par le beacon client (historique d'admission compris). */
+	UPROPERTY(BlueprintAssignable)
+	FOnLobbyChannelEvents OnLobbyChannelEvents;
+
 	// ----- Accesseurs beacon client -----
 
 	UFUNCTION()
 	ALobbyBeaconClient* GetLobbyBeaconClient() const { return LobbyBeaconClient; }
 
+	/** Hte du lobby perdu, lection ou reconnexion en cours (le roster affich reste le dernier reu). */
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	bool IsMigratingHost() const { return Migration.bActive; }
+
 	// ----- tat interne -----
 
 	int32 MaxPlayers = 0;
@@ -164,9 +256,53 @@ private:
 	UPROPERTY()
 	ALobbyBeaconClient* LobbyBeaconClient = nullptr;
 
+	/** Host object enregistr sur BeaconHost : source du nombre de joueurs annonc en LAN. */
+	TWeakObjectPtr<ALobbyBeaconHostObject> LobbyHostObject;
+
 	/** vite les doubles connexions beacon. */
 	bool bBeaconConnecting = false;
 
+	// ----- Join via pool de connexions -----
+	UPROPERTY()
+	ULobbyBeaconPool* BeaconPool = nullptr;
+
+	TArray<FCustomSessionInfo> JoinCandidates;
+	int32 NextJoinCandidate = 0;
+	TWeakObjectPtr<ALobbyBeaconClient> PendingJoinClient;
+	FString PendingJoinAddress;
+	int32 PendingJoinPort = 0;
+	double JoinStartSeconds = 0.0;
+	int32 JoinAttempts = 0;
+
+	/** Room rejointe ou hberge en LAN : le nouvel hte d'une migration s'y annonce aussi. */
+	bool bLobbyIsLan = false;
+
+	/** Beacon de l'hte du lobby rejoint : retent  la perte de connexion avant d'lire. */
+	FString LobbyHostAddress;
+	int32 LobbyHostPort = 0;
+
+	/** Adresse du beacon d'une room ; faux si elle n'est plus joignable. */
+	bool ResolveBeaconAddress(const FCustomSessionInfo& SessionInfo, FString& OutAddress, int32& OutPort) const;
+	void TryNextJoinCandidate();
+	void HandleJoinReservation(bool bValidated, TWeakObjectPtr<ALobbyBeaconClient> WeakClient);
+
+	// ----- Dcouverte LAN filtre -----
+	FLanRoomDiscovery LanDiscovery;
+	FTSTicker::FDelegateHandle NetworkTickHandle;
+
+	/** Filtre de la dernire recherche en ligne, revrifi  la rception. */
+	FRoomQueryFilter LastQueryFilter;
+
+	/** Core ticker : dcouverte LAN et entretien du pool beacon. */
+	bool TickNetwork(float DeltaTime);
+	void StartLanAdvertising();
+	void OnLanRoomsFound(const TArray<FLanRoomAdvert>& Rooms);
+	void OnLanRoomChanged(ERoomListChange Change, const FLanRoomAdvert& Room);
+
+	/** Source du blob annonc : relu ici plutt que dcod depuis LastSessionSettings. */
+	UPROPERTY()
+	FRoomSettings HostedRoomSettings;
+
 	/**
 	 * Informations du joueur hte, stockes entre CreateSession() et
 	 * la connexion beacon. Doit tre rempli par l'UI via SetHostPlayerInfo()
@@ -174,10 +310,58 @@ private:
 	 */
 	FPlayerLobbyInfo PendingHostPlayerInfo;
 
+	// ----- Migration d'hte -----
+
+	/**
+	 * Copie du lobby prise  la perte de l'hte. L'ancien hte est d'abord
+	 * retent pendant HostLossConfirmSeconds : s'il rpond, seul notre lien
+	 * tait tomb et on reprend sa room. Sinon, lection dterministe :
+	 * plus petit PlayerId parmi les joueurs restants, identique chez tous
+	 * les clients puisqu'ils partagent la mme rvision du roster. Un lu
+	 * injoignable aprs MigrationConnectTimeoutSeconds est cart et
+	 * l'lection recommence sans lui.
+	 */
+	struct FLobbyMigration
+	{
+		TArray<FPlayerLobbyInfo> Candidates;
+		FRoomSettings Settings;
+		FPlayerLobbyInfo LocalPlayer;
+		int32 Revision = 0;
+		int32 ElectedPlayerId = 0;
+		double ElectedDeadline = 0.0;
+		double NextAttemptSeconds = 0.0;
+		double StartSeconds = 0.0;
+		FString LostHostAddress;
+		int32 LostHostPort = 0;
+		double ConfirmDeadline = 0.0;
+		bool bConfirmingHostLoss = false;
+		bool bActive = false;
+	};
+	FLobbyMigration Migration;
+
+	void HandleHostLost();
+	void HandleRoomClosed();
+	void ElectMigratedHost();
+	void BecomeMigratedHost();
+
+	/** Appel par TickNetwork : ancien hte retent, puis (re)connexion vers l'lu, lu suivant  l'chance. */
+	void TickMigration(double Now);
+	void RequestMigrationReservation(const FString& Address, int32 Port);
+	void HandleMigrationReservation(bool bValidated, TWeakObjectPtr<ALobbyBeaconClient> WeakClient);
+
+	/** Tentative de rservation en cours abandonne (connexion ferme, hors du pool). */
+	void AbandonPendingJoin();
+
+	/** Client admis (join ou migration) : devient la connexion du lobby. */
+	void AdoptLobbyClient(ALobbyBeaconClient* Client);
+
 	/** Relais interne : propage les mises  jour lobby au delegate public. */
 	UFUNCTION()
 	void HandleLobbyUpdated_Internal(const TArray<FPlayerLobbyInfo>& Players);
 
+	UFUNCTION()
+	void HandleLobbyEvents_Internal(const TArray<FLobbyChannelEvent>& Events);
+
 	/** Nettoyage du beacon client (disconnect + destroy). */
 	void CleanupBeaconClient();
 
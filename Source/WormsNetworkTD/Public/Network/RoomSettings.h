@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Beacon/LobbyTypes.h"
+#include "RoomSettings.generated.h"
+
+// ============================================================
+//  Settings d'une room, annoncés en un seul blob
+//
+//  Un seul setting de session (LobbyConstants::Key_RoomSettings,
+//  ViaOnlineServiceAndPing) au lieu d'une clé par valeur : ~10 octets
+//  dans le ping LAN, décodé une fois par résultat de recherche.
+//
+//  Format v1 (octets) :
+//    Version | GameMode | UnitLife (u16) | UnitCount | TurnsBeforeWater
+//    | longueur du nom | nom (UTF-8)
+//  Nouveau setting : ajouté en fin de blob avec Version + 1. Un client
+//  plus ancien lit le préfixe qu'il connaît et ignore la suite.
+// ============================================================
+USTRUCT(BlueprintType)
+struct WORMSNETWORKTD_API FRoomSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	static constexpr uint8 CurrentVersion = 1;
+
+	/** Tronqué à l'encodage. */
+	static constexpr int32 MaxRoomNameChars = 32;
+
+	UPROPERTY(BlueprintReadWrite)
+	FString RoomName = TEXT("");
+
+	UPROPERTY(BlueprintReadWrite)
+	EWormsGameMode GameMode = EWormsGameMode::OneVsOne;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 UnitLife = 100;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 UnitCount = 1;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 TurnsBeforeWater = 10;
+
+	int32 GetMaxPlayers() const { return GetMaxPlayersForGameMode(GameMode); }
+
+	TArray<uint8> Encode() const;
+
+	/** Faux si le blob est tronqué ou invalide (la struct est alors indéterminée). */
+	bool Decode(TConstArrayView<uint8> Blob);
+};
+
+// ============================================================
+//  Filtre de recherche de rooms
+//
+//  Évalué par l'hôte avant de répondre (LAN : FLanRoomDiscovery ;
+//  service en ligne : QuerySettings) : une room qui ne peut pas
+//  correspondre n'envoie rien. Le ping n'est connu que du client,
+//  MaxPingMs est donc appliqué à la réception.
+// ============================================================
+USTRUCT(BlueprintType)
+struct WORMSNETWORKTD_API FRoomQueryFilter
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Bit i = EWormsGameMode i accepté. */
+	UPROPERTY(BlueprintReadWrite)
+	uint8 ModeMask = 0xFF;
+
+	/** Rooms pleines exclues. */
+	UPROPERTY(BlueprintReadWrite)
+	bool bRequireFreeSlot = false;
+
+	/** 0 = pas de limite. Avec une limite, un ping inconnu (< 0) est refusé. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 MaxPingMs = 0;
+
+	void SetModeAllowed(EWormsGameMode GameMode, bool bAllowed);
+	bool AllowsMode(EWormsGameMode GameMode) const { return (ModeMask & (1u << static_cast<uint8>(GameMode))) != 0; }
+
+	/** Un seul mode accepté (filtrable par égalité côté service), sinon Count. */
+	EWormsGameMode GetSingleMode() const;
+
+	/** Critères connus de l'hôte (mode, place libre). */
+	bool MatchesRoom(const FRoomSettings& Room, int32 CurrentPlayers, int32 MaxPlayers) const;
+
+	bool MatchesPing(int32 PingMs) const { return MaxPingMs <= 0 || (PingMs >= 0 && PingMs <= MaxPingMs); }
+};
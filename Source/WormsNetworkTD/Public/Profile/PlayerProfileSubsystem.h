@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Async/Future.h"
+#include "Beacon/LobbyTypes.h"
+#include "Network/RoomSettings.h"
+#include "PlayerProfileSubsystem.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlayerProfileLoaded);
+
+// ============================================================
+//  Profil local du joueur (format .wprf)
+//
+//  Format v1 (octets) :
+//    Magic (u32) | Version | longueur du nom | nom (UTF-8)
+//    | ProfileIcon | TeamIcon | longueur du blob room | FRoomSettings::Encode()
+//  Même règle que FRoomSettings : un nouveau champ s'ajoute en fin avec
+//  Version + 1, une version plus ancienne lit le préfixe qu'elle connaît.
+// ============================================================
+USTRUCT(BlueprintType)
+struct WORMSNETWORKTD_API FPlayerProfile
+{
+	GENERATED_USTRUCT_BODY()
+
+	static constexpr uint32 Magic = 0x46525057; // "WPRF"
+	static constexpr uint8 CurrentVersion = 1;
+
+	/** Tronqué à l'encodage. */
+	static constexpr int32 MaxPlayerNameChars = 24;
+
+	UPROPERTY(BlueprintReadWrite)
+	FString PlayerName = TEXT("");
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 ProfileIcon = 0;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 TeamIcon = 0;
+
+	/** Settings de la dernière room ouverte, reproposés à la création suivante. */
+	UPROPERTY(BlueprintReadWrite)
+	FRoomSettings LastRoomSettings;
+
+	TArray<uint8> Encode() const;
+
+	/** Faux si le blob est tronqué ou invalide (la struct est alors indéterminée). */
+	bool Decode(TConstArrayView<uint8> Blob);
+};
+
+// ============================================================
+//  Subsystem de profil
+//
+//  Chargé une fois au démarrage sur le pool de threads (lecture +
+//  décodage), appliqué sur le game thread puis OnProfileLoaded.
+//  Chaque modification est différée de SaveDebounceSeconds : une
+//  rafale de changements donne une seule écriture, faite hors du
+//  game thread (fichier temporaire puis remplacement). Une écriture
+//  au plus en vol ; celle de fin de session est synchrone.
+//  Alimente FPlayerLobbyInfo (hôte et joueur qui rejoint).
+// ============================================================
+UCLASS(Config = Game)
+class WORMSNETWORKTD_API UPlayerProfileSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+public:
+	/** Valeurs par défaut tant que IsLoaded() est faux. */
+	const FPlayerProfile& GetProfile() const { return Profile; }
+
+	UFUNCTION(BlueprintCallable, Category = "Profile")
+	bool IsLoaded() const { return bLoaded; }
+
+	/** Nom et icônes du profil ; PlayerId et UnitNB restent à remplir par l'hôte. */
+	UFUNCTION(BlueprintCallable, Category = "Profile")
+	FPlayerLobbyInfo MakeLobbyInfo() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Profile")
+	void SetPlayerName(const FString& PlayerName);
+
+	UFUNCTION(BlueprintCallable, Category = "Profile")
+	void SetIcons(int32 ProfileIcon, int32 TeamIcon);
+
+	UFUNCTION(BlueprintCallable, Category = "Profile")
+	void SetLastRoomSettings(const FRoomSettings& RoomSettings);
+
+	/** Diffusé une fois, que le fichier existe ou non. */
+	UPROPERTY(BlueprintAssignable)
+	FOnPlayerProfileLoaded OnProfileLoaded;
+
+private:
+	/** Délai sans modification avant l'écriture (DefaultGame.ini). */
+	UPROPERTY(Config)
+	float SaveDebounceSeconds = 2.f;
+
+	/** Une suite ininterrompue de modifications est écrite au plus tard après ce délai. */
+	UPROPERTY(Config)
+	float MaxSaveDelaySeconds = 10.f;
+
+	/** Fichier dans Saved/SaveGames. */
+	UPROPERTY(Config)
+	FString ProfileFileName = TEXT("Profile.wprf");
+
+	UPROPERTY()
+	FPlayerProfile Profile;
+
+	bool bLoaded = false;
+
+	/** Champs modifiés avant la fin du chargement : ils l'emportent sur le fichier. */
+	enum EProfileField : uint8
+	{
+		Field_Name = 1 << 0,
+		Field_Icons = 1 << 1,
+		Field_Room = 1 << 2
+	};
+	uint8 FieldsChangedBeforeLoad = 0;
+
+	bool bDirty = false;
+	double FirstDirtySeconds = 0.0;
+	double SaveDueSeconds = 0.0;
+
+	/** Écriture en cours sur le pool de threads (résultat : succès disque). */
+	TFuture<bool> SaveTask;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	FString GetProfilePath() const;
+	void MarkDirty(uint8 Field);
+	void HandleProfileLoaded(const FPlayerProfile& Loaded, bool bFound);
+	void StartSave();
+	bool Tick(float DeltaTime);
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Containers/Ticker.h"
+#include "BeaconNetBenchmark.generated.h"
+
+class AOnlineBeaconHost;
+class ALobbyBeaconHostObject;
+class ALobbyBeaconClient;
+
+// ============================================================
+//  Conditions réseau émulées (PacketSimulationSettings du NetDriver)
+// ============================================================
+struct FBeaconNetCondition
+{
+	FString Name;
+	int32 LossPercent = 0;   // perte dans chaque sens
+	int32 LagMinMs = 0;      // latence min dans chaque sens
+	int32 LagMaxMs = 0;      // latence max (LagMax - LagMin = jitter)
+};
+
+struct FBeaconNetResult
+{
+	FString ConditionName;
+	int32 NumClients = 0;
+	int32 NumReserved = 0;
+	int32 NumConverged = 0;
+	double ReservationMedianMs = -1.0;
+	double ReservationMaxMs = -1.0;
+	double RosterConvergenceMs = -1.0;
+	double CloseNotifyMaxMs = -1.0;   // dernier client prévenu de la fermeture
+	double HostCloseMs = -1.0;        // places libérées (acquittements ou délai)
+	uint64 ClientBytesOut = 0;
+	uint64 ClientBytesIn = 0;
+	bool bTimedOut = false;
+};
+
+// ============================================================
+//  Benchmark beacon en loopback
+//
+//  Lance un host beacon + N clients dans le même process, applique une
+//  matrice de conditions réseau et mesure :
+//   - le temps jusqu'à Client_ReservationAccepted (par client),
+//   - le temps jusqu'à ce que TOUS les clients aient le roster complet,
+//   - la fermeture de la room (BeginClose) : dernier client prévenu et
+//     libération des places côté hôte,
+//   - les octets émis / reçus par les NetDrivers clients.
+//  Le rapport (Saved/Profiling/BeaconNetBench.txt) a un format fixe,
+//  trié par condition, pour être diffé d'un commit à l'autre.
+//
+//  Console : Worms.BeaconNetBench [NumClients] [exit]
+//  Headless : -nullrhi -ExecCmds="Worms.BeaconNetBench 3 exit"
+//  Nécessite un build non-Shipping (DO_ENABLE_NET_TEST).
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API UBeaconNetBenchmark : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Démarre le benchmark sur le monde donné. Renvoie false si un run est déjà en cours. */
+	static bool Run(UWorld* World, int32 NumClients, bool bExitWhenDone);
+
+	static TArray<FBeaconNetCondition> GetDefaultMatrix();
+
+private:
+	enum class EStep : uint8
+	{
+		StartCondition,
+		Running,
+		Closing,
+		Teardown,
+		Done
+	};
+
+	bool Tick(float DeltaTime);
+	void StartCondition();
+	void FinishCondition(bool bTimedOut);
+	void Teardown();
+	void WriteReport() const;
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<FBeaconNetCondition> Matrix;
+	TArray<FBeaconNetResult> Results;
+	int32 ConditionIndex = 0;
+	int32 NumClients = 3;
+	bool bExitWhenDone = false;
+	EStep Step = EStep::StartCondition;
+
+	UPROPERTY()
+	TObjectPtr<AOnlineBeaconHost> BeaconHost;
+
+	UPROPERTY()
+	TObjectPtr<ALobbyBeaconHostObject> HostObject;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ALobbyBeaconClient>> Clients;
+
+	double ConditionStartTime = 0.0;
+	double TeardownStartTime = 0.0;
+	TArray<double> ReservationTimes;
+	double ConvergenceTime = -1.0;
+	double CloseStartTime = 0.0;
+	TArray<double> CloseNotifyTimes;
+	double HostCloseTime = -1.0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static TWeakObjectPtr<UBeaconNetBenchmark> ActiveRun;
+};
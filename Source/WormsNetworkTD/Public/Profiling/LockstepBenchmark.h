@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/LockstepSimulation.h"
+
+struct FLockstepBenchResult
+{
+	int32 NumTurns = 0;
+	uint32 NumFrames = 0;
+	double SimMicrosecondsPerTick = 0.0;
+	bool bDeterministic = false;
+
+	// Octets par tour, topologie listen server (N - 1 clients distants)
+	double LockstepBytesUpPerTurn = 0.0;
+	double LockstepBytesDownPerTurn = 0.0;
+
+	/** Ticks où un client distant attendait sa frame (modèle réseau). */
+	uint32 NetStallTicks = 0;
+
+	double RepMovementBytesPerTurn = 0.0;
+	int32 RepMovementBitsPerUpdate = 0;
+	float NetUpdateFrequency = 0.f;
+};
+
+// ============================================================
+//  Benchmark lockstep (hors ligne, sans monde)
+//
+//  Joue une partie scriptée deux fois avec la même graine :
+//   - vérifie que les checksums de chaque tour sont identiques,
+//   - mesure le coût CPU d'un tick de simulation,
+//   - compare les octets/tour du flux d'inputs à ce que coûterait
+//     SetReplicateMovement(true) sur les mêmes déplacements
+//     (FRepMovement sérialisé à GetNetUpdateFrequency() du worm).
+//  Le flux d'inputs est rejoué sur le protocole du subsystem (paquets
+//  redondants, accusés, renvoi à 100 ms) avec une latence fixe sans perte,
+//  chaque paquet mesuré par NetSerialize.
+//  Le coût de référence ignore les ServerMove du CharacterMovement
+//  client -> serveur : c'est un minorant.
+//
+//  Rapport : Saved/Profiling/LockstepBench.txt
+//  Console : Worms.LockstepBench [NumTurns] [exit]
+// ============================================================
+class WORMSNETWORKTD_API FLockstepBenchmark
+{
+public:
+	static FLockstepBenchResult Run(const FLockstepMatchConfig& Config, int32 NumTurns);
+
+	/** Inputs scriptés de la frame courante (marche, saut, tir), fonction pure de l'état. */
+	static void MakeScriptedInputs(const FLockstepState& State, int32 NumPlayers, TArray<FLockstepInput>& OutInputs);
+
+	/** Saved/Profiling/LockstepBench.txt, puis sortie du moteur si bExitWhenDone. */
+	static void WriteReport(const FLockstepMatchConfig& Config, const FLockstepBenchResult& Result, bool bExitWhenDone = false);
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================
+//  Rapport texte commun aux outils Worms.* (Saved/Profiling/<Nom>.txt)
+//
+//  Format fixe, diffable d'un commit à l'autre :
+//    # <Nom> v<Version> | clé=valeur | ...
+//    [section]
+//      mesure                         valeur
+//  Écriture, trace dans le log et sortie du moteur ("exit" en
+//  argument) sont faites ici pour tous les outils.
+// ============================================================
+class WORMSNETWORKTD_API FProfilingReport
+{
+public:
+	/** Fields : "clé=valeur | clé=valeur", sans le nom ni la version. */
+	FProfilingReport(const TCHAR* InName, int32 Version, const FString& Fields, int32 InKeyWidth = 24);
+
+	void AddSection(const FString& Label);
+	void AddInt(const TCHAR* Key, int64 Value);
+	void AddFloat(const TCHAR* Key, double Value, int32 Decimals = 2);
+	void AddText(const TCHAR* Key, const FString& Value);
+	void AddYesNo(const TCHAR* Key, bool bValue);
+
+	/** Ligne libre (tableaux propres à un outil). */
+	void AddLine(const FString& Line);
+
+	const FString& GetText() const { return Text; }
+
+	/** Saved/Profiling/<Nom>.txt + log ; renvoie le chemin du fichier. */
+	FString Write() const;
+
+	/** Write() puis RequestEngineExit si bExitWhenDone. */
+	void WriteAndMaybeExit(bool bExitWhenDone) const;
+
+	/** "exit" présent parmi les arguments de la commande console. */
+	static bool HasExitArg(const TArray<FString>& Args);
+
+	/** Médiane en millisecondes d'échantillons en secondes (trie Samples). */
+	static double MedianMs(TArray<double>& Samples);
+
+private:
+	FString Name;
+	FString Text;
+	int32 KeyWidth = 24;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================
+//  Trace de démarrage (cold start -> menu interactif)
+//
+//  Chaque étape pose un marqueur horodaté depuis le lancement du process
+//  (GStartTime). À la fin, la trace est exportée en JSON dans
+//  Saved/Profiling/StartupTrace.json.
+//
+//  Ligne de commande :
+//    -StartupTrace           exporte la trace quand le menu est interactif
+//    -ExitAfterStartupTrace  quitte juste après l'export (bench headless,
+//                            ex: -nullrhi -unattended -ExitAfterStartupTrace)
+// ============================================================
+namespace StartupTraceMarkers
+{
+	static const TCHAR* ModuleStartup = TEXT("ModuleStartup");
+	static const TCHAR* GameInstanceInit = TEXT("GameInstanceInit");
+	static const TCHAR* SessionSubsystemInit = TEXT("SessionSubsystemInit");
+	static const TCHAR* SessionInterfaceResolved = TEXT("SessionInterfaceResolved");
+	static const TCHAR* PlayerControllerBeginPlay = TEXT("PlayerControllerBeginPlay");
+	static const TCHAR* MenuConstructed = TEXT("MenuConstructed");
+	static const TCHAR* MenuFirstPaint = TEXT("MenuFirstPaint");
+}
+
+class WORMSNETWORKTD_API FStartupTrace
+{
+public:
+	/** Pose un marqueur (seule la première occurrence d'un nom est gardée). */
+	static void Mark(const TCHAR* Name);
+
+	/**
+	 * Le menu est interactif : clôt la trace, l'exporte si demandé
+	 * et quitte si -ExitAfterStartupTrace est présent.
+	 */
+	static void Finish();
+
+	/** Écrit la trace courante sur disque, renvoie le chemin du fichier. */
+	static FString Export();
+
+	static bool IsFinished() { return bFinished; }
+
+private:
+	struct FMarker
+	{
+		FString Name;
+		double SecondsSinceStart = 0.0;
+		uint32 ThreadId = 0;
+	};
+
+	static TArray<FMarker> Markers;
+	static FCriticalSection MarkersLock;
+	static bool bFinished;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PaperGroupedSpriteComponent.h"
+#include "WormSpriteBatchComponent.generated.h"
+
+// ============================================================
+//  Lot de sprites d'un atlas
+//
+//  Un UPaperGroupedSpriteComponent dessine toutes ses instances qui
+//  partagent une texture en un seul draw call. On y ajoute seulement
+//  le changement de sprite par instance (frame de flipbook), que le
+//  composant moteur n'expose pas, et un flag de modification pour ne
+//  renvoyer le lot au rendu que si une instance a changé.
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API UWormSpriteBatchComponent : public UPaperGroupedSpriteComponent
+{
+	GENERATED_BODY()
+
+public:
+	UWormSpriteBatchComponent();
+
+	/** Change la frame affichée (le lot est marqué modifié). */
+	void SetInstanceSprite(int32 InstanceIndex, UPaperSprite* Sprite);
+
+	void MarkInstancesDirty() { bInstancesDirty = true; }
+
+	/** Un seul MarkRenderStateDirty par frame, et seulement si nécessaire. */
+	void FlushInstances();
+
+private:
+	bool bInstancesDirty = false;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Simulation/DamageTypes.h"
+#include "WormSpriteBatchSubsystem.generated.h"
+
+class UPaperFlipbook;
+class UTexture;
+class UWormSpriteBatchComponent;
+
+/** Tête de lecture partagée par toutes les entrées qui jouent un flipbook. */
+USTRUCT()
+struct FFlipbookTimeline
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UPaperFlipbook> Flipbook = nullptr;
+
+	int32 KeyFrame = 0;
+	int32 NumKeyFrames = 0;
+	int32 RefCount = 0;
+};
+
+/** Un sprite animé rendu par lot (worm, projectile, particule). */
+USTRUCT()
+struct FWormSpriteEntry
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AActor> Owner;
+
+	/** Clé de OwnerToEntry, encore valable après destruction de Owner. */
+	TObjectKey<AActor> OwnerKey;
+
+	/** Référence dure : le flipbook reste chargé tant qu'il est affiché. */
+	UPROPERTY()
+	TObjectPtr<UPaperFlipbook> Flipbook = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UWormSpriteBatchComponent> Batch = nullptr;
+
+	int32 Instance = INDEX_NONE;
+	FVector Offset = FVector::ZeroVector;
+	float Scale = 1.f;
+	float Facing = 1.f;
+	FLinearColor Tint = FLinearColor::White;
+	float FlashTimeLeft = 0.f;
+
+	/** Décalage en keyframes par rapport à la tête de lecture partagée. */
+	int32 PhaseKeyFrames = 0;
+
+	/** Recalage d'une animation redémarrée (saut, chute), remis à zéro au changement suivant. */
+	int32 RestartKeyFrames = 0;
+
+	// Dernier état envoyé au lot : rien n'est réécrit s'il n'a pas changé
+	int32 ShownKeyFrame = INDEX_NONE;
+	FTransform ShownTransform;
+	FLinearColor ShownColor = FLinearColor::Transparent;
+
+	bool bUsed = false;
+};
+
+// ============================================================
+//  Rendu groupé des flipbooks
+//
+//  Remplace le UPaperFlipbookComponent de chaque worm : un seul
+//  UWormSpriteBatchComponent par atlas (texture des frames) dessine
+//  toutes les entrées qui le partagent, en un draw call. Par instance :
+//  frame courante du flipbook, retournement (FacingDirection) et teinte.
+//
+//  Animation sur timeline partagée : chaque flipbook utilisé avance
+//  sa tête de lecture une fois par frame (FFlipbookTimeline) ; une
+//  entrée n'en lit que l'index, décalé de sa phase. Les entrées hors
+//  du rectangle visible (AWormsCameraManager) sont réduites à une
+//  échelle nulle puis plus mises à jour, et un lot n'est renvoyé au
+//  rendu que si une instance a changé.
+//
+//  Les flashs de dégâts viennent des événements de
+//  UDamageResolutionSubsystem. Inexistant sur serveur dédié.
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API UWormSpriteBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Nouvelle entrée suivant la position de Owner. Renvoie un handle. */
+	int32 AddEntry(AActor* Owner, const FVector& Offset = FVector::ZeroVector, float Scale = 1.f);
+	void RemoveEntry(int32 Handle);
+
+	/**
+	 * Change d'animation (et de lot si l'atlas diffère). bRestart : l'entrée
+	 * est recalée pour repartir de la première keyframe (saut, chute) ;
+	 * sinon elle reprend son décalage de phase (idle, course désynchronisés).
+	 */
+	void SetFlipbook(int32 Handle, UPaperFlipbook* Flipbook, bool bRestart = false);
+
+	/** Décalage fixe en keyframes par rapport à la timeline partagée. */
+	void SetPhaseOffset(int32 Handle, int32 PhaseKeyFrames);
+
+	/** +1 = vers la droite, -1 = retourné. */
+	void SetFacing(int32 Handle, float Facing);
+	void SetTint(int32 Handle, const FLinearColor& Tint);
+
+	int32 GetNumBatches() const { return Batches.Num(); }
+	int32 GetNumTimelines() const { return Timelines.Num(); }
+
+	/** Entrées ignorées à la dernière frame car hors écran. */
+	int32 GetNumSkippedLastFrame() const { return NumSkippedLastFrame; }
+
+private:
+	UWormSpriteBatchComponent* GetOrCreateBatch(UTexture* Atlas);
+
+	/** Retire l'instance de son lot et recale les index des autres entrées du lot. */
+	void DetachInstance(FWormSpriteEntry& Entry);
+
+	FFlipbookTimeline* AcquireTimeline(UPaperFlipbook* Flipbook);
+	void ReleaseTimeline(UPaperFlipbook* Flipbook);
+
+	UFUNCTION()
+	void HandleDamageEvents(const TArray<FWormsDamageEvent>& Events);
+
+	UPROPERTY()
+	TArray<FWormSpriteEntry> Entries;
+	TArray<int32> FreeList;
+	TMap<TObjectKey<AActor>, int32> OwnerToEntry;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UPaperFlipbook>, FFlipbookTimeline> Timelines;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UTexture>, TObjectPtr<UWormSpriteBatchComponent>> Batches;
+
+	/** Porteur transient des lots, à l'origine du monde. */
+	UPROPERTY()
+	TObjectPtr<AActor> BatchOwner;
+
+	int32 NumSkippedLastFrame = 0;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Simulation/DamageTypes.h"
+#include "Simulation/SpatialHash2D.h"
+#include "DamageResolutionSubsystem.generated.h"
+
+class ACustomPaperCharacter;
+class AWormsMatchInfo;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDamageEvents, const TArray<FWormsDamageEvent>&, Events);
+
+// ============================================================
+//  Résolution groupée des dégâts (serveur)
+//
+//  Les explosions et atterrissages de la frame sont mis en file,
+//  puis résolus en un seul lot au tick du subsystem :
+//   1. collecte : toutes les explosions en un appel au spatial hash,
+//   2. calcul : dégâts et impulsions cumulés par cible, en tableaux
+//      parallèles (un worm touché par 3 fragments = une seule entrée),
+//   3. application : PV, éjection, morts, puis une seule liste
+//      d'événements répliquée par AWormsMatchInfo.
+//  Les clients n'ont ni RPC ni OnRep par worm : OnDamageEvents sert
+//  aux chiffres flottants et aux flashs.
+//  Le mode lockstep calcule ses dégâts dans la simulation et n'en a
+//  pas besoin.
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API UDamageResolutionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ----- Serveur -----
+
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	void QueueExplosion(const FWormsExplosion& Explosion);
+
+	/** Début de chute : mémorise l'altitude de départ. */
+	void NotifyStartedFalling(ACustomPaperCharacter* Worm);
+
+	/** Atterrissage : les dégâts de chute partent dans le prochain lot. */
+	void NotifyLanded(ACustomPaperCharacter* Worm);
+
+	/** Résout tout ce qui est en file (appelé au tick, ou à la main après une salve). */
+	void ResolvePending();
+
+	// ----- Toutes machines -----
+
+	/** Appelé par AWormsMatchInfo::OnRep_DamageEvents (et côté serveur à l'écriture). */
+	void HandleReplicatedEvents(const TArray<FWormsDamageEvent>& Events);
+
+	/** Client arrivé en cours de match : la fenêtre reçue à l'arrivée est de l'historique, marquée vue sans diffusion. */
+	void SkipReplicatedEvents(const TArray<FWormsDamageEvent>& Events);
+
+	UPROPERTY(BlueprintAssignable, Category = "Damage")
+	FOnDamageEvents OnDamageEvents;
+
+private:
+	AWormsMatchInfo* FindMatchInfo();
+
+	/** Ligne de la table de résolution : index = cible touchée dans ce lot. */
+	int32 FindOrAddTarget(ACustomPaperCharacter* Worm);
+
+	// File du lot courant
+	TArray<FWormsExplosion> PendingExplosions;
+	TArray<TPair<TWeakObjectPtr<ACustomPaperCharacter>, float>> PendingFalls;
+
+	// Altitude de début de chute, par worm en l'air
+	TMap<TObjectKey<ACustomPaperCharacter>, float> FallStartZ;
+
+	// Table de résolution (tableaux parallèles, réutilisés d'un lot à l'autre)
+	TArray<ACustomPaperCharacter*> Targets;
+	TArray<int32> TargetDamage;
+	TArray<FVector2D> TargetImpulse;
+	TArray<uint8> TargetFlags;
+	TMap<ACustomPaperCharacter*, int32> TargetToRow;
+
+	TArray<FSpatialBlast> Blasts;
+	FSpatialBatchResult BlastHits;
+
+	uint32 NextSerial = 1;
+	uint32 LastSeenSerial = 0;
+
+	TWeakObjectPtr<AWormsMatchInfo> MatchInfo;
+};
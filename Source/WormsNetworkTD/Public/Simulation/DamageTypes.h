@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "DamageTypes.generated.h"
+
+// ============================================================
+//  Constantes de résolution des dégâts
+//  Mêmes valeurs que la simulation lockstep (FLockstepSimulation).
+// ============================================================
+namespace DamageConstants
+{
+	// Chute sans dégâts (cm), puis 1 PV par cellule de 8 cm au-delà
+	static constexpr float SafeFallHeight = 320.f;
+	static constexpr float FallDamagePerUnit = 1.f / 8.f;
+
+	// Événements gardés dans la liste répliquée (les clients en retard rattrapent via Serial)
+	static constexpr int32 MaxReplicatedEvents = 32;
+
+	// Flags de FWormsDamageEvent
+	static constexpr uint8 Flag_Killed = 1 << 0;
+	static constexpr uint8 Flag_Fall = 1 << 1;
+}
+
+/** Explosion à résoudre côté serveur (plan XZ). */
+USTRUCT(BlueprintType)
+struct FWormsExplosion
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector Center = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite)
+	float Radius = 64.f;
+
+	/** Dégâts au centre, décroissance linéaire jusqu'au bord. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 Damage = 50;
+
+	/** Vitesse d'éjection au centre (cm/s). */
+	UPROPERTY(BlueprintReadWrite)
+	float Knockback = 900.f;
+};
+
+// ============================================================
+//  Événement de dégâts répliqué (chiffres flottants, flash)
+// ============================================================
+USTRUCT(BlueprintType)
+struct FWormsDamageEvent
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Croissant ; un client ignore les événements déjà vus. */
+	UPROPERTY()
+	uint32 Serial = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<AActor> Target = nullptr;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Damage = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 RemainingHealth = 0;
+
+	/** Position au moment du coup, pour placer le chiffre flottant. */
+	UPROPERTY(BlueprintReadOnly)
+	FVector_NetQuantize Location;
+
+	/** Combinaison de DamageConstants::Flag_*. */
+	UPROPERTY(BlueprintReadOnly)
+	uint8 Flags = 0;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================
+//  Arithmétique virgule fixe Q16.16
+//
+//  Toute la simulation lockstep passe par ce type : les résultats sont
+//  bit-à-bit identiques quel que soit le CPU / compilateur, ce qui n'est
+//  pas garanti avec les floats (FMA, x87, libm différentes).
+//  Les conversions float ne servent qu'aux constantes de tuning et au
+//  rendu, jamais dans la boucle de simulation.
+// ============================================================
+struct FFixed
+{
+	static constexpr int32 FracBits = 16;
+	static constexpr int32 One = 1 << FracBits;
+
+	int32 Raw = 0;
+
+	static constexpr FFixed FromRaw(int32 InRaw) { FFixed F; F.Raw = InRaw; return F; }
+	static constexpr FFixed FromInt(int32 Value) { return FromRaw(Value * One); }
+
+	/** Ratio exact Num/Den, pour les constantes (ex: 1/60). */
+	static constexpr FFixed FromRatio(int32 Num, int32 Den) { return FromRaw(static_cast<int32>((static_cast<int64>(Num) << FracBits) / Den)); }
+
+	/** Uniquement pour les constantes de tuning, hors simulation. */
+	static FFixed FromFloat(float Value) { return FromRaw(static_cast<int32>(FMath::RoundToInt(Value * One))); }
+
+	float ToFloat() const { return static_cast<float>(Raw) / One; }
+
+	/** Partie entière (arrondi vers -inf). */
+	int32 FloorToInt() const { return Raw >> FracBits; }
+
+	constexpr FFixed operator+(FFixed B) const { return FromRaw(Raw + B.Raw); }
+	constexpr FFixed operator-(FFixed B) const { return FromRaw(Raw - B.Raw); }
+	constexpr FFixed operator-() const { return FromRaw(-Raw); }
+	constexpr FFixed operator*(FFixed B) const { return FromRaw(static_cast<int32>((static_cast<int64>(Raw) * B.Raw) >> FracBits)); }
+	constexpr FFixed operator/(FFixed B) const { return FromRaw(static_cast<int32>((static_cast<int64>(Raw) << FracBits) / B.Raw)); }
+	constexpr FFixed operator*(int32 B) const { return FromRaw(Raw * B); }
+
+	FFixed& operator+=(FFixed B) { Raw += B.Raw; return *this; }
+	FFixed& operator-=(FFixed B) { Raw -= B.Raw; return *this; }
+
+	constexpr bool operator==(FFixed B) const { return Raw == B.Raw; }
+	constexpr bool operator!=(FFixed B) const { return Raw != B.Raw; }
+	constexpr bool operator<(FFixed B) const { return Raw < B.Raw; }
+	constexpr bool operator<=(FFixed B) const { return Raw <= B.Raw; }
+	constexpr bool operator>(FFixed B) const { return Raw > B.Raw; }
+	constexpr bool operator>=(FFixed B) const { return Raw >= B.Raw; }
+
+	static FFixed Abs(FFixed A) { return A.Raw < 0 ? -A : A; }
+	static FFixed Min(FFixed A, FFixed B) { return A.Raw < B.Raw ? A : B; }
+	static FFixed Max(FFixed A, FFixed B) { return A.Raw > B.Raw ? A : B; }
+	static FFixed Clamp(FFixed V, FFixed Lo, FFixed Hi) { return Min(Max(V, Lo), Hi); }
+
+	/** Racine carrée entière (Newton sur int64), déterministe. */
+	static FFixed Sqrt(FFixed A)
+	{
+		if (A.Raw <= 0)
+			return FFixed();
+
+		// sqrt(Raw * 2^16) en Q16.16
+		const uint64 N = static_cast<uint64>(A.Raw) << FracBits;
+		uint64 X = N;
+		uint64 Y = (X + 1) >> 1;
+		while (Y < X)
+		{
+			X = Y;
+			Y = (X + N / X) >> 1;
+		}
+		return FromRaw(static_cast<int32>(X));
+	}
+
+	/**
+	 * Sinus / cosinus déterministes. Angle en unités binaires :
+	 * 65536 = un tour complet (même quantification que FLockstepInput::AimAngle).
+	 * Approximation polynomiale d'ordre 5 sur le quart d'onde (erreur < 1e-4).
+	 */
+	static FFixed SinBinary(uint16 Angle)
+	{
+		// Ramène sur [0, 16384] (quart d'onde) avec symétries
+		const uint32 Quadrant = Angle >> 14;
+		int64 X = Angle & 0x3FFF;
+		if (Quadrant & 1)
+		{
+			X = 0x4000 - X;
+		}
+
+		// x dans [0,1] en Q16 ; sin(pi/2 * x) ~ x * (a - x^2 * (b - c * x^2))
+		const int64 XQ = X << 2;                              // Q16
+		const int64 X2 = (XQ * XQ) >> 16;
+		// Coefficients minimax (Q16), proches de Taylor : pi/2, (pi/2)^3/6, (pi/2)^5/120
+		constexpr int64 A = 102926;
+		constexpr int64 B = 42128;
+		constexpr int64 C = 4746;
+		const int64 Inner = B - ((C * X2) >> 16);
+		const int64 Poly = A - ((X2 * Inner) >> 16);
+		int64 Result = (XQ * Poly) >> 16;
+		Result = FMath::Min<int64>(Result, One);
+
+		return FromRaw(static_cast<int32>((Quadrant & 2) ? -Result : Result));
+	}
+
+	static FFixed CosBinary(uint16 Angle)
+	{
+		return SinBinary(static_cast<uint16>(Angle + 0x4000));
+	}
+};
+
+struct FFixedVec2
+{
+	FFixed X;
+	FFixed Z;
+
+	FFixedVec2() = default;
+	constexpr FFixedVec2(FFixed InX, FFixed InZ) : X(InX), Z(InZ) {}
+
+	FFixedVec2 operator+(const FFixedVec2& B) const { return FFixedVec2(X + B.X, Z + B.Z); }
+	FFixedVec2 operator-(const FFixedVec2& B) const { return FFixedVec2(X - B.X, Z - B.Z); }
+	FFixedVec2 operator*(FFixed S) const { return FFixedVec2(X * S, Z * S); }
+	FFixedVec2& operator+=(const FFixedVec2& B) { X += B.X; Z += B.Z; return *this; }
+	bool operator==(const FFixedVec2& B) const { return X == B.X && Z == B.Z; }
+
+	/** Longueur au carré en int64 brut (Q32.32) : pas de débordement pour les distances de la map. */
+	int64 SizeSquaredRaw() const
+	{
+		return static_cast<int64>(X.Raw) * X.Raw + static_cast<int64>(Z.Raw) * Z.Raw;
+	}
+
+	FFixed Size() const
+	{
+		// sqrt(Q32.32) = Q16.16
+		const uint64 N = static_cast<uint64>(SizeSquaredRaw());
+		if (N == 0)
+			return FFixed();
+		uint64 R = N;
+		uint64 Y = (R + 1) >> 1;
+		while (Y < R)
+		{
+			R = Y;
+			Y = (R + N / R) >> 1;
+		}
+		return FFixed::FromRaw(static_cast<int32>(R));
+	}
+
+	FVector ToVector(float Y = 0.f) const { return FVector(X.ToFloat(), Y, Z.ToFloat()); }
+	static FFixedVec2 FromVector(const FVector& V) { return FFixedVec2(FFixed::FromFloat(V.X), FFixed::FromFloat(V.Z)); }
+
+	/** Plan XZ en flottants, même repère que USpatialHashSubsystem::ToPlane. */
+	FVector2D ToPlane() const { return FVector2D(X.ToFloat(), Z.ToFloat()); }
+};
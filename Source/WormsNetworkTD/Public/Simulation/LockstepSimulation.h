@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/FixedMath.h"
+#include "Simulation/TerrainMask.h"
+#include "Simulation/WaterLevel.h"
+#include "Simulation/LockstepTypes.h"
+
+// ============================================================
+//  État simulé (POD + terrain), identique bit à bit sur chaque machine
+// ============================================================
+struct FLockstepWorm
+{
+	FFixedVec2 Position;
+	FFixedVec2 Velocity;
+	FFixed FallStartZ;
+	int32 Health = 0;
+	uint8 OwnerPlayer = 0;
+	bool bGrounded = false;
+	bool bAlive = true;
+};
+
+struct FLockstepProjectile
+{
+	FFixedVec2 Position;
+	FFixedVec2 Velocity;
+	uint8 OwnerPlayer = 0;
+};
+
+/** Origine d'un dégât, fixée par la simulation au moment où elle l'applique. */
+enum class ELockstepDamageCause : uint8
+{
+	Explosion = 0,
+	Fall = 1,
+	Water = 2
+};
+
+/** Dégât appliqué pendant un tick (flux rejoué par les replays). */
+struct FLockstepDamageOp
+{
+	uint32 Frame = 0;
+	uint8 WormIndex = 0;
+	int32 Damage = 0;
+	FFixedVec2 Impulse;
+	ELockstepDamageCause Cause = ELockstepDamageCause::Explosion;
+
+	/** Ce dégât a tué le worm. Non enregistré dans les replays (la simulation le redonne). */
+	bool bKill = false;
+};
+
+struct WORMSNETWORKTD_API FLockstepState
+{
+	uint32 Frame = 0;
+	int32 Turn = 0;
+	int32 TurnTick = 0;
+	int32 ActivePlayer = 0;
+
+	/** Décompte après la résolution du tir (phase de retraite), -1 = pas de tir. */
+	int32 RetreatTicksLeft = -1;
+	bool bShotFiredThisTurn = false;
+
+	FFixed Wind;
+	uint32 RandomState = 1;
+
+	TArray<int32> ActiveWormPerPlayer;
+	TArray<FLockstepWorm> Worms;
+	TArray<FLockstepProjectile> Projectiles;
+	FTerrainMask Terrain;
+	FWaterLevel Water;
+
+	/** Worms vivants triés par hauteur (noyade), reconstruit au chargement. */
+	FHeightIndex WormHeights;
+
+	int32 GetActiveWormIndex() const
+	{
+		return ActiveWormPerPlayer.IsValidIndex(ActivePlayer) ? ActiveWormPerPlayer[ActivePlayer] : INDEX_NONE;
+	}
+
+	/** Snapshot binaire complet (replays, resynchronisation). */
+	void Serialize(FArchive& Ar);
+};
+
+// ============================================================
+//  Simulation déterministe à pas fixe
+//
+//  Aucune dépendance au framerate, aux acteurs ou aux floats :
+//  Step() ne consomme que les inputs de la frame. Deux machines qui
+//  reçoivent le même flux d'inputs produisent le même checksum.
+// ============================================================
+class WORMSNETWORKTD_API FLockstepSimulation
+{
+public:
+	/** Durée d'un tick en secondes (virgule fixe). */
+	static const FFixed FixedDt;
+
+	void Init(const FLockstepMatchConfig& InConfig);
+
+	/**
+	 * Avance d'un tick. Inputs contient un FLockstepInput par joueur ;
+	 * seul l'input du joueur actif pilote son worm.
+	 * @return true si ce tick a clos le tour courant.
+	 */
+	bool Step(TConstArrayView<FLockstepInput> Inputs);
+
+	/** Checksum de l'état complet (worms, projectiles, terrain, RNG). */
+	uint32 ComputeChecksum() const;
+
+	const FLockstepState& GetState() const { return State; }
+	FLockstepState& GetMutableState() { return State; }
+	const FLockstepMatchConfig& GetConfig() const { return Config; }
+
+	/** Dégâts produits par le dernier Step(). */
+	const TArray<FLockstepDamageOp>& GetLastDamageOps() const { return LastDamageOps; }
+
+	/** Nombre de joueurs ayant encore au moins un worm vivant. */
+	int32 CountAlivePlayers() const;
+
+private:
+	void GenerateTerrain();
+	void SpawnWorms();
+	void StepWorm(int32 WormIndex, const FLockstepInput* Input);
+	void StepProjectiles();
+	void Explode(const FFixedVec2& Center, uint8 OwnerPlayer);
+	void ApplyDamage(int32 WormIndex, int32 Damage, const FFixedVec2& Impulse, ELockstepDamageCause Cause);
+	void EndTurn();
+	void RaiseWater();
+	uint32 NextRandom();
+
+	FLockstepMatchConfig Config;
+	FLockstepState State;
+	TArray<FLockstepDamageOp> LastDamageOps;
+};
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Simulation/LockstepSimulation.h"
+#include "Simulation/MatchReplay.h"
+#include "Simulation/MatchStatsLog.h"
+#include "LockstepSubsystem.generated.h"
+
+class ACustomPlayerController;
+class AWormsBotController;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLockstepTurnEnded, int32 /*Turn*/, uint32 /*Checksum*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLockstepFrameStepped, uint32 /*Frame*/, TConstArrayView<FLockstepInput> /*Inputs*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLockstepDesync, int32, Turn, int32, PlayerIndex);
+
+// ============================================================
+//  Subsystem lockstep
+//
+//  Fait tourner FLockstepSimulation à LockstepConstants::TickRate,
+//  indépendamment du framerate. Seuls les inputs circulent :
+//   - chaque machine échantillonne l'input local de la frame F + InputDelay
+//     et envoie au serveur, une fois par frame, un paquet unreliable de
+//     tous ses inputs pas encore confirmés (Server_SubmitLockstepInputs),
+//   - le serveur agrège les inputs de tous les joueurs et renvoie à chacun,
+//     au plus une fois par Tick, un paquet unreliable des frames complètes
+//     qu'il n'a pas encore accusées (Client_ReceiveLockstepFrames) ;
+//     l'accusé voyage dans le paquet d'inputs du client,
+//   - une frame n'est simulée qu'une fois confirmée ; sinon on attend.
+//  À chaque fin de tour, le checksum de l'état est comparé au serveur.
+//  Le match est enregistré en replay .wrpl (Saved/Replays) par le serveur
+//  si bRecordReplays (client : bRecordClientReplays), écrit hors du game thread,
+//  et le serveur journalise tirs, dégâts, morts et tours dans
+//  Saved/MatchStats (.wstat, écriture asynchrone) si bRecordMatchStats.
+//  Les slots libres d'une room FFA sont complétés par des bots
+//  (AWormsBotController) dont l'input est produit côté serveur.
+//  Sur la map de jeu (UWormsGameInstance::IsMatchWorld), le serveur lance
+//  la partie dès que tous les joueurs prévenus au lancement ont un pawn ;
+//  chaque worm de la simulation a alors un acteur, lié sur toutes les
+//  machines via ACustomPaperCharacter::LockstepWormIndex.
+// ============================================================
+UCLASS(Config = Game)
+class WORMSNETWORKTD_API ULockstepSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ----- Démarrage -----
+
+	/** Serveur : attribue un index à chaque PlayerController et lance la partie partout. */
+	UFUNCTION(BlueprintCallable, Category = "Lockstep")
+	void StartLockstepMatch(FLockstepMatchConfig Config);
+
+	/**
+	 * Serveur : config de match à partir des settings de la session hôte
+	 * (FRoomSettings : UnitLife, UnitCount, TurnsBeforeWater), graine tirée ici.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lockstep")
+	FLockstepMatchConfig MakeMatchConfigFromSession() const;
+
+	/** Serveur : partie avec NumBots bots en plus des joueurs, au moins deux participants (Worms.BotMatch). */
+	void StartBotMatch(int32 NumBots);
+
+	/** Toutes machines : initialise la simulation (appelé par Client_StartLockstep). */
+	void BeginMatch(const FLockstepMatchConfig& Config, int32 InLocalPlayerIndex);
+
+	UFUNCTION(BlueprintPure, Category = "Lockstep")
+	bool IsRunning() const { return bRunning; }
+
+	UFUNCTION(BlueprintPure, Category = "Lockstep")
+	int32 GetLocalPlayerIndex() const { return LocalPlayerIndex; }
+
+	const FLockstepSimulation& GetSimulation() const { return Simulation; }
+
+	// ----- Input local -----
+
+	/** Appelé à chaque frame où l'action Move est active. */
+	void SetLocalMoveAxis(float Axis);
+
+	/** Boutons à inclure dans le prochain input échantillonné. */
+	void AddLocalButtons(uint8 Buttons);
+
+	/** Tir : angle en degrés (0 = droite, 90 = haut), puissance 0..1. */
+	UFUNCTION(BlueprintCallable, Category = "Lockstep")
+	void QueueFire(float AimDegrees, float Power01);
+
+	/**
+	 * Aperçu de visée du worm actif (vent et terrain courants), à appeler
+	 * chaque frame pendant la visée. Vide si ce n'est pas le tour local.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lockstep")
+	TArray<FVector> PreviewLocalShot(float AimDegrees, float Power01) const;
+
+	// ----- Réseau (appelé par ACustomPlayerController) -----
+
+	/** Serveur : input d'un joueur pour une frame future (un doublon est ignoré). */
+	void ServerReceiveInput(AController* From, uint32 Frame, const FLockstepInput& Input);
+
+	/** Serveur : paquet redondant d'un client, frame par frame via ServerReceiveInput, et son accusé. */
+	void ServerReceiveInputPacket(AController* From, const FLockstepInputPacket& Packet);
+
+	/** Toutes machines : paquet redondant de frames confirmées, frame par frame via ReceiveConfirmedFrame. */
+	void ReceiveConfirmedFramePacket(const FLockstepFramePacket& Packet);
+
+	/** Serveur : checksum de fin de tour remonté par un client. */
+	void ServerReceiveTurnChecksum(ACustomPlayerController* From, int32 Turn, uint32 Checksum);
+
+	// ----- Présentation -----
+
+	/** Les acteurs liés suivent la position simulée du worm (aucune réplication de mouvement). */
+	void BindWormActor(int32 WormIndex, AActor* Actor);
+
+	// ----- Events -----
+	FOnLockstepTurnEnded OnTurnEnded;
+	FOnLockstepFrameStepped OnFrameStepped;
+
+	UPROPERTY(BlueprintAssignable, Category = "Lockstep")
+	FOnLockstepDesync OnDesync;
+
+	/** Chemin du dernier replay (vide si aucun) ; l'écriture peut être encore en cours. */
+	const FString& GetLastReplayPath() const { return LastReplayPath; }
+
+protected:
+	/** Serveur : la simulation étant identique partout, un seul replay suffit. */
+	UPROPERTY(Config)
+	bool bRecordReplays = true;
+
+	/** Client : replay local en plus de celui du serveur (opt-in). */
+	UPROPERTY(Config)
+	bool bRecordClientReplays = false;
+
+	/** Serveur : journal de statistiques (équilibrage, exploitation). */
+	UPROPERTY(Config)
+	bool bRecordMatchStats = true;
+
+	/** Complète les rooms FFA avec des bots jusqu'à GetMaxPlayersForGameMode. */
+	UPROPERTY(Config)
+	bool bFillFFAWithBots = true;
+
+	/** Map de jeu : délai max d'attente des joueurs prévenus avant de lancer sans eux. */
+	UPROPERTY(Config)
+	float AutoStartTimeoutSeconds = 20.f;
+
+private:
+	struct FPendingFrame
+	{
+		TArray<FLockstepInput> Inputs;
+		uint32 ReceivedMask = 0;
+	};
+
+	/** Envoi des frames confirmées à un client distant. */
+	struct FServerPeer
+	{
+		/** Première frame que le client n'a pas (FLockstepInputPacket::AckFrame). */
+		uint32 AckFrame = 0;
+
+		/** ServerNextConfirmFrame au dernier envoi : au-delà, du nouveau à envoyer. */
+		uint32 SentUntilFrame = 0;
+		double LastSendSeconds = 0.0;
+	};
+
+	bool CanStepFrame(uint32 Frame) const;
+	void SampleLocalInput();
+	void SendLocalInputs();
+	uint32 GetFirstMissingFrame() const;
+	void ReceiveConfirmedFrame(uint32 Frame, TConstArrayView<FLockstepInput> Inputs);
+	void ServerSampleBotInputs();
+	int32 ServerGetBotFillCount(int32 NumHumans) const;
+	void ServerSpawnBots(int32 NumBots);
+	void ServerTryAutoStart();
+	void ServerBindWormActors(const FLockstepMatchConfig& Config);
+	void StepOneFrame();
+	void SyncBoundActors();
+	void ServerTryConfirmFrames();
+	void ServerSendConfirmedFrames();
+	void ServerCheckChecksum(int32 Turn, int32 PlayerIndex, uint32 Checksum);
+	uint32 ServerGetExpectedMask() const;
+	int32 ServerGetPlayerIndex(const AController* Controller) const;
+	ACustomPlayerController* GetLocalController() const;
+	void EndMatch();
+
+	FLockstepSimulation Simulation;
+	bool bRunning = false;
+	int32 LocalPlayerIndex = INDEX_NONE;
+	double Accumulator = 0.0;
+
+	FMatchReplayWriter ReplayWriter;
+	FString LastReplayPath;
+
+	/** Écriture du dernier replay sur le pool de threads. */
+	TFuture<bool> ReplaySaveTask;
+
+	// ----- Statistiques (serveur) -----
+	void StatsBeginMatch();
+	void StatsRecordFrame(uint32 Frame, int32 Turn, TConstArrayView<FLockstepInput> Inputs, int32 ActivePlayer, bool bShotBefore, bool bTurnEnded, uint32 Checksum);
+	void StatsEndMatch();
+
+	/** Journal de la session (UWormsGameInstance::GetMatchStatsWriter) ; null si désactivé. */
+	FMatchStatsWriter* StatsWriter = nullptr;
+	bool bStatsRecording = false;
+	bool bStatsShotThisTurn = false;
+	uint32 StatsTurnStartFrame = 0;
+	double StatsTurnStartSeconds = 0.0;
+
+	// ----- Côté local -----
+	uint32 NextSampleFrame = 0;
+	TMap<uint32, TArray<FLockstepInput>> ConfirmedFrames;
+	float PendingMoveAxis = 0.f;
+	uint64 LastMoveInputFrame = 0;
+	FLockstepInput PendingInput;
+
+	/** Inputs envoyés mais pas encore revenus dans une frame confirmée (renvoyés à chaque paquet). */
+	TArray<FLockstepInput> UnconfirmedInputs;
+	uint32 FirstUnconfirmedFrame = 0;
+
+	/** Frame échantillonnée, accusé reçu ou frames confirmées reçues depuis le dernier paquet. */
+	bool bInputsDirty = false;
+	double LastInputSendSeconds = 0.0;
+
+	// ----- Côté serveur -----
+	/** Slots lockstep : joueurs humains puis bots, index = ordre du tableau. */
+	TArray<TWeakObjectPtr<AController>> ServerPlayers;
+	TArray<TWeakObjectPtr<AWormsBotController>> ServerBots;
+	int32 ForcedBotCount = INDEX_NONE;
+
+	/** Map de jeu : partie lancée automatiquement à l'arrivée des joueurs. */
+	bool bAutoStartPending = false;
+	double AutoStartDeadline = 0.0;
+
+	/** Acteurs créés pour les worms sans pawn (unités suivantes, bots). */
+	TArray<TWeakObjectPtr<AActor>> ServerSpawnedWorms;
+
+	TMap<uint32, FPendingFrame> ServerPendingFrames;
+	uint32 ServerNextConfirmFrame = 0;
+
+	/** Parallèle à ServerPlayers (slots des bots et du joueur local inutilisés). */
+	TArray<FServerPeer> ServerPeers;
+
+	/** Frames confirmées qu'un client distant n'a pas encore accusées. */
+	TMap<uint32, TArray<FLockstepInput>> ServerConfirmedHistory;
+
+	/** Fin de partie : au-delà, les clients qui n'ont pas accusé sont abandonnés. */
+	double ServerFlushDeadline = 0.0;
+
+	/** Checksums calculés par la simulation serveur, par tour. */
+	TMap<int32, uint32> ServerTurnChecksums;
+
+	/** Rapports clients arrivés avant que le serveur ait fini le tour. */
+	TMultiMap<int32, TPair<int32, uint32>> ServerPendingReports;
+
+	UPROPERTY()
+	TMap<int32, TWeakObjectPtr<AActor>> BoundActors;
+};
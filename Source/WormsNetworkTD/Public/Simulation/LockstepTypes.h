@@ -0,0 +1,199 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LockstepTypes.generated.h"
+
+// ============================================================
+//  Constantes de la simulation lockstep
+//  Les valeurs de tuning reprennent celles d'ACustomPaperCharacter
+//  (GravityScale 2.5, JumpZVelocity 800, MaxWalkSpeed 600).
+// ============================================================
+namespace LockstepConstants
+{
+	// Fréquence fixe de la simulation, indépendante du framerate
+	static constexpr int32 TickRate = 60;
+
+	// Retard d'entrée : l'input échantillonné à la frame F est appliqué à F + InputDelay
+	static constexpr uint32 InputDelayFrames = 3;
+
+	// Nombre max de joueurs (masque 8 bits côté serveur)
+	static constexpr int32 MaxPlayers = 8;
+
+	// Inputs par paquet (FLockstepInputPacket) : ~260 ms à 60 Hz de redondance
+	static constexpr int32 MaxPacketInputs = 16;
+
+	// Frames par paquet descendant (FLockstepFramePacket), même fenêtre
+	static constexpr int32 MaxPacketFrames = 16;
+
+	// Sous-pas max d'un projectile par tick (évite de traverser une paroi fine)
+	static constexpr int32 MaxProjectileSubsteps = 8;
+
+	// Boutons de FLockstepInput::Buttons
+	static constexpr uint8 Button_Jump = 1 << 0;
+	static constexpr uint8 Button_Fire = 1 << 1;
+}
+
+// ============================================================
+//  Input d'un joueur pour une frame de simulation
+//  Seule donnée échangée en lockstep : ~4 bits au repos,
+//  ~28 bits lors d'un tir.
+// ============================================================
+USTRUCT(BlueprintType)
+struct FLockstepInput
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** -1 = gauche, 0 = immobile, 1 = droite. */
+	UPROPERTY()
+	int8 MoveAxis = 0;
+
+	/** Combinaison de LockstepConstants::Button_*. */
+	UPROPERTY(BlueprintReadWrite)
+	uint8 Buttons = 0;
+
+	/** Angle de visée, 65536 = un tour (cf. FFixed::SinBinary). */
+	UPROPERTY()
+	uint16 AimAngle = 0;
+
+	/** Puissance du tir, 0..255. */
+	UPROPERTY(BlueprintReadWrite)
+	uint8 Power = 0;
+
+	bool HasButton(uint8 Button) const { return (Buttons & Button) != 0; }
+
+	bool operator==(const FLockstepInput& Other) const
+	{
+		return MoveAxis == Other.MoveAxis && Buttons == Other.Buttons
+			&& AimAngle == Other.AimAngle && Power == Other.Power;
+	}
+
+	/** Sérialisation compacte : 2 bits de déplacement, 2 bits de boutons, visée uniquement si tir. */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLockstepInput> : public TStructOpsTypeTraitsBase2<FLockstepInput>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// ============================================================
+//  Paquet d'inputs client -> serveur (un par frame réseau, unreliable)
+//
+//  Inputs des frames FirstFrame, FirstFrame + 1, ... ; tout input pas
+//  encore confirmé par le serveur est renvoyé dans le paquet suivant,
+//  si bien qu'une perte est réparée sans retransmission fiable.
+//  Le paquet porte aussi l'accusé des frames confirmées reçues (AckFrame).
+//  ~72 bits d'en-tête puis ~4 bits par frame au repos.
+// ============================================================
+USTRUCT()
+struct FLockstepInputPacket
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	uint32 FirstFrame = 0;
+
+	/** Première frame confirmée que le client n'a pas encore : le serveur renvoie à partir d'elle. */
+	UPROPERTY()
+	uint32 AckFrame = 0;
+
+	/** Au plus LockstepConstants::MaxPacketInputs. */
+	UPROPERTY()
+	TArray<FLockstepInput> Inputs;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLockstepInputPacket> : public TStructOpsTypeTraitsBase2<FLockstepInputPacket>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// ============================================================
+//  Paquet de frames confirmées serveur -> client (unreliable)
+//
+//  Frames FirstFrame, FirstFrame + 1, ... ; pour chacune, les inputs de
+//  tous les joueurs dans l'ordre des index. Le serveur repart de l'accusé
+//  du client (FLockstepInputPacket::AckFrame) : une frame perdue revient
+//  dans le paquet suivant sans bloquer les autres.
+//  ~40 bits d'en-tête puis ~4 bits par joueur et par frame au repos.
+// ============================================================
+USTRUCT()
+struct FLockstepFramePacket
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	uint32 FirstFrame = 0;
+
+	/** Inputs par frame (FLockstepMatchConfig::NumPlayers). */
+	UPROPERTY()
+	uint8 NumPlayers = 0;
+
+	/** NumPlayers inputs par frame, au plus LockstepConstants::MaxPacketFrames frames. */
+	UPROPERTY()
+	TArray<FLockstepInput> Inputs;
+
+	int32 GetNumFrames() const { return NumPlayers > 0 ? Inputs.Num() / NumPlayers : 0; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLockstepFramePacket> : public TStructOpsTypeTraitsBase2<FLockstepFramePacket>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// ============================================================
+//  Paramètres d'une partie lockstep (identiques sur toutes les machines)
+// ============================================================
+USTRUCT(BlueprintType)
+struct FLockstepMatchConfig
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 NumPlayers = 2;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 UnitsPerPlayer = 1;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 UnitLife = 100;
+
+	/** Durée max d'un tour en ticks de simulation. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 TicksPerTurn = 45 * LockstepConstants::TickRate;
+
+	/** Graine partagée : terrain, vent. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 Seed = 0;
+
+	/** Taille de la map en cellules FTerrainMask. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 MapWidthCells = 512;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 MapHeightCells = 256;
+
+	/** Tours avant que l'eau commence à monter (FRoomSettings::TurnsBeforeWater). */
+	UPROPERTY(BlueprintReadWrite)
+	int32 TurnsBeforeWater = 10;
+
+	/** Montée de l'eau à chaque fin de tour, en cellules. */
+	UPROPERTY(BlueprintReadWrite)
+	int32 WaterRiseCells = 3;
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/BitWriter.h"
+#include "Async/Future.h"
+#include "Simulation/LockstepSimulation.h"
+
+// ============================================================
+//  Replays de match (format .wrpl)
+//
+//  Puisque la simulation lockstep est déterministe, un replay n'a besoin
+//  que de la config, d'un snapshot de départ et du flux d'inputs :
+//   - Keyframe : snapshot compressé de FLockstepState en début de tour
+//                (tous les KeyframeIntervalTurns tours) pour le seek,
+//   - Turn     : inputs bit-packés du tour (1 bit par frame sans input),
+//                dégâts appliqués et checksum de fin de tour,
+//   - Index    : table des keyframes en fin de fichier.
+//  Un match complet tient en quelques dizaines de Ko.
+// ============================================================
+namespace MatchReplayConstants
+{
+	static constexpr uint32 Magic = 0x4C505257; // "WRPL"
+	static constexpr uint32 Version = 3;
+
+	// Un keyframe tous les N tours : compromis taille / temps de seek
+	static constexpr int32 KeyframeIntervalTurns = 4;
+
+	static const TCHAR* FileExtension = TEXT(".wrpl");
+}
+
+struct FMatchReplayKeyframe
+{
+	uint32 Frame = 0;
+	int32 Turn = 0;
+	int64 Offset = 0;
+};
+
+struct FMatchReplayTurn
+{
+	int32 Turn = 0;
+	uint32 StartFrame = 0;
+	uint32 NumFrames = 0;
+	uint32 Checksum = 0;
+
+	/** false pour le dernier tour si le match a été interrompu (pas de checksum). */
+	bool bComplete = false;
+
+	/** Inputs bit-packés (cf. FLockstepInput::NetSerialize). */
+	TArray<uint8> PackedInputs;
+	int64 PackedInputBits = 0;
+
+	TArray<FLockstepDamageOp> DamageOps;
+};
+
+// ============================================================
+//  Écriture (pendant le match)
+// ============================================================
+class WORMSNETWORKTD_API FMatchReplayWriter
+{
+public:
+	/** À appeler juste après FLockstepSimulation::Init. */
+	void Begin(const FLockstepMatchConfig& Config, const FLockstepState& InitialState);
+
+	/** Après chaque Step : inputs de la frame et dégâts produits. */
+	void RecordFrame(uint32 Frame, TConstArrayView<FLockstepInput> Inputs, TConstArrayView<FLockstepDamageOp> DamageOps);
+
+	/** Fin de tour : State est déjà le début du tour suivant. */
+	void RecordTurnEnd(int32 Turn, uint32 Checksum, const FLockstepState& State);
+
+	/** Termine l'enregistrement (tour en cours inclus) et rend le fichier complet. */
+	bool Finalize(TArray<uint8>& OutData);
+
+	/** Finalize puis écriture synchrone (outils). Renvoie false en cas d'échec disque. */
+	bool Finish(const FString& Path);
+
+	/** Écriture sur le pool de threads ; le résultat indique le succès disque. */
+	static TFuture<bool> SaveAsync(const FString& Path, TArray<uint8>&& Data);
+
+	bool IsRecording() const { return bRecording; }
+
+	/** Chemin par défaut : Saved/Replays/Match_<date>.wrpl */
+	static FString MakeDefaultPath();
+
+private:
+	void WriteKeyframe(const FLockstepState& State);
+	void FlushTurn();
+
+	bool bRecording = false;
+	int32 NumPlayers = 0;
+	TArray<uint8> Buffer;
+	TUniquePtr<FArchive> Writer;
+	TArray<FMatchReplayKeyframe> Keyframes;
+
+	FMatchReplayTurn CurrentTurn;
+	TUniquePtr<FBitWriter> TurnBits;
+};
+
+// ============================================================
+//  Lecture / seek / vérification (client ou serveur headless)
+// ============================================================
+class WORMSNETWORKTD_API FMatchReplayReader
+{
+public:
+	bool Open(const FString& Path);
+	bool OpenFromMemory(TArray<uint8>&& Data);
+
+	const FLockstepMatchConfig& GetConfig() const { return Config; }
+	const TArray<FMatchReplayKeyframe>& GetKeyframes() const { return Keyframes; }
+	const TArray<FMatchReplayTurn>& GetTurns() const { return Turns; }
+	uint32 GetNumFrames() const;
+
+	/**
+	 * Place Sim sur l'état juste avant Frame : charge le keyframe précédent
+	 * puis re-simule au plus KeyframeIntervalTurns tours.
+	 */
+	bool SeekToFrame(uint32 Frame, FLockstepSimulation& Sim) const;
+
+	/** Avance Sim d'une frame à partir des inputs enregistrés. */
+	bool StepFrame(FLockstepSimulation& Sim) const;
+
+	/** Inputs enregistrés pour une frame donnée. */
+	bool GetFrameInputs(uint32 Frame, TArray<FLockstepInput>& OutInputs) const;
+
+	/**
+	 * Re-simule tout le match depuis le début et compare checksums
+	 * et dégâts au flux enregistré (résolution de litiges).
+	 */
+	bool Verify(FString& OutError) const;
+
+private:
+	bool Parse();
+	bool LoadKeyframe(const FMatchReplayKeyframe& Keyframe, FLockstepSimulation& Sim) const;
+	int32 FindTurnIndex(uint32 Frame) const;
+	void DecodeTurn(int32 TurnIndex) const;
+
+	TArray<uint8> Data;
+	FLockstepMatchConfig Config;
+	TArray<FMatchReplayKeyframe> Keyframes;
+	TArray<FMatchReplayTurn> Turns;
+
+	// Cache du dernier tour décodé (les lectures sont séquentielles)
+	mutable int32 DecodedTurnIndex = INDEX_NONE;
+	mutable TArray<FLockstepInput> DecodedInputs;
+};
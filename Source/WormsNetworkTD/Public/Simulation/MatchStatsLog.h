@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+class IFileHandle;
+
+// ============================================================
+//  Journal de statistiques de match (format .wstat)
+//
+//  Fichier en ajout seul, un par session serveur, plusieurs matchs à
+//  la suite (MatchBegin ... MatchEnd) :
+//    Magic (u32) | Version (u32) | enregistrements
+//  Enregistrement : longueur (u16) | type (u8) | champs du type.
+//  La longueur permet de sauter un type inconnu (version plus récente)
+//  et de s'arrêter proprement sur une fin tronquée (serveur tué) ;
+//  un nouveau champ s'ajoute en fin d'enregistrement.
+// ============================================================
+namespace MatchStatsConstants
+{
+	static constexpr uint32 Magic = 0x41545357; // "WSTA"
+	static constexpr uint32 Version = 1;
+
+	/** Période de vidage du thread d'écriture. */
+	static constexpr uint32 FlushIntervalMs = 500;
+
+	static const TCHAR* FileExtension = TEXT(".wstat");
+}
+
+enum class EMatchStatsRecord : uint8
+{
+	MatchBegin = 1,
+	Shot = 2,
+	Damage = 3,
+	Death = 4,
+	TurnEnd = 5,
+	MatchEnd = 6
+};
+
+enum class EMatchStatsCause : uint8
+{
+	Weapon = 0,
+	Fall = 1,
+	Water = 2
+};
+
+/**
+ * Enregistrement à plat : seuls les champs de son type sont écrits
+ * (cf. Serialize). POD, copié tel quel dans la file du thread d'écriture.
+ */
+struct WORMSNETWORKTD_API FMatchStatsRecord
+{
+	EMatchStatsRecord Type = EMatchStatsRecord::MatchBegin;
+	uint32 Frame = 0;
+	int32 Turn = 0;
+
+	/** Joueur actif (Shot, TurnEnd), propriétaire du worm (Damage, Death), vainqueur (MatchEnd, 0xFF = aucun). */
+	uint8 Player = 0;
+	uint8 Worm = 0;
+
+	// ----- Shot -----
+	uint16 AimAngle = 0;
+	uint8 Power = 0;
+	int32 WindRaw = 0;
+
+	// ----- Damage / Death -----
+	int32 Damage = 0;
+	EMatchStatsCause Cause = EMatchStatsCause::Weapon;
+	bool bKill = false;
+
+	// ----- TurnEnd -----
+	int32 TurnTicks = 0;
+	uint32 TurnMs = 0;
+	int32 WaterRow = 0;
+	bool bShot = false;
+	uint32 Checksum = 0;
+
+	// ----- MatchBegin -----
+	int64 StartTicksUtc = 0;
+	uint8 NumPlayers = 0;
+	uint8 UnitsPerPlayer = 0;
+	int32 UnitLife = 0;
+	int32 Seed = 0;
+	int32 TurnsBeforeWater = 0;
+
+	// ----- MatchEnd : Frame, Turn, Player -----
+	bool bComplete = false;
+
+	void Serialize(FArchive& Ar);
+};
+
+// ============================================================
+//  Écriture asynchrone
+//
+//  Push() (game thread) ne fait qu'un Enqueue dans une file sans verrou
+//  (TQueue MPSC) : ni accès disque ni verrou côté gameplay.
+//  Un FRunnable vide la file toutes les FlushIntervalMs (ou sur Flush()),
+//  encode les enregistrements et les ajoute au fichier en une écriture.
+//  Le fichier est ouvert par ce thread ; la destruction attend le
+//  dernier vidage.
+// ============================================================
+class WORMSNETWORKTD_API FMatchStatsWriter : public FRunnable
+{
+public:
+	explicit FMatchStatsWriter(const FString& InPath);
+	virtual ~FMatchStatsWriter() override;
+
+	/** Thread-safe (plusieurs producteurs). */
+	void Push(const FMatchStatsRecord& Record);
+
+	/** Réveille le thread d'écriture sans attendre la prochaine période. */
+	void Flush();
+
+	const FString& GetPath() const { return Path; }
+
+	/** Enregistrements écrits / perdus (fichier non ouvert ou écriture refusée). */
+	int64 GetNumWritten() const { return NumWritten; }
+	int64 GetNumDropped() const { return NumDropped; }
+
+	/** Saved/MatchStats/Stats_<date>.wstat */
+	static FString MakeDefaultPath();
+
+	// ----- FRunnable -----
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void Drain();
+
+	FString Path;
+	TQueue<FMatchStatsRecord, EQueueMode::Mpsc> Queue;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopRequested{ false };
+
+	// ----- Thread d'écriture uniquement -----
+	TUniquePtr<IFileHandle> File;
+	TArray<uint8> Scratch;
+	std::atomic<int64> NumWritten{ 0 };
+	std::atomic<int64> NumDropped{ 0 };
+};
+
+// ============================================================
+//  Lecture (outil hors ligne, cf. Worms.MatchStats)
+// ============================================================
+class WORMSNETWORKTD_API FMatchStatsReader
+{
+public:
+	/**
+	 * Appelle Visit pour chaque enregistrement connu du fichier. Faux si
+	 * l'en-tête est invalide ; une fin tronquée arrête la lecture sans erreur
+	 * (bOutTruncated).
+	 */
+	static bool ReadFile(const FString& Path, TFunctionRef<void(const FMatchStatsRecord&)> Visit, bool& bOutTruncated);
+
+	static bool ReadMemory(TConstArrayView<uint8> Data, TFunctionRef<void(const FMatchStatsRecord&)> Visit, bool& bOutTruncated);
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ============================================================
+//  Catégories d'entrées (masque de filtre pour les requêtes)
+// ============================================================
+namespace SpatialCategory
+{
+	static constexpr uint8 Worm = 1 << 0;
+	static constexpr uint8 Projectile = 1 << 1;
+	static constexpr uint8 Pickup = 1 << 2;
+	static constexpr uint8 All = 0xFF;
+}
+
+/** Explosion à résoudre (plan XZ du jeu). */
+struct FSpatialBlast
+{
+	FVector2D Center = FVector2D::ZeroVector;
+	float Radius = 0.f;
+	uint8 CategoryMask = SpatialCategory::All;
+};
+
+/** Un couple (explosion, entrée) dans le rayon. */
+struct FSpatialHit
+{
+	int32 BlastIndex = 0;
+	int32 Handle = INDEX_NONE;
+	float DistanceSquared = 0.f;
+};
+
+/**
+ * Résultat d'une requête groupée, au format CSR : les hits de l'explosion i
+ * sont Hits[BlastOffsets[i] .. BlastOffsets[i + 1]).
+ */
+struct FSpatialBatchResult
+{
+	TArray<FSpatialHit> Hits;
+	TArray<int32> BlastOffsets;
+
+	TConstArrayView<FSpatialHit> GetHitsForBlast(int32 BlastIndex) const
+	{
+		return TConstArrayView<FSpatialHit>(Hits.GetData() + BlastOffsets[BlastIndex], BlastOffsets[BlastIndex + 1] - BlastOffsets[BlastIndex]);
+	}
+};
+
+// ============================================================
+//  Spatial hash 2D à grille uniforme
+//
+//  Chaque entrée vit dans la liste chaînée (double) du bucket de sa
+//  cellule. Un déplacement qui reste dans la même cellule ne coûte
+//  qu'une écriture de position ; un changement de cellule est un
+//  unlink/link en O(1). Les handles sont stables (free-list).
+//  Plusieurs cellules peuvent partager un bucket : chaque entrée garde
+//  sa cellule pour filtrer les collisions de hash.
+// ============================================================
+class WORMSNETWORKTD_API FSpatialHash2D
+{
+public:
+	explicit FSpatialHash2D(float InCellSize = 128.f, int32 InNumBuckets = 1024);
+
+	int32 Add(const FVector2D& Position, uint8 Category, int32 UserData = INDEX_NONE);
+	void Remove(int32 Handle);
+
+	/** Mise à jour incrémentale : O(1), relink uniquement si la cellule change. */
+	void Update(int32 Handle, const FVector2D& Position);
+
+	bool IsValidHandle(int32 Handle) const { return Entries.IsValidIndex(Handle) && Entries[Handle].bUsed; }
+	const FVector2D& GetPosition(int32 Handle) const { return Entries[Handle].Position; }
+	int32 GetUserData(int32 Handle) const { return Entries[Handle].UserData; }
+	int32 Num() const { return NumUsed; }
+
+	/** Toutes les entrées dans le rayon de chaque explosion, en un seul appel. */
+	void QueryRadiusBatch(TConstArrayView<FSpatialBlast> Blasts, FSpatialBatchResult& OutResult) const;
+
+	/** Variante unitaire (renvoie les handles). */
+	void QueryRadius(const FVector2D& Center, float Radius, uint8 CategoryMask, TArray<int32>& OutHandles) const;
+
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		FVector2D Position = FVector2D::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int32 UserData = INDEX_NONE;
+		uint8 Category = 0;
+		bool bUsed = false;
+	};
+
+	FIntPoint ToCell(const FVector2D& Position) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Position.X * InvCellSize), FMath::FloorToInt32(Position.Y * InvCellSize));
+	}
+
+	int32 BucketOf(const FIntPoint& Cell) const
+	{
+		// Hash de Teschner et al. (grands premiers), masqué sur une puissance de 2
+		const uint32 H = (static_cast<uint32>(Cell.X) * 73856093u) ^ (static_cast<uint32>(Cell.Y) * 19349663u);
+		return static_cast<int32>(H & BucketMask);
+	}
+
+	void Link(int32 Handle);
+	void Unlink(int32 Handle);
+
+	template<typename FunctorType>
+	void ForEachInRadius(const FVector2D& Center, float Radius, uint8 CategoryMask, FunctorType&& Functor) const;
+
+	float CellSize;
+	float InvCellSize;
+	uint32 BucketMask;
+	TArray<int32> BucketHeads;
+	TArray<FEntry> Entries;
+	TArray<int32> FreeList;
+	int32 NumUsed = 0;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Simulation/SpatialHash2D.h"
+#include "SpatialHashSubsystem.generated.h"
+
+// ============================================================
+//  Spatial hash du monde (worms, projectiles, pickups)
+//
+//  Les acteurs s'enregistrent à leur BeginPlay. Le hash suit leur
+//  RootComponent via TransformUpdated : seuls les acteurs qui bougent
+//  sont mis à jour, sans tick ni parcours global.
+//  Remplace les overlaps moteur pour les explosions : une bombe à
+//  fragmentation résout toutes ses explosions en un appel.
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API USpatialHashSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Enregistre un acteur (idempotent). Category = SpatialCategory::*. */
+	void RegisterActor(AActor* Actor, uint8 Category);
+	void UnregisterActor(AActor* Actor);
+
+	/** Toutes les explosions en un seul passage ; résoudre les acteurs avec GetActor(Hit.Handle). */
+	void QueryExplosions(TConstArrayView<FSpatialBlast> Blasts, FSpatialBatchResult& OutResult) const;
+
+	/** Requête unitaire (Blueprint), plan XZ. */
+	UFUNCTION(BlueprintCallable, Category = "Spatial")
+	TArray<AActor*> QueryRadius(FVector Center, float Radius) const;
+
+	AActor* GetActor(int32 Handle) const;
+
+	const FSpatialHash2D& GetHash() const { return Hash; }
+
+	static FVector2D ToPlane(const FVector& Location) { return FVector2D(Location.X, Location.Z); }
+
+private:
+	void HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 Handle);
+
+	struct FRegisteredActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformHandle;
+	};
+
+	FSpatialHash2D Hash;
+
+	/** Indexé par handle du hash. */
+	TArray<FRegisteredActor> Registered;
+	TMap<TObjectKey<AActor>, int32> ActorToHandle;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/FixedMath.h"
+
+// ============================================================
+//  Masque de terrain destructible (1 bit par cellule)
+//
+//  Ligne 0 = bas de la map. Chaque ligne est stockée sur WordsPerRow
+//  mots de 64 bits (bit x%64 du mot x/64), ce qui permet de tester ou
+//  de creuser une ligne entière en quelques opérations.
+//  Partagé par la simulation lockstep, l'eau, les trajectoires et les bots.
+// ============================================================
+struct WORMSNETWORKTD_API FTerrainMask
+{
+	/** Taille d'une cellule en unités monde (cm). */
+	static constexpr int32 CellSize = 8;
+
+	FTerrainMask() = default;
+	FTerrainMask(int32 InWidth, int32 InHeight) { Init(InWidth, InHeight); }
+
+	void Init(int32 InWidth, int32 InHeight);
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetWordsPerRow() const { return WordsPerRow; }
+
+	bool IsValidCell(int32 X, int32 Y) const { return X >= 0 && Y >= 0 && X < Width && Y < Height; }
+
+	bool IsSolid(int32 X, int32 Y) const
+	{
+		if (!IsValidCell(X, Y))
+			return false;
+		return (Bits[Y * WordsPerRow + (X >> 6)] >> (X & 63)) & 1ull;
+	}
+
+	void SetSolid(int32 X, int32 Y, bool bSolid);
+
+	/** Remplit toutes les cellules de [0, Height) sous la hauteur donnée par colonne. */
+	void FillColumnsFromHeights(const TArray<int32>& ColumnHeights);
+
+	/**
+	 * Creuse un disque (explosion). Renvoie la plage de lignes modifiées
+	 * [OutMinRow, OutMaxRow] pour les mises à jour incrémentales.
+	 */
+	bool CarveCircle(int32 CenterX, int32 CenterY, int32 Radius, int32& OutMinRow, int32& OutMaxRow);
+
+	/** Plus haute cellule solide de la colonne X sous MaxY (INDEX_NONE si aucune). */
+	int32 FindGroundBelow(int32 X, int32 MaxY) const;
+
+	/** Accès direct aux mots d'une ligne (pour les traitements par lignes). */
+	const uint64* GetRow(int32 Y) const { return &Bits[Y * WordsPerRow]; }
+
+	/** Hash du masque complet (checksum de désync). */
+	uint32 ComputeHash(uint32 Crc = 0) const;
+
+	void Serialize(FArchive& Ar);
+
+	// ----- Conversions monde <-> cellules -----
+
+	static int32 WorldToCell(FFixed World)
+	{
+		// Division entière arrondie vers -inf (les coordonnées négatives sont hors map)
+		const int32 W = World.FloorToInt();
+		return W >= 0 ? W / CellSize : -((-W + CellSize - 1) / CellSize);
+	}
+	static FFixed CellToWorld(int32 Cell) { return FFixed::FromInt(Cell * CellSize); }
+	static int32 WorldToCell(float World) { return FMath::FloorToInt(World / CellSize); }
+
+	bool IsSolidAtWorld(const FFixedVec2& Pos) const { return IsSolid(WorldToCell(Pos.X), WorldToCell(Pos.Z)); }
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 WordsPerRow = 0;
+	TArray<uint64> Bits;
+};
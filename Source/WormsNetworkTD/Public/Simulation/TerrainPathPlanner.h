@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/TerrainMask.h"
+
+/** Colonne traversée par un déplacement planifié. */
+struct FTerrainPathStep
+{
+	int32 CellX = 0;
+
+	/** Cellule des pieds une fois sur cette colonne. */
+	int32 FeetY = 0;
+
+	/** Marche trop haute pour le pas automatique : sauter avant d'y entrer. */
+	bool bJump = false;
+};
+
+// ============================================================
+//  Planificateur de déplacement sur le masque de terrain
+//
+//  Un worm ne se déplace que vers la gauche ou la droite : le chemin
+//  est une suite de colonnes, chacune avec la surface sous ses pieds.
+//  On avance colonne par colonne en suivant le sol local (grottes
+//  comprises) tant que la marche est franchissable :
+//   - montée d'une cellule : pas automatique de la simulation,
+//   - montée jusqu'à MaxJumpCells : saut,
+//   - descente jusqu'à MaxDropCells : chute sans dégâts,
+//   - sinon (mur, trou, eau) : arrêt.
+//  Coût O(colonnes parcourues), aucune allocation hors OutSteps.
+// ============================================================
+struct WORMSNETWORKTD_API FTerrainPathPlanner
+{
+	/** Hauteur de saut franchissable (JumpZVelocity 800, gravité 2450 : ~16 cellules). */
+	static constexpr int32 MaxJumpCells = 12;
+
+	/** Chute sans dégâts : SafeFallHeight 320 cm = 40 cellules. */
+	static constexpr int32 MaxDropCells = 40;
+
+	/**
+	 * Avance de FromX vers ToX (au plus MaxColumns colonnes) depuis des pieds
+	 * en FromFeetY. Les colonnes dont la surface serait sous WaterRow sont
+	 * interdites. Renvoie la dernière colonne atteignable (FromX si bloqué).
+	 */
+	static int32 PlanWalk(const FTerrainMask& Terrain, int32 FromX, int32 FromFeetY, int32 ToX,
+		int32 MaxColumns, int32 WaterRow, TArray<FTerrainPathStep>& OutSteps);
+
+	/** Surface (cellule des pieds) de la colonne X atteignable depuis FeetY, INDEX_NONE sinon. */
+	static int32 FindFeetY(const FTerrainMask& Terrain, int32 X, int32 FeetY);
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/TerrainMask.h"
+#include "Simulation/LockstepTypes.h"
+
+// ============================================================
+//  Constantes balistiques
+//  Mêmes valeurs et même découpage en sous-pas que
+//  FLockstepSimulation::StepProjectiles (gravité = GravityScale 2.5
+//  d'ACustomPaperCharacter), en flottants : l'aperçu et les bots
+//  n'ont pas besoin d'être déterministes, la simulation fait foi.
+// ============================================================
+namespace TrajectoryConstants
+{
+	static constexpr float Gravity = -980.f * 2.5f;
+	static constexpr float ProjectileMaxSpeed = 1500.f;
+	static constexpr float SpawnHeight = 2.f * FTerrainMask::CellSize;
+	static constexpr float Dt = 1.f / 60.f;
+
+	// Sous-pas de position par tick : un par cellule parcourue, plafonné
+	static constexpr int32 MaxSubsteps = LockstepConstants::MaxProjectileSubsteps;
+
+	/** Nombre de sous-pas pour un déplacement (DX, DZ) sur un tick, règle de la simulation. */
+	FORCEINLINE int32 GetSubsteps(float DX, float DZ)
+	{
+		return FMath::Clamp(FMath::FloorToInt(FMath::Max(FMath::Abs(DX), FMath::Abs(DZ))) / FTerrainMask::CellSize + 1, 1, MaxSubsteps);
+	}
+
+	// Taille des lots SIMD
+	static constexpr int32 LaneCount = 4;
+}
+
+struct FTrajectoryParams
+{
+	/** Position du tireur (pieds), plan XZ. */
+	FVector2D Origin = FVector2D::ZeroVector;
+	float Wind = 0.f;
+	float Gravity = TrajectoryConstants::Gravity;
+	float MaxSpeed = TrajectoryConstants::ProjectileMaxSpeed;
+	int32 MaxTicks = 5 * 60;
+};
+
+struct FTrajectoryCandidate
+{
+	float AngleDegrees = 45.f;
+	float Power01 = 1.f;
+};
+
+struct FTrajectoryImpact
+{
+	FVector2D Position = FVector2D::ZeroVector;
+	int32 Ticks = 0;
+
+	/** Faux si le projectile sort de la map ou dépasse MaxTicks. */
+	bool bHitTerrain = false;
+};
+
+// ============================================================
+//  Solveur de trajectoires
+//
+//  Intègre les candidats par paquets de LaneCount dans des registres
+//  VectorRegister4Float (positions et vitesses en SoA) ; seule la
+//  lecture du masque de terrain reste scalaire, une fois par voie
+//  encore en vol. Même ordre d'opérations que la version scalaire :
+//  les deux donnent des impacts identiques au bit près.
+//   - aperçu de visée : BuildPreview, un seul tir, points tous les N ticks,
+//   - bots : FindBestShot, balayage angle x puissance vers une cible.
+//
+//  Benchmark : Worms.TrajectoryBench (Saved/Profiling/TrajectoryBench.txt)
+// ============================================================
+class WORMSNETWORKTD_API FTrajectorySolver
+{
+public:
+	/** Impact de chaque candidat ; OutImpacts.Num() == Candidates.Num(). */
+	static void SimulateBatch(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+		TConstArrayView<FTrajectoryCandidate> Candidates, TArrayView<FTrajectoryImpact> OutImpacts);
+
+	/** Référence scalaire (un candidat), pour le benchmark et les cas isolés. */
+	static FTrajectoryImpact SimulateOne(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+		const FTrajectoryCandidate& Candidate);
+
+	/** Points de la trajectoire (un tous les PointEveryTicks ticks), impact inclus. */
+	static FTrajectoryImpact BuildPreview(const FTerrainMask& Terrain, const FTrajectoryParams& Params,
+		const FTrajectoryCandidate& Candidate, TArray<FVector2D>& OutPoints, int32 PointEveryTicks = 2);
+
+	/**
+	 * Balaye AngleSteps x PowerSteps candidats (angles sur ]0, 180[ degrés)
+	 * et garde l'impact au sol le plus proche de Target, à plus de
+	 * MinSelfDistance du tireur. Renvoie faux si aucun candidat ne touche.
+	 */
+	static bool FindBestShot(const FTerrainMask& Terrain, const FTrajectoryParams& Params, const FVector2D& Target,
+		int32 AngleSteps, int32 PowerSteps, float MinSelfDistance,
+		FTrajectoryCandidate& OutBest, float& OutMissDistance);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/FixedMath.h"
+#include "Simulation/TerrainMask.h"
+
+// ============================================================
+//  Niveau d'eau (montée par paliers aux fins de tour)
+//
+//  La surface est horizontale : la zone immergée est l'ensemble des
+//  cellules vides sous la ligne d'eau, stockée comme un masque de bits
+//  parallèle à FTerrainMask. Chaque mise à jour ne touche que les lignes
+//  concernées (lignes nouvellement immergées, ou lignes creusées par une
+//  explosion sous l'eau) : O(lignes modifiées), jamais O(map).
+// ============================================================
+struct WORMSNETWORKTD_API FWaterLevel
+{
+	void Init(const FTerrainMask& Terrain, int32 InRow);
+
+	/** Nombre de lignes de cellules sous l'eau (valeur répliquée, quantifiée). */
+	int32 GetRow() const { return Row; }
+	FFixed GetWorldZ() const { return FTerrainMask::CellToWorld(Row); }
+
+	/** Monte jusqu'à NewRow. Renvoie le nombre de lignes traitées. */
+	int32 RaiseTo(int32 NewRow, const FTerrainMask& Terrain);
+
+	/** Terrain creusé sur [MinRow, MaxRow] : recalcule la part immergée de ces lignes. */
+	void OnTerrainChanged(const FTerrainMask& Terrain, int32 MinRow, int32 MaxRow);
+
+	bool IsWaterCell(int32 X, int32 Y) const
+	{
+		if (X < 0 || Y < 0 || X >= Width || Y >= Row)
+			return false;
+		return (WaterBits[Y * WordsPerRow + (X >> 6)] >> (X & 63)) & 1ull;
+	}
+
+	/** Mots de la ligne Y du masque d'eau (Y < GetRow()). */
+	const uint64* GetWaterRow(int32 Y) const { return &WaterBits[Y * WordsPerRow]; }
+
+private:
+	void RebuildRow(const FTerrainMask& Terrain, int32 Y);
+
+	int32 Row = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 WordsPerRow = 0;
+	TArray<uint64> WaterBits;
+};
+
+// ============================================================
+//  Index des worms trié par hauteur
+//
+//  Tenu à jour au fil des déplacements (seuls les worms qui bougent
+//  sont réinsérés) ; « qui est sous l'eau » devient une recherche
+//  dichotomique + le préfixe concerné, sans parcourir tous les worms.
+// ============================================================
+struct WORMSNETWORKTD_API FHeightIndex
+{
+	void Reset(int32 NumEntries);
+
+	/** Position Z d'une entrée ; l'entrée est replacée à son rang. */
+	void SetHeight(int32 Index, FFixed Z);
+
+	/** Retire définitivement une entrée (worm mort). */
+	void Remove(int32 Index);
+
+	/** Toutes les entrées strictement sous Z, de la plus basse à la plus haute. */
+	void CollectBelow(FFixed Z, TArray<int32>& OutIndices) const;
+
+	int32 Num() const { return Sorted.Num(); }
+
+private:
+	struct FEntry
+	{
+		int32 ZRaw = 0;
+		int32 Index = 0;
+
+		bool operator<(const FEntry& Other) const
+		{
+			return ZRaw != Other.ZRaw ? ZRaw < Other.ZRaw : Index < Other.Index;
+		}
+	};
+
+	TArray<FEntry> Sorted;
+	TArray<int32> Heights;   // Z brut courant de chaque index, pour retrouver son entrée
+	TBitArray<> Removed;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WaterSubsystem.generated.h"
+
+class AWormsMatchInfo;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWaterLevelChanged, float, WaterWorldZ, int32, WaterRow);
+
+// ============================================================
+//  Subsystem d'eau
+//
+//  La montée et la noyade sont calculées par la simulation lockstep
+//  (FLockstepSimulation::RaiseWater, déterministe). Ce subsystem en
+//  est la façade monde :
+//   - serveur : à chaque fin de tour, pousse le niveau dans AWormsMatchInfo,
+//   - tous : relaie le niveau répliqué aux visuels (OnWaterLevelChanged).
+// ============================================================
+UCLASS()
+class WORMSNETWORKTD_API UWaterSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintPure, Category = "Water")
+	int32 GetWaterLevelRow() const { return WaterRow; }
+
+	/** Hauteur monde de la surface de l'eau. */
+	UFUNCTION(BlueprintPure, Category = "Water")
+	float GetWaterWorldZ() const;
+
+	UFUNCTION(BlueprintPure, Category = "Water")
+	bool IsSubmerged(const FVector& WorldLocation) const { return WorldLocation.Z < GetWaterWorldZ(); }
+
+	/** Appelé par AWormsMatchInfo::OnRep_WaterLevelRow (et côté serveur à l'écriture). */
+	void HandleWaterLevelRow(int32 Row);
+
+	UPROPERTY(BlueprintAssignable, Category = "Water")
+	FOnWaterLevelChanged OnWaterLevelChanged;
+
+private:
+	void HandleTurnEnded(int32 Turn, uint32 Checksum);
+
+	int32 WaterRow = 0;
+	FDelegateHandle TurnEndedHandle;
+
+	UPROPERTY()
+	TObjectPtr<AWormsMatchInfo> MatchInfo;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Simulation/LockstepSimulation.h"
+#include "Simulation/TerrainPathPlanner.h"
+#include "Simulation/TrajectorySolver.h"
+
+// ============================================================
+//  Cerveau de bot (un joueur lockstep)
+//
+//  Fonction de l'état de simulation uniquement : produit le même
+//  FLockstepInput qu'un joueur humain (déplacement, saut, tir), qui
+//  suit ensuite le chemin réseau normal. Le tour d'un bot :
+//   1. cible = worm ennemi vivant le plus proche,
+//   2. tir direct si FTrajectorySolver trouve un impact assez proche,
+//   3. sinon marche vers la cible (FTerrainPathPlanner), puis tir,
+//   4. après le tir, recul à l'opposé pendant la retraite.
+//  Ne tourne que sur le serveur : aucune contrainte de déterminisme.
+// ============================================================
+struct WORMSNETWORKTD_API FWormBotBrain
+{
+	void Reset(int32 InPlayerIndex);
+
+	/** Input de ce joueur pour la frame échantillonnée (appelé une fois par frame). */
+	FLockstepInput Think(const FLockstepState& State);
+
+	int32 GetPlayerIndex() const { return PlayerIndex; }
+
+private:
+	enum class EPhase : uint8
+	{
+		Waiting,
+		Walking,
+		Aiming,
+		Retreating
+	};
+
+	void PlanTurn(const FLockstepState& State, const FLockstepWorm& Self);
+
+	/** Cherche un tir vers la cible depuis la position actuelle ; tir de repli sinon. */
+	void PlanShot(const FLockstepState& State, const FLockstepWorm& Self);
+
+	int32 PlayerIndex = INDEX_NONE;
+	EPhase Phase = EPhase::Waiting;
+	int32 PlannedTurn = INDEX_NONE;
+
+	FVector2D TargetPosition = FVector2D::ZeroVector;
+	int32 MoveDir = 1;
+
+	// Marche
+	TArray<FTerrainPathStep> Path;
+	int32 WalkEndX = 0;
+	int32 WalkFrames = 0;
+	int32 LastCellX = 0;
+	int32 StuckFrames = 0;
+
+	// Tir
+	FTrajectoryCandidate Shot;
+	int32 AimFramesLeft = 0;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+class ACustomPaperCharacter;
+
+// ============================================================
+//  Snapshot d'un worm (mode acteur)
+//
+//  Base pour une validation de tir côté serveur et une réconciliation
+//  du client propriétaire : ni l'une ni l'autre n'est branchée, la
+//  capture est opt-in (ACustomPaperCharacter::bRecordSnapshotHistory).
+//  État qui compte pour le gameplay d'ACustomPaperCharacter, en POD :
+//  copie par memcpy, aucune allocation à la capture ni à la
+//  restauration. Le temps est celui du serveur (GetServerWorldTimeSeconds
+//  côté client), pour comparer les historiques des deux côtés.
+// ============================================================
+struct FWormSnapshot
+{
+	double Time = 0.0;
+	FVector3f Location = FVector3f::ZeroVector;
+	FVector3f Velocity = FVector3f::ZeroVector;
+	int16 Health = 0;
+	uint8 AnimState = 0;    // EPlayerState
+	uint8 MovementMode = 0; // EMovementMode
+	int8 Facing = 1;
+
+	/** Interpolation entre deux snapshots : position et vitesse, le reste vient de A. */
+	static FWormSnapshot Lerp(const FWormSnapshot& A, const FWormSnapshot& B, double Time);
+};
+
+static_assert(TIsTriviallyCopyConstructible<FWormSnapshot>::Value, "FWormSnapshot doit rester POD");
+
+// ============================================================
+//  Historique à taille fixe (anneau)
+//
+//  Une entrée par tick du worm ; la plus ancienne est écrasée.
+//  Stockage inline (TStaticArray) : l'historique vit dans l'acteur,
+//  sans allocation ni pointeur à suivre.
+// ============================================================
+class WORMSNETWORKTD_API FWormSnapshotHistory
+{
+public:
+	/** ~1 s à 60 Hz : de quoi couvrir un ping élevé le jour où la validation existe. */
+	static constexpr int32 Capacity = 64;
+
+	void Reset() { Head = 0; Count = 0; }
+
+	/** Ajoute un snapshot ; un temps non croissant remplace le dernier. */
+	void Push(const FWormSnapshot& Snapshot);
+
+	int32 Num() const { return Count; }
+	bool IsEmpty() const { return Count == 0; }
+
+	/** i = 0 : le plus ancien. */
+	const FWormSnapshot& Get(int32 Index) const { return Slots[(Head - Count + Index + Capacity) % Capacity]; }
+	const FWormSnapshot& Latest() const { return Get(Count - 1); }
+
+	/**
+	 * État au temps demandé, interpolé entre les deux snapshots qui
+	 * l'encadrent. Faux s'il sort de l'historique (trop ancien ou vide) ;
+	 * au-delà du dernier, renvoie le dernier.
+	 */
+	bool Sample(double Time, FWormSnapshot& OutSnapshot) const;
+
+private:
+	TStaticArray<FWormSnapshot, Capacity> Slots;
+	int32 Head = 0;
+	int32 Count = 0;
+};
+
+// ============================================================
+//  Retour arrière temporaire (serveur, pour une future validation de tir)
+//
+//  Replace le worm à son état au temps donné, puis restaure l'état
+//  courant à la destruction. Le spatial hash suit le déplacement
+//  (TransformUpdated) : les requêtes faites dans la portée voient
+//  les positions passées.
+// ============================================================
+class WORMSNETWORKTD_API FScopedWormRewind
+{
+public:
+	FScopedWormRewind(ACustomPaperCharacter* InWorm, double Time);
+	~FScopedWormRewind();
+
+	/** Faux si le temps sort de l'historique : le worm n'a pas bougé. */
+	bool IsRewound() const { return bRewound; }
+
+private:
+	ACustomPaperCharacter* Worm = nullptr;
+	FWormSnapshot Saved;
+	bool bRewound = false;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/Button.h"
+#include "Engine/Texture2D.h"
 #include "RoomInfoTemplate.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnJoinClicked, int32, SessionIndex);
@@ -41,6 +42,10 @@ public:
 	UPROPERTY()
 	int32 SessionIndex;
 
+	// Icône du mode (préchargée, nullptr tant que le streaming n'est pas fini)
+	UPROPERTY(BlueprintReadOnly, Category = "Room Info")
+	TObjectPtr<UTexture2D> RoomModeIcon;
+
 
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<UButton> Btn_JoinLobby;
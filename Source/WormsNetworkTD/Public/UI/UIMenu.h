@@ -25,6 +25,11 @@ class WORMSNETWORKTD_API UUIMenu : public UUserWidget
 protected:
 	virtual void NativeConstruct() override;
 
+	/** Utilisé uniquement pour poser le marqueur "premier affichage" de la trace de démarrage. */
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+		const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+		int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
 public:
 	// ============================================================
 	//  MENU PRINCIPAL
@@ -137,12 +142,16 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
 	TArray<TObjectPtr<URoomInfoTemplate>> RoomInfosUI;
 
+	/** Liste en direct : lignes patchées par les hôtes LAN au lieu de recherches complètes. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	bool bLiveRoomList = true;
+
 	// ============================================================
 	//  SETTINGS DE PARTIE (valeurs sélectionnées dans les ComboBox)
 	// ============================================================
 
 	UPROPERTY(BlueprintReadOnly, Category = "Settings")
-	FString SelectedGameMode = LobbyConstants::GameMode_1V1;
+	EWormsGameMode SelectedGameMode = EWormsGameMode::OneVsOne;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Settings")
 	int32 SelectedTurnsBeforeWater = 10;
@@ -267,6 +276,16 @@ public:
 	UFUNCTION()
 	bool PassFilter(const FCustomSessionInfo& Session) const;
 
+	/** Filtre envoyé à la recherche, construit depuis les cases de mode. */
+	FRoomQueryFilter MakeQueryFilter() const;
+
+	/** Recoche "Tous" sans relancer de recherche. */
+	void ResetModeFilter();
+
+	/** Patch d'une ligne de la liste en direct (ajout, joueurs, fermeture). */
+	UFUNCTION()
+	void HandleRoomListPatched(const FCustomSessionInfo& Room, ERoomListChange Change);
+
 	// ============================================================
 	//  JOIN / LOBBY — état
 	// ============================================================
@@ -283,10 +302,28 @@ public:
 	UFUNCTION()
 	void HandleBeaconCreated(ALobbyBeaconClient* BeaconClient);
 
+	/** L'hôte a fermé la room : retour au menu principal. */
+	UFUNCTION()
+	void HandleLobbyClosed();
+
+	/** Réapplique les icônes préchargées sur les widgets déjà affichés. */
+	UFUNCTION()
+	void HandlePreloadedAssetsChanged();
+
+	/** Profil chargé : les settings de la dernière room sont reproposés. */
+	UFUNCTION()
+	void HandleProfileLoaded();
+
 private:
 	/** Référence au subsystem de session (initialisée dans NativeConstruct). */
 	TObjectPtr<UOnlineSessionSubsystem> SessionSubsystem;
 
+	/** Référence au subsystem de préchargement (initialisée dans NativeConstruct). */
+	TObjectPtr<class UAssetPreloadSubsystem> PreloadSubsystem;
+
+	/** Référence au subsystem de profil (initialisée dans NativeConstruct). */
+	TObjectPtr<class UPlayerProfileSubsystem> ProfileSubsystem;
+
 	// ============================================================
 	//  État interne des filtres (source de vérité)
 	// ============================================================
@@ -304,4 +341,17 @@ private:
 
 	/** Met à jour les widgets de statut de la room (Status + PlayerNb). */
 	void UpdateRoomStatusUI(bool bIsOpen, int32 CurrentPlayers);
+
+	/** Sélectionne les valeurs de Settings dans les ComboBox de création de room. */
+	void ApplyRoomSettingsToUI(const FRoomSettings& Settings);
+
+	/** Résout les textures d'icônes d'un widget joueur depuis le preload. */
+	void ApplyPlayerIcons(UUserInfoTemplate* PlayerInfoWidget) const;
+
+	/** Valeurs affichées d'une ligne de room (création et patch). */
+	void ApplyRoomInfo(URoomInfoTemplate* RoomInfoWidget, const FString& RoomName, int32 RoomModeID,
+		int32 PlayerInRoom, int32 MaxPlayerInRoom, int32 RoomPing) const;
+
+	/** Ligne affichée pour FoundSessions[SessionIndex], nullptr si retirée. */
+	URoomInfoTemplate* FindRoomInfoUI(int32 SessionIndex) const;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/Texture2D.h"
 #include "UserInfoTemplate.generated.h"
 
 /**
@@ -30,4 +31,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player Info")
 	int32 PlayerId;
 
+	// Textures résolues par UAssetPreloadSubsystem (nullptr tant que le streaming n'est pas fini)
+	UPROPERTY(BlueprintReadOnly, Category = "Player Info")
+	TObjectPtr<UTexture2D> ProfileIconTexture;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Player Info")
+	TObjectPtr<UTexture2D> TeamIconTexture;
+
+	//To Update the UI Ingame when values change
+	UFUNCTION(BlueprintNativeEvent)
+	void UpdateValues();
+	void UpdateValues_Implementation();
 };
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "Simulation/MatchStatsLog.h"
 #include "WormsGameInstance.generated.h"
 
 UCLASS()
@@ -10,6 +11,9 @@ class WORMSNETWORKTD_API UWormsGameInstance : public UGameInstance
 	GENERATED_BODY()
 
 public:
+	virtual void Init() override;
+	virtual void Shutdown() override;
+
 	/**
 	 * Mis  true par Client_NotifyGameStarting() avant le ServerTravel.
 	 * Survit  tous les travels  empche BeginPlay du PlayerController
@@ -17,4 +21,24 @@ public:
 	 */
 	UPROPERTY()
 	bool bGameStarted = false;
+
+	/**
+	 * Serveur : nombre de joueurs prvenus au lancement (OnStartGameClicked).
+	 * La partie lockstep dmarre quand ils ont tous un pawn sur la map de jeu.
+	 */
+	UPROPERTY()
+	int32 ExpectedMatchPlayers = 0;
+
+	/** Monde de jeu d'une partie lance (pas le menu ni une preview d'diteur). */
+	static bool IsMatchWorld(const UWorld* World);
+
+	/**
+	 * Serveur : journal .wstat de la session, cr au premier match.
+	 * Vit ici et non dans ULockstepSubsystem (un par monde) : un seul
+	 * fichier pour tous les matchs, ServerTravel compris.
+	 */
+	FMatchStatsWriter& GetMatchStatsWriter();
+
+private:
+	TUniquePtr<FMatchStatsWriter> MatchStatsWriter;
 };
\ No newline at end of file
@@ -2,5 +2,16 @@
 
 #include "WormsNetworkTD.h"
 #include "Modules/ModuleManager.h"
+#include "Profiling/StartupTrace.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, WormsNetworkTD, "WormsNetworkTD" );
+class FWormsNetworkTDModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		FDefaultGameModuleImpl::StartupModule();
+		FStartupTrace::Mark(StartupTraceMarkers::ModuleStartup);
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FWormsNetworkTDModule, WormsNetworkTD, "WormsNetworkTD" );